@@ -22,9 +22,11 @@
 #include <stdint.h>
 #endif
 
+#include <onnx-mlir/Runtime/OMAsync.h>
 #include <onnx-mlir/Runtime/OMInstrument.h>
 #include <onnx-mlir/Runtime/OMSignature.h>
 #include <onnx-mlir/Runtime/OMTensor.h>
+#include <onnx-mlir/Runtime/OMTensorArena.h>
 #include <onnx-mlir/Runtime/OMTensorList.h>
 
 /*! \mainpage ONNX-MLIR Runtime API documentation
@@ -114,8 +116,9 @@
  * \subsection reference Reference
  *
  * For full reference to available C Runtime API, refer to
- * `include/onnx-mlir/Runtime/OMTensor.h` and
- * `include/onnx-mlir/Runtime/OMTensorList.h`.
+ * `include/onnx-mlir/Runtime/OMTensor.h`,
+ * `include/onnx-mlir/Runtime/OMTensorList.h` and, for asynchronous inference,
+ * `include/onnx-mlir/Runtime/OMAsync.h`.
  *
  */
 
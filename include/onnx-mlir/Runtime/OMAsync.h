@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------- OMAsync.h - OMAsyncQueue Declaration header ------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of the asynchronous inference API: a queue
+// of inference requests served by a pool of worker threads.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMASYNC_H
+#define ONNX_MLIR_OMASYNC_H
+
+#include "onnx-mlir/Runtime/OMTensorList.h"
+
+struct OMAsyncQueue;
+
+#ifndef __cplusplus
+typedef struct OMAsyncQueue OMAsyncQueue;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Model entry point, e.g. run_main_graph */
+typedef OMTensorList *(*OMEntryPointFunc)(OMTensorList *);
+
+/* Completion callback, called from a worker thread with the output list of
+ * the inference, which is then owned by the callback.
+ */
+typedef void (*OMAsyncCallback)(OMTensorList *output, void *userData);
+
+/**
+ * \brief OMAsyncQueue creator
+ *
+ * Create a queue of inference requests for a model entry point, served by
+ * numThreads worker threads. Requests are run in submission order, up to
+ * numThreads of them at the same time.
+ *
+ * @param entryPoint model entry point to call for each request
+ * @param numThreads number of worker threads, at least 1
+ * @return pointer to the OMAsyncQueue created, NULL if creation failed or
+ * if asynchronous inference is not supported on this platform.
+ *
+ */
+OMAsyncQueue *omAsyncQueueCreate(
+    OMEntryPointFunc entryPoint, int64_t numThreads);
+
+/**
+ * \brief OMAsyncQueue destroyer
+ *
+ * Wait for all the submitted requests to complete, then destroy the queue
+ * and its worker threads. The queue must not be destroyed from a completion
+ * callback, which runs on one of these threads: such a call reports an error
+ * and leaves the queue alive.
+ *
+ * @param queue pointer to the OMAsyncQueue to be destroyed
+ *
+ */
+void omAsyncQueueDestroy(OMAsyncQueue *queue);
+
+/**
+ * \brief Asynchronous inference
+ *
+ * Enqueue an inference request and return without waiting for it. Once
+ * the inference completes, callback is called from a worker thread with
+ * the output list and userData. The input list remains owned by the
+ * caller and must stay alive until the callback is called.
+ *
+ * @param queue queue to submit the request to
+ * @param input input list of the inference
+ * @param callback function called with the output list on completion
+ * @param userData opaque pointer passed to callback
+ * @return 0 if the request was submitted, -1 otherwise.
+ *
+ */
+int omRunAsync(OMAsyncQueue *queue, OMTensorList *input,
+    OMAsyncCallback callback, void *userData);
+
+/**
+ * \brief Asynchronous inference with a given entry point
+ *
+ * Same as omRunAsync, but the request calls entryPoint instead of the entry
+ * point of the queue. This lets the worker threads of one queue serve the
+ * requests of several models.
+ *
+ * @param queue queue to submit the request to
+ * @param entryPoint model entry point to call for this request
+ * @param input input list of the inference
+ * @param callback function called with the output list on completion
+ * @param userData opaque pointer passed to callback
+ * @return 0 if the request was submitted, -1 otherwise.
+ *
+ */
+int omRunAsyncWithEntryPoint(OMAsyncQueue *queue, OMEntryPointFunc entryPoint,
+    OMTensorList *input, OMAsyncCallback callback, void *userData);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMASYNC_H
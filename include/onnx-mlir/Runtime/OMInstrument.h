@@ -60,6 +60,23 @@ void OMInstrumentInit();
  */
 void OMInstrumentPoint(int64_t id, int64_t tag);
 
+/**
+ * Create an instrument point for a named node.
+ * Same as OMInstrumentPoint, for an op identified by its full op name and by
+ * the name of its node in the model. In addition, the time elapsed since the
+ * previous point is accumulated, at each after-op point, into per node and per
+ * op type statistics (call count, total, min and max time). These statistics
+ * are written, sorted by decreasing total time, at process exit.
+ *
+ * @param opName name of the op, e.g. "Conv"
+ * @param nodeName name of the node, e.g. the ONNX node name
+ * @param tag can used to give extra control of output. Used for begin/end mark now
+ * @return void
+ *
+ */
+void OMInstrumentNamedPoint(
+    const char *opName, const char *nodeName, int64_t tag);
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +52,12 @@
 
 struct OMTensor;
 
+/* Alignment, in bytes, of the data buffers allocated by omTensorCreateEmpty.
+ * Models compiled with --aligned-entry-point run a faster code path when all
+ * their inputs are aligned on this boundary.
+ */
+#define OM_TENSOR_ALIGNMENT 64
+
 #ifndef __cplusplus
 typedef struct OMTensor OMTensor;
 #endif
@@ -111,7 +117,8 @@ OMTensor *omTensorCreateWithOwnership(void *data_ptr, int64_t *shape,
  * MemRefs to OMTensors for user convenience.
  *
  * The OMTensor created using this constructor owns the underlying memory
- * space allocated to the content of the tensor.
+ * space allocated to the content of the tensor. The content is aligned on
+ * OM_TENSOR_ALIGNMENT bytes.
  *
  * @param shape list of integers indicating the tensor shape.
  * @param rank tensor rank.
@@ -143,6 +150,16 @@ void omTensorDestroy(OMTensor *tensor);
  */
 void *omTensorGetDataPtr(OMTensor *tensor);
 
+/**
+ * \brief OMTensor allocated pointer getter.
+ *
+ * @param tensor pointer to the OMTensor
+ * @return pointer to the allocated data buffer of the OMTensor, i.e. the
+ *         pointer freed when an owning OMTensor is destroyed,
+ *         NULL if the allocated data buffer is not set.
+ */
+void *omTensorGetAllocatedPtr(OMTensor *tensor);
+
 /**
  * \brief OMTensor data shape getter.
  *
@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------- OMTensorArena.h - OMTensorArena Declaration header ----------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of OMTensorArena, a reusable arena for the
+// metadata of OMTensors and OMTensorLists.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMTENSORARENA_H
+#define ONNX_MLIR_OMTENSORARENA_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+struct OMTensorArena;
+
+#ifndef __cplusplus
+typedef struct OMTensorArena OMTensorArena;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief OMTensorArena creator
+ *
+ * Create an arena for OMTensor and OMTensorList structs. While an arena is
+ * current on a thread, the OMTensors and OMTensorLists created on that
+ * thread, including the outputs of a model entry point, are allocated from
+ * the arena instead of the heap. The arena grows as needed. After a reset,
+ * it reuses its memory, so that steady-state inferences do no heap
+ * allocation for metadata. Tensor data buffers are not affected.
+ *
+ * A typical inference loop is:
+ *
+ * ```c
+ * OMTensorArena *arena = omTensorArenaCreate(4096);
+ * omTensorArenaSetCurrent(arena);
+ * while (...) {
+ *   OMTensorList *output = run_main_graph(input);
+ *   ...
+ *   omTensorListDestroy(output); // frees the output data buffers
+ *   omTensorArenaReset(arena);   // reclaims the output metadata
+ * }
+ * omTensorArenaSetCurrent(NULL);
+ * omTensorArenaDestroy(arena);
+ * ```
+ *
+ * The current arena is a thread-local variable of the runtime, and every
+ * model library links its own copy of the runtime. An arena only applies to
+ * the models that see the same copy as the caller of omTensorArenaSetCurrent.
+ * A model library loaded with dlopen(RTLD_LOCAL), as ExecutionSession does,
+ * keeps its own copy: look up omTensorArenaSetCurrent in that library with
+ * dlsym and call it instead.
+ *
+ * @param size initial size of the arena in bytes
+ * @return pointer to the OMTensorArena created, NULL if creation failed.
+ *
+ */
+OMTensorArena *omTensorArenaCreate(int64_t size);
+
+/**
+ * \brief OMTensorArena destroyer
+ *
+ * Destroy the arena. OMTensors and OMTensorLists allocated from it must no
+ * longer be used.
+ *
+ * @param arena pointer to the OMTensorArena to be destroyed
+ *
+ */
+void omTensorArenaDestroy(OMTensorArena *arena);
+
+/**
+ * \brief OMTensorArena reset
+ *
+ * Reclaim all the OMTensors and OMTensorLists allocated from the arena.
+ * Destroying them before the reset is still needed to free the data
+ * buffers they own, but does not free their metadata.
+ *
+ * @param arena pointer to the OMTensorArena to be reset
+ *
+ */
+void omTensorArenaReset(OMTensorArena *arena);
+
+/**
+ * \brief Current OMTensorArena setter
+ *
+ * @param arena arena to allocate from on the calling thread, NULL to
+ * allocate from the heap.
+ *
+ */
+void omTensorArenaSetCurrent(OMTensorArena *arena);
+
+/**
+ * \brief Current OMTensorArena getter
+ *
+ * @return arena allocated from on the calling thread, NULL if none.
+ *
+ */
+OMTensorArena *omTensorArenaGetCurrent();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMTENSORARENA_H
@@ -64,6 +64,19 @@ OMTensorList *omTensorListCreate(OMTensor **tensors, int64_t n);
 OMTensorList *omTensorListCreateWithOwnership(
     OMTensor **tensors, int64_t n, int64_t owning);
 
+/**
+ * \brief OMTensor pointer array creator
+ *
+ * Create an array of n OMTensor pointers, to be passed with ownership to
+ * omTensorListCreateWithOwnership. The array is allocated from the current
+ * OMTensorArena of the thread if any, from the heap otherwise.
+ *
+ * @param n number of elements in the array
+ * @return pointer to the array created, NULL if creation failed.
+ *
+ */
+OMTensor **omTensorArrayCreate(int64_t n);
+
 /**
  * \brief OMTensorList destroyer
  *
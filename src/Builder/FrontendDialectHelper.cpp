@@ -83,6 +83,15 @@ struct TransformValueToONNXData<int8_t> {
   }
 };
 
+// FLOAT16 and BFLOAT16 values are stored as their bit patterns in int32_data.
+template <>
+struct TransformValueToONNXData<uint16_t> {
+  static const google::protobuf::RepeatedField<int32_t> data(
+      onnx::TensorProto initializer) {
+    return initializer.int32_data();
+  }
+};
+
 template <>
 struct TransformValueToONNXData<bool> {
   static const google::protobuf::RepeatedField<int32_t> data(
@@ -172,6 +181,23 @@ mlir::DenseElementsAttr onnxTensorProtoToDenseElmAttr(
         tensorType, llvm::makeArrayRef(arrayAttrInitializer));
     break;
   }
+  case (onnx::TensorProto::FLOAT16):
+  case (onnx::TensorProto::BFLOAT16): {
+    // Half precision data is read as raw 16 bit patterns and reinterpreted
+    // with the semantics of the element type.
+    const auto &arrayAttrInitializer =
+        CreateArrayAttribute<uint16_t>(initializer);
+    mlir::FloatType elmType =
+        (initializer.data_type() == onnx::TensorProto::FLOAT16)
+            ? builder.getF16Type()
+            : builder.getBF16Type();
+    auto tensorType = mlir::RankedTensorType::get(tensorDims, elmType);
+    llvm::SmallVector<llvm::APFloat, 64> values;
+    for (uint16_t bits : arrayAttrInitializer)
+      values.emplace_back(elmType.getFloatSemantics(), llvm::APInt(16, bits));
+    denseElmAttr = mlir::DenseElementsAttr::get(tensorType, values);
+    break;
+  }
   case (onnx::TensorProto::INT8): {
     const auto &arrayAttrInitializer =
         CreateArrayAttribute<int8_t>(initializer);
@@ -241,6 +267,8 @@ mlir::Type convertONNXTypeToMLIRType(
   switch (onnxType) {
   case onnx::TensorProto_DataType::TensorProto_DataType_FLOAT16:
     return builder_.getF16Type();
+  case onnx::TensorProto_DataType::TensorProto_DataType_BFLOAT16:
+    return builder_.getBF16Type();
   case onnx::TensorProto_DataType::TensorProto_DataType_FLOAT:
     return builder_.getF32Type();
   case onnx::TensorProto_DataType::TensorProto_DataType_DOUBLE:
@@ -1233,6 +1233,11 @@ private:
 
   void InitHandlerMap() {
 #include "src/Builder/OpBuildTable.inc"
+    // Operators from opsets newer than the ONNX version onnx-mlir is built
+    // with, which are defined in AdditionalONNXOps.td.
+    import_handler_map_["LayerNormalization"] =
+        &onnx_mlir::detail::FrontendGenImpl::buildOperation<
+            mlir::ONNXLayerNormalizationOp>;
   }
 
   /*!
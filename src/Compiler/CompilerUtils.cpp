@@ -514,6 +514,8 @@ static std::string genSharedLib(string outputBaseName, std::vector<string> opts,
   string sharedLibPath = outputBaseName + ".so";
   std::vector<string> outputOpt = {"-o", sharedLibPath};
   std::vector<string> sharedLibOpts = {"-shared", "-fPIC"};
+  // The runtime starts pthreads for asynchronous inference.
+  libs.emplace_back("pthread");
   llvm::for_each(libs, [](string &lib) { lib = "-l" + lib; });
   llvm::for_each(libDirs, [](string &libDir) { libDir = "-L" + libDir; });
 #endif
@@ -654,6 +656,9 @@ void addONNXToMLIRPasses(mlir::PassManager &pm) {
     }
   }
 
+  if (nchwcLayout > 0)
+    pm.addNestedPass<FuncOp>(mlir::createONNXToNCHWcPass(nchwcLayout));
+
   pm.addNestedPass<FuncOp>(mlir::createONNXToAtenLeakyReluOpTransformPass());
   pm.addNestedPass<FuncOp>(mlir::createONNXToAtenMaxPool2dOpTransformPass());
   pm.addNestedPass<FuncOp>(mlir::createONNXToAtenConv2DOpTransformPass());
@@ -700,7 +705,8 @@ void addKrnlToLLVMPasses(mlir::OpPassManager &pm) {
   }
 
   pm.addPass(mlir::createLowerToCFGPass());
-  pm.addPass(mlir::createConvertKrnlToLLVMPass());
+  pm.addPass(
+      mlir::createConvertKrnlToLLVMPass(alignedEntryPoint, modelSymbolPrefix));
   pm.addPass(mlir::createReconcileUnrealizedCastsPass());
   pm.addPass(mlir::createCanonicalizerPass());
 }
@@ -820,6 +826,11 @@ void emitOutputFiles(string outputBaseName, EmissionTargetType emissionTarget,
       printf("Shared library %s has been compiled.\n", sharedLib.c_str());
   } break;
   case EmitJNI: {
+    // The JNI wrapper calls the unprefixed entry point.
+    if (!modelSymbolPrefix.empty()) {
+      llvm::errs() << "--symbol-prefix is not supported with --EmitJNI\n";
+      exit(1);
+    }
     compileModuleToJniJar(module, outputBaseName);
     if (keepFiles(KeepFilesOfType::MLIR))
       outputCode(module, outputBaseName, ".llvm.mlir");
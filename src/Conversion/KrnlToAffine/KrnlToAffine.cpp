@@ -1030,8 +1030,16 @@ private:
                 Value vb = createAffine.load(vecB, bAccess);
                 // TTmpC() = vector_fma(va, vb, TTmpC());
                 Value tmpVal = createAffine.load(TmpC, tmpCAccess);
-                Value res = createAffine.getBuilder().create<vector::FMAOp>(
-                    createAffine.getLoc(), va, vb, tmpVal);
+                OpBuilder &b = createAffine.getBuilder();
+                Location vecLoc = createAffine.getLoc();
+                Value res;
+                if (elementType.isa<IntegerType>()) {
+                  // No integer fma, used by quantized matmuls on i32 tiles.
+                  Value prod = b.create<arith::MulIOp>(vecLoc, va, vb);
+                  res = b.create<arith::AddIOp>(vecLoc, prod, tmpVal);
+                } else {
+                  res = b.create<vector::FMAOp>(vecLoc, va, vb, tmpVal);
+                }
                 createAffine.store(res, TmpC, tmpCAccess);
               });
           // Store temp result into C(i)
@@ -1211,6 +1219,13 @@ public:
           }
         }
         Value sourceVal = createKrnl.loadIE(sourceMemref, currLoadIndices);
+        // Extend half precision sources into wider buffers.
+        Type buffElementType =
+            buffMemref.getType().cast<MemRefType>().getElementType();
+        if (sourceVal.getType() != buffElementType) {
+          MathBuilder createMath(createKrnl);
+          sourceVal = createMath.cast(buffElementType, sourceVal);
+        }
         createKrnl.storeIE(sourceVal, buffMemref, currLoopIndices);
       } else {
         createKrnl.storeIE(padVal, buffMemref, currLoopIndices);
@@ -1337,6 +1352,13 @@ public:
         }
       }
       Value destVal = createKrnl.loadIE(buffMemref, currLoopIndices);
+      // Truncate wider buffers into half precision destinations.
+      Type destElementType =
+          destMemref.getType().cast<MemRefType>().getElementType();
+      if (destVal.getType() != destElementType) {
+        MathBuilder createMath(createKrnl);
+        destVal = createMath.cast(destElementType, destVal);
+      }
       createKrnl.storeIE(destVal, destMemref, currStoreIndices);
     } else {
       if (writeUBs[i].isLiteralAndIdenticalTo(0)) {
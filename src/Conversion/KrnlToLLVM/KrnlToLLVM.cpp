@@ -53,6 +53,14 @@
 using namespace mlir;
 namespace {
 
+// Alignment, in bytes, of the buffers passed to the aligned variant of the
+// entry function. Must match OM_TENSOR_ALIGNMENT in the runtime.
+static constexpr int64_t ENTRY_POINT_ALIGNMENT = 64;
+
+static std::string getAlignedEntryFuncName(StringRef funcName) {
+  return (funcName + "_aligned").str();
+}
+
 static onnx::TensorProto::DataType llvmTypeToOnnxType(mlir::Type elemType) {
   if (elemType.isa<Float32Type>())
     return onnx::TensorProto::FLOAT;
@@ -72,6 +80,8 @@ static onnx::TensorProto::DataType llvmTypeToOnnxType(mlir::Type elemType) {
     return onnx::TensorProto::STRING;
   if (elemType.isa<Float16Type>())
     return onnx::TensorProto::FLOAT16;
+  if (elemType.isa<BFloat16Type>())
+    return onnx::TensorProto::BFLOAT16;
   if (elemType.isa<Float64Type>())
     return onnx::TensorProto::DOUBLE;
   if (elemType.isUnsignedInteger(32))
@@ -147,6 +157,47 @@ static FlatSymbolRefAttr getOrInsertInstrument(
   return SymbolRefAttr::get(context, funcName);
 }
 
+// Create a function declaration for OMInstrumentNamedPoint, the signature is:
+//   `void (i8*, i8*, i64)`
+static FlatSymbolRefAttr getOrInsertNamedInstrument(
+    PatternRewriter &rewriter, ModuleOp module) {
+  auto *context = module.getContext();
+  std::string funcName("OMInstrumentNamedPoint");
+  if (module.lookupSymbol<LLVM::LLVMFuncOp>(funcName))
+    return SymbolRefAttr::get(context, funcName);
+  auto llvmVoidTy = LLVM::LLVMVoidType::get(context);
+  auto llvmI8PtrTy = LLVM::LLVMPointerType::get(IntegerType::get(context, 8));
+  auto llvmI64Ty = IntegerType::get(context, 64);
+  auto llvmFnType = LLVM::LLVMFunctionType::get(llvmVoidTy,
+      ArrayRef<mlir::Type>({llvmI8PtrTy, llvmI8PtrTy, llvmI64Ty}), false);
+
+  PatternRewriter::InsertionGuard insertGuard(rewriter);
+  rewriter.setInsertionPointToStart(module.getBody());
+  rewriter.create<LLVM::LLVMFuncOp>(module.getLoc(), funcName, llvmFnType);
+  return SymbolRefAttr::get(context, funcName);
+}
+
+// Return a pointer to a null terminated global string holding str, creating
+// the global, named symName, if it does not exist yet.
+static Value getOrCreateGlobalCString(PatternRewriter &rewriter,
+    ModuleOp module, Location loc, StringRef symName, StringRef str) {
+  auto *context = module.getContext();
+  auto llvmI8Ty = IntegerType::get(context, 8);
+  std::string cstr = str.str();
+  cstr.push_back('\0');
+  auto global = module.lookupSymbol<LLVM::GlobalOp>(symName);
+  if (!global) {
+    PatternRewriter::InsertionGuard insertGuard(rewriter);
+    rewriter.setInsertionPointToStart(module.getBody());
+    global = rewriter.create<LLVM::GlobalOp>(loc,
+        LLVM::LLVMArrayType::get(llvmI8Ty, cstr.size()), /*isConstant=*/true,
+        LLVM::Linkage::Internal, symName, rewriter.getStringAttr(cstr));
+  }
+  Value globalPtr = rewriter.create<LLVM::AddressOfOp>(loc, global);
+  return rewriter.create<LLVM::BitcastOp>(
+      loc, LLVM::LLVMPointerType::get(llvmI8Ty), globalPtr);
+}
+
 /// Return a symbol reference to the memcpy function, inserting it into the
 /// module if necessary.
 static FlatSymbolRefAttr getOrInsertMemcpy(
@@ -216,27 +267,6 @@ static FlatSymbolRefAttr getOrInsertRandomNormal(
   return SymbolRefAttr::get(context, functionName.str());
 }
 
-static FlatSymbolRefAttr getOrInsertMalloc(
-    PatternRewriter &rewriter, ModuleOp module) {
-  // Insert the malloc/aligned_alloc declaration if it is not already present.
-  auto allocFunc = module.lookupSymbol<LLVM::LLVMFuncOp>("malloc");
-  auto ctx = rewriter.getContext();
-  LLVMTypeConverter converter(ctx);
-  if (!allocFunc) {
-    OpBuilder::InsertionGuard guard(rewriter);
-    rewriter.setInsertionPointToStart(module.getBody());
-    SmallVector<Type, 2> callArgTypes = {converter.getIndexType()};
-    // aligned_alloc(size_t alignment, size_t size)
-    auto voidPtrType = LLVM::LLVMPointerType::get(
-        IntegerType::get(&converter.getContext(), 8));
-    allocFunc =
-        rewriter.create<LLVM::LLVMFuncOp>(rewriter.getUnknownLoc(), "malloc",
-            LLVM::LLVMFunctionType::get(voidPtrType, callArgTypes,
-                /*isVarArg=*/false));
-  }
-  return SymbolRefAttr::get(ctx, "malloc");
-}
-
 ATTRIBUTE(unused)
 static FlatSymbolRefAttr getOrInsertDealloc(
     PatternRewriter &rewriter, ModuleOp module) {
@@ -651,6 +681,26 @@ public:
     // LLVM::LLVMFunctionType::get(
     //    llvmVoidTy, ArrayRef<mlir::Type>({llvmI64Ty, llvmI64Ty}), false);
 
+    // Named points pass the op and node names as strings.
+    if (instrumentOp.nodeName().hasValue()) {
+      StringRef opName = instrumentOp.opName().getValue();
+      StringRef nodeName = instrumentOp.nodeName().getValue();
+      auto namedInstrumentRef =
+          getOrInsertNamedInstrument(rewriter, parentModule);
+      Value opNameStr = getOrCreateGlobalCString(rewriter, parentModule, loc,
+          ("om_instrument_op_" + opName).str(), opName);
+      Value nodeNameStr = getOrCreateGlobalCString(rewriter, parentModule, loc,
+          ("om_instrument_node_" + nodeName).str(), nodeName);
+      Value tag =
+          rewriter.create<LLVM::ConstantOp>(loc, IntegerType::get(context, 64),
+              rewriter.getIntegerAttr(
+                  rewriter.getIntegerType(64), instrumentOp.tag()));
+      rewriter.create<CallOp>(loc, namedInstrumentRef, ArrayRef<Type>({}),
+          ArrayRef<Value>({opNameStr, nodeNameStr, tag}));
+      rewriter.eraseOp(op);
+      return success();
+    }
+
     auto instrumentRef = getOrInsertInstrument(rewriter, parentModule);
 
     Value nodeName =
@@ -699,6 +749,11 @@ public:
                        .getBody()[1];
     Value alignedDstMemory = rewriter.create<LLVM::ExtractValueOp>(
         loc, dstType, operandAdaptor.dest(), rewriter.getI64ArrayAttr(1));
+    // Optional element offsets, applied before casting to i8*.
+    ValueRange offsets = operandAdaptor.offsets();
+    if (!offsets.empty())
+      alignedDstMemory = rewriter.create<LLVM::GEPOp>(
+          loc, dstType, alignedDstMemory, ArrayRef<Value>({offsets[0]}));
     Value alignedInt8PtrDstMemory = rewriter.create<LLVM::BitcastOp>(loc,
         LLVM::LLVMPointerType::get(IntegerType::get(context, 8)),
         alignedDstMemory);
@@ -710,6 +765,9 @@ public:
                        .getBody()[1];
     Value alignedSrcMemory = rewriter.create<LLVM::ExtractValueOp>(
         loc, srcType, operandAdaptor.src(), rewriter.getI64ArrayAttr(1));
+    if (!offsets.empty())
+      alignedSrcMemory = rewriter.create<LLVM::GEPOp>(
+          loc, srcType, alignedSrcMemory, ArrayRef<Value>({offsets[1]}));
     Value alignedInt8PtrSrcMemory = rewriter.create<LLVM::BitcastOp>(loc,
         LLVM::LLVMPointerType::get(IntegerType::get(context, 8)),
         alignedSrcMemory);
@@ -1004,13 +1062,20 @@ class KrnlEntryPointOpLowering : public OpRewritePattern<KrnlEntryPointOp> {
 public:
   using OpRewritePattern<KrnlEntryPointOp>::OpRewritePattern;
   ArrayRef<bool> constantOutputs;
+  bool alignedEntryPoint;
+  // Prepended to the name of every symbol exported for the entry point, so
+  // that several models can be linked or loaded side by side.
+  std::string symbolPrefix;
 
-  KrnlEntryPointOpLowering(MLIRContext *ctx, ArrayRef<bool> constantOutputs)
+  KrnlEntryPointOpLowering(MLIRContext *ctx, ArrayRef<bool> constantOutputs,
+      bool alignedEntryPoint, StringRef symbolPrefix)
       : OpRewritePattern<KrnlEntryPointOp>(ctx),
-        constantOutputs(constantOutputs) {}
+        constantOutputs(constantOutputs), alignedEntryPoint(alignedEntryPoint),
+        symbolPrefix(symbolPrefix.str()) {}
 
   enum class API {
     CREATE_OMTENSOR_LIST,
+    CREATE_OMTENSOR_ARRAY,
     CREATE_OMTENSOR,
     GET_DATA,
     SET_DATA,
@@ -1089,16 +1154,18 @@ public:
     auto inSigArrayType =
         LLVM::LLVMArrayType::get(IntegerType::get(context, 8), inSig.size());
     auto insig = rewriter.create<LLVM::GlobalOp>(loc, inSigArrayType,
-        /*isConstant=*/true, LLVM::Linkage::External, "_in_signature",
-        inSigAttr);
+        /*isConstant=*/true, LLVM::Linkage::External,
+        symbolPrefix + "_in_signature", inSigAttr);
 
     auto outSigArrayType =
         LLVM::LLVMArrayType::get(IntegerType::get(context, 8), outSig.size());
     auto outsig = rewriter.create<LLVM::GlobalOp>(loc, outSigArrayType,
-        /*isConstant=*/true, LLVM::Linkage::External, "_out_signature",
-        outSigAttr);
-    genSignatureFunction(rewriter, context, "omInputSignature", insig, loc);
-    genSignatureFunction(rewriter, context, "omOutputSignature", outsig, loc);
+        /*isConstant=*/true, LLVM::Linkage::External,
+        symbolPrefix + "_out_signature", outSigAttr);
+    genSignatureFunction(
+        rewriter, context, symbolPrefix + "omInputSignature", insig, loc);
+    genSignatureFunction(
+        rewriter, context, symbolPrefix + "omOutputSignature", outsig, loc);
 
     // Rewrite Krnl Entry Point Operation to an LLVM function with a dynamic
     // signature. The signature is dynamic because it remains the same no matter
@@ -1112,14 +1179,15 @@ public:
               KrnlEntryPointOp::getEntryPointFuncAttrName())
             .getLeafReference()
             .getValue();
-    auto dynEntryPointName = "run_" + staticEntryPointFuncName;
-    assert(module.lookupSymbol(dynEntryPointName.str()) == nullptr &&
+    std::string dynEntryPointName =
+        symbolPrefix + "run_" + staticEntryPointFuncName.str();
+    assert(module.lookupSymbol(dynEntryPointName) == nullptr &&
            "dynamic entry point name is not unique");
     rewriter.eraseOp(op);
     auto dynEntryPointFuncTy =
         LLVM::LLVMFunctionType::get(opaquePtrTy, {opaquePtrTy}, false);
     auto dynamicEntryPointFunc = rewriter.create<LLVM::LLVMFuncOp>(
-        loc, dynEntryPointName.str(), dynEntryPointFuncTy);
+        loc, dynEntryPointName, dynEntryPointFuncTy);
     auto &entryPointEntryBlock =
         createEntryBlock(dynEntryPointFuncTy, dynamicEntryPointFunc);
     rewriter.setInsertionPointToStart(&entryPointEntryBlock);
@@ -1140,6 +1208,7 @@ public:
     // Retrieve dynamic mem refs from wrapped input, and convert every one of
     // them to static mem refs.
     SmallVector<Value, 4> staticInputs;
+    SmallVector<Value, 4> inputDataPtrs;
     auto wrappedInput = entryPointEntryBlock.getArgument(0);
 
     auto omTensorPtrArr =
@@ -1178,16 +1247,46 @@ public:
 
       // Fill in the memref underlying ptrToMemRef with information extracted
       // from omTensorPtr.
-      fillPtrToMemRefWithOMTensor(
+      Value dataPtr = fillPtrToMemRefWithOMTensor(
           omTensorPtr, ptrToMemRef, rewriter, loc, apiRegistry, module);
+      inputDataPtrs.emplace_back(dataPtr);
 
       // ptrToMemRef will be an input to main computation graph function.
       staticInputs.emplace_back(ptrToMemRef);
     }
 
     // Call static entry point with the memref ptrs created, and get output.
-    rewriter.create<LLVM::CallOp>(
-        loc, ArrayRef<Type>({}), wrappedStaticEntryPointFuncName, staticInputs);
+    if (alignedEntryPoint && !inputDataPtrs.empty()) {
+      // Dispatch to the variant of the static entry point that assumes
+      // aligned and non-aliasing inputs when all the input buffers are
+      // aligned, and to the generic one otherwise.
+      Value allAligned =
+          emitAllAligned(rewriter, loc, inputDataPtrs, ENTRY_POINT_ALIGNMENT);
+      Block *dispatchBlock = rewriter.getInsertionBlock();
+      Block *joinBlock =
+          rewriter.splitBlock(dispatchBlock, rewriter.getInsertionPoint());
+
+      Block *alignedBlock = rewriter.createBlock(joinBlock);
+      std::string alignedFuncName =
+          "_mlir_ciface_" +
+          StringRef(getAlignedEntryFuncName(staticEntryPointFuncName)).lower();
+      rewriter.create<LLVM::CallOp>(
+          loc, ArrayRef<Type>({}), alignedFuncName, staticInputs);
+      rewriter.create<LLVM::BrOp>(loc, ValueRange(), joinBlock);
+
+      Block *genericBlock = rewriter.createBlock(joinBlock);
+      rewriter.create<LLVM::CallOp>(loc, ArrayRef<Type>({}),
+          wrappedStaticEntryPointFuncName, staticInputs);
+      rewriter.create<LLVM::BrOp>(loc, ValueRange(), joinBlock);
+
+      rewriter.setInsertionPointToEnd(dispatchBlock);
+      rewriter.create<LLVM::CondBrOp>(loc, allAligned, alignedBlock,
+          ValueRange(), genericBlock, ValueRange());
+      rewriter.setInsertionPointToStart(joinBlock);
+    } else {
+      rewriter.create<LLVM::CallOp>(loc, ArrayRef<Type>({}),
+          wrappedStaticEntryPointFuncName, staticInputs);
+    }
     auto outMemRefs = rewriter.create<LLVM::LoadOp>(loc, ptrToOutMemRef);
     auto outMemRefsType = outMemRefs.getType().dyn_cast<LLVM::LLVMStructType>();
 
@@ -1214,26 +1313,10 @@ public:
     auto numOutput = rewriter.create<LLVM::ConstantOp>(
         loc, int64Ty, rewriter.getI64IntegerAttr(outMemRefList.size()));
 
-    auto mallocSym = getOrInsertMalloc(rewriter, module);
-    // TODO(tjingrant): get pointer size from data layout.
-    size_t kPtrSize = 8;
-    auto outputOmtPtrsArraySizeInByte = rewriter.create<LLVM::ConstantOp>(loc,
-        int64Ty, rewriter.getI64IntegerAttr(outMemRefList.size() * kPtrSize));
-    auto outOmtPtrsArr =
-        rewriter
-            .create<LLVM::CallOp>(loc,
-                LLVM::LLVMPointerType::get(
-                    IntegerType::get(module.getContext(), 8)),
-                mallocSym, ArrayRef<Value>(outputOmtPtrsArraySizeInByte))
-            .getResult(0);
-    outOmtPtrsArr = rewriter
-                        .create<LLVM::BitcastOp>(loc,
-                            LLVM::LLVMPointerType::get(
-                                LLVM::LLVMPointerType::get(
-                                    IntegerType::get(module.getContext(), 8)),
-                                0),
-                            outOmtPtrsArr)
-                        .getResult();
+    // The array of output OMTensor pointers is allocated by the runtime, from
+    // the current OMTensor arena if any.
+    auto outOmtPtrsArr = callApi(rewriter, loc, apiRegistry,
+        API::CREATE_OMTENSOR_ARRAY, {numOutput});
 
     for (unsigned int i = 0; i < outMemRefList.size(); i++) {
       // Get the i-th memref returned, convert to a dynamic memref and store it
@@ -1293,6 +1376,7 @@ private:
     // clang-format off
     std::vector<ApiSpec> apiSpecs = {
         ApiSpec(API::CREATE_OMTENSOR_LIST, "omTensorListCreateWithOwnership", opaquePtrTy, {opaquePtrPtrTy, int64Ty, int64Ty}),
+        ApiSpec(API::CREATE_OMTENSOR_ARRAY, "omTensorArrayCreate", opaquePtrPtrTy, {int64Ty}),
         ApiSpec(API::CREATE_OMTENSOR, "omTensorCreateUntyped", opaquePtrTy, {int64Ty}),
         ApiSpec(API::GET_DATA, "omTensorGetDataPtr", opaquePtrTy, {opaquePtrTy}),
         ApiSpec(API::SET_DATA, "omTensorSetDataPtr", voidTy, {opaquePtrTy, int64Ty, opaquePtrTy, opaquePtrTy}),
@@ -1354,7 +1438,31 @@ private:
     return *entryPointEntryBlock;
   }
 
-  void fillPtrToMemRefWithOMTensor(Value &rtMemRef, Value &ptrToMemRef,
+  // Return whether all the pointers are aligned on `alignment` bytes, as an
+  // i1 value.
+  Value emitAllAligned(PatternRewriter &rewriter, Location loc,
+      ArrayRef<Value> ptrs, int64_t alignment) const {
+    auto int64Ty = rewriter.getI64Type();
+    Value mask = rewriter.create<LLVM::ConstantOp>(
+        loc, int64Ty, rewriter.getI64IntegerAttr(alignment - 1));
+    Value zero = rewriter.create<LLVM::ConstantOp>(
+        loc, int64Ty, rewriter.getI64IntegerAttr(0));
+    Value allAligned;
+    for (Value ptr : ptrs) {
+      Value addr = rewriter.create<LLVM::PtrToIntOp>(loc, int64Ty, ptr);
+      Value misalignment = rewriter.create<LLVM::AndOp>(loc, addr, mask);
+      Value aligned = rewriter.create<LLVM::ICmpOp>(
+          loc, LLVM::ICmpPredicate::eq, misalignment, zero);
+      allAligned = allAligned
+                       ? rewriter.create<LLVM::AndOp>(loc, allAligned, aligned)
+                       : aligned;
+    }
+    return allAligned;
+  }
+
+  // Fill in the memref pointed to by ptrToMemRef from the OMTensor rtMemRef,
+  // and return the data pointer of the OMTensor.
+  Value fillPtrToMemRefWithOMTensor(Value &rtMemRef, Value &ptrToMemRef,
       PatternRewriter &rewriter, const Location &loc,
       const std::map<API, ApiSpec> &apiRegistry, ModuleOp &module) const {
     auto *context = module.getContext();
@@ -1365,10 +1473,10 @@ private:
     Value memRef = rewriter.create<LLVM::UndefOp>(loc, memRefTy);
 
     // Set dataPtr and alignedDataPtr;
-    auto dataPtr =
+    auto omtDataPtr =
         callApi(rewriter, loc, apiRegistry, API::GET_DATA, {rtMemRef});
-    dataPtr = rewriter.create<LLVM::BitcastOp>(
-        loc, memRefTy.cast<LLVM::LLVMStructType>().getBody()[0], dataPtr);
+    Value dataPtr = rewriter.create<LLVM::BitcastOp>(
+        loc, memRefTy.cast<LLVM::LLVMStructType>().getBody()[0], omtDataPtr);
     memRef = rewriter.create<LLVM::InsertValueOp>(loc, memRefTy, memRef,
         dataPtr, rewriter.getArrayAttr({rewriter.getI64IntegerAttr(0)}));
     memRef = rewriter.create<LLVM::InsertValueOp>(loc, memRefTy, memRef,
@@ -1414,6 +1522,7 @@ private:
     }
 
     rewriter.create<LLVM::StoreOp>(loc, memRef, ptrToMemRef);
+    return omtDataPtr;
   }
 
   void fillOMTensorWithMemRef(Value &outMemRef, Value &outOMTensor,
@@ -1773,7 +1882,8 @@ private:
 
 void mlir::populateAffineAndKrnlToLLVMConversion(RewritePatternSet &patterns,
     MLIRContext *ctx, LLVMTypeConverter &typeConverter,
-    ArrayRef<bool> constantOutputs) {
+    ArrayRef<bool> constantOutputs, bool alignedEntryPoint,
+    StringRef symbolPrefix) {
   // TODO: look at what is done in
   // mlir/lib/Conversion/VectorToLLVM/ConvertVectorToLLVMPass.cpp in function
   // LowerVectorToLLVMPass::runOnOperation() and see what we should do about it.
@@ -1807,7 +1917,8 @@ void mlir::populateAffineAndKrnlToLLVMConversion(RewritePatternSet &patterns,
   patterns.insert<KrnlGlobalOpLowering, KrnlVectorTypeCastOpLowering>(
       ctx, typeConverter);
   patterns.insert<KrnlGetRefOpLowering>(ctx, typeConverter);
-  patterns.insert<KrnlEntryPointOpLowering>(ctx, constantOutputs);
+  patterns.insert<KrnlEntryPointOpLowering>(
+      ctx, constantOutputs, alignedEntryPoint, symbolPrefix);
 
   patterns.insert<KrnlInstrumentOpLowering>(ctx);
 
@@ -1905,6 +2016,67 @@ void mlir::checkConstantOutputs(
   }
 }
 
+/// Clone the lowered entry function `funcName` and its C interface into a
+/// variant whose input data pointers are marked aligned and noalias. The
+/// dynamic entry point calls this variant when all its inputs are aligned.
+static void genAlignedEntryFunc(ModuleOp &module, StringRef funcName) {
+  MLIRContext *context = module.getContext();
+  auto func = module.lookupSymbol<LLVM::LLVMFuncOp>(funcName);
+  auto cifaceFunc =
+      module.lookupSymbol<LLVM::LLVMFuncOp>("_mlir_ciface_" + funcName.lower());
+  assert(func && cifaceFunc && "entry function must exist as an llvm func");
+  std::string alignedName = getAlignedEntryFuncName(funcName);
+
+  OpBuilder builder(context);
+  builder.setInsertionPointAfter(cifaceFunc);
+  auto alignedFunc = cast<LLVM::LLVMFuncOp>(builder.clone(*func));
+  SymbolTable::setSymbolName(alignedFunc, alignedName);
+
+  // The C interface takes a pointer to the output memref, then a pointer to
+  // each input memref. The entry function takes each input memref expanded
+  // into allocated ptr, aligned ptr, offset, sizes and strides. Inputs are
+  // never written to by the model, so they can be marked noalias even if the
+  // caller passes the same buffer twice.
+  auto cifaceTy = cifaceFunc.getType().cast<LLVM::LLVMFunctionType>();
+  unsigned argIdx = 0;
+  for (unsigned i = 1; i < cifaceTy.getNumParams(); i++) {
+    auto memRefTy = cifaceTy.getParamType(i)
+                        .cast<LLVM::LLVMPointerType>()
+                        .getElementType()
+                        .cast<LLVM::LLVMStructType>();
+    unsigned alignedPtrIdx = argIdx + 1;
+    alignedFunc.setArgAttr(alignedPtrIdx, LLVM::LLVMDialect::getAlignAttrName(),
+        builder.getI64IntegerAttr(ENTRY_POINT_ALIGNMENT));
+    alignedFunc.setArgAttr(alignedPtrIdx,
+        LLVM::LLVMDialect::getNoAliasAttrName(), builder.getUnitAttr());
+    argIdx += 3 + 2 * getRankFromMemRefType(memRefTy);
+  }
+
+  auto alignedCifaceFunc = cast<LLVM::LLVMFuncOp>(builder.clone(*cifaceFunc));
+  SymbolTable::setSymbolName(
+      alignedCifaceFunc, "_mlir_ciface_" + StringRef(alignedName).lower());
+  alignedCifaceFunc.walk([&](LLVM::CallOp callOp) {
+    auto callee = callOp->getAttrOfType<FlatSymbolRefAttr>("callee");
+    if (callee && callee.getValue() == funcName)
+      callOp->setAttr("callee", FlatSymbolRefAttr::get(context, alignedName));
+  });
+}
+
+/// Give internal linkage to the lowered entry function `funcName`, its C
+/// interface and their aligned variants, which are only called through the
+/// dynamic entry point.
+static void internalizeEntryFunc(ModuleOp &module, StringRef funcName) {
+  MLIRContext *context = module.getContext();
+  std::string alignedName = getAlignedEntryFuncName(funcName);
+  for (StringRef name : {funcName, StringRef(alignedName)}) {
+    std::string cifaceName = "_mlir_ciface_" + name.lower();
+    for (StringRef symbol : {name, StringRef(cifaceName)})
+      if (auto func = module.lookupSymbol<LLVM::LLVMFuncOp>(symbol))
+        func->setAttr("linkage",
+            LLVM::LinkageAttr::get(context, LLVM::Linkage::Internal));
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // KRNL + Standard + Vector + Affine dialects lowering to LLVM.
 //===----------------------------------------------------------------------===//
@@ -1919,7 +2091,28 @@ struct ConvertKrnlToLLVMPass
     return "Lower the Krnl Affine and Std dialects to LLVM.";
   }
 
+  ConvertKrnlToLLVMPass() = default;
+  ConvertKrnlToLLVMPass(const ConvertKrnlToLLVMPass &pass)
+      : PassWrapper<ConvertKrnlToLLVMPass, OperationPass<ModuleOp>>() {}
+  ConvertKrnlToLLVMPass(bool alignedEntryPoint, std::string symbolPrefix) {
+    this->alignedEntryPoint = alignedEntryPoint;
+    this->symbolPrefix = symbolPrefix;
+  }
+
   void runOnOperation() final;
+
+  // Allocate all buffers aligned, and emit an entry point that calls a
+  // variant of the entry function specialized for aligned inputs when
+  // possible.
+  Option<bool> alignedEntryPoint{*this, "aligned-entry-point",
+      llvm::cl::desc("Emit an entry point specialized for aligned inputs."),
+      llvm::cl::init(false)};
+
+  // Prefix the symbols exported for each entry point, and hide the entry
+  // functions, so that several models can live in the same process.
+  Option<std::string> symbolPrefix{*this, "symbol-prefix",
+      llvm::cl::desc("Prefix of the symbols exported for the entry points."),
+      llvm::cl::init("")};
 };
 } // end anonymous namespace
 
@@ -1934,6 +2127,29 @@ void ConvertKrnlToLLVMPass::runOnOperation() {
   SmallVector<bool, 4> constantOutputs;
   checkConstantOutputs(module, constantOutputs);
 
+  // Outputs and intermediate buffers are allocated aligned, so that they can
+  // be fed back to the aligned entry point.
+  if (alignedEntryPoint) {
+    OpBuilder builder(&getContext());
+    module.walk([&](memref::AllocOp allocOp) {
+      if (allocOp.alignment().getValueOr(0) < ENTRY_POINT_ALIGNMENT)
+        allocOp.alignmentAttr(
+            builder.getI64IntegerAttr(ENTRY_POINT_ALIGNMENT));
+    });
+  }
+
+  // Entry functions are post-processed once lowered.
+  SmallVector<std::string, 1> entryFuncNames;
+  module.walk([&](KrnlEntryPointOp entryPointOp) {
+    entryFuncNames.emplace_back(
+        entryPointOp
+            ->getAttrOfType<SymbolRefAttr>(
+                KrnlEntryPointOp::getEntryPointFuncAttrName())
+            .getLeafReference()
+            .getValue()
+            .str());
+  });
+
   // Define the target for this lowering i.e. the LLVM dialect.
   ConversionTarget target(getContext());
   target.addLegalDialect<LLVM::LLVMDialect>();
@@ -1961,14 +2177,23 @@ void ConvertKrnlToLLVMPass::runOnOperation() {
   // We lower in stages until all the code is in the LLVM dialect.
   RewritePatternSet patterns(&getContext());
 
-  populateAffineAndKrnlToLLVMConversion(
-      patterns, &getContext(), typeConverter, constantOutputs);
+  populateAffineAndKrnlToLLVMConversion(patterns, &getContext(),
+      typeConverter, constantOutputs, alignedEntryPoint, symbolPrefix);
 
   // We want to completely lower to LLVM, so we use a `FullConversion`. This
   // ensures that only legal operations will remain after the conversion.
   if (failed(
           applyFullConversion(getOperation(), target, std::move(patterns)))) {
     signalPassFailure();
+    return;
+  }
+
+  for (StringRef funcName : entryFuncNames) {
+    // The aligned variants are cloned from the fully lowered entry functions.
+    if (alignedEntryPoint)
+      genAlignedEntryFunc(module, funcName);
+    if (!symbolPrefix.empty())
+      internalizeEntryFunc(module, funcName);
   }
 }
 
@@ -1976,3 +2201,9 @@ void ConvertKrnlToLLVMPass::runOnOperation() {
 std::unique_ptr<mlir::Pass> mlir::createConvertKrnlToLLVMPass() {
   return std::make_unique<ConvertKrnlToLLVMPass>();
 }
+
+std::unique_ptr<mlir::Pass> mlir::createConvertKrnlToLLVMPass(
+    bool alignedEntryPoint, std::string symbolPrefix) {
+  return std::make_unique<ConvertKrnlToLLVMPass>(
+      alignedEntryPoint, symbolPrefix);
+}
@@ -29,7 +29,8 @@ void checkConstantOutputs(
 
 void populateAffineAndKrnlToLLVMConversion(RewritePatternSet &patterns,
     MLIRContext *ctx, LLVMTypeConverter &typeConverter,
-    ArrayRef<bool> constantOutputs);
+    ArrayRef<bool> constantOutputs, bool alignedEntryPoint = false,
+    StringRef symbolPrefix = "");
 
 } // namespace mlir
 
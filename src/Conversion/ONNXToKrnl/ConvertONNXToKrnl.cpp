@@ -103,9 +103,19 @@ void populateONNXToKrnlConversionPattern(RewritePatternSet &patterns,
   populateLoweringONNXOneHotOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXCompressOpPattern(patterns, typeConverter, ctx);
   // Neural network
+  populateLoweringONNXScaledDotProductAttentionOpPattern(
+      patterns, typeConverter, ctx);
   populateLoweringONNXConvOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXConvTransposeOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXNCHWcOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXNormalizationOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXPoolingOpPattern(patterns, typeConverter, ctx);
+  // Quantization
+  populateLoweringONNXDequantizeLinearOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXMatMulIntegerOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXQLinearConvOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXQLinearMatMulOpPattern(patterns, typeConverter, ctx);
+  populateLoweringONNXQuantizeLinearOpPattern(patterns, typeConverter, ctx);
   // Recurrent neural network
   populateLoweringONNXGRUOpPattern(patterns, typeConverter, ctx);
   populateLoweringONNXLSTMOpPattern(patterns, typeConverter, ctx);
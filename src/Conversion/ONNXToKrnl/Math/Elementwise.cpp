@@ -902,9 +902,18 @@ struct ONNXElementwiseUnaryOpLowering : public ConversionPattern {
         loopIVs.push_back(arg);
     }
 
-    auto loadedVal = rewriter.create<KrnlLoadOp>(loc, X, loopIVs);
-    auto loweredOpResult = emitScalarOpFor<ElementwiseUnaryOp>(
-        rewriter, loc, op, memRefType.getElementType(), {loadedVal});
+    // Half precision data is extended to f32 for the computation and
+    // truncated back when stored.
+    MathBuilder createMath(rewriter, loc);
+    Type elementType = memRefType.getElementType();
+    Type computeType = elementType;
+    if (X.getType().cast<MemRefType>().getElementType() == elementType)
+      computeType = getComputeElementType(elementType);
+    Value loadedVal = createMath.cast(
+        computeType, rewriter.create<KrnlLoadOp>(loc, X, loopIVs));
+    Value loweredOpResult = emitScalarOpFor<ElementwiseUnaryOp>(
+        rewriter, loc, op, computeType, {loadedVal});
+    loweredOpResult = createMath.cast(elementType, loweredOpResult);
     // Store result in the resulting array.
     rewriter.create<KrnlStoreOp>(loc, loweredOpResult, alloc, loopIVs);
 
@@ -983,9 +992,21 @@ struct ONNXElementwiseBinaryOpLowering : public ConversionPattern {
     assert(succeeded(res));
     Value rhs = createKrnl.loadIE(operands[1], rhsAccessExprs);
 
+    // Half precision data is extended to f32 for the computation and
+    // truncated back when stored. Ops with a different output type (e.g.
+    // comparisons) compute directly on the loaded values.
+    MathBuilder createMath(createKrnl);
+    Type computeType = outputElementType;
+    if (lhs.getType() == outputElementType) {
+      computeType = getComputeElementType(outputElementType);
+      lhs = createMath.cast(computeType, lhs);
+      rhs = createMath.cast(computeType, rhs);
+    }
+
     // Apply the element-wise function.
     Value result = emitScalarOpFor<ElementwiseBinaryOp>(
-        rewriter, loc, op, outputElementType, {lhs, rhs});
+        rewriter, loc, op, computeType, {lhs, rhs});
+    result = createMath.cast(outputElementType, result);
 
     // Store result in the resulting array.
     createKrnl.storeIE(result, alloc, outputAccessExprs);
@@ -1048,13 +1069,19 @@ struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
         outputAccessExprs.emplace_back(DimIndexExpr(arg));
     }
 
+    // Half precision data is extended to f32 for the computation and
+    // truncated back when stored.
+    MathBuilder createMath(createKrnl);
+    Type computeType = getComputeElementType(outputElementType);
+
     // Fold over operands for each of their scalar values.
     // Obtain the first operand.
     SmallVector<IndexExpr, 4> oprdAccessExprs;
     LogicalResult res = shapeHelper.GetAccessExprs(
         operands[0], 0, outputAccessExprs, oprdAccessExprs);
     assert(succeeded(res));
-    Value accumulated = createKrnl.loadIE(operands[0], oprdAccessExprs);
+    Value accumulated = createMath.cast(
+        computeType, createKrnl.loadIE(operands[0], oprdAccessExprs));
 
     // Iterate over the remaining operands.
     for (unsigned i = 1; i < numArgs; i++) {
@@ -1063,14 +1090,16 @@ struct ONNXElementwiseVariadicOpLowering : public ConversionPattern {
       LogicalResult res = shapeHelper.GetAccessExprs(
           operands[i], i, outputAccessExprs, oprdAccessExprs);
       assert(succeeded(res));
-      Value next = createKrnl.loadIE(operands[i], oprdAccessExprs);
+      Value next = createMath.cast(
+          computeType, createKrnl.loadIE(operands[i], oprdAccessExprs));
       // Fold.
       accumulated = emitScalarOpFor<ElementwiseVariadicOp>(
-          rewriter, loc, op, outputElementType, {accumulated, next});
+          rewriter, loc, op, computeType, {accumulated, next});
     }
 
     Value finalResult = emitPostProcessingFor<ElementwiseVariadicOp>(
-        rewriter, loc, op, outputElementType, accumulated);
+        rewriter, loc, op, computeType, accumulated);
+    finalResult = createMath.cast(outputElementType, finalResult);
 
     // Store result in the resulting array.
     createKrnl.storeIE(finalResult, alloc, outputAccessExprs);
@@ -35,7 +35,8 @@ struct ONNXGemmOpLowering : public ConversionPattern {
   void genericGemm(ONNXGemmOp &gemmOp, ONNXGemmOpAdaptor &operandAdaptor,
       Type elementType, ONNXGemmOpShapeHelper &shapeHelper, Value alloc,
       Value zeroVal, Value alphaVal, Value betaVal,
-      ConversionPatternRewriter &rewriter, Location loc) const {
+      const ElementwiseEpilogue &epilogue, ConversionPatternRewriter &rewriter,
+      Location loc) const {
     // R is result (alloc).
     Value A(operandAdaptor.A()), B(operandAdaptor.B()), R(alloc);
 
@@ -74,9 +75,12 @@ struct ONNXGemmOpLowering : public ConversionPattern {
                   bAccess = {j, k};
                 else
                   bAccess = {k, j};
-                // Perform the reduction by adding a*b to reduction.
-                Value aVal = create.krnl.load(A, aAccess);
-                Value bVal = create.krnl.load(B, bAccess);
+                // Perform the reduction by adding a*b to reduction. Half
+                // precision inputs are accumulated in the wider elementType.
+                Value aVal =
+                    create.math.cast(elementType, create.krnl.load(A, aAccess));
+                Value bVal =
+                    create.math.cast(elementType, create.krnl.load(B, bAccess));
                 Value tmp = create.math.mul(aVal, bVal);
                 Value rVal = create.krnl.load(red);
                 create.krnl.store(create.math.add(tmp, rVal), red);
@@ -94,18 +98,23 @@ struct ONNXGemmOpLowering : public ConversionPattern {
                   IndexExpr::select(dim > 1, DimIndexExpr(outerIndices[x]), 0)
                       .getValue());
             }
-            Value c = create.krnl.load(operandAdaptor.C(), cAccess);
+            Value c = create.math.cast(
+                elementType, create.krnl.load(operandAdaptor.C(), cAccess));
             res = create.math.add(res, create.math.mul(betaVal, c));
           }
-          create.krnl.store(res, R, outerIndices);
+          res = epilogue.emit(rewriter, loc, res, outerIndices);
+          Type outputElementType =
+              R.getType().cast<MemRefType>().getElementType();
+          create.krnl.store(
+              create.math.cast(outputElementType, res), R, outerIndices);
         });
   }
 
   void tiledTransposedGemm(ONNXGemmOp &gemmOp,
       ONNXGemmOpAdaptor &operandAdaptor, Type elementType,
       ONNXGemmOpShapeHelper &shapeHelper, Value alloc, Value zeroVal,
-      Value alphaVal, Value betaVal, ConversionPatternRewriter &rewriter,
-      Location loc) const {
+      Value alphaVal, Value betaVal, const ElementwiseEpilogue &epilogue,
+      ConversionPatternRewriter &rewriter, Location loc) const {
 
     // R is result (alloc).
     Value A(operandAdaptor.A()), B(operandAdaptor.B()), R(alloc);
@@ -116,10 +125,16 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     IndexExpr K = shapeHelper.aDims[1]; // aDims are already transposed.
     LiteralIndexExpr zero(0);
     Value z = zero.getValue();
+    // Half precision results are computed in elementType (f32) buffers.
+    Type outputElementType = R.getType().cast<MemRefType>().getElementType();
+    bool widenOutput = outputElementType != elementType;
 
     // Initialize alloc/R to zero.
     KrnlBuilder createKrnl(rewriter, loc);
-    createKrnl.memset(R, zeroVal);
+    if (widenOutput)
+      createKrnl.memset(R, emitConstantOp(rewriter, loc, outputElementType, 0));
+    else
+      createKrnl.memset(R, zeroVal);
 
     // Prepare for the computations.
     // 1) Define blocking, with simdization along the j axis.
@@ -150,6 +165,42 @@ struct ONNXGemmOpLowering : public ConversionPattern {
         // length.
       }
     }
+    // Half precision outputs are accumulated in a wide R tile over the full K
+    // range, and only truncated when copied out of the buffer.
+    if (widenOutput)
+      mustTileR = true;
+    // The epilogue is applied to each R tile once its K loop is done, while
+    // the tile is still in the buffer.
+    if (!epilogue.empty())
+      mustTileR = true;
+
+    // Apply the alpha/beta coefficients to res, the compute type value of
+    // R[i, j].
+    float alphaLit = gemmOp.alpha().convertToFloat();
+    float betaLit = gemmOp.beta().convertToFloat();
+    auto emitAlphaBeta = [&](KrnlBuilder &createKrnl, Value res,
+                             ValueRange outerIndices) -> Value {
+      MathBuilder createMath(createKrnl);
+      if (alphaLit != 1.0)
+        res = createMath.mul(alphaVal, res);
+      if (shapeHelper.hasBias) {
+        IndexExprScope innerScope(createKrnl);
+        SmallVector<Value, 2> cAccess;
+        for (int x = 2 - shapeHelper.cRank; x < 2; ++x) {
+          // If dim > 1, use loop index, otherwise broadcast on 0's element.
+          DimIndexExpr dim(shapeHelper.cDims[x]);
+          cAccess.emplace_back(
+              IndexExpr::select(dim > 1, DimIndexExpr(outerIndices[x]), 0)
+                  .getValue());
+        }
+        Value c = createMath.cast(
+            elementType, createKrnl.load(operandAdaptor.C(), cAccess));
+        if (betaLit != 1.0)
+          c = createMath.mul(betaVal, c);
+        res = createMath.add(res, c);
+      }
+      return res;
+    };
 
     // 2) Alloc data for tiles.
     MemRefType aTileType =
@@ -219,6 +270,27 @@ struct ONNXGemmOpLowering : public ConversionPattern {
                             unrollAndJam, false);
                       });
                 });
+            if (!epilogue.empty()) {
+              // rBuff[x, y] holds R[i1 + x, j1 + y].
+              IndexExprScope tileScope(createKrnl);
+              IndexExpr xUb =
+                  IndexExpr::min(SymbolIndexExpr(I) - SymbolIndexExpr(i1),
+                      iCacheTile);
+              IndexExpr yUb =
+                  IndexExpr::min(SymbolIndexExpr(J) - SymbolIndexExpr(j1),
+                      jCacheTile);
+              ValueRange tileLoops = createKrnl.defineLoops(2);
+              createKrnl.iterateIE(tileLoops, tileLoops, {zero, zero},
+                  {xUb, yUb}, [&](KrnlBuilder &createKrnl, ValueRange xy) {
+                    MathBuilder createMath(createKrnl);
+                    SmallVector<Value, 2> rIndices = {
+                        createMath.add(i1, xy[0]), createMath.add(j1, xy[1])};
+                    Value res = createKrnl.load(rBuff, xy);
+                    res = emitAlphaBeta(createKrnl, res, rIndices);
+                    res = epilogue.emit(rewriter, loc, res, rIndices);
+                    createKrnl.store(res, rBuff, xy);
+                  });
+            }
             createKrnl.copyFromBuffer(rBuff, R, {i1, j1});
           });
 
@@ -266,10 +338,10 @@ struct ONNXGemmOpLowering : public ConversionPattern {
           });
     }
 
-    // Perform the alpha/beta computations.
-    float alphaLit = gemmOp.alpha().convertToFloat();
-    float betaLit = gemmOp.beta().convertToFloat();
-    if (alphaLit == 1.0 && (betaLit == 0.0 || !shapeHelper.hasBias)) {
+    // Perform the alpha/beta computations, unless already done with the
+    // epilogue.
+    if (!epilogue.empty() ||
+        (alphaLit == 1.0 && (betaLit == 0.0 || !shapeHelper.hasBias))) {
       // No need for the multiply/add.
       return;
     }
@@ -277,26 +349,12 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     createKrnl.iterateIE(outerLoops, outerLoops, {zero, zero}, {I, J},
         [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
           // Handle alpha/beta coefficients.
-          Value res = createKrnl.load(R, outerIndices);
           MathBuilder createMath(createKrnl);
-          if (alphaLit != 1.0)
-            res = createMath.mul(alphaVal, res);
-          if (shapeHelper.hasBias) {
-            IndexExprScope innerScope(createKrnl, shapeHelper.scope);
-            SmallVector<Value, 2> cAccess;
-            for (int x = 2 - shapeHelper.cRank; x < 2; ++x) {
-              // If dim > 1, use loop index, otherwise broadcast on 0's element.
-              DimIndexExpr dim(shapeHelper.cDims[x]);
-              cAccess.emplace_back(
-                  IndexExpr::select(dim > 1, DimIndexExpr(outerIndices[x]), 0)
-                      .getValue());
-            }
-            Value c = createKrnl.load(operandAdaptor.C(), cAccess);
-            if (betaLit != 1.0)
-              c = createMath.mul(betaVal, c);
-            res = createMath.add(res, c);
-          }
-          createKrnl.store(res, R, outerIndices);
+          Value res =
+              createMath.cast(elementType, createKrnl.load(R, outerIndices));
+          res = emitAlphaBeta(createKrnl, res, outerIndices);
+          createKrnl.store(
+              createMath.cast(outputElementType, res), R, outerIndices);
         });
   }
 
@@ -313,18 +371,26 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     auto shapecomputed = shapeHelper.computeShape(operandAdaptor);
     assert(succeeded(shapecomputed));
 
+    // Elementwise ops following the Gemm are applied to its output tiles, and
+    // the output is the one of the last op of that chain.
+    ElementwiseEpilogue epilogue(rewriter, op);
+
     // Insert an allocation and deallocation for the output of this operation.
     MemRefType outputMemRefType = convertToMemRefType(*op->result_type_begin());
     Type elementType = outputMemRefType.getElementType();
-    Value alloc = insertAllocAndDeallocSimple(rewriter, op, outputMemRefType,
-        loc, shapeHelper.dimsForOutput(0), (int64_t)BUFFER_ALIGN);
+    Value alloc = insertAllocAndDeallocSimple(rewriter, epilogue.getLastOp(),
+        outputMemRefType, loc, shapeHelper.dimsForOutput(0),
+        (int64_t)BUFFER_ALIGN);
+
+    // Half precision data is loaded, extended and computed in f32.
+    Type computeType = getComputeElementType(elementType);
 
     // Get the constants: zero, alpha,and beta.
     float alphaLit = gemmOp.alpha().convertToFloat();
     float betaLit = gemmOp.beta().convertToFloat();
-    Value alpha = emitConstantOp(rewriter, loc, elementType, alphaLit);
-    Value beta = emitConstantOp(rewriter, loc, elementType, betaLit);
-    Value zero = emitConstantOp(rewriter, loc, elementType, 0);
+    Value alpha = emitConstantOp(rewriter, loc, computeType, alphaLit);
+    Value beta = emitConstantOp(rewriter, loc, computeType, betaLit);
+    Value zero = emitConstantOp(rewriter, loc, computeType, 0);
 
     LLVM_DEBUG({
       if (DEBUG_SIMD_OFF)
@@ -361,13 +427,13 @@ struct ONNXGemmOpLowering : public ConversionPattern {
     });
 
     if (DEBUG_OPTIMIZED_OFF) {
-      genericGemm(gemmOp, operandAdaptor, elementType, shapeHelper, alloc, zero,
-          alpha, beta, rewriter, loc);
+      genericGemm(gemmOp, operandAdaptor, computeType, shapeHelper, alloc, zero,
+          alpha, beta, epilogue, rewriter, loc);
     } else {
-      tiledTransposedGemm(gemmOp, operandAdaptor, elementType, shapeHelper,
-          alloc, zero, alpha, beta, rewriter, loc);
+      tiledTransposedGemm(gemmOp, operandAdaptor, computeType, shapeHelper,
+          alloc, zero, alpha, beta, epilogue, rewriter, loc);
     }
-    rewriter.replaceOp(op, alloc);
+    epilogue.replaceOps(rewriter, alloc);
     return success();
   }
 };
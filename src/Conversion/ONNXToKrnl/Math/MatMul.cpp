@@ -31,7 +31,8 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
   void replaceGenericMatmul(ONNXMatMulOp &matMulOp,
       ONNXMatMulOpAdaptor &operandAdaptor, Type elementType,
       ONNXMatMulOpShapeHelper &shapeHelper, Value alloc, Value fzero,
-      ConversionPatternRewriter &rewriter, Location loc) const {
+      const ElementwiseEpilogue &epilogue, ConversionPatternRewriter &rewriter,
+      Location loc) const {
 
     // Define loops and bounds.
     KrnlBuilder createKrnl(rewriter, loc);
@@ -106,6 +107,7 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
                 create.krnl.store(accumulated, reductionVal);
               });
           Value accumulated = create.krnl.load(reductionVal);
+          accumulated = epilogue.emit(rewriter, loc, accumulated, outerIndices);
           create.krnl.store(accumulated, alloc, outerIndices);
         });
   }
@@ -115,7 +117,8 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
   void replace2x2Matmul2d(ONNXMatMulOp &matMulOp,
       ONNXMatMulOpAdaptor &operandAdaptor, Type elementType,
       ONNXMatMulOpShapeHelper &shapeHelper, Value alloc, Value zeroVal,
-      ConversionPatternRewriter &rewriter, Location loc) const {
+      const ElementwiseEpilogue &epilogue, ConversionPatternRewriter &rewriter,
+      Location loc) const {
 
     // Prepare: loop bounds and zero
     Value A(operandAdaptor.A()), B(operandAdaptor.B()), C(alloc);
@@ -173,13 +176,48 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
     ValueRange kRegBlock = create.krnl.block(kk, kRegTile);
     Value kk1(kRegBlock[0]), kk2(kRegBlock[1]);
     create.krnl.permute({ii1, ii2, jj1, jj2, kk1, kk2}, {0, 3, 1, 4, 2, 5});
-    create.krnl.iterate({ii, jj, kk}, {ii1, jj1, kk1}, {zero, zero, zero},
+    if (epilogue.empty()) {
+      create.krnl.iterate({ii, jj, kk}, {ii1, jj1, kk1}, {zero, zero, zero},
+          {I, J, K}, [&](KrnlBuilder &createKrnl, ValueRange indices) {
+            Value i1(indices[0]), j1(indices[1]), k1(indices[2]);
+            createKrnl.matmul(A, {zero, zero}, B, {zero, zero}, C, {zero, zero},
+                {ii2, jj2, kk2}, {i1, j1, k1}, {I, J, K},
+                {iRegTile, jRegTile, kRegTile}, {}, {}, {},
+                /*simd*/ true, /*unroll*/ true, /*overcompute*/ false);
+          });
+      return;
+    }
+
+    // With an epilogue, the K loop is nested inside the I and J loops, so that
+    // each iRegTile x jRegTile tile of C is complete, and still in cache, when
+    // the epilogue is applied to it.
+    create.krnl.iterate({ii, jj, kk}, {ii1, jj1}, {zero, zero, zero},
         {I, J, K}, [&](KrnlBuilder &createKrnl, ValueRange indices) {
-          Value i1(indices[0]), j1(indices[1]), k1(indices[2]);
-          createKrnl.matmul(A, {zero, zero}, B, {zero, zero}, C, {zero, zero},
-              {ii2, jj2, kk2}, {i1, j1, k1}, {I, J, K},
-              {iRegTile, jRegTile, kRegTile}, {}, {}, {},
-              /*simd*/ true, /*unroll*/ true, /*overcompute*/ false);
+          Value i1(indices[0]), j1(indices[1]);
+          createKrnl.iterate({}, {kk1}, {}, {},
+              [&](KrnlBuilder &createKrnl, ValueRange kIndex) {
+                Value k1(kIndex[0]);
+                createKrnl.matmul(A, {zero, zero}, B, {zero, zero}, C,
+                    {zero, zero}, {ii2, jj2, kk2}, {i1, j1, k1}, {I, J, K},
+                    {iRegTile, jRegTile, kRegTile}, {}, {}, {},
+                    /*simd*/ true, /*unroll*/ true, /*overcompute*/ false);
+              });
+          IndexExprScope tileScope(createKrnl);
+          IndexExpr xUb = IndexExpr::min(
+              SymbolIndexExpr(I) - SymbolIndexExpr(i1), iRegTile);
+          IndexExpr yUb = IndexExpr::min(
+              SymbolIndexExpr(J) - SymbolIndexExpr(j1), jRegTile);
+          ValueRange tileLoops = createKrnl.defineLoops(2);
+          createKrnl.iterateIE(tileLoops, tileLoops,
+              {LiteralIndexExpr(0), LiteralIndexExpr(0)}, {xUb, yUb},
+              [&](KrnlBuilder &createKrnl, ValueRange xy) {
+                MathBuilder createMath(createKrnl);
+                SmallVector<Value, 2> cIndices = {
+                    createMath.add(i1, xy[0]), createMath.add(j1, xy[1])};
+                Value res = createKrnl.load(C, cIndices);
+                res = epilogue.emit(rewriter, loc, res, cIndices);
+                createKrnl.store(res, C, cIndices);
+              });
         });
   }
 
@@ -199,11 +237,15 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
     LogicalResult shapecomputed = shapeHelper.computeShape(operandAdaptor);
     assert(succeeded(shapecomputed));
 
+    // Elementwise ops following the MatMul are applied to its output tiles,
+    // and the output is the one of the last op of that chain.
+    ElementwiseEpilogue epilogue(rewriter, op);
+
     // Insert an allocation and deallocation for the output of this operation.
     MemRefType outputMemRefType = convertToMemRefType(*op->result_type_begin());
     Type elementType = outputMemRefType.getElementType();
-    Value alloc = insertAllocAndDeallocSimple(
-        rewriter, op, outputMemRefType, loc, shapeHelper.dimsForOutput(0));
+    Value alloc = insertAllocAndDeallocSimple(rewriter, epilogue.getLastOp(),
+        outputMemRefType, loc, shapeHelper.dimsForOutput(0));
 
     // Get the constants: zero.
     Value zero = emitConstantOp(rewriter, loc, elementType, 0);
@@ -213,13 +255,13 @@ struct ONNXMatMulOpLowering : public ConversionPattern {
     auto bRank = B.getType().cast<MemRefType>().getShape().size();
     if (aRank == 2 && bRank == 2) {
       replace2x2Matmul2d(matMulOp, operandAdaptor, elementType, shapeHelper,
-          alloc, zero, rewriter, loc);
+          alloc, zero, epilogue, rewriter, loc);
     } else {
       replaceGenericMatmul(matMulOp, operandAdaptor, elementType, shapeHelper,
-          alloc, zero, rewriter, loc);
+          alloc, zero, epilogue, rewriter, loc);
     }
     // Done.
-    rewriter.replaceOp(op, alloc);
+    epilogue.replaceOps(rewriter, alloc);
     return success();
   }
 };
@@ -0,0 +1,320 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------------- Attention.cpp - Lowering Attention Op -----------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX ScaledDotProductAttention Operator to Krnl
+// dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+
+using namespace mlir;
+
+static constexpr int BUFFER_ALIGN = 128;
+// Number of query rows, and of key/value rows, processed together.
+static constexpr int64_t ATTENTION_ROW_TILE = 32;
+static constexpr int64_t ATTENTION_COL_TILE = 64;
+
+// Scaled dot product attention of queries Q [B... x S x E], keys
+// K [B... x L x E] and values V [B... x L x Ev], with an optional additive
+// mask broadcastable to [B... x S x L]:
+//   Y = softmax(scale * Q x Kt + mask) x V
+//
+// The S x L score matrix is never materialized. For each block of
+// ATTENTION_ROW_TILE query rows, the keys and values are streamed in blocks
+// of ATTENTION_COL_TILE rows, and the softmax is computed online: each row
+// keeps the running maximum m of its scores, the running sum l of their
+// exponentials, and an unnormalized output O. For a new block of scores s:
+//   m' = max(m, max(s)), p = exp(s - m'), c = exp(m - m')
+//   l = l * c + sum(p), O = O * c + p x Vblock, m = m'
+// and Y = O / l once all the blocks are processed. While all the scores of a
+// row are -inf, e.g. masked out, m' is -inf too: c = 1 and p = 0 are used
+// instead of the NaNs of exp(-inf + inf), so that the later blocks of the row
+// still give the right result. A row that is entirely masked out ends with
+// l = 0 and outputs NaN, as the unfused softmax does. Both products use the
+// register tiled krnl.matmul on packed blocks.
+struct ONNXScaledDotProductAttentionOpLowering : public ConversionPattern {
+  ONNXScaledDotProductAttentionOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXScaledDotProductAttentionOp::getOperationName(), 1,
+            ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = op->getLoc();
+    ONNXScaledDotProductAttentionOpAdaptor operandAdaptor(operands);
+    ONNXScaledDotProductAttentionOp attentionOp =
+        llvm::cast<ONNXScaledDotProductAttentionOp>(op);
+    Value query = operandAdaptor.Q();
+    Value key = operandAdaptor.K();
+    Value value = operandAdaptor.V();
+    Value mask = operandAdaptor.Mask();
+    bool hasMask = !mask.getType().isa<NoneType>();
+
+    // The blocks are packed in static buffers, so the head sizes E and Ev
+    // must be known at compile time.
+    MemRefType memRefType = convertToMemRefType(*op->result_type_begin());
+    Type elementType = memRefType.getElementType();
+    int64_t rank = memRefType.getRank();
+    int64_t batchRank = rank - 2;
+    auto qType = query.getType().cast<MemRefType>();
+    auto vType = value.getType().cast<MemRefType>();
+    int64_t E = qType.getShape()[rank - 1];
+    int64_t Ev = vType.getShape()[rank - 1];
+    if (E < 0 || Ev < 0 || getComputeElementType(elementType) != elementType)
+      return failure();
+
+    IndexExprScope scope(&rewriter, loc);
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    IndexExpr iZero = LiteralIndexExpr(0);
+    MemRefBoundsIndexCapture queryBounds(query);
+    MemRefBoundsIndexCapture keyBounds(key);
+    SmallVector<IndexExpr, 4> outputDims;
+    for (int64_t i = 0; i < rank - 1; ++i)
+      outputDims.emplace_back(queryBounds.getSymbol(i));
+    outputDims.emplace_back(LiteralIndexExpr(Ev));
+    IndexExpr S = outputDims[rank - 2];
+    IndexExpr L = keyBounds.getSymbol(rank - 2);
+    Value alloc =
+        insertAllocAndDeallocSimple(rewriter, op, memRefType, loc, outputDims);
+
+    // Packed blocks: Qp [Br x E] holds the scaled queries, Kt [E x Bc] the
+    // transposed keys, Vp [Bc x Ev] the values and P [Br x Bc] the scores.
+    // O [Br x Ev], m [Br] and l [Br] hold the state of the online softmax.
+    auto allocBuffer = [&](ArrayRef<int64_t> shape) {
+      return insertAllocAndDealloc(MemRefType::get(shape, elementType), loc,
+          rewriter, /*insertDealloc=*/true, nullptr, BUFFER_ALIGN);
+    };
+    Value Qp = allocBuffer({ATTENTION_ROW_TILE, E});
+    Value Kt = allocBuffer({E, ATTENTION_COL_TILE});
+    Value Vp = allocBuffer({ATTENTION_COL_TILE, Ev});
+    Value P = allocBuffer({ATTENTION_ROW_TILE, ATTENTION_COL_TILE});
+    Value O = allocBuffer({ATTENTION_ROW_TILE, Ev});
+    Value rowMax = allocBuffer({ATTENTION_ROW_TILE});
+    Value rowSum = allocBuffer({ATTENTION_ROW_TILE});
+
+    Value fZero = create.math.constant(elementType, 0);
+    Value fOne = create.math.constant(elementType, 1);
+    Value negInfinity = create.math.constant(
+        elementType, -std::numeric_limits<float>::infinity());
+    Value scale = create.math.constant(
+        elementType, attentionOp.scale().convertToDouble());
+    Value zero = create.math.constantIndex(0);
+    ArrayRef<int64_t> maskShape;
+    if (hasMask)
+      maskShape = mask.getType().cast<MemRefType>().getShape();
+
+    // Iterate over the batch dimensions and the blocks of query rows.
+    ValueRange rowLoops = create.krnl.defineLoops(rank - 1);
+    SmallVector<IndexExpr, 4> rowLbs(rank - 1, iZero);
+    SmallVector<IndexExpr, 4> rowUbs(
+        outputDims.begin(), outputDims.begin() + batchRank);
+    rowUbs.emplace_back(S.ceilDiv(ATTENTION_ROW_TILE));
+    create.krnl.iterateIE(rowLoops, rowLoops, rowLbs, rowUbs,
+        [&](KrnlBuilder &createKrnl, ValueRange rowIndices) {
+          IndexExprScope rowScope(createKrnl);
+          MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+          SmallVector<Value, 4> batch(
+              rowIndices.begin(), rowIndices.begin() + batchRank);
+          IndexExpr rowStart =
+              DimIndexExpr(rowIndices[batchRank]) * ATTENTION_ROW_TILE;
+          IndexExpr rows = IndexExpr::min(
+              SymbolIndexExpr(S) - rowStart, ATTENTION_ROW_TILE);
+
+          // Qp = scale * Q[b, rowStart : rowStart + rows].
+          ValueRange packQLoops = create.krnl.defineLoops(2);
+          create.krnl.iterateIE(packQLoops, packQLoops,
+              {LiteralIndexExpr(0), LiteralIndexExpr(0)},
+              {rows, LiteralIndexExpr(E)},
+              [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                IndexExprScope packScope(createKrnl);
+                MathBuilder createMath(createKrnl);
+                DimIndexExpr r(indices[0]), e(indices[1]);
+                SmallVector<IndexExpr, 4> access;
+                for (Value b : batch)
+                  access.emplace_back(SymbolIndexExpr(b));
+                access.emplace_back(SymbolIndexExpr(rowStart) + r);
+                access.emplace_back(e);
+                Value q = createKrnl.loadIE(query, access);
+                createKrnl.storeIE(createMath.mul(q, scale), Qp, {r, e});
+              });
+          create.krnl.memset(O, fZero);
+          create.krnl.memset(rowMax, negInfinity);
+          create.krnl.memset(rowSum, fZero);
+
+          // Stream over the blocks of key/value rows.
+          ValueRange colLoop = create.krnl.defineLoops(1);
+          create.krnl.iterateIE(colLoop, colLoop, {LiteralIndexExpr(0)},
+              {SymbolIndexExpr(L).ceilDiv(ATTENTION_COL_TILE)},
+              [&](KrnlBuilder &createKrnl, ValueRange colIndices) {
+                IndexExprScope colScope(createKrnl);
+                MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
+                    createKrnl);
+                IndexExpr colStart =
+                    DimIndexExpr(colIndices[0]) * ATTENTION_COL_TILE;
+                IndexExpr cols = IndexExpr::min(
+                    SymbolIndexExpr(L) - colStart, ATTENTION_COL_TILE);
+                IndexExpr blockRows = SymbolIndexExpr(rows);
+
+                // Kt = K[b, colStart : colStart + cols]^T and
+                // Vp = V[b, colStart : colStart + cols].
+                auto packKV = [&](Value src, Value dst, int64_t size,
+                                  bool transpose) {
+                  ValueRange packLoops = create.krnl.defineLoops(2);
+                  create.krnl.iterateIE(packLoops, packLoops,
+                      {LiteralIndexExpr(0), LiteralIndexExpr(0)},
+                      {cols, LiteralIndexExpr(size)},
+                      [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                        IndexExprScope packScope(createKrnl);
+                        DimIndexExpr c(indices[0]), e(indices[1]);
+                        SmallVector<IndexExpr, 4> access;
+                        for (Value b : batch)
+                          access.emplace_back(SymbolIndexExpr(b));
+                        access.emplace_back(SymbolIndexExpr(colStart) + c);
+                        access.emplace_back(e);
+                        Value val = createKrnl.loadIE(src, access);
+                        if (transpose)
+                          createKrnl.storeIE(val, dst, {e, c});
+                        else
+                          createKrnl.storeIE(val, dst, {c, e});
+                      });
+                };
+                packKV(key, Kt, E, /*transpose=*/true);
+                packKV(value, Vp, Ev, /*transpose=*/false);
+
+                // P = Qp x Kt.
+                create.krnl.memset(P, fZero);
+                emitTiledMatmul(create.krnl, Qp, {zero, zero}, Kt,
+                    {zero, zero}, P, {zero, zero}, blockRows, cols,
+                    LiteralIndexExpr(E));
+
+                // Online softmax update of each row.
+                ValueRange updateLoop = create.krnl.defineLoops(1);
+                create.krnl.iterateIE(updateLoop, updateLoop,
+                    {LiteralIndexExpr(0)}, {blockRows},
+                    [&](KrnlBuilder &createKrnl, ValueRange updateIndices) {
+                      IndexExprScope updateScope(createKrnl);
+                      MathBuilder createMath(createKrnl);
+                      Value r = updateIndices[0];
+                      IndexExpr blockCols = SymbolIndexExpr(cols);
+                      Value oldMax = createKrnl.load(rowMax, {r});
+
+                      // Add the mask and update the row maximum.
+                      ValueRange maxLoop = createKrnl.defineLoops(1);
+                      createKrnl.iterateIE(maxLoop, maxLoop,
+                          {LiteralIndexExpr(0)}, {blockCols},
+                          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                            IndexExprScope maxScope(createKrnl);
+                            MathBuilder createMath(createKrnl);
+                            DimIndexExpr c(indices[0]);
+                            Value s = createKrnl.load(P, {r, indices[0]});
+                            if (hasMask) {
+                              // The mask is aligned with the trailing
+                              // dimensions of [B... x S x L], and broadcast
+                              // along its dimensions of size 1.
+                              SmallVector<IndexExpr, 4> fullAccess;
+                              for (Value b : batch)
+                                fullAccess.emplace_back(SymbolIndexExpr(b));
+                              fullAccess.emplace_back(
+                                  SymbolIndexExpr(rowStart) +
+                                  SymbolIndexExpr(r));
+                              fullAccess.emplace_back(
+                                  SymbolIndexExpr(colStart) + c);
+                              int64_t maskRank = maskShape.size();
+                              SmallVector<IndexExpr, 4> maskAccess;
+                              for (int64_t i = 0; i < maskRank; ++i) {
+                                if (maskShape[i] == 1)
+                                  maskAccess.emplace_back(LiteralIndexExpr(0));
+                                else
+                                  maskAccess.emplace_back(
+                                      fullAccess[rank - maskRank + i]);
+                              }
+                              s = createMath.add(
+                                  s, createKrnl.loadIE(mask, maskAccess));
+                              createKrnl.store(s, P, {r, indices[0]});
+                            }
+                            Value m = createKrnl.load(rowMax, {r});
+                            createKrnl.store(createMath.max(m, s), rowMax, {r});
+                          });
+
+                      // P = exp(P - m'), l = l * c + sum(P), with c = 1 and
+                      // P = 0 while m' is -inf.
+                      Value newMax = createKrnl.load(rowMax, {r});
+                      Value isMaxInfinite = createMath.eq(newMax, negInfinity);
+                      Value expMax =
+                          createMath.exp(createMath.sub(oldMax, newMax));
+                      Value correction =
+                          createMath.select(isMaxInfinite, fOne, expMax);
+                      Value l = createKrnl.load(rowSum, {r});
+                      createKrnl.store(
+                          createMath.mul(l, correction), rowSum, {r});
+                      ValueRange expLoop = createKrnl.defineLoops(1);
+                      createKrnl.iterateIE(expLoop, expLoop,
+                          {LiteralIndexExpr(0)}, {blockCols},
+                          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                            MathBuilder createMath(createKrnl);
+                            Value c = indices[0];
+                            Value expScore = createMath.exp(createMath.sub(
+                                createKrnl.load(P, {r, c}), newMax));
+                            Value p = createMath.select(
+                                isMaxInfinite, fZero, expScore);
+                            createKrnl.store(p, P, {r, c});
+                            Value l = createKrnl.load(rowSum, {r});
+                            createKrnl.store(createMath.add(l, p), rowSum, {r});
+                          });
+
+                      // O = O * c.
+                      ValueRange rescaleLoop = createKrnl.defineLoops(1);
+                      createKrnl.iterateIE(rescaleLoop, rescaleLoop,
+                          {LiteralIndexExpr(0)}, {LiteralIndexExpr(Ev)},
+                          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                            MathBuilder createMath(createKrnl);
+                            Value o = createKrnl.load(O, {r, indices[0]});
+                            createKrnl.store(createMath.mul(o, correction), O,
+                                {r, indices[0]});
+                          });
+                    });
+
+                // O += P x Vp.
+                emitTiledMatmul(create.krnl, P, {zero, zero}, Vp, {zero, zero},
+                    O, {zero, zero}, blockRows, LiteralIndexExpr(Ev), cols);
+              });
+
+          // Y[b, rowStart : rowStart + rows] = O / l.
+          ValueRange storeLoops = create.krnl.defineLoops(2);
+          create.krnl.iterateIE(storeLoops, storeLoops,
+              {LiteralIndexExpr(0), LiteralIndexExpr(0)},
+              {rows, LiteralIndexExpr(Ev)},
+              [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                IndexExprScope storeScope(createKrnl);
+                MathBuilder createMath(createKrnl);
+                DimIndexExpr r(indices[0]), v(indices[1]);
+                Value o = createKrnl.loadIE(O, {r, v});
+                Value l = createKrnl.loadIE(rowSum, {r});
+                SmallVector<IndexExpr, 4> access;
+                for (Value b : batch)
+                  access.emplace_back(SymbolIndexExpr(b));
+                access.emplace_back(SymbolIndexExpr(rowStart) + r);
+                access.emplace_back(v);
+                createKrnl.storeIE(createMath.div(o, l), alloc, access);
+              });
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXScaledDotProductAttentionOpPattern(
+    RewritePatternSet &patterns, TypeConverter &typeConverter,
+    MLIRContext *ctx) {
+  patterns.insert<ONNXScaledDotProductAttentionOpLowering>(typeConverter, ctx);
+}
@@ -14,9 +14,120 @@
 
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
 #include "src/Dialect/ONNX/ShapeInference/ONNXShapeHelper.hpp"
+#include "src/Support/OMOptions.hpp"
 
 using namespace mlir;
 
+static constexpr int BUFFER_ALIGN = 128;
+// Depthwise convolutions keep up to this many filter taps (7 x 7) in
+// registers, and compute this many consecutive output pixels of a row at once.
+static constexpr int MAX_DEPTHWISE_TAPS = 49;
+static constexpr int64_t DEPTHWISE_WIDTH_TILE = 8;
+
+//===----------------------------------------------------------------------===//
+// Winograd transforms
+//===----------------------------------------------------------------------===//
+
+// Transform matrices of the Winograd minimal filtering algorithm
+// F(m x m, 3 x 3) (Lavin and Gray, "Fast Algorithms for Convolutional Neural
+// Networks"), which computes an m x m output tile y from an alpha x alpha
+// input tile d, where alpha = m + 2, and a 3 x 3 filter g as
+//   y = AT [(G g GT) * (BT d B)] A
+// where * is the elementwise product. All matrices are row major.
+struct WinogradTransforms {
+  int64_t m;
+  int64_t alpha;
+  ArrayRef<double> BT; // alpha x alpha
+  ArrayRef<double> G;  // alpha x 3
+  ArrayRef<double> AT; // m x alpha
+};
+
+// F(2 x 2, 3 x 3): 16 multiplies per 2 x 2 tile instead of 36.
+static const double winogradF2BT[] = {
+    1, 0, -1, 0, 0, 1, 1, 0, 0, -1, 1, 0, 0, 1, 0, -1};
+static const double winogradF2G[] = {
+    1, 0, 0, 0.5, 0.5, 0.5, 0.5, -0.5, 0.5, 0, 0, 1};
+static const double winogradF2AT[] = {1, 1, 1, 0, 0, 1, -1, -1};
+
+// F(4 x 4, 3 x 3): 36 multiplies per 4 x 4 tile instead of 144.
+static const double winogradF4BT[] = {4, 0, -5, 0, 1, 0, 0, -4, -4, 1, 1, 0,
+    0, 4, -4, -1, 1, 0, 0, -2, -1, 2, 1, 0, 0, 2, -1, -2, 1, 0, 0, 4, 0, -5, 0,
+    1};
+static const double winogradF4G[] = {1.0 / 4, 0, 0, -1.0 / 6, -1.0 / 6,
+    -1.0 / 6, -1.0 / 6, 1.0 / 6, -1.0 / 6, 1.0 / 24, 1.0 / 12, 1.0 / 6,
+    1.0 / 24, -1.0 / 12, 1.0 / 6, 0, 0, 1};
+static const double winogradF4AT[] = {1, 1, 1, 1, 1, 0, 0, 1, -1, 2, -2, 0, 0,
+    1, 1, 4, 4, 0, 0, 1, -1, 8, -8, 1};
+
+static WinogradTransforms getWinogradTransforms(int64_t m) {
+  if (m == 2)
+    return {2, 4, winogradF2BT, winogradF2G, winogradF2AT};
+  assert(m == 4 && "expected a Winograd output tile of 2 or 4");
+  return {4, 6, winogradF4BT, winogradF4G, winogradF4AT};
+}
+
+// Compute L X LT at compile time, for a p x q matrix L and a q x q matrix X.
+static void computeWinogradTransform(ArrayRef<double> L, int64_t p, int64_t q,
+    ArrayRef<double> X, SmallVectorImpl<double> &res) {
+  SmallVector<double, 36> LX(p * q, 0);
+  for (int64_t i = 0; i < p; ++i)
+    for (int64_t j = 0; j < q; ++j)
+      for (int64_t k = 0; k < q; ++k)
+        LX[i * q + j] += L[i * q + k] * X[k * q + j];
+  res.assign(p * p, 0);
+  for (int64_t i = 0; i < p; ++i)
+    for (int64_t j = 0; j < p; ++j)
+      for (int64_t k = 0; k < q; ++k)
+        res[i * p + j] += LX[i * q + k] * L[j * q + k];
+}
+
+// Emit sum_k coefs[k] * values[k]. Zero coefficients are skipped, and
+// coefficients of 1 and -1 are folded into additions and subtractions.
+static Value emitLinearCombination(MathBuilder &createMath, Type type,
+    ArrayRef<double> coefs, ArrayRef<Value> values) {
+  Value res;
+  for (unsigned k = 0; k < coefs.size(); ++k) {
+    double coef = coefs[k];
+    if (coef == 0)
+      continue;
+    if (!res) {
+      res = (coef == 1) ? values[k]
+                        : createMath.mul(createMath.constant(type, coef),
+                              values[k]);
+    } else if (coef == 1) {
+      res = createMath.add(res, values[k]);
+    } else if (coef == -1) {
+      res = createMath.sub(res, values[k]);
+    } else {
+      res = createMath.add(
+          res, createMath.mul(createMath.constant(type, coef), values[k]));
+    }
+  }
+  return res ? res : createMath.constant(type, 0);
+}
+
+// Emit L X LT for a p x q matrix L of constants and a q x q matrix X of
+// values, as unrolled scalar operations.
+static void emitWinogradTransform(MathBuilder &createMath, Type type,
+    ArrayRef<double> L, int64_t p, int64_t q, ArrayRef<Value> X,
+    SmallVectorImpl<Value> &res) {
+  SmallVector<Value, 36> LX;
+  SmallVector<Value, 6> column;
+  for (int64_t i = 0; i < p; ++i)
+    for (int64_t j = 0; j < q; ++j) {
+      column.clear();
+      for (int64_t k = 0; k < q; ++k)
+        column.emplace_back(X[k * q + j]);
+      LX.emplace_back(emitLinearCombination(
+          createMath, type, L.slice(i * q, q), column));
+    }
+  res.clear();
+  for (int64_t i = 0; i < p; ++i)
+    for (int64_t j = 0; j < p; ++j)
+      res.emplace_back(emitLinearCombination(createMath, type,
+          L.slice(j * q, q), ArrayRef<Value>(LX).slice(i * q, q)));
+}
+
 struct ONNXConvOpLowering : public ConversionPattern {
   ONNXConvOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
       : ConversionPattern(
@@ -25,7 +136,8 @@ struct ONNXConvOpLowering : public ConversionPattern {
   void convUnoptimized(ConversionPatternRewriter &rewriter,
       IndexExprScope *topScope, ONNXConvOp &convOp,
       ONNXConvOpAdaptor &operandAdaptor, ONNXConvOpShapeHelper &shapeHelper,
-      MemRefType &memRefType, Value alloc) const {
+      MemRefType &memRefType, Value alloc,
+      const ElementwiseEpilogue &epilogue) const {
     auto loc = convOp.getLoc();
     KrnlBuilder createKrnl(rewriter, loc);
 
@@ -38,7 +150,9 @@ struct ONNXConvOpLowering : public ConversionPattern {
     bool hasBias = !biasOperand.getType().isa<NoneType>();
     int64_t groupNum = convOp.group();
     IndexExpr G = LiteralIndexExpr(groupNum);
-    Value fZero = emitConstantOp(rewriter, loc, memRefType.getElementType(), 0);
+    // Half precision data is accumulated in f32.
+    Type computeType = getComputeElementType(memRefType.getElementType());
+    Value fZero = emitConstantOp(rewriter, loc, computeType, 0);
 
     // Bounds for output sizes: [N x CO x HO x WO]:
     // where N is Batch Size,
@@ -101,8 +215,7 @@ struct ONNXConvOpLowering : public ConversionPattern {
                 IndexExprScope outputSpacialScope(createKrnl);
                 MemRefBuilder createMemRef(createKrnl);
                 // Create a local reduction value and set to zero.
-                MemRefType tmpType =
-                    MemRefType::get({}, memRefType.getElementType());
+                MemRefType tmpType = MemRefType::get({}, computeType);
                 // Single scalar, no need for default alignment.
                 Value reductionVal = createMemRef.alloca(tmpType);
                 createKrnl.store(fZero, reductionVal);
@@ -164,8 +277,8 @@ struct ONNXConvOpLowering : public ConversionPattern {
                         IndexExpr t = (k * d) - pos;
                         inputAccessFct.emplace_back(t);
                       }
-                      Value image =
-                          createKrnl.loadIE(inputOperand, inputAccessFct);
+                      Value image = createMath.cast(computeType,
+                          createKrnl.loadIE(inputOperand, inputAccessFct));
                       // Create access fct for filter: [co, ciPerG, kh, kw].
                       SmallVector<IndexExpr, 4> filterAccessFct;
                       filterAccessFct.emplace_back(DimIndexExpr(co));
@@ -175,8 +288,8 @@ struct ONNXConvOpLowering : public ConversionPattern {
                         DimIndexExpr k(redIndices[1 + i]);
                         filterAccessFct.emplace_back(k);
                       }
-                      Value filter =
-                          createKrnl.loadIE(filterOperand, filterAccessFct);
+                      Value filter = createMath.cast(computeType,
+                          createKrnl.loadIE(filterOperand, filterAccessFct));
                       Value oldRed = createKrnl.load(reductionVal);
                       Value mul = createMath.mul(image, filter);
                       Value newRed = createMath.add(oldRed, mul);
@@ -186,10 +299,10 @@ struct ONNXConvOpLowering : public ConversionPattern {
                 Value result = createKrnl.load(reductionVal);
                 // Store the result. Optionally add bias.
                 SymbolIndexExpr coInOutputSpacial(co);
+                MathBuilder createMath(createKrnl);
                 if (hasBias) {
-                  MathBuilder createMath(createKrnl);
-                  Value bias =
-                      createKrnl.loadIE(biasOperand, {coInOutputSpacial});
+                  Value bias = createMath.cast(computeType,
+                      createKrnl.loadIE(biasOperand, {coInOutputSpacial}));
                   result = createMath.add(result, bias);
                 }
                 SmallVector<IndexExpr, 4> resAccessFunc;
@@ -197,11 +310,474 @@ struct ONNXConvOpLowering : public ConversionPattern {
                 resAccessFunc.emplace_back(coInOutputSpacial);
                 for (Value o : outputSpatialIndices)
                   resAccessFunc.emplace_back(DimIndexExpr(o));
+                result = epilogue.emitIE(rewriter, loc, result, resAccessFunc);
+                result = createMath.cast(memRefType.getElementType(), result);
                 createKrnl.storeIE(result, alloc, resAccessFunc);
               }); // Output spacial loops.
         });       // Outer loops;
   }
 
+  // Return the output tile size m of the Winograd F(m x m, 3 x 3) algorithm
+  // to use for this convolution, or 0 if the direct algorithm is to be used.
+  // Winograd applies to static f32 2D convolutions with a single group and a
+  // 3 x 3 kernel, with unit strides and dilations.
+  int64_t getWinogradTileSize(ONNXConvOp &convOp,
+      ONNXConvOpAdaptor &operandAdaptor, ONNXConvOpShapeHelper &shapeHelper,
+      MemRefType &memRefType) const {
+    int64_t m = winogradTile;
+    if (m != 2 && m != 4)
+      return 0;
+    auto xType = operandAdaptor.X().getType().cast<MemRefType>();
+    auto wType = operandAdaptor.W().getType().cast<MemRefType>();
+    if (convOp.group() != 1 || memRefType.getRank() != 4 ||
+        !memRefType.hasStaticShape() || !xType.hasStaticShape() ||
+        !wType.hasStaticShape() || !memRefType.getElementType().isF32())
+      return 0;
+    if (wType.getShape()[2] != 3 || wType.getShape()[3] != 3)
+      return 0;
+    for (int i = 0; i < 2; ++i)
+      if (shapeHelper.strides[i] != 1 || shapeHelper.dilations[i] != 1 ||
+          !shapeHelper.pads[i].isLiteral())
+        return 0;
+    // Use smaller tiles for small images.
+    int64_t HO = memRefType.getShape()[2], WO = memRefType.getShape()[3];
+    if (HO < m || WO < m)
+      m = 2;
+    if (HO < m || WO < m)
+      return 0;
+    return m;
+  }
+
+  // Winograd F(m x m, 3 x 3) convolution, for an input image X [N x C x H x W]
+  // and a filter W [M x C x 3 x 3]. The output image Y [N x M x HO x WO] is
+  // split into T = N x tH x tW tiles of size m x m, and computed as:
+  //   U [alpha x alpha x M x C] = G W GT, at compile time for constant filters
+  //   V [alpha x alpha x C x T] = BT Xp B, on the zero padded image Xp
+  //   Z [alpha x alpha x M x T] = U x V, one matmul per (xi, nu)
+  //   Y = AT Z A + B
+  void convWinograd(ConversionPatternRewriter &rewriter, ONNXConvOp &convOp,
+      ONNXConvOpAdaptor &operandAdaptor, ONNXConvOpShapeHelper &shapeHelper,
+      MemRefType &memRefType, Value alloc, int64_t m,
+      const ElementwiseEpilogue &epilogue) const {
+    Location loc = convOp.getLoc();
+    MultiDialectBuilder<KrnlBuilder, MemRefBuilder, MathBuilder> create(
+        rewriter, loc);
+    WinogradTransforms wt = getWinogradTransforms(m);
+    int64_t alpha = wt.alpha;
+    Value input = operandAdaptor.X();
+    Value filter = operandAdaptor.W();
+    Value bias = operandAdaptor.B();
+    bool hasBias = !bias.getType().isa<NoneType>();
+    Type elementType = memRefType.getElementType();
+    Value fZero = create.math.constant(elementType, 0);
+    IndexExpr iZero = LiteralIndexExpr(0);
+
+    ArrayRef<int64_t> xShape = input.getType().cast<MemRefType>().getShape();
+    ArrayRef<int64_t> yShape = memRefType.getShape();
+    int64_t N = yShape[0], M = yShape[1], HO = yShape[2], WO = yShape[3];
+    int64_t C = xShape[1], H = xShape[2], W = xShape[3];
+    int64_t pH = shapeHelper.pads[0].getLiteral();
+    int64_t pW = shapeHelper.pads[1].getLiteral();
+    int64_t tH = (HO + m - 1) / m, tW = (WO + m - 1) / m;
+    int64_t T = N * tH * tW;
+
+    // Filter transform: U = G W GT.
+    MemRefType uType = MemRefType::get({alpha, alpha, M, C}, elementType);
+    Value U;
+    if (DenseElementsAttr wAttr =
+            getDenseElementAttributeFromKrnlValue(filter)) {
+      SmallVector<double, 9> wValues;
+      for (float val : wAttr.getValues<float>())
+        wValues.emplace_back(val);
+      SmallVector<float, 1> uValues(alpha * alpha * M * C);
+      SmallVector<double, 36> u;
+      for (int64_t mo = 0; mo < M; ++mo)
+        for (int64_t c = 0; c < C; ++c) {
+          ArrayRef<double> g = ArrayRef<double>(wValues).slice(
+              (mo * C + c) * 9, 9);
+          computeWinogradTransform(wt.G, alpha, 3, g, u);
+          for (int64_t xn = 0; xn < alpha * alpha; ++xn)
+            uValues[(xn * M + mo) * C + c] = u[xn];
+        }
+      U = create.krnl.constant(uType, "winograd_filter_",
+          DenseElementsAttr::get(
+              RankedTensorType::get(uType.getShape(), elementType),
+              llvm::makeArrayRef(uValues)));
+    } else {
+      U = insertAllocAndDealloc(
+          uType, loc, rewriter, /*insertDealloc=*/true, nullptr, BUFFER_ALIGN);
+      ValueRange loopDef = create.krnl.defineLoops(2);
+      create.krnl.iterateIE(loopDef, loopDef, {iZero, iZero},
+          {LiteralIndexExpr(M), LiteralIndexExpr(C)},
+          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+            MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+            SmallVector<Value, 9> g;
+            for (int64_t i = 0; i < 3; ++i)
+              for (int64_t j = 0; j < 3; ++j)
+                g.emplace_back(create.krnl.load(filter,
+                    {indices[0], indices[1], create.math.constantIndex(i),
+                        create.math.constantIndex(j)}));
+            SmallVector<Value, 36> u;
+            emitWinogradTransform(
+                create.math, elementType, wt.G, alpha, 3, g, u);
+            for (int64_t xn = 0; xn < alpha * alpha; ++xn)
+              create.krnl.store(u[xn], U,
+                  {create.math.constantIndex(xn / alpha),
+                      create.math.constantIndex(xn % alpha), indices[0],
+                      indices[1]});
+          });
+    }
+
+    // Copy the image into a zero padded image Xp [N x C x HP x WP], so that
+    // all the input tiles are full.
+    int64_t HP = tH * m + 2, WP = tW * m + 2;
+    MemRefType xpType = MemRefType::get({N, C, HP, WP}, elementType);
+    Value Xp = insertAllocAndDealloc(
+        xpType, loc, rewriter, /*insertDealloc=*/true, nullptr, BUFFER_ALIGN);
+    create.krnl.memset(Xp, fZero);
+    ValueRange copyLoops = create.krnl.defineLoops(4);
+    create.krnl.iterateIE(copyLoops, copyLoops, {iZero, iZero, iZero, iZero},
+        {LiteralIndexExpr(N), LiteralIndexExpr(C), LiteralIndexExpr(H),
+            LiteralIndexExpr(W)},
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope scope(createKrnl);
+          DimIndexExpr h(indices[2]), w(indices[3]);
+          Value val = createKrnl.load(input, indices);
+          createKrnl.storeIE(val, Xp,
+              {DimIndexExpr(indices[0]), DimIndexExpr(indices[1]), h + pH,
+                  w + pW});
+        });
+
+    // Input transform: V = BT d B for each alpha x alpha input tile d, which
+    // starts at (th * m, tw * m) in Xp, with t = (n * tH + th) * tW + tw.
+    MemRefType vType = MemRefType::get({alpha, alpha, C, T}, elementType);
+    Value V = insertAllocAndDealloc(
+        vType, loc, rewriter, /*insertDealloc=*/true, nullptr, BUFFER_ALIGN);
+    ValueRange inputLoops = create.krnl.defineLoops(4);
+    create.krnl.iterateIE(inputLoops, inputLoops, {iZero, iZero, iZero, iZero},
+        {LiteralIndexExpr(N), LiteralIndexExpr(C), LiteralIndexExpr(tH),
+            LiteralIndexExpr(tW)},
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope scope(createKrnl);
+          MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+          DimIndexExpr n(indices[0]), c(indices[1]), th(indices[2]),
+              tw(indices[3]);
+          IndexExpr t = (n * tH + th) * tW + tw;
+          SmallVector<Value, 36> d;
+          for (int64_t i = 0; i < alpha; ++i)
+            for (int64_t j = 0; j < alpha; ++j)
+              d.emplace_back(create.krnl.loadIE(
+                  Xp, {n, c, th * m + i, tw * m + j}));
+          SmallVector<Value, 36> v;
+          emitWinogradTransform(create.math, elementType, wt.BT, alpha, alpha,
+              d, v);
+          for (int64_t xn = 0; xn < alpha * alpha; ++xn)
+            create.krnl.storeIE(v[xn], V,
+                {LiteralIndexExpr(xn / alpha), LiteralIndexExpr(xn % alpha), c,
+                    t});
+        });
+
+    // Batched matmul in the transform domain: Z[xi, nu] = U[xi, nu] x V[xi, nu]
+    // for each (xi, nu), with [M x C] x [C x T] matrices.
+    MemRefType zType = MemRefType::get({alpha, alpha, M, T}, elementType);
+    Value Z = insertAllocAndDealloc(
+        zType, loc, rewriter, /*insertDealloc=*/true, nullptr, BUFFER_ALIGN);
+    create.krnl.memset(Z, fZero);
+    Value zero = create.math.constantIndex(0);
+    ValueRange batchLoops = create.krnl.defineLoops(2);
+    create.krnl.iterateIE(batchLoops, batchLoops, {iZero, iZero},
+        {LiteralIndexExpr(alpha), LiteralIndexExpr(alpha)},
+        [&](KrnlBuilder &createKrnl, ValueRange batchIndices) {
+          IndexExprScope scope(createKrnl);
+          Value xi(batchIndices[0]), nu(batchIndices[1]);
+          emitTiledMatmul(createKrnl, U, {xi, nu, zero, zero}, V,
+              {xi, nu, zero, zero}, Z, {xi, nu, zero, zero},
+              LiteralIndexExpr(M), LiteralIndexExpr(T), LiteralIndexExpr(C));
+        });
+
+    // Output transform: y = AT z A + B for each tile. Partial tiles at the
+    // bottom and right borders go through a local m x m buffer.
+    bool fullTiles = (HO % m == 0) && (WO % m == 0);
+    ValueRange outputLoops = create.krnl.defineLoops(4);
+    create.krnl.iterateIE(outputLoops, outputLoops,
+        {iZero, iZero, iZero, iZero},
+        {LiteralIndexExpr(N), LiteralIndexExpr(M), LiteralIndexExpr(tH),
+            LiteralIndexExpr(tW)},
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope scope(createKrnl);
+          MultiDialectBuilder<KrnlBuilder, MemRefBuilder, MathBuilder> create(
+              createKrnl);
+          DimIndexExpr n(indices[0]), mo(indices[1]), th(indices[2]),
+              tw(indices[3]);
+          IndexExpr t = (n * tH + th) * tW + tw;
+          SmallVector<Value, 36> z;
+          for (int64_t xn = 0; xn < alpha * alpha; ++xn)
+            z.emplace_back(create.krnl.loadIE(Z,
+                {LiteralIndexExpr(xn / alpha), LiteralIndexExpr(xn % alpha),
+                    mo, t}));
+          SmallVector<Value, 16> y;
+          emitWinogradTransform(
+              create.math, elementType, wt.AT, m, alpha, z, y);
+          if (hasBias) {
+            Value b = create.krnl.loadIE(bias, {mo});
+            for (Value &val : y)
+              val = create.math.add(val, b);
+          }
+          if (fullTiles) {
+            for (int64_t ij = 0; ij < m * m; ++ij) {
+              SmallVector<IndexExpr, 4> yAccess = {
+                  n, mo, th * m + (ij / m), tw * m + (ij % m)};
+              Value val = epilogue.emitIE(rewriter, loc, y[ij], yAccess);
+              create.krnl.storeIE(val, alloc, yAccess);
+            }
+            return;
+          }
+          Value tile = create.mem.alignedAlloca(
+              MemRefType::get({m, m}, elementType), BUFFER_ALIGN);
+          for (int64_t ij = 0; ij < m * m; ++ij)
+            create.krnl.store(y[ij], tile,
+                {create.math.constantIndex(ij / m),
+                    create.math.constantIndex(ij % m)});
+          IndexExpr hLen = IndexExpr::min(LiteralIndexExpr(HO) - th * m, m);
+          IndexExpr wLen = IndexExpr::min(LiteralIndexExpr(WO) - tw * m, m);
+          ValueRange copyLoops = create.krnl.defineLoops(2);
+          create.krnl.iterateIE(copyLoops, copyLoops, {iZero, iZero},
+              {hLen, wLen}, [&](KrnlBuilder &createKrnl, ValueRange ij) {
+                IndexExprScope innerScope(createKrnl);
+                DimIndexExpr i(ij[0]), j(ij[1]);
+                SmallVector<IndexExpr, 4> yAccess = {SymbolIndexExpr(n),
+                    SymbolIndexExpr(mo), SymbolIndexExpr(th) * m + i,
+                    SymbolIndexExpr(tw) * m + j};
+                Value val = createKrnl.load(tile, ij);
+                val = epilogue.emitIE(rewriter, loc, val, yAccess);
+                createKrnl.storeIE(val, alloc, yAccess);
+              });
+        });
+  }
+
+  // Return true if the convolution is a pointwise (1 x 1) 2D convolution with
+  // a single group, unit strides and no padding, which is a matrix
+  // multiplication over the channels for each image.
+  bool isPointwiseConv(ONNXConvOp &convOp, ONNXConvOpAdaptor &operandAdaptor,
+      ONNXConvOpShapeHelper &shapeHelper, MemRefType &memRefType) const {
+    Type elementType = memRefType.getElementType();
+    if (convOp.group() != 1 || memRefType.getRank() != 4 ||
+        getComputeElementType(elementType) != elementType)
+      return false;
+    MemRefBoundsIndexCapture filterBounds(operandAdaptor.W());
+    for (int i = 2; i < 4; ++i)
+      if (!filterBounds.isLiteral(i) || filterBounds.getShape(i) != 1)
+        return false;
+    for (int i = 0; i < 2; ++i)
+      if (shapeHelper.strides[i] != 1)
+        return false;
+    for (IndexExpr pad : shapeHelper.pads)
+      if (!pad.isLiteral() || pad.getLiteral() != 0)
+        return false;
+    return true;
+  }
+
+  // Pointwise convolution of X [N x C x H x W] with W [M x C x 1 x 1], without
+  // any im2col: for each image n, Y[n] [M x HW] = W [M x C] x X[n] [C x HW] is
+  // computed by the tiled matmul on views of the data, accumulating into an
+  // output initialized with the bias. The epilogue is applied to each image
+  // right after its matmul.
+  void convPointwise(ConversionPatternRewriter &rewriter, ONNXConvOp &convOp,
+      ONNXConvOpAdaptor &operandAdaptor, MemRefType &memRefType, Value alloc,
+      const ElementwiseEpilogue &epilogue) const {
+    Location loc = convOp.getLoc();
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    Value input = operandAdaptor.X();
+    Value filter = operandAdaptor.W();
+    Value bias = operandAdaptor.B();
+    bool hasBias = !bias.getType().isa<NoneType>();
+    Type elementType = memRefType.getElementType();
+    IndexExpr iZero = LiteralIndexExpr(0);
+
+    // Views X [N x C x HW], W [M x C] and Y [N x M x HW] of the data.
+    MemRefBoundsIndexCapture inputBounds(input);
+    MemRefBoundsIndexCapture filterBounds(filter);
+    IndexExpr N = inputBounds.getSymbol(0);
+    IndexExpr C = inputBounds.getSymbol(1);
+    IndexExpr HW = getNumElementsFrom(inputBounds, 2);
+    IndexExpr M = filterBounds.getSymbol(0);
+    auto getViewType = [&](SmallVectorImpl<IndexExpr> &dims) {
+      SmallVector<int64_t, 3> shape;
+      for (IndexExpr dim : dims)
+        shape.emplace_back(dim.isLiteral() ? dim.getLiteral() : -1);
+      return MemRefType::get(shape, elementType);
+    };
+    SmallVector<IndexExpr, 3> xDims = {N, C, HW};
+    SmallVector<IndexExpr, 2> wDims = {M, C};
+    SmallVector<IndexExpr, 3> yDims = {N, M, HW};
+    Value X = emitMemRefReinterpretCastOp(
+        rewriter, loc, input, getViewType(xDims), xDims);
+    Value W = emitMemRefReinterpretCastOp(
+        rewriter, loc, filter, getViewType(wDims), wDims);
+    Value Y = emitMemRefReinterpretCastOp(
+        rewriter, loc, alloc, getViewType(yDims), yDims);
+
+    // Initialize the output with the bias.
+    if (hasBias) {
+      ValueRange initLoops = create.krnl.defineLoops(3);
+      create.krnl.iterateIE(initLoops, initLoops, {iZero, iZero, iZero}, yDims,
+          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+            Value b = createKrnl.load(bias, {indices[1]});
+            createKrnl.store(b, Y, indices);
+          });
+    } else {
+      create.krnl.memset(alloc, create.math.constant(elementType, 0));
+    }
+
+    // Y[n] += W x X[n].
+    Value zero = create.math.constantIndex(0);
+    ValueRange batchLoop = create.krnl.defineLoops(1);
+    create.krnl.iterateIE(batchLoop, batchLoop, {iZero}, {N},
+        [&](KrnlBuilder &createKrnl, ValueRange batchIndices) {
+          IndexExprScope scope(createKrnl);
+          Value n(batchIndices[0]);
+          emitTiledMatmul(createKrnl, W, {zero, zero}, X, {n, zero, zero}, Y,
+              {n, zero, zero}, SymbolIndexExpr(M), SymbolIndexExpr(HW),
+              SymbolIndexExpr(C));
+          if (epilogue.empty())
+            return;
+          MemRefBoundsIndexCapture allocBounds(alloc);
+          SmallVector<IndexExpr, 3> imageUbs;
+          for (int i = 1; i < 4; ++i)
+            imageUbs.emplace_back(allocBounds.getSymbol(i));
+          ValueRange imageLoops = createKrnl.defineLoops(3);
+          createKrnl.iterateIE(imageLoops, imageLoops, {iZero, iZero, iZero},
+              imageUbs, [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                SmallVector<Value, 4> yIndices = {
+                    n, indices[0], indices[1], indices[2]};
+                Value val = createKrnl.load(alloc, yIndices);
+                val = epilogue.emit(rewriter, loc, val, yIndices);
+                createKrnl.store(val, alloc, yIndices);
+              });
+        });
+  }
+
+  // Return true if the convolution is a static 2D depthwise convolution, with
+  // one group per input and output channel and a small kernel.
+  bool isDepthwiseConv(ONNXConvOp &convOp, ONNXConvOpAdaptor &operandAdaptor,
+      ONNXConvOpShapeHelper &shapeHelper, MemRefType &memRefType) const {
+    Type elementType = memRefType.getElementType();
+    auto xType = operandAdaptor.X().getType().cast<MemRefType>();
+    auto wType = operandAdaptor.W().getType().cast<MemRefType>();
+    if (memRefType.getRank() != 4 || !memRefType.hasStaticShape() ||
+        !xType.hasStaticShape() || !wType.hasStaticShape() ||
+        getComputeElementType(elementType) != elementType)
+      return false;
+    int64_t C = xType.getShape()[1];
+    if (C == 1 || convOp.group() != C || memRefType.getShape()[1] != C)
+      return false;
+    if (wType.getShape()[2] * wType.getShape()[3] > MAX_DEPTHWISE_TAPS)
+      return false;
+    for (IndexExpr pad : shapeHelper.pads)
+      if (!pad.isLiteral())
+        return false;
+    return true;
+  }
+
+  // Depthwise convolution, where each channel c of X [N x C x H x W] is
+  // convolved with its own kH x kW filter W[c]. For each (n, c), the image
+  // plane is copied into a zero padded plane buffer, so that the inner loops
+  // are free of boundary checks, and the filter taps are loaded once and kept
+  // in registers. The loop over the output width is blocked so that it is
+  // unrolled and vectorized by the backend.
+  void convDepthwise(ConversionPatternRewriter &rewriter, ONNXConvOp &convOp,
+      ONNXConvOpAdaptor &operandAdaptor, ONNXConvOpShapeHelper &shapeHelper,
+      MemRefType &memRefType, Value alloc,
+      const ElementwiseEpilogue &epilogue) const {
+    Location loc = convOp.getLoc();
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    Value input = operandAdaptor.X();
+    Value filter = operandAdaptor.W();
+    Value bias = operandAdaptor.B();
+    bool hasBias = !bias.getType().isa<NoneType>();
+    Type elementType = memRefType.getElementType();
+    IndexExpr iZero = LiteralIndexExpr(0);
+
+    ArrayRef<int64_t> xShape = input.getType().cast<MemRefType>().getShape();
+    ArrayRef<int64_t> wShape = filter.getType().cast<MemRefType>().getShape();
+    ArrayRef<int64_t> yShape = memRefType.getShape();
+    int64_t N = yShape[0], C = yShape[1], HO = yShape[2], WO = yShape[3];
+    int64_t H = xShape[2], W = xShape[3], kH = wShape[2], kW = wShape[3];
+    int64_t sH = shapeHelper.strides[0], sW = shapeHelper.strides[1];
+    int64_t dH = shapeHelper.dilations[0], dW = shapeHelper.dilations[1];
+    int64_t pH = shapeHelper.pads[0].getLiteral();
+    int64_t pW = shapeHelper.pads[1].getLiteral();
+
+    // Zero padded plane, large enough for both the padded image and all the
+    // input windows. Its border is zeroed once and never written afterwards.
+    int64_t HP = std::max((HO - 1) * sH + (kH - 1) * dH + 1, pH + H);
+    int64_t WP = std::max((WO - 1) * sW + (kW - 1) * dW + 1, pW + W);
+    MemRefType planeType = MemRefType::get({HP, WP}, elementType);
+    Value plane = insertAllocAndDealloc(planeType, loc, rewriter,
+        /*insertDealloc=*/true, nullptr, BUFFER_ALIGN);
+    create.krnl.memset(plane, create.math.constant(elementType, 0));
+
+    ValueRange outerLoops = create.krnl.defineLoops(2);
+    create.krnl.iterateIE(outerLoops, outerLoops, {iZero, iZero},
+        {LiteralIndexExpr(N), LiteralIndexExpr(C)},
+        [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+          IndexExprScope outerScope(createKrnl);
+          MultiDialectBuilder<KrnlBuilder, MathBuilder> create(createKrnl);
+          DimIndexExpr n(outerIndices[0]), c(outerIndices[1]);
+
+          // Copy the image plane X[n, c] into the padded plane.
+          ValueRange copyLoops = create.krnl.defineLoops(2);
+          create.krnl.iterateIE(copyLoops, copyLoops, {iZero, iZero},
+              {LiteralIndexExpr(H), LiteralIndexExpr(W)},
+              [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                IndexExprScope copyScope(createKrnl);
+                DimIndexExpr h(indices[0]), w(indices[1]);
+                Value val = createKrnl.loadIE(input,
+                    {SymbolIndexExpr(n), SymbolIndexExpr(c), h, w});
+                createKrnl.storeIE(val, plane, {h + pH, w + pW});
+              });
+
+          // Keep the filter taps and the bias in registers.
+          SmallVector<Value, MAX_DEPTHWISE_TAPS> taps;
+          for (int64_t kh = 0; kh < kH; ++kh)
+            for (int64_t kw = 0; kw < kW; ++kw)
+              taps.emplace_back(create.krnl.loadIE(filter,
+                  {c, LiteralIndexExpr(0), LiteralIndexExpr(kh),
+                      LiteralIndexExpr(kw)}));
+          Value init = hasBias ? create.krnl.loadIE(bias, {c})
+                               : create.math.constant(elementType, 0);
+
+          // for ho = 0 .. HO:
+          //   for wo = 0 .. WO, blocked by DEPTHWISE_WIDTH_TILE:
+          //     Y[n, c, ho, wo] = B[c] +
+          //       sum_{kh, kw} W[c, 0, kh, kw] * P[ho*sH+kh*dH, wo*sW+kw*dW]
+          ValueRange outputLoops = create.krnl.defineLoops(2);
+          ValueRange woBlock =
+              create.krnl.block(outputLoops[1], DEPTHWISE_WIDTH_TILE);
+          create.krnl.iterateIE(outputLoops,
+              {outputLoops[0], woBlock[0], woBlock[1]}, {iZero, iZero},
+              {LiteralIndexExpr(HO), LiteralIndexExpr(WO)},
+              [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                IndexExprScope innerScope(createKrnl);
+                MathBuilder createMath(createKrnl);
+                // Indices are (ho, wo block start, wo).
+                DimIndexExpr ho(indices[0]), wo(indices[2]);
+                Value acc = init;
+                for (int64_t kh = 0; kh < kH; ++kh)
+                  for (int64_t kw = 0; kw < kW; ++kw) {
+                    Value val = createKrnl.loadIE(plane,
+                        {ho * sH + kh * dH, wo * sW + kw * dW});
+                    acc = createMath.add(
+                        acc, createMath.mul(taps[kh * kW + kw], val));
+                  }
+                SmallVector<IndexExpr, 4> yAccess = {
+                    SymbolIndexExpr(n), SymbolIndexExpr(c), ho, wo};
+                acc = epilogue.emitIE(rewriter, loc, acc, yAccess);
+                createKrnl.storeIE(acc, alloc, yAccess);
+              });
+        });
+  }
+
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     auto loc = op->getLoc();
@@ -215,15 +791,32 @@ struct ONNXConvOpLowering : public ConversionPattern {
     auto shapecomputed = shapeHelper.computeShape(operandAdaptor);
     assert(succeeded(shapecomputed));
 
+    // Elementwise ops following the convolution are applied to its output
+    // before it is stored, and the output is the one of the last op of that
+    // chain.
+    ElementwiseEpilogue epilogue(rewriter, op);
+
     // Insert an allocation and deallocation for the result of this operation.
     MemRefType memRefType = convertToMemRefType(*op->result_type_begin());
-    Value alloc = insertAllocAndDeallocSimple(
-        rewriter, op, memRefType, loc, shapeHelper.dimsForOutput(0));
+    Value alloc = insertAllocAndDeallocSimple(rewriter, epilogue.getLastOp(),
+        memRefType, loc, shapeHelper.dimsForOutput(0));
 
-    convUnoptimized(rewriter, shapeHelper.scope, convOp, operandAdaptor,
-        shapeHelper, memRefType, alloc);
+    int64_t winogradTileSize =
+        getWinogradTileSize(convOp, operandAdaptor, shapeHelper, memRefType);
+    if (winogradTileSize > 0)
+      convWinograd(rewriter, convOp, operandAdaptor, shapeHelper, memRefType,
+          alloc, winogradTileSize, epilogue);
+    else if (isPointwiseConv(convOp, operandAdaptor, shapeHelper, memRefType))
+      convPointwise(
+          rewriter, convOp, operandAdaptor, memRefType, alloc, epilogue);
+    else if (isDepthwiseConv(convOp, operandAdaptor, shapeHelper, memRefType))
+      convDepthwise(rewriter, convOp, operandAdaptor, shapeHelper, memRefType,
+          alloc, epilogue);
+    else
+      convUnoptimized(rewriter, shapeHelper.scope, convOp, operandAdaptor,
+          shapeHelper, memRefType, alloc, epilogue);
 
-    rewriter.replaceOp(op, alloc);
+    epilogue.replaceOps(rewriter, alloc);
     return success();
   }
 };
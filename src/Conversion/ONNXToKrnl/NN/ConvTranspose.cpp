@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------- ConvTranspose.cpp - Lowering ConvTranspose Op -------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX ConvTranspose Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+
+using namespace mlir;
+
+static constexpr int BUFFER_ALIGN = 128;
+
+// ConvTranspose of an image X [N x C x I1 x ... x Ir] with a filter
+// W [C x M/G x K1 x ... x Kr] in G groups scatters every input pixel, scaled
+// by the filter, into the output image Y [N x M x O1 x ... x Or]:
+//   Y[n, g*M/G + m, x*s + k*d - p] += X[n, g*C/G + c, x] * W[g*C/G + c, m, k]
+//
+// It is lowered as a GEMM followed by a col2im accumulation. For each image n
+// and group g:
+//   Col [M/G*K x I] = Wt[g] [M/G*K x C/G] x X[n, g] [C/G x I]
+// where K and I are the flattened kernel and input image sizes, and Wt is the
+// filter transposed once per call. Col2im then adds Col[m*K + k, x] to
+// Y[n, g*M/G + m, x*s + k*d - p] for the positions inside the output, which
+// is initialized with the bias. Output padding only enlarges the output.
+struct ONNXConvTransposeOpLowering : public ConversionPattern {
+  ONNXConvTransposeOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXConvTransposeOp::getOperationName(), 1, ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = op->getLoc();
+    ONNXConvTransposeOpAdaptor operandAdaptor(operands);
+    ONNXConvTransposeOp convTransposeOp = llvm::cast<ONNXConvTransposeOp>(op);
+    Value input = operandAdaptor.X();
+    Value filter = operandAdaptor.W();
+    Value bias = operandAdaptor.B();
+    bool hasBias = !bias.getType().isa<NoneType>();
+
+    // Only the batch size may be unknown at compile time.
+    MemRefType memRefType = convertToMemRefType(*op->result_type_begin());
+    Type elementType = memRefType.getElementType();
+    auto xType = input.getType().cast<MemRefType>();
+    auto wType = filter.getType().cast<MemRefType>();
+    int64_t rank = memRefType.getRank();
+    if (!wType.hasStaticShape() ||
+        getComputeElementType(elementType) != elementType)
+      return failure();
+    for (int64_t i = 1; i < rank; ++i)
+      if (xType.getShape()[i] < 0 || memRefType.getShape()[i] < 0)
+        return failure();
+
+    ArrayRef<int64_t> xShape = xType.getShape();
+    ArrayRef<int64_t> wShape = wType.getShape();
+    ArrayRef<int64_t> yShape = memRefType.getShape();
+    int64_t spatialRank = rank - 2;
+    int64_t G = convTransposeOp.group();
+    int64_t CPerGroup = xShape[1] / G;
+    int64_t MPerGroup = wShape[1];
+    int64_t K = 1, I = 1;
+    for (int64_t i = 2; i < rank; ++i) {
+      K *= wShape[i];
+      I *= xShape[i];
+    }
+    // Strides, dilations and pads are set by shape inference.
+    SmallVector<int64_t, 3> strides, dilations, pads;
+    for (int64_t i = 0; i < spatialRank; ++i) {
+      strides.emplace_back(ArrayAttrIntVal(convTransposeOp.strides(), i));
+      dilations.emplace_back(ArrayAttrIntVal(convTransposeOp.dilations(), i));
+      pads.emplace_back(ArrayAttrIntVal(convTransposeOp.pads(), i));
+    }
+
+    IndexExprScope scope(&rewriter, loc);
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    IndexExpr iZero = LiteralIndexExpr(0);
+    MemRefBoundsIndexCapture inputBounds(input);
+    IndexExpr N = inputBounds.getSymbol(0);
+    SmallVector<IndexExpr, 4> outputDims;
+    outputDims.emplace_back(N);
+    for (int64_t i = 1; i < rank; ++i)
+      outputDims.emplace_back(LiteralIndexExpr(yShape[i]));
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, outputDims);
+
+    // Initialize the output with the bias.
+    Value fZero = create.math.constant(elementType, 0);
+    if (hasBias) {
+      ValueRange initLoops = create.krnl.defineLoops(rank);
+      SmallVector<IndexExpr, 4> initLbs(rank, iZero);
+      create.krnl.iterateIE(initLoops, initLoops, initLbs, outputDims,
+          [&](KrnlBuilder &createKrnl, ValueRange indices) {
+            Value b = createKrnl.load(bias, {indices[1]});
+            createKrnl.store(b, alloc, indices);
+          });
+    } else {
+      create.krnl.memset(alloc, fZero);
+    }
+
+    // Transposed filter Wt [G x M/G*K x C/G], from the view W [C x M/G*K].
+    SmallVector<IndexExpr, 2> wDims = {
+        LiteralIndexExpr(G * CPerGroup), LiteralIndexExpr(MPerGroup * K)};
+    Value W = emitMemRefReinterpretCastOp(rewriter, loc, filter,
+        MemRefType::get({G * CPerGroup, MPerGroup * K}, elementType), wDims);
+    MemRefType wtType =
+        MemRefType::get({G, MPerGroup * K, CPerGroup}, elementType);
+    Value Wt = insertAllocAndDealloc(
+        wtType, loc, rewriter, /*insertDealloc=*/true, nullptr, BUFFER_ALIGN);
+    ValueRange transposeLoops = create.krnl.defineLoops(3);
+    create.krnl.iterateIE(transposeLoops, transposeLoops,
+        {iZero, iZero, iZero},
+        {LiteralIndexExpr(G), LiteralIndexExpr(CPerGroup),
+            LiteralIndexExpr(MPerGroup * K)},
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope transposeScope(createKrnl);
+          DimIndexExpr g(indices[0]), c(indices[1]), r(indices[2]);
+          Value val = createKrnl.loadIE(W, {g * CPerGroup + c, r});
+          createKrnl.storeIE(val, Wt, {g, r, c});
+        });
+
+    // View X [N x G x C/G x I] of the input image, and Col buffer.
+    SmallVector<IndexExpr, 4> xDims = {N, LiteralIndexExpr(G),
+        LiteralIndexExpr(CPerGroup), LiteralIndexExpr(I)};
+    Value X = emitMemRefReinterpretCastOp(rewriter, loc, input,
+        MemRefType::get({xShape[0], G, CPerGroup, I}, elementType), xDims);
+    MemRefType colType = MemRefType::get({MPerGroup * K, I}, elementType);
+    Value col = insertAllocAndDealloc(
+        colType, loc, rewriter, /*insertDealloc=*/true, nullptr, BUFFER_ALIGN);
+
+    Value zero = create.math.constantIndex(0);
+    ValueRange outerLoops = create.krnl.defineLoops(2);
+    create.krnl.iterateIE(outerLoops, outerLoops, {iZero, iZero},
+        {N, LiteralIndexExpr(G)},
+        [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+          IndexExprScope outerScope(createKrnl);
+          Value n(outerIndices[0]), g(outerIndices[1]);
+
+          // Col = Wt[g] x X[n, g].
+          createKrnl.memset(col, fZero);
+          emitTiledMatmul(createKrnl, Wt, {g, zero, zero}, X,
+              {n, g, zero, zero}, col, {zero, zero},
+              LiteralIndexExpr(MPerGroup * K), LiteralIndexExpr(I),
+              LiteralIndexExpr(CPerGroup));
+
+          // Col2im, with the bounds of x such that 0 <= x*s + k*d - p < O:
+          // for m = 0 .. M/G, k1 = 0 .. K1, ..., kr = 0 .. Kr:
+          //   for xi = max(ceil((pi - ki*di) / si), 0) ..
+          //            min(ceil((Oi + pi - ki*di) / si), Ii):
+          //     Y[n, g*M/G + m, x*s + k*d - p] += Col[m*K + k, x]
+          ValueRange kernelLoops = createKrnl.defineLoops(spatialRank + 1);
+          SmallVector<IndexExpr, 4> kernelLbs(
+              spatialRank + 1, LiteralIndexExpr(0));
+          SmallVector<IndexExpr, 4> kernelUbs;
+          kernelUbs.emplace_back(LiteralIndexExpr(MPerGroup));
+          for (int64_t i = 0; i < spatialRank; ++i)
+            kernelUbs.emplace_back(LiteralIndexExpr(wShape[2 + i]));
+          createKrnl.iterateIE(kernelLoops, kernelLoops, kernelLbs, kernelUbs,
+              [&](KrnlBuilder &createKrnl, ValueRange kernelIndices) {
+                IndexExprScope kernelScope(createKrnl);
+                DimIndexExpr m(kernelIndices[0]);
+                IndexExpr row = m;
+                SmallVector<IndexExpr, 3> imageLbs, imageUbs, kdMinusP;
+                for (int64_t i = 0; i < spatialRank; ++i) {
+                  DimIndexExpr k(kernelIndices[1 + i]);
+                  row = row * wShape[2 + i] + k;
+                  IndexExpr kd = k * dilations[i] - pads[i];
+                  imageLbs.emplace_back(IndexExpr::max(
+                      (LiteralIndexExpr(0) - kd).ceilDiv(strides[i]), 0));
+                  imageUbs.emplace_back(IndexExpr::min(
+                      (LiteralIndexExpr(yShape[2 + i]) - kd)
+                          .ceilDiv(strides[i]),
+                      xShape[2 + i]));
+                  kdMinusP.emplace_back(kd);
+                }
+                ValueRange imageLoops = createKrnl.defineLoops(spatialRank);
+                createKrnl.iterateIE(imageLoops, imageLoops, imageLbs,
+                    imageUbs, [&](KrnlBuilder &createKrnl, ValueRange x) {
+                      IndexExprScope imageScope(createKrnl);
+                      MathBuilder createMath(createKrnl);
+                      SmallVector<IndexExpr, 5> outputAccess;
+                      outputAccess.emplace_back(SymbolIndexExpr(n));
+                      outputAccess.emplace_back(
+                          SymbolIndexExpr(g) * MPerGroup + SymbolIndexExpr(m));
+                      IndexExpr column = LiteralIndexExpr(0);
+                      for (int64_t i = 0; i < spatialRank; ++i) {
+                        DimIndexExpr xi(x[i]);
+                        column = column * xShape[2 + i] + xi;
+                        outputAccess.emplace_back(
+                            xi * strides[i] + SymbolIndexExpr(kdMinusP[i]));
+                      }
+                      Value val = createKrnl.loadIE(
+                          col, {SymbolIndexExpr(row), column});
+                      Value res = createKrnl.loadIE(alloc, outputAccess);
+                      createKrnl.storeIE(
+                          createMath.add(res, val), alloc, outputAccess);
+                    });
+              });
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXConvTransposeOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXConvTransposeOpLowering>(typeConverter, ctx);
+}
@@ -0,0 +1,428 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===--------------- NCHWc.cpp - Lowering NCHW<b>c Ops --------------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ops on channel blocked NCHW<b>c tensors, introduced by
+// the NCHWc layout pass, to Krnl dialect. In these kernels, the innermost loop
+// iterates over the b channels of a block, which are contiguous in the input,
+// the output and the packed filter, and have a compile time trip count.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+
+using namespace mlir;
+
+static constexpr int BUFFER_ALIGN = 128;
+
+// Output size of a window op along one spatial dimension:
+//   O = floor((I + pBegin + pEnd - ((K - 1) * d + 1)) / s) + 1
+static IndexExpr getWindowOutputDim(IndexExpr I, int64_t K, int64_t pBegin,
+    int64_t pEnd, int64_t s, int64_t d) {
+  return (I + (pBegin + pEnd - ((K - 1) * d + 1))).floorDiv(s) + 1;
+}
+
+// Compute the range [lb, ub) of the kernel positions k along one spatial
+// dimension for which the input position o * s + k * d - p is inside the
+// input image of size I, as in the lowering of ONNXConvOp. Also return
+// p - o * s, so that the input position is k * d - pMinOS.
+static void getWindowBounds(IndexExpr o, IndexExpr I, int64_t K, int64_t p,
+    int64_t s, int64_t d, IndexExpr &lb, IndexExpr &ub, IndexExpr &pMinOS) {
+  pMinOS = LiteralIndexExpr(p) - (o * s);
+  // lb = ceil((p - o * s) / d)
+  lb = IndexExpr::max(pMinOS.ceilDiv(d), 0);
+  // ub = ceil((I + p - o * s) / d)
+  ub = IndexExpr::min((I + pMinOS).ceilDiv(d), K);
+}
+
+//===----------------------------------------------------------------------===//
+// LayoutTransform
+//===----------------------------------------------------------------------===//
+
+struct ONNXLayoutTransformOpLowering : public ConversionPattern {
+  ONNXLayoutTransformOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXLayoutTransformOp::getOperationName(), 1, ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = op->getLoc();
+    ONNXLayoutTransformOpAdaptor operandAdaptor(operands);
+    ONNXLayoutTransformOp transformOp = cast<ONNXLayoutTransformOp>(op);
+    Value input = operandAdaptor.data();
+    MemRefType memRefType = convertToMemRefType(*op->result_type_begin());
+    bool toBlocked = getNCHWcBlockSize(transformOp.target_layout()) > 0;
+
+    IndexExprScope scope(&rewriter, loc);
+    MemRefBoundsIndexCapture inputBounds(input);
+    SmallVector<IndexExpr, 5> inputDims, outputDims;
+    inputBounds.getDimList(inputDims);
+    int64_t blockSize;
+    if (toBlocked) {
+      // [N x C x H x W] -> [N x C/b x H x W x b]
+      blockSize = memRefType.getShape()[4];
+      outputDims = {inputDims[0], inputDims[1].floorDiv(blockSize),
+          inputDims[2], inputDims[3], LiteralIndexExpr(blockSize)};
+    } else {
+      // [N x C/b x H x W x b] -> [N x C x H x W]
+      blockSize = input.getType().cast<MemRefType>().getShape()[4];
+      outputDims = {inputDims[0], inputDims[1] * blockSize, inputDims[2],
+          inputDims[3]};
+    }
+    assert(blockSize > 0 && "expected a static block size");
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, outputDims, BUFFER_ALIGN);
+
+    // Iterate over the blocked tensor, so that the innermost loop walks
+    // contiguously over the channels of a block.
+    const SmallVectorImpl<IndexExpr> &blockedDims =
+        toBlocked ? outputDims : inputDims;
+    KrnlBuilder createKrnl(rewriter, loc);
+    ValueRange loopDef = createKrnl.defineLoops(5);
+    SmallVector<IndexExpr, 5> lbs(5, LiteralIndexExpr(0));
+    createKrnl.iterateIE(loopDef, loopDef, lbs, blockedDims,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope innerScope(createKrnl);
+          // Channel c = cb * b + cl of the NCHW tensor.
+          DimIndexExpr cb(indices[1]), cl(indices[4]);
+          SmallVector<IndexExpr, 4> nchwIndices = {DimIndexExpr(indices[0]),
+              cb * blockSize + cl, DimIndexExpr(indices[2]),
+              DimIndexExpr(indices[3])};
+          if (toBlocked) {
+            Value val = createKrnl.loadIE(input, nchwIndices);
+            createKrnl.store(val, alloc, indices);
+          } else {
+            Value val = createKrnl.load(input, indices);
+            createKrnl.storeIE(val, alloc, nchwIndices);
+          }
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// ConvNCHWc
+//===----------------------------------------------------------------------===//
+
+struct ONNXConvNCHWcOpLowering : public ConversionPattern {
+  ONNXConvNCHWcOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(
+            typeConverter, mlir::ONNXConvNCHWcOp::getOperationName(), 1, ctx) {}
+
+  // Pack the filter W [M x C x kH x kW] into
+  // [M/b x C/b x kH x kW x b (ci) x b (co)], so that the b output channels
+  // of a block are contiguous for a given input channel.
+  Value packFilter(ConversionPatternRewriter &rewriter, Location loc,
+      Operation *op, Value filter, int64_t blockSize) const {
+    MemRefBoundsIndexCapture filterBounds(filter);
+    SmallVector<IndexExpr, 6> packedDims = {
+        filterBounds.getDim(0).floorDiv(blockSize),
+        filterBounds.getDim(1).floorDiv(blockSize), filterBounds.getDim(2),
+        filterBounds.getDim(3), LiteralIndexExpr(blockSize),
+        LiteralIndexExpr(blockSize)};
+    SmallVector<int64_t, 6> packedShape;
+    IndexExpr::getShape(packedDims, packedShape);
+    MemRefType packedType = MemRefType::get(
+        packedShape, filter.getType().cast<MemRefType>().getElementType());
+    Value packed = insertAllocAndDeallocSimple(
+        rewriter, op, packedType, loc, packedDims, true, BUFFER_ALIGN);
+
+    KrnlBuilder createKrnl(rewriter, loc);
+    ValueRange loopDef = createKrnl.defineLoops(6);
+    SmallVector<IndexExpr, 6> lbs(6, LiteralIndexExpr(0));
+    createKrnl.iterateIE(loopDef, loopDef, lbs, packedDims,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope innerScope(createKrnl);
+          DimIndexExpr cob(indices[0]), cib(indices[1]), ci(indices[4]),
+              co(indices[5]);
+          Value val = createKrnl.loadIE(filter,
+              {cob * blockSize + co, cib * blockSize + ci,
+                  DimIndexExpr(indices[2]), DimIndexExpr(indices[3])});
+          createKrnl.store(val, packed, indices);
+        });
+    return packed;
+  }
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = op->getLoc();
+    ONNXConvNCHWcOpAdaptor operandAdaptor(operands);
+    ONNXConvNCHWcOp convOp = cast<ONNXConvNCHWcOp>(op);
+    Value input = operandAdaptor.X();
+    Value bias = operandAdaptor.B();
+    bool hasBias = !bias.getType().isa<NoneType>();
+    MemRefType memRefType = convertToMemRefType(*op->result_type_begin());
+    int64_t blockSize = memRefType.getShape()[4];
+    assert(blockSize > 0 && "expected a static block size");
+    // Half precision data is accumulated in f32.
+    Type computeType = getComputeElementType(memRefType.getElementType());
+
+    int64_t K[2], pBegin[2], s[2], d[2];
+    for (int i = 0; i < 2; ++i) {
+      K[i] = ArrayAttrIntVal(convOp.kernel_shape(), i);
+      pBegin[i] = ArrayAttrIntVal(convOp.pads(), i);
+      s[i] = ArrayAttrIntVal(convOp.strides(), i);
+      d[i] = ArrayAttrIntVal(convOp.dilations(), i);
+    }
+
+    // Output Y: [N x M/b x HO x WO x b].
+    IndexExprScope scope(&rewriter, loc);
+    MemRefBoundsIndexCapture inputBounds(input);
+    MemRefBoundsIndexCapture filterBounds(operandAdaptor.W());
+    IndexExpr CIB = inputBounds.getDim(1);
+    SmallVector<IndexExpr, 5> outputDims = {inputBounds.getDim(0),
+        filterBounds.getDim(0).floorDiv(blockSize)};
+    for (int i = 0; i < 2; ++i)
+      outputDims.emplace_back(
+          getWindowOutputDim(inputBounds.getDim(2 + i), K[i], pBegin[i],
+              ArrayAttrIntVal(convOp.pads(), 2 + i), s[i], d[i]));
+    outputDims.emplace_back(LiteralIndexExpr(blockSize));
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, outputDims, BUFFER_ALIGN);
+
+    Value filter =
+        packFilter(rewriter, loc, op, operandAdaptor.W(), blockSize);
+
+    // for n = 0 .. N, cob = 0 .. M/b, ho = 0 .. HO, wo = 0 .. WO:
+    //   acc[0 .. b] = B[cob * b .. cob * b + b] or 0
+    //   for cib = 0 .. C/b, kh = lb .. ub, kw = lb .. ub, ci = 0 .. b:
+    //     x = X[n, cib, kh * dh - (ph - ho * sh), kw * dw - (pw - wo * sw), ci]
+    //     for co = 0 .. b:
+    //       acc[co] += x * Wp[cob, cib, kh, kw, ci, co]
+    //   Y[n, cob, ho, wo, 0 .. b] = acc[0 .. b]
+    KrnlBuilder createKrnl(rewriter, loc);
+    Value fZero = MathBuilder(createKrnl).constant(computeType, 0);
+    IndexExpr iZero = LiteralIndexExpr(0);
+    IndexExpr B = LiteralIndexExpr(blockSize);
+    ValueRange outerLoops = createKrnl.defineLoops(4);
+    SmallVector<IndexExpr, 4> outerLbs(4, iZero);
+    SmallVector<IndexExpr, 4> outerUbs(
+        outputDims.begin(), outputDims.end() - 1);
+    createKrnl.iterateIE(outerLoops, outerLoops, outerLbs, outerUbs,
+        [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+          IndexExprScope outerScope(createKrnl);
+          MemRefBuilder createMemRef(createKrnl);
+          DimIndexExpr cob(outerIndices[1]);
+          // Accumulators of the b output channels of the block.
+          Value acc = createMemRef.alignedAlloca(
+              MemRefType::get({blockSize}, computeType), BUFFER_ALIGN);
+          ValueRange initLoop = createKrnl.defineLoops(1);
+          createKrnl.iterateIE(initLoop, initLoop, {iZero}, {B},
+              [&](KrnlBuilder &createKrnl, ValueRange coIndex) {
+                IndexExprScope coScope(createKrnl);
+                MathBuilder createMath(createKrnl);
+                Value init = fZero;
+                if (hasBias) {
+                  DimIndexExpr cl(coIndex[0]);
+                  IndexExpr co = SymbolIndexExpr(cob) * blockSize + cl;
+                  init = createMath.cast(
+                      computeType, createKrnl.loadIE(bias, {co}));
+                }
+                createKrnl.store(init, acc, coIndex);
+              });
+
+          // Reduction over the input channels and the kernel window.
+          SmallVector<IndexExpr, 4> redLbs = {iZero};
+          SmallVector<IndexExpr, 4> redUbs = {SymbolIndexExpr(CIB)};
+          IndexExpr pMinOS[2];
+          for (int i = 0; i < 2; ++i) {
+            IndexExpr lb, ub;
+            getWindowBounds(DimIndexExpr(outerIndices[2 + i]),
+                SymbolIndexExpr(inputBounds.getDim(2 + i)), K[i], pBegin[i],
+                s[i], d[i], lb, ub, pMinOS[i]);
+            redLbs.emplace_back(lb);
+            redUbs.emplace_back(ub);
+          }
+          redLbs.emplace_back(iZero);
+          redUbs.emplace_back(B);
+          ValueRange redLoops = createKrnl.defineLoops(4);
+          createKrnl.iterateIE(redLoops, redLoops, redLbs, redUbs,
+              [&](KrnlBuilder &createKrnl, ValueRange redIndices) {
+                IndexExprScope redScope(createKrnl);
+                MathBuilder createMath(createKrnl);
+                DimIndexExpr kh(redIndices[1]), kw(redIndices[2]);
+                SmallVector<IndexExpr, 5> inputAccessFct = {
+                    SymbolIndexExpr(outerIndices[0]),
+                    DimIndexExpr(redIndices[0]),
+                    kh * d[0] - SymbolIndexExpr(pMinOS[0]),
+                    kw * d[1] - SymbolIndexExpr(pMinOS[1]),
+                    DimIndexExpr(redIndices[3])};
+                Value image = createMath.cast(
+                    computeType, createKrnl.loadIE(input, inputAccessFct));
+                ValueRange coLoop = createKrnl.defineLoops(1);
+                createKrnl.iterateIE(coLoop, coLoop, {iZero}, {B},
+                    [&](KrnlBuilder &createKrnl, ValueRange coIndex) {
+                      MathBuilder createMath(createKrnl);
+                      Value w = createMath.cast(computeType,
+                          createKrnl.load(filter,
+                              {outerIndices[1], redIndices[0], redIndices[1],
+                                  redIndices[2], redIndices[3], coIndex[0]}));
+                      Value oldAcc = createKrnl.load(acc, coIndex);
+                      Value newAcc =
+                          createMath.add(oldAcc, createMath.mul(image, w));
+                      createKrnl.store(newAcc, acc, coIndex);
+                    });
+              });
+
+          ValueRange storeLoop = createKrnl.defineLoops(1);
+          createKrnl.iterateIE(storeLoop, storeLoop, {iZero}, {B},
+              [&](KrnlBuilder &createKrnl, ValueRange coIndex) {
+                MathBuilder createMath(createKrnl);
+                Value res = createMath.cast(memRefType.getElementType(),
+                    createKrnl.load(acc, coIndex));
+                createKrnl.store(res, alloc,
+                    {outerIndices[0], outerIndices[1], outerIndices[2],
+                        outerIndices[3], coIndex[0]});
+              });
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// PoolNCHWc
+//===----------------------------------------------------------------------===//
+
+struct ONNXPoolNCHWcOpLowering : public ConversionPattern {
+  ONNXPoolNCHWcOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(
+            typeConverter, mlir::ONNXPoolNCHWcOp::getOperationName(), 1, ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = op->getLoc();
+    ONNXPoolNCHWcOpAdaptor operandAdaptor(operands);
+    ONNXPoolNCHWcOp poolOp = cast<ONNXPoolNCHWcOp>(op);
+    Value input = operandAdaptor.X();
+    MemRefType memRefType = convertToMemRefType(*op->result_type_begin());
+    Type elementType = memRefType.getElementType();
+    Type computeType = getComputeElementType(elementType);
+    int64_t blockSize = memRefType.getShape()[4];
+    assert(blockSize > 0 && "expected a static block size");
+    bool isMax = poolOp.mode() == "max";
+    bool countIncludePad = poolOp.count_include_pad() == 1;
+
+    int64_t K[2], pBegin[2], s[2];
+    for (int i = 0; i < 2; ++i) {
+      K[i] = ArrayAttrIntVal(poolOp.kernel_shape(), i);
+      pBegin[i] = ArrayAttrIntVal(poolOp.pads(), i);
+      s[i] = ArrayAttrIntVal(poolOp.strides(), i);
+    }
+
+    // Output Y: [N x C/b x HO x WO x b].
+    IndexExprScope scope(&rewriter, loc);
+    MemRefBoundsIndexCapture inputBounds(input);
+    SmallVector<IndexExpr, 5> outputDims = {
+        inputBounds.getDim(0), inputBounds.getDim(1)};
+    for (int i = 0; i < 2; ++i)
+      outputDims.emplace_back(getWindowOutputDim(inputBounds.getDim(2 + i),
+          K[i], pBegin[i], ArrayAttrIntVal(poolOp.pads(), 2 + i), s[i], 1));
+    outputDims.emplace_back(LiteralIndexExpr(blockSize));
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, outputDims, BUFFER_ALIGN);
+
+    // for n = 0 .. N, cb = 0 .. C/b, ho = 0 .. HO, wo = 0 .. WO:
+    //   acc[0 .. b] = identity
+    //   for kh = lb .. ub, kw = lb .. ub, c = 0 .. b:
+    //     acc[c] = max/add(acc[c], X[n, cb, kh - (ph - ho * sh),
+    //                                kw - (pw - wo * sw), c])
+    //   Y[n, cb, ho, wo, 0 .. b] = acc[0 .. b] (divided by the count for avg)
+    KrnlBuilder createKrnl(rewriter, loc);
+    Value identity =
+        isMax ? emitNegativeInfinityConstantOp(rewriter, loc, computeType)
+              : emitConstantOp(rewriter, loc, computeType, 0);
+    IndexExpr iZero = LiteralIndexExpr(0);
+    IndexExpr B = LiteralIndexExpr(blockSize);
+    ValueRange outerLoops = createKrnl.defineLoops(4);
+    SmallVector<IndexExpr, 4> outerLbs(4, iZero);
+    SmallVector<IndexExpr, 4> outerUbs(
+        outputDims.begin(), outputDims.end() - 1);
+    createKrnl.iterateIE(outerLoops, outerLoops, outerLbs, outerUbs,
+        [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+          IndexExprScope outerScope(createKrnl);
+          MemRefBuilder createMemRef(createKrnl);
+          MathBuilder createMath(createKrnl);
+          Value acc = createMemRef.alignedAlloca(
+              MemRefType::get({blockSize}, computeType), BUFFER_ALIGN);
+          ValueRange initLoop = createKrnl.defineLoops(1);
+          createKrnl.iterateIE(initLoop, initLoop, {iZero}, {B},
+              [&](KrnlBuilder &createKrnl, ValueRange cIndex) {
+                createKrnl.store(identity, acc, cIndex);
+              });
+
+          SmallVector<IndexExpr, 3> redLbs, redUbs;
+          IndexExpr pMinOS[2];
+          for (int i = 0; i < 2; ++i) {
+            IndexExpr lb, ub;
+            getWindowBounds(DimIndexExpr(outerIndices[2 + i]),
+                SymbolIndexExpr(inputBounds.getDim(2 + i)), K[i], pBegin[i],
+                s[i], 1, lb, ub, pMinOS[i]);
+            redLbs.emplace_back(lb);
+            redUbs.emplace_back(ub);
+          }
+          // The window is always inside the padded image, as the output
+          // sizes are rounded down, so its size with pads is kH x kW.
+          IndexExpr count = countIncludePad
+                                ? LiteralIndexExpr(K[0] * K[1])
+                                : (redUbs[0] - redLbs[0]) *
+                                      (redUbs[1] - redLbs[1]);
+          redLbs.emplace_back(iZero);
+          redUbs.emplace_back(B);
+          ValueRange redLoops = createKrnl.defineLoops(3);
+          createKrnl.iterateIE(redLoops, redLoops, redLbs, redUbs,
+              [&](KrnlBuilder &createKrnl, ValueRange redIndices) {
+                IndexExprScope redScope(createKrnl);
+                MathBuilder createMath(createKrnl);
+                DimIndexExpr kh(redIndices[0]), kw(redIndices[1]);
+                SmallVector<IndexExpr, 5> inputAccessFct = {
+                    SymbolIndexExpr(outerIndices[0]),
+                    SymbolIndexExpr(outerIndices[1]),
+                    kh - SymbolIndexExpr(pMinOS[0]),
+                    kw - SymbolIndexExpr(pMinOS[1]),
+                    DimIndexExpr(redIndices[2])};
+                Value val = createMath.cast(
+                    computeType, createKrnl.loadIE(input, inputAccessFct));
+                Value oldAcc = createKrnl.load(acc, {redIndices[2]});
+                Value newAcc = isMax ? createMath.max(oldAcc, val)
+                                     : createMath.add(oldAcc, val);
+                createKrnl.store(newAcc, acc, {redIndices[2]});
+              });
+
+          Value divisor;
+          if (!isMax)
+            divisor = createMath.cast(computeType, count.getValue());
+          ValueRange storeLoop = createKrnl.defineLoops(1);
+          createKrnl.iterateIE(storeLoop, storeLoop, {iZero}, {B},
+              [&](KrnlBuilder &createKrnl, ValueRange cIndex) {
+                MathBuilder createMath(createKrnl);
+                Value res = createKrnl.load(acc, cIndex);
+                if (!isMax)
+                  res = createMath.div(res, divisor);
+                res = createMath.cast(elementType, res);
+                createKrnl.store(res, alloc,
+                    {outerIndices[0], outerIndices[1], outerIndices[2],
+                        outerIndices[3], cIndex[0]});
+              });
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXNCHWcOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXLayoutTransformOpLowering>(typeConverter, ctx);
+  patterns.insert<ONNXConvNCHWcOpLowering>(typeConverter, ctx);
+  patterns.insert<ONNXPoolNCHWcOpLowering>(typeConverter, ctx);
+}
@@ -285,9 +285,273 @@ struct ONNXInstanceNormalizationOpLowering : public ConversionPattern {
   }
 };
 
+// Number of independent partial sums accumulated for the statistics of a row
+// of LayerNormalization, so that the reduction loop can be vectorized.
+static constexpr int64_t LAYERNORM_LANES = 8;
+
+// Return a 1D view [D] of the Scale or B input of LayerNormalization, where D
+// is the product of the normalized dimensions innerDims of X. A parameter that
+// is broadcast along some of these dimensions is first expanded into a buffer.
+static Value flattenLayerNormParam(ConversionPatternRewriter &rewriter,
+    Location loc, Value param, SmallVectorImpl<IndexExpr> &innerDims,
+    IndexExpr D) {
+  MemRefType paramType = param.getType().cast<MemRefType>();
+  ArrayRef<int64_t> shape = paramType.getShape();
+  int64_t paramRank = shape.size();
+  int64_t innerRank = innerDims.size();
+  MemRefType flatType = MemRefType::get(
+      {D.isLiteral() ? D.getLiteral() : -1}, paramType.getElementType());
+  SmallVector<IndexExpr, 1> flatDims = {D};
+
+  bool isBroadcast = false;
+  for (int64_t i = 0; i < innerRank; ++i) {
+    int64_t p = paramRank - innerRank + i;
+    bool isInnerOne =
+        innerDims[i].isLiteral() && innerDims[i].getLiteral() == 1;
+    if ((p < 0 || shape[p] == 1) && !isInnerOne)
+      isBroadcast = true;
+  }
+  if (!isBroadcast)
+    return emitMemRefReinterpretCastOp(
+        rewriter, loc, param, flatType, flatDims);
+
+  KrnlBuilder createKrnl(rewriter, loc);
+  Value flat = insertAllocAndDeallocSimple(
+      rewriter, nullptr, flatType, loc, flatDims, /*insertDealloc=*/true);
+  ValueRange loops = createKrnl.defineLoops(innerRank);
+  SmallVector<IndexExpr, 4> lbs(innerRank, LiteralIndexExpr(0));
+  createKrnl.iterateIE(loops, loops, lbs, innerDims,
+      [&](KrnlBuilder &createKrnl, ValueRange indices) {
+        IndexExprScope expandScope(createKrnl);
+        IndexExpr flatIndex = LiteralIndexExpr(0);
+        SmallVector<IndexExpr, 4> paramAccess;
+        for (int64_t p = 0; p < paramRank - innerRank; ++p)
+          paramAccess.emplace_back(LiteralIndexExpr(0));
+        for (int64_t i = 0; i < innerRank; ++i) {
+          DimIndexExpr index(indices[i]);
+          flatIndex = flatIndex * SymbolIndexExpr(innerDims[i]) + index;
+          int64_t p = paramRank - innerRank + i;
+          if (p < 0)
+            continue;
+          if (shape[p] == 1)
+            paramAccess.emplace_back(LiteralIndexExpr(0));
+          else
+            paramAccess.emplace_back(index);
+        }
+        Value val = createKrnl.loadIE(param, paramAccess);
+        createKrnl.storeIE(val, flat, {flatIndex});
+      });
+  return flat;
+}
+
+struct ONNXLayerNormalizationOpLowering : public ConversionPattern {
+  ONNXLayerNormalizationOpLowering(
+      TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXLayerNormalizationOp::getOperationName(), 1, ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    // layer_normalization{axis, epsilon}(x, scale, bias) =
+    //      (x - mean) / sqrt(variance + epsilon) * scale + bias
+    // where mean and variance are computed over the dimensions [axis, rank).
+    //
+    // X is viewed as R rows of D normalized values, and each row is swept
+    // twice. The first sweep accumulates the sums of x - x0 and (x - x0)^2 in
+    // LAYERNORM_LANES independent lanes, where the first value x0 of the row
+    // shifts the data to avoid cancellation in the variance. The second sweep
+    // computes Y. Both sweeps are blocked by LAYERNORM_LANES.
+    ONNXLayerNormalizationOpAdaptor operandAdaptor(operands);
+    ONNXLayerNormalizationOp layerNormOp =
+        llvm::cast<ONNXLayerNormalizationOp>(op);
+    Location loc = op->getLoc();
+    Value input = operandAdaptor.X();
+    Value scale = operandAdaptor.Scale();
+    Value bias = operandAdaptor.B();
+    bool hasBias = !bias.getType().isa<NoneType>();
+    Value mean = layerNormOp.Mean();
+    Value invStdDev = layerNormOp.InvStdDev();
+    bool hasMean = !mean.getType().isa<NoneType>();
+    bool hasInvStdDev = !invStdDev.getType().isa<NoneType>();
+
+    MemRefType memRefType = convertToMemRefType(*op->result_type_begin());
+    Type elementType = memRefType.getElementType();
+    // Statistics of half precision data are accumulated in f32.
+    Type computeType = getComputeElementType(elementType);
+    int64_t rank = memRefType.getRank();
+    int64_t axis = layerNormOp.axis();
+    axis = axis >= 0 ? axis : rank + axis;
+
+    IndexExprScope scope(&rewriter, loc);
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    MemRefBoundsIndexCapture inputBounds(input);
+    SmallVector<IndexExpr, 4> outputDims, innerDims, statDims;
+    inputBounds.getDimList(outputDims);
+    IndexExpr R = LiteralIndexExpr(1);
+    IndexExpr D = LiteralIndexExpr(1);
+    for (int64_t i = 0; i < rank; ++i) {
+      if (i < axis) {
+        R = R * outputDims[i];
+        statDims.emplace_back(outputDims[i]);
+      } else {
+        D = D * outputDims[i];
+        innerDims.emplace_back(outputDims[i]);
+        statDims.emplace_back(LiteralIndexExpr(1));
+      }
+    }
+    int64_t staticR = R.isLiteral() ? R.getLiteral() : -1;
+    int64_t staticD = D.isLiteral() ? D.getLiteral() : -1;
+
+    // Views X, Y [R x D] of the input and output, and views [D] of the
+    // parameters.
+    Value alloc =
+        insertAllocAndDeallocSimple(rewriter, op, memRefType, loc, outputDims);
+    SmallVector<IndexExpr, 2> rowsDims = {R, D};
+    MemRefType rowsType = MemRefType::get({staticR, staticD}, elementType);
+    Value X = emitMemRefReinterpretCastOp(
+        rewriter, loc, input, rowsType, rowsDims);
+    Value Y = emitMemRefReinterpretCastOp(
+        rewriter, loc, alloc, rowsType, rowsDims);
+    Value scaleFlat = flattenLayerNormParam(rewriter, loc, scale, innerDims, D);
+    Value biasFlat =
+        hasBias ? flattenLayerNormParam(rewriter, loc, bias, innerDims, D)
+                : nullptr;
+
+    // Optional statistics, with views [R].
+    SmallVector<IndexExpr, 1> statRowsDims = {R};
+    Value meanAlloc = mean, meanRows;
+    if (hasMean) {
+      MemRefType meanType = convertToMemRefType(mean.getType());
+      meanAlloc = insertAllocAndDeallocSimple(rewriter, nullptr, meanType, loc,
+          statDims, checkInsertDealloc(op, 1));
+      meanRows = emitMemRefReinterpretCastOp(rewriter, loc, meanAlloc,
+          MemRefType::get({staticR}, meanType.getElementType()), statRowsDims);
+    }
+    Value invStdDevAlloc = invStdDev, invStdDevRows;
+    if (hasInvStdDev) {
+      MemRefType invStdDevType = convertToMemRefType(invStdDev.getType());
+      invStdDevAlloc = insertAllocAndDeallocSimple(rewriter, nullptr,
+          invStdDevType, loc, statDims, checkInsertDealloc(op, 2));
+      invStdDevRows = emitMemRefReinterpretCastOp(rewriter, loc,
+          invStdDevAlloc,
+          MemRefType::get({staticR}, invStdDevType.getElementType()),
+          statRowsDims);
+    }
+
+    Value fZero = create.math.constant(computeType, 0);
+    Value fOne = create.math.constant(computeType, 1);
+    Value epsilon = create.math.constant(
+        computeType, layerNormOp.epsilon().convertToDouble());
+    Value invD = create.math.div(
+        fOne, create.math.cast(computeType, D.getValue()));
+    MemRefType lanesType = MemRefType::get({2, LAYERNORM_LANES}, computeType);
+
+    ValueRange rowLoop = create.krnl.defineLoops(1);
+    create.krnl.iterateIE(rowLoop, rowLoop, {LiteralIndexExpr(0)}, {R},
+        [&](KrnlBuilder &createKrnl, ValueRange rowIndices) {
+          MultiDialectBuilder<KrnlBuilder, MemRefBuilder, MathBuilder> create(
+              createKrnl);
+          IndexExprScope rowScope(createKrnl);
+          Value row = rowIndices[0];
+          IndexExpr rowD = SymbolIndexExpr(D);
+
+          // First sweep: lanes[0, l] and lanes[1, l] accumulate x - x0 and
+          // (x - x0)^2 for the values x of the row with index l modulo
+          // LAYERNORM_LANES.
+          Value shift = create.math.cast(computeType,
+              create.krnl.load(X, {row, create.math.constantIndex(0)}));
+          Value lanes = create.mem.alloca(lanesType);
+          create.krnl.memset(lanes, fZero);
+          ValueRange sumLoop = create.krnl.defineLoops(1);
+          ValueRange sumBlock = create.krnl.block(sumLoop[0], LAYERNORM_LANES);
+          create.krnl.iterateIE(sumLoop, {sumBlock[0], sumBlock[1]},
+              {LiteralIndexExpr(0)}, {rowD},
+              [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                IndexExprScope sumScope(createKrnl);
+                MathBuilder createMath(createKrnl);
+                // Indices are (block start, d).
+                DimIndexExpr block(indices[0]), d(indices[1]);
+                IndexExpr lane = d - block;
+                Value x = createMath.cast(computeType,
+                    createKrnl.loadIE(X, {SymbolIndexExpr(row), d}));
+                x = createMath.sub(x, shift);
+                IndexExpr sumAccess[] = {LiteralIndexExpr(0), lane};
+                IndexExpr squareAccess[] = {LiteralIndexExpr(1), lane};
+                Value sum = createKrnl.loadIE(lanes, sumAccess);
+                Value square = createKrnl.loadIE(lanes, squareAccess);
+                createKrnl.storeIE(createMath.add(sum, x), lanes, sumAccess);
+                createKrnl.storeIE(createMath.add(square, createMath.mul(x, x)),
+                    lanes, squareAccess);
+              });
+
+          // Reduce the lanes, then
+          //   mean = x0 + sum / D
+          //   var = max(square / D - (sum / D)^2, 0)
+          Value sum = fZero, square = fZero;
+          for (int64_t l = 0; l < LAYERNORM_LANES; ++l) {
+            IndexExpr sumAccess[] = {LiteralIndexExpr(0), LiteralIndexExpr(l)};
+            IndexExpr squareAccess[] = {
+                LiteralIndexExpr(1), LiteralIndexExpr(l)};
+            sum = create.math.add(sum, create.krnl.loadIE(lanes, sumAccess));
+            square = create.math.add(
+                square, create.krnl.loadIE(lanes, squareAccess));
+          }
+          Value shiftedMean = create.math.mul(sum, invD);
+          Value variance = create.math.sub(create.math.mul(square, invD),
+              create.math.mul(shiftedMean, shiftedMean));
+          variance = create.math.max(variance, fZero);
+          Value rowMean = create.math.add(shift, shiftedMean);
+          Value rowInvStdDev = create.math.div(
+              fOne, create.math.sqrt(create.math.add(variance, epsilon)));
+          if (hasMean)
+            create.krnl.store(
+                create.math.cast(
+                    meanRows.getType().cast<MemRefType>().getElementType(),
+                    rowMean),
+                meanRows, {row});
+          if (hasInvStdDev)
+            create.krnl.store(
+                create.math.cast(
+                    invStdDevRows.getType().cast<MemRefType>().getElementType(),
+                    rowInvStdDev),
+                invStdDevRows, {row});
+
+          // Second sweep:
+          //   y = (x - mean) * invStdDev * scale + bias
+          ValueRange normLoop = create.krnl.defineLoops(1);
+          ValueRange normBlock =
+              create.krnl.block(normLoop[0], LAYERNORM_LANES);
+          create.krnl.iterateIE(normLoop, {normBlock[0], normBlock[1]},
+              {LiteralIndexExpr(0)}, {rowD},
+              [&](KrnlBuilder &createKrnl, ValueRange indices) {
+                MathBuilder createMath(createKrnl);
+                Value d = indices[1];
+                Value x =
+                    createMath.cast(computeType, createKrnl.load(X, {row, d}));
+                Value s = createMath.cast(
+                    computeType, createKrnl.load(scaleFlat, {d}));
+                Value val = createMath.mul(
+                    createMath.sub(x, rowMean), rowInvStdDev);
+                val = createMath.mul(val, s);
+                if (hasBias) {
+                  Value b = createMath.cast(
+                      computeType, createKrnl.load(biasFlat, {d}));
+                  val = createMath.add(val, b);
+                }
+                createKrnl.store(
+                    createMath.cast(elementType, val), Y, {row, d});
+              });
+        });
+
+    rewriter.replaceOp(op, {alloc, meanAlloc, invStdDevAlloc});
+    return success();
+  }
+};
+
 void populateLoweringONNXNormalizationOpPattern(RewritePatternSet &patterns,
     TypeConverter &typeConverter, MLIRContext *ctx) {
   patterns.insert<ONNXBatchNormalizationInferenceModeOpLowering>(
       typeConverter, ctx);
   patterns.insert<ONNXInstanceNormalizationOpLowering>(typeConverter, ctx);
+  patterns.insert<ONNXLayerNormalizationOpLowering>(typeConverter, ctx);
 }
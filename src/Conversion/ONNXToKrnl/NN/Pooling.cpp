@@ -17,6 +17,8 @@
 
 using namespace mlir;
 
+static constexpr int BUFFER_ALIGN = 128;
+
 // Identity values
 template <>
 Value getIdentityValue<ONNXMaxPoolSingleOutOp>(
@@ -190,6 +192,17 @@ void postProcessPoolingWindow<ONNXAveragePoolOp>(
   rewriter.create<KrnlStoreOp>(loc, average, alloc, resultIndices);
 }
 
+//===----------------------------------------------------------------------===//
+// Helper function to compute the [start, end) input range covered by the
+// pooling window of output index `o` along one non-dilated dimension.
+//
+static std::vector<IndexExpr> getWindowRange(IndexExpr o, IndexExpr dim,
+    int64_t kernel, int64_t pad, int64_t stride, bool ceilMode) {
+  SmallVector<IndexExpr, 6> exprs = {o, dim, LiteralIndexExpr(kernel),
+      LiteralIndexExpr(pad), LiteralIndexExpr(stride), LiteralIndexExpr(1)};
+  return getIndexExprsForConvWindow(exprs, ceilMode, /*isDilated=*/false);
+}
+
 //===----------------------------------------------------------------------===//
 // Template function that does pooling.
 //
@@ -198,6 +211,198 @@ struct ONNXPoolOpLowering : public ConversionPattern {
   ONNXPoolOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
       : ConversionPattern(typeConverter, PoolOp::getOperationName(), 1, ctx) {}
 
+  // A 2D window without dilation can be reduced in two passes: a row pass
+  // reducing each input row along W into a [H x WO] buffer, and a column pass
+  // reducing that buffer along H into the output. Per output column, this
+  // costs about H * kW + HO * kH operations instead of HO * kH * kW, which is
+  // a win when sH * kW + kH < kH * kW (e.g. 3x3 windows with unit strides).
+  bool isSeparablePool2D(PoolOpShapeHelper &shapeHelper, int64_t inputRank,
+      Type elementType) const {
+    if (inputRank != 4 || shapeHelper.kernelShape.size() != 2)
+      return false;
+    // Partial reductions are kept in the output, so half precision data keeps
+    // using the scalar path.
+    if (!elementType.isF32() && !elementType.isF64())
+      return false;
+    for (int i = 0; i < 2; ++i)
+      if (shapeHelper.dilations[i] != 1 ||
+          !shapeHelper.kernelShape[i].isLiteral() ||
+          !shapeHelper.pads[i].isLiteral())
+        return false;
+    int64_t kH = shapeHelper.kernelShape[0].getLiteral();
+    int64_t kW = shapeHelper.kernelShape[1].getLiteral();
+    int64_t sH = shapeHelper.strides[0];
+    return sH * kW + kH < kH * kW;
+  }
+
+  // Separable 2D pooling. Both passes have a unit stride innermost loop over
+  // the output width, without per-element bound checks, so that it can be
+  // vectorized. Average pooling multiplies by reciprocals of the window sizes
+  // computed once per op (count_include_pad) or once per output row/column.
+  //
+  //   for n in range(N):
+  //     for c in range(C):
+  //       tmp[:, :] = identity
+  //       for h in range(H):
+  //         for kw in range(kW):
+  //           # Output columns whose window contains column wo * sW + kw - pW.
+  //           for wo in range(woLb(kw), woUb(kw)):
+  //             tmp[h, wo] = op(tmp[h, wo], input[n, c, h, wo * sW + kw - pW])
+  //       for ho in range(HO):
+  //         output[n, c, ho, :] = identity
+  //         for hi in range(startH(ho), endH(ho)):
+  //           for wo in range(WO):
+  //             output[n, c, ho, wo] = op(output[n, c, ho, wo], tmp[hi, wo])
+  //         # AveragePool only.
+  //         for wo in range(WO):
+  //           output[n, c, ho, wo] *= recipH(ho) * recipW[wo]
+  void separablePool2D(ConversionPatternRewriter &rewriter, Location loc,
+      PoolOp poolOp, Value input, Value alloc, PoolOpShapeHelper &shapeHelper,
+      bool ceilMode) const {
+    Operation *op = poolOp.getOperation();
+    MemRefType outputType = alloc.getType().cast<MemRefType>();
+    Type elementType = outputType.getElementType();
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    Value identity = getIdentityValue<PoolOp>(rewriter, loc, elementType);
+
+    MemRefBoundsIndexCapture inputBounds(input);
+    IndexExpr N = inputBounds.getSymbol(0);
+    IndexExpr C = inputBounds.getSymbol(1);
+    IndexExpr H = inputBounds.getSymbol(2);
+    IndexExpr W = inputBounds.getSymbol(3);
+    IndexExpr HO = SymbolIndexExpr(shapeHelper.dimsForOutput(0)[2]);
+    IndexExpr WO = SymbolIndexExpr(shapeHelper.dimsForOutput(0)[3]);
+    int64_t kH = shapeHelper.kernelShape[0].getLiteral();
+    int64_t kW = shapeHelper.kernelShape[1].getLiteral();
+    int64_t pH = shapeHelper.pads[0].getLiteral();
+    int64_t pW = shapeHelper.pads[1].getLiteral();
+    int64_t sH = shapeHelper.strides[0];
+    int64_t sW = shapeHelper.strides[1];
+    LiteralIndexExpr zero(0);
+
+    // Row pass buffer, reused for every (n, c) image.
+    int64_t hShape = input.getType().cast<MemRefType>().getShape()[2];
+    MemRefType tmpType =
+        MemRefType::get({hShape, outputType.getShape()[3]}, elementType);
+    SmallVector<IndexExpr, 2> tmpDims = {H, WO};
+    Value tmp = insertAllocAndDeallocSimple(
+        rewriter, op, tmpType, loc, tmpDims, (int64_t)BUFFER_ALIGN);
+
+    // Reciprocals of the window sizes for AveragePool.
+    bool isAverage = std::is_same<PoolOp, ONNXAveragePoolOp>::value;
+    bool countIncludePad = getCountIncludePad<PoolOp>(poolOp);
+    Value one = create.math.constant(elementType, 1);
+    Value recipKernel, recipW;
+    if (isAverage && countIncludePad) {
+      recipKernel = create.math.constant(elementType, 1.0 / (kH * kW));
+    } else if (isAverage) {
+      MemRefType recipType =
+          MemRefType::get({outputType.getShape()[3]}, elementType);
+      SmallVector<IndexExpr, 1> recipDims = {WO};
+      recipW = insertAllocAndDeallocSimple(
+          rewriter, op, recipType, loc, recipDims, (int64_t)BUFFER_ALIGN);
+      ValueRange woLoop = create.krnl.defineLoops(1);
+      create.krnl.iterateIE(woLoop, woLoop, {zero}, {WO},
+          [&](KrnlBuilder &createKrnl, ValueRange woIndex) {
+            IndexExprScope scope(createKrnl);
+            MathBuilder createMath(createKrnl);
+            std::vector<IndexExpr> window = getWindowRange(
+                DimIndexExpr(woIndex[0]), SymbolIndexExpr(W), kW, pW, sW,
+                ceilMode);
+            IndexExpr size = window[1] - window[0];
+            Value sizeVal = createMath.cast(elementType, size.getValue());
+            createKrnl.store(createMath.div(one, sizeVal), recipW, woIndex);
+          });
+    }
+
+    ValueRange outerLoops = create.krnl.defineLoops(2);
+    create.krnl.iterateIE(outerLoops, outerLoops, {zero, zero}, {N, C},
+        [&](KrnlBuilder &createKrnl, ValueRange ncIndices) {
+          Value n(ncIndices[0]), c(ncIndices[1]);
+          // Row pass.
+          createKrnl.memset(tmp, identity);
+          ValueRange rowLoops = createKrnl.defineLoops(2);
+          createKrnl.iterateIE(rowLoops, rowLoops, {zero, zero},
+              {SymbolIndexExpr(H), LiteralIndexExpr(kW)},
+              [&](KrnlBuilder &createKrnl, ValueRange hkIndices) {
+                IndexExprScope rowScope(createKrnl);
+                DimIndexExpr kw(hkIndices[1]);
+                // 0 <= wo * sW + kw - pW < W.
+                IndexExpr woLb = IndexExpr::max(
+                    (LiteralIndexExpr(pW) - kw).ceilDiv(sW), 0);
+                IndexExpr woUb = IndexExpr::min(
+                    (SymbolIndexExpr(W) + (pW - 1) - kw).floorDiv(sW) + 1,
+                    SymbolIndexExpr(WO));
+                ValueRange woLoop = createKrnl.defineLoops(1);
+                createKrnl.iterateIE(woLoop, woLoop, {woLb}, {woUb},
+                    [&](KrnlBuilder &createKrnl, ValueRange woIndex) {
+                      IndexExprScope innerScope(createKrnl);
+                      IndexExpr wi = DimIndexExpr(woIndex[0]) * sW +
+                                     DimIndexExpr(hkIndices[1]) - pW;
+                      Value x = createKrnl.loadIE(input,
+                          {DimIndexExpr(n), DimIndexExpr(c),
+                              DimIndexExpr(hkIndices[0]), wi});
+                      SmallVector<Value, 2> tmpIndices = {
+                          hkIndices[0], woIndex[0]};
+                      Value acc = createKrnl.load(tmp, tmpIndices);
+                      Value res = emitScalarOpFor<PoolOp>(
+                          rewriter, loc, op, elementType, {acc, x});
+                      createKrnl.store(res, tmp, tmpIndices);
+                    });
+              });
+          // Column pass.
+          ValueRange hoLoop = createKrnl.defineLoops(1);
+          createKrnl.iterateIE(hoLoop, hoLoop, {zero}, {SymbolIndexExpr(HO)},
+              [&](KrnlBuilder &createKrnl, ValueRange hoIndex) {
+                IndexExprScope colScope(createKrnl);
+                MathBuilder createMath(createKrnl);
+                Value ho(hoIndex[0]);
+                std::vector<IndexExpr> window = getWindowRange(
+                    DimIndexExpr(ho), SymbolIndexExpr(H), kH, pH, sH, ceilMode);
+                ValueRange initLoop = createKrnl.defineLoops(1);
+                createKrnl.iterateIE(initLoop, initLoop, {zero},
+                    {SymbolIndexExpr(WO)},
+                    [&](KrnlBuilder &createKrnl, ValueRange woIndex) {
+                      createKrnl.store(identity, alloc, {n, c, ho, woIndex[0]});
+                    });
+                ValueRange colLoops = createKrnl.defineLoops(2);
+                createKrnl.iterateIE(colLoops, colLoops, {window[0], zero},
+                    {window[1], SymbolIndexExpr(WO)},
+                    [&](KrnlBuilder &createKrnl, ValueRange hwIndices) {
+                      SmallVector<Value, 4> outIndices = {
+                          n, c, ho, hwIndices[1]};
+                      Value t = createKrnl.load(tmp, hwIndices);
+                      Value acc = createKrnl.load(alloc, outIndices);
+                      Value res = emitScalarOpFor<PoolOp>(
+                          rewriter, loc, op, elementType, {acc, t});
+                      createKrnl.store(res, alloc, outIndices);
+                    });
+                if (!isAverage)
+                  return;
+                Value recipH;
+                if (!countIncludePad) {
+                  IndexExpr size = window[1] - window[0];
+                  recipH = createMath.div(
+                      one, createMath.cast(elementType, size.getValue()));
+                }
+                ValueRange scaleLoop = createKrnl.defineLoops(1);
+                createKrnl.iterateIE(scaleLoop, scaleLoop, {zero},
+                    {SymbolIndexExpr(WO)},
+                    [&](KrnlBuilder &createKrnl, ValueRange woIndex) {
+                      MathBuilder createMath(createKrnl);
+                      SmallVector<Value, 4> outIndices = {n, c, ho, woIndex[0]};
+                      Value scale = recipKernel;
+                      if (!countIncludePad)
+                        scale = createMath.mul(
+                            recipH, createKrnl.load(recipW, woIndex));
+                      Value sum = createKrnl.load(alloc, outIndices);
+                      createKrnl.store(
+                          createMath.mul(sum, scale), alloc, outIndices);
+                    });
+              });
+        });
+  }
+
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     PoolOpAdaptor operandAdaptor(operands);
@@ -238,6 +443,13 @@ struct ONNXPoolOpLowering : public ConversionPattern {
     Value alloc = insertAllocAndDeallocSimple(
         rewriter, op, memRefType, loc, shapeHelper.dimsForOutput(0));
 
+    if (isSeparablePool2D(shapeHelper, inputShape.size(), outputElementType)) {
+      separablePool2D(rewriter, loc, poolOp, inputOperand, alloc, shapeHelper,
+          ceilMode);
+      rewriter.replaceOp(op, alloc);
+      return success();
+    }
+
     // input = Pool(output)
     //
     // The input/output shapes will look like this:
@@ -14,6 +14,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Dialect/ONNX/ShapeInference/ONNXShapeHelper.hpp"
 
 bool gEmitDealloc = true;
 
@@ -128,6 +129,12 @@ MemRefType convertToMemRefType(Type type) {
       memRefType.getShape(), convertElemType(memRefType.getElementType()));
 }
 
+Type getComputeElementType(Type elementType) {
+  if (elementType.isF16() || elementType.isBF16())
+    return FloatType::getF32(elementType.getContext());
+  return elementType;
+}
+
 /// Insert an allocation and deallocation for the given MemRefType.
 Value insertAllocAndDealloc(MemRefType type, Location loc,
     PatternRewriter &rewriter, bool insertDealloc, Value operand,
@@ -215,9 +222,9 @@ Value insertAllocAndDeallocSimple(PatternRewriter &rewriter, Operation *op,
 }
 
 // Determine if current function returns the result value of the
-// current op or the result value of reinterpret_cast op whose
-// operand is the result value of current op. If it does then
-// dealloc should not be inserted.
+// current op or the result value of an op lowered to a view of it,
+// such as reinterpret_cast. If it does then dealloc should not be
+// inserted.
 bool checkInsertDealloc(Operation *currentOp, int resultIndex) {
   if (gEmitDealloc == false)
     return false;
@@ -225,44 +232,84 @@ bool checkInsertDealloc(Operation *currentOp, int resultIndex) {
   auto parentBlock = currentOp->getBlock();
   bool insertDealloc = true;
 
-  // Check if the result value of `currentOp` is an operand of
-  // `ReinterpretCastOp`, and store the result value of `ReinterpretCastOp`.
-  // Reshape, Squeeze, and Unsqueeze ops are checked because they are lowered to
-  // `ReinterpretCastOp`.
-  SmallVector<Value, 32> castOpResults;
-  if (currentOp->getNumResults() > 0) {
-    parentBlock->walk([currentOp, resultIndex, &castOpResults](Operation *op) {
-      if (isa<memref::ReinterpretCastOp>(op) || isa<ONNXReshapeOp>(op) ||
-          isa<ONNXSqueezeV11Op>(op) || isa<ONNXUnsqueezeV11Op>(op) ||
-          isa<ONNXSqueezeOp>(op) || isa<ONNXUnsqueezeOp>(op)) {
-        auto result = currentOp->getResult(resultIndex);
-        for (const auto &operand : op->getOperands())
-          if (operand == result)
-            castOpResults.emplace_back(op->getResults()[0]);
-      }
-    });
+  // Collect the result value of `currentOp` and the results of the ops that
+  // are lowered to views of it, e.g. `ReinterpretCastOp`, since they share
+  // its buffer. Views of views are followed as well.
+  SmallVector<Value, 32> aliases;
+  if (currentOp->getNumResults() > 0)
+    aliases.emplace_back(currentOp->getResult(resultIndex));
+  for (unsigned int i = 0; i < aliases.size(); ++i) {
+    Value alias = aliases[i];
+    for (Operation *user : alias.getUsers())
+      if (user->getNumResults() > 0 && user->getOperand(0) == alias &&
+          isLoweredToView(user))
+        aliases.emplace_back(user->getResult(0));
   }
-  // If there is at least one result to investigate.
-  if (currentOp->getNumResults() > 0) {
-    parentBlock->walk(
-        [&insertDealloc, currentOp, resultIndex, &castOpResults](ReturnOp op) {
-          auto result = currentOp->getResult(resultIndex);
-          for (const auto &operand : op.getOperands()) {
-            // Determine if current function returns the result value of the
-            // current op.
-            if (operand == result)
-              insertDealloc = false;
-            // Determin if the result value of reinterpret_cast op whose operand
-            // is the result value of current op
-            for (const auto &castOpResult : castOpResults)
-              if (operand == castOpResult)
-                insertDealloc = false;
-          }
-        });
+  // Determine if current function returns the result value of the current op
+  // or a view of it.
+  if (!aliases.empty()) {
+    parentBlock->walk([&insertDealloc, &aliases](ReturnOp op) {
+      for (const auto &operand : op.getOperands())
+        if (llvm::is_contained(aliases, operand))
+          insertDealloc = false;
+    });
   }
   return insertDealloc;
 }
 
+bool isLoweredToView(Operation *op) {
+  if (isa<memref::ReinterpretCastOp, ONNXReshapeOp, ONNXSqueezeOp,
+          ONNXSqueezeV11Op, ONNXUnsqueezeOp, ONNXUnsqueezeV11Op,
+          ONNXIdentityOp>(op))
+    return true;
+  if (auto flattenOp = dyn_cast<ONNXFlattenOp>(op))
+    return !isViewOfBlockArgument(flattenOp.input());
+  if (auto sliceOp = dyn_cast<ONNXSliceOp>(op)) {
+    if (isViewOfBlockArgument(sliceOp.data()))
+      return false;
+    ONNXSliceOpAdaptor operandAdaptor(sliceOp);
+    ONNXSliceOpShapeHelper shapeHelper(&sliceOp);
+    if (failed(shapeHelper.computeShape(operandAdaptor)))
+      return false;
+    return isContiguousPrefixSlice(shapeHelper.starts, shapeHelper.steps,
+        shapeHelper.dimsForOutput(0), sliceOp.data());
+  }
+  return false;
+}
+
+bool isViewOfBlockArgument(Value value) {
+  while (!value.isa<BlockArgument>()) {
+    Operation *op = value.getDefiningOp();
+    if (!op || op->getNumOperands() == 0 || !isLoweredToView(op))
+      return false;
+    value = op->getOperand(0);
+  }
+  return true;
+}
+
+bool isContiguousPrefixSlice(ArrayRef<IndexExpr> starts,
+    ArrayRef<IndexExpr> steps, ArrayRef<IndexExpr> outputDims, Value data) {
+  MemRefBoundsIndexCapture dataBounds(data);
+  int64_t rank = outputDims.size();
+  // Leading output dims of size 1 select a single row, whatever their step.
+  int64_t k = 0;
+  while (k < rank && outputDims[k].isLiteralAndIdenticalTo(1))
+    ++k;
+  for (int64_t i = 0; i < rank; ++i) {
+    if (!starts[i].isLiteralAndIdenticalTo(0))
+      return false;
+    if (i < k)
+      continue;
+    if (!steps[i].isLiteralAndIdenticalTo(1))
+      return false;
+    // Past the first sliced dim, dims must be kept whole.
+    if (i > k && (!dataBounds.isLiteral(i) || !outputDims[i].isLiteral() ||
+                     dataBounds.getShape(i) != outputDims[i].getLiteral()))
+      return false;
+  }
+  return true;
+}
+
 // Create a mapping from result type's dimensions to input type's dimensions,
 // given that the result type is the result of a reduction op over the input
 // type.
@@ -328,6 +375,11 @@ Value emitPositiveInfinityConstantOp(
         float value = std::numeric_limits<float>::infinity();
         constantAttr = rewriter.getF16FloatAttr(value);
       })
+      .Case<BFloat16Type>([&](Type) {
+        // 0x7F80
+        float value = std::numeric_limits<float>::infinity();
+        constantAttr = rewriter.getFloatAttr(type, value);
+      })
       .Case<Float32Type>([&](Type) {
         // 0x7F800000
         float value = std::numeric_limits<float>::infinity();
@@ -398,6 +450,11 @@ Value emitNegativeInfinityConstantOp(
         float value = -std::numeric_limits<float>::infinity();
         constantAttr = rewriter.getF16FloatAttr(value);
       })
+      .Case<BFloat16Type>([&](Type) {
+        // 0xFF80
+        float value = -std::numeric_limits<float>::infinity();
+        constantAttr = rewriter.getFloatAttr(type, value);
+      })
       .Case<Float32Type>([&](Type) {
         // 0xFF800000
         float value = -std::numeric_limits<float>::infinity();
@@ -642,6 +699,44 @@ Value emitMemRefReinterpretCastOp(ConversionPatternRewriter &rewriter,
   return newView;
 }
 
+/// Emit C += A x B for matrices starting at aStart, bStart and cStart, with
+/// the register tiling of the 2D MatMul lowering.
+void emitTiledMatmul(KrnlBuilder &createKrnl, Value A, ValueRange aStart,
+    Value B, ValueRange bStart, Value C, ValueRange cStart, IndexExpr I,
+    IndexExpr J, IndexExpr K) {
+  // Update tiling for very small sizes known at compile time.
+  int64_t iRegTile(4), jRegTile(8), kRegTile(8);
+  if (I.isLiteral())
+    iRegTile = std::min(iRegTile, I.getLiteral());
+  if (J.isLiteral()) {
+    int64_t constJ = J.getLiteral();
+    if (constJ % jRegTile != 0 && constJ % 4 == 0 && constJ <= 32)
+      jRegTile = 4;
+  }
+  if (K.isLiteral())
+    kRegTile = std::min(kRegTile, K.getLiteral());
+
+  MathBuilder createMath(createKrnl);
+  Value zero = createMath.constantIndex(0);
+  Value iUB(I.getValue()), jUB(J.getValue()), kUB(K.getValue());
+  ValueRange origLoop = createKrnl.defineLoops(3);
+  Value ii(origLoop[0]), jj(origLoop[1]), kk(origLoop[2]);
+  ValueRange iRegBlock = createKrnl.block(ii, iRegTile);
+  Value ii1(iRegBlock[0]), ii2(iRegBlock[1]);
+  ValueRange jRegBlock = createKrnl.block(jj, jRegTile);
+  Value jj1(jRegBlock[0]), jj2(jRegBlock[1]);
+  ValueRange kRegBlock = createKrnl.block(kk, kRegTile);
+  Value kk1(kRegBlock[0]), kk2(kRegBlock[1]);
+  createKrnl.permute({ii1, ii2, jj1, jj2, kk1, kk2}, {0, 3, 1, 4, 2, 5});
+  createKrnl.iterate({ii, jj, kk}, {ii1, jj1, kk1}, {zero, zero, zero},
+      {iUB, jUB, kUB}, [&](KrnlBuilder &createKrnl, ValueRange indices) {
+        Value i1(indices[0]), j1(indices[1]), k1(indices[2]);
+        createKrnl.matmul(A, aStart, B, bStart, C, cStart, {ii2, jj2, kk2},
+            {i1, j1, k1}, {iUB, jUB, kUB}, {iRegTile, jRegTile, kRegTile}, {},
+            {}, {}, /*simd*/ true, /*unroll*/ true, /*overcompute*/ false);
+      });
+}
+
 /// Emit krnl iterate to compute argsort of a given MemRef along a given axis.
 /// Output MemRef has the same shape as the input MemRef but is of IndexType.
 /// By default, sort values in the descending order.
@@ -747,6 +842,174 @@ Value getOptionalScalarValue(ConversionPatternRewriter &rewriter, Location loc,
   }
 }
 
+// Runs of contiguous elements shorter than this are copied element by element
+// rather than with a memcpy call.
+static constexpr int64_t MIN_MEMCPY_ELEMS = 16;
+
+IndexExpr getNumElementsFrom(MemRefBoundsIndexCapture &bounds, int64_t from) {
+  IndexExpr numElems = LiteralIndexExpr(1);
+  for (int64_t i = from; i < (int64_t)bounds.getRank(); ++i)
+    numElems = numElems * bounds.getSymbol(i);
+  return numElems;
+}
+
+bool isWorthMemcpy(Value memref, IndexExpr runSize) {
+  MemRefType type = memref.getType().cast<MemRefType>();
+  Type elementType = type.getElementType();
+  if (!type.getLayout().isIdentity() || !elementType.isIntOrFloat() ||
+      elementType.getIntOrFloatBitWidth() % 8 != 0)
+    return false;
+  return !runSize.isLiteral() || runSize.getLiteral() >= MIN_MEMCPY_ELEMS;
+}
+
+void emitRowRunCopy(KrnlBuilder &createKrnl, Value dest, Value src,
+    ArrayRef<IndexExpr> outerUbs, IndexExpr runSize, IndexExpr destRowSize,
+    IndexExpr destStart, IndexExpr srcRowSize, IndexExpr srcStart) {
+  int64_t outerRank = outerUbs.size();
+  if (outerRank == 0) {
+    createKrnl.memcpyIE(dest, src, runSize, destStart, srcStart);
+    return;
+  }
+  SmallVector<IndexExpr, 4> lbs(outerRank, LiteralIndexExpr(0));
+  ValueRange loopDef = createKrnl.defineLoops(outerRank);
+  createKrnl.iterateIE(loopDef, loopDef, lbs, outerUbs,
+      [&](KrnlBuilder &createKrnl, ValueRange indices) {
+        IndexExprScope scope(createKrnl);
+        IndexExpr row = LiteralIndexExpr(0);
+        for (int64_t i = 0; i < outerRank; ++i)
+          row = row * SymbolIndexExpr(outerUbs[i]) + DimIndexExpr(indices[i]);
+        IndexExpr destOffset =
+            row * SymbolIndexExpr(destRowSize) + SymbolIndexExpr(destStart);
+        IndexExpr srcOffset =
+            row * SymbolIndexExpr(srcRowSize) + SymbolIndexExpr(srcStart);
+        createKrnl.memcpyIE(
+            dest, src, SymbolIndexExpr(runSize), destOffset, srcOffset);
+      });
+}
+
+//===----------------------------------------------------------------------===//
+// Elementwise epilogues.
+//===----------------------------------------------------------------------===//
+
+/// Return the lowered value of `v` if it is defined before `op`, so that it
+/// can be loaded while lowering `op`, or null otherwise.
+static Value getLoweredValueBefore(
+    ConversionPatternRewriter &rewriter, Value v, Operation *op) {
+  bool isDefinedBefore;
+  if (v.getParentBlock() == op->getBlock()) {
+    Operation *def = v.getDefiningOp();
+    isDefinedBefore = !def || def->isBeforeInBlock(op);
+  } else {
+    isDefinedBefore =
+        v.getParentRegion()->isProperAncestor(op->getParentRegion());
+  }
+  if (!isDefinedBefore)
+    return nullptr;
+  Value lowered = rewriter.getRemappedValue(v);
+  if (!lowered || !lowered.getType().isa<MemRefType>())
+    return nullptr;
+  return lowered;
+}
+
+ElementwiseEpilogue::ElementwiseEpilogue(
+    ConversionPatternRewriter &rewriter, Operation *op)
+    : op(op) {
+  Value res = op->getResult(0);
+  auto resType = res.getType().dyn_cast<RankedTensorType>();
+  if (!resType || !getComputeElementType(resType.getElementType()).isF32())
+    return;
+
+  while (res.hasOneUse()) {
+    Operation *user = *res.getUsers().begin();
+    if (user->getBlock() != op->getBlock() || user->getNumResults() != 1 ||
+        user->getResult(0).getType() != resType)
+      return;
+    SmallVector<Value, 2> extra;
+    if (auto clipOp = dyn_cast<ONNXClipOp>(user)) {
+      if (clipOp.input() != res)
+        return;
+      for (Value bound : {clipOp.min(), clipOp.max()}) {
+        if (bound.getType().isa<NoneType>()) {
+          extra.emplace_back(nullptr);
+          continue;
+        }
+        auto boundType = bound.getType().dyn_cast<RankedTensorType>();
+        if (!boundType || boundType.getRank() != 0)
+          return;
+        Value lowered = getLoweredValueBefore(rewriter, bound, op);
+        if (!lowered)
+          return;
+        extra.emplace_back(lowered);
+      }
+    } else if (auto addOp = dyn_cast<ONNXAddOp>(user)) {
+      // Dynamic shapes could hide a broadcast of either operand.
+      Value residual = (addOp.A() == res) ? addOp.B() : addOp.A();
+      if (residual.getType() != resType || !resType.hasStaticShape())
+        return;
+      Value lowered = getLoweredValueBefore(rewriter, residual, op);
+      if (!lowered)
+        return;
+      extra.emplace_back(lowered);
+    } else if (!isa<ONNXReluOp, ONNXLeakyReluOp, ONNXSigmoidOp>(user)) {
+      return;
+    }
+    ops.emplace_back(user);
+    extraOperands.emplace_back(extra);
+    res = user->getResult(0);
+  }
+}
+
+Value ElementwiseEpilogue::emit(ConversionPatternRewriter &rewriter,
+    Location loc, Value val, ValueRange indices) const {
+  if (ops.empty())
+    return val;
+  MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+  Type type = rewriter.getF32Type();
+  Value res = create.math.cast(type, val);
+  for (unsigned i = 0; i < ops.size(); ++i) {
+    Operation *user = ops[i];
+    ArrayRef<Value> extra = extraOperands[i];
+    if (isa<ONNXReluOp>(user)) {
+      res = emitScalarOpFor<ONNXReluOp>(rewriter, loc, user, type, {res});
+    } else if (isa<ONNXLeakyReluOp>(user)) {
+      res = emitScalarOpFor<ONNXLeakyReluOp>(rewriter, loc, user, type, {res});
+    } else if (isa<ONNXSigmoidOp>(user)) {
+      res = emitScalarOpFor<ONNXSigmoidOp>(rewriter, loc, user, type, {res});
+    } else if (isa<ONNXClipOp>(user)) {
+      // Same semantics as the Clip lowering.
+      if (extra[0]) {
+        Value min = create.math.cast(type, create.krnl.load(extra[0]));
+        res = create.math.select(create.math.slt(res, min), min, res);
+      }
+      if (extra[1]) {
+        Value max = create.math.cast(type, create.krnl.load(extra[1]));
+        res = create.math.select(create.math.slt(res, max), res, max);
+      }
+    } else {
+      Value residual =
+          create.math.cast(type, create.krnl.load(extra[0], indices));
+      res = create.math.add(res, residual);
+    }
+  }
+  return create.math.cast(val.getType(), res);
+}
+
+Value ElementwiseEpilogue::emitIE(ConversionPatternRewriter &rewriter,
+    Location loc, Value val, ArrayRef<IndexExpr> indices) const {
+  if (ops.empty())
+    return val;
+  SmallVector<Value, 4> indexValues;
+  IndexExpr::getValues(indices, indexValues);
+  return emit(rewriter, loc, val, indexValues);
+}
+
+void ElementwiseEpilogue::replaceOps(
+    ConversionPatternRewriter &rewriter, Value alloc) const {
+  rewriter.replaceOp(op, alloc);
+  for (Operation *user : ops)
+    rewriter.replaceOp(user, alloc);
+}
+
 //===----------------------------------------------------------------------===//
 // Type conversion from Onnx types to Krnl types.
 //===----------------------------------------------------------------------===//
@@ -79,6 +79,11 @@ bool hasAllScalarValues(ArrayRef<Value> values);
 /// Get the corresponding MemRefType of a given TensorType/MemRefType.
 MemRefType convertToMemRefType(Type type);
 
+/// Get the element type used for computations on data of the given element
+/// type. Half precision types (f16, bf16) are computed in f32, other types
+/// are computed as is.
+Type getComputeElementType(Type elementType);
+
 /// Insert an allocation and deallocation for the given MemRefType.
 Value insertAllocAndDealloc(MemRefType type, Location loc,
     PatternRewriter &rewriter, bool insertDealloc, Value operand = nullptr,
@@ -100,6 +105,23 @@ Value insertAllocAndDeallocSimple(PatternRewriter &rewriter, Operation *op,
 // inserted.
 bool checkInsertDealloc(Operation *currentOp, int resultIndex = 0);
 
+// Return true if `op` is lowered to a view of its first operand, sharing the
+// buffer of that operand instead of copying it. Flatten and Slice are only
+// lowered to views of buffers that the function itself allocates.
+bool isLoweredToView(Operation *op);
+
+// Return true if `value` is a block argument, or a view of one through ops
+// lowered to views. Its buffer then belongs to the caller, so the entry point
+// must not return it in an output that the runtime frees.
+bool isViewOfBlockArgument(Value value);
+
+// Return true if a slice with the given starts, steps and output dims selects
+// a contiguous prefix of `data`: all starts are 0, the leading output dims are
+// 1, and the dims after the first sliced dim, which has a unit step, are kept
+// whole. Such slices are lowered to a view of `data`.
+bool isContiguousPrefixSlice(ArrayRef<IndexExpr> starts,
+    ArrayRef<IndexExpr> steps, ArrayRef<IndexExpr> outputDims, Value data);
+
 // Create a mapping from result type's dimensions to input type's dimensions,
 // given that the result type is the result of a reduction op over the input
 // type.
@@ -117,13 +139,13 @@ void defineLoops(ConversionPatternRewriter &rewriter, Location loc,
     std::vector<Value> &loops, int64_t numLoops);
 
 // Emit a positive infinity constant of a specific type.
-// Supported types: F16, F32, F64, Int8, Int16, Int32, Int64.
+// Supported types: F16, BF16, F32, F64, Int8, Int16, Int32, Int64.
 // In case of Integer, emit the maximum value.
 Value emitPositiveInfinityConstantOp(
     ConversionPatternRewriter &rewriter, Location loc, Type type);
 
 // Emit a negative infinity constant of a specific type.
-// Supported types: F16, F32, F64, Int8, Int16, Int32, Int64.
+// Supported types: F16, BF16, F32, F64, Int8, Int16, Int32, Int64.
 // In case of Float, emit the negative of the positive infinity.
 // In case of Integer, emit the minimum value.
 Value emitNegativeInfinityConstantOp(
@@ -163,6 +185,14 @@ Value emitMemRefReinterpretCastOp(ConversionPatternRewriter &rewriter,
     Location loc, Value data, const MemRefType &memRefType,
     const SmallVectorImpl<IndexExpr> &outputDims);
 
+/// Emit C += A x B for [I x K] x [K x J] matrices starting at aStart, bStart
+/// and cStart, whose leading indices select the matrices within higher rank
+/// buffers. The loops are register tiled as in the 2D MatMul lowering, with
+/// simdization along J, around a krnl.matmul.
+void emitTiledMatmul(KrnlBuilder &createKrnl, Value A, ValueRange aStart,
+    Value B, ValueRange bStart, Value C, ValueRange cStart, IndexExpr I,
+    IndexExpr J, IndexExpr K);
+
 /// Emit krnl iterate to compute argsort of a given MemRef along a given axis.
 /// Output MemRef has the same shape as the input MemRef but is of IndexType.
 Value emitArgSort(ConversionPatternRewriter &rewriter, Location loc,
@@ -215,6 +245,28 @@ Value emitScalarOpFor(ConversionPatternRewriter &rewriter, Location loc,
   }
 }
 
+// Round half to even, also used by the quantized ops. Defined in
+// Math/Elementwise.cpp.
+template <>
+Value emitScalarOpFor<ONNXRoundOp>(ConversionPatternRewriter &rewriter,
+    Location loc, Operation *op, Type elementType,
+    ArrayRef<Value> scalarOperands);
+
+// Activations also applied by the epilogues of the Gemm, MatMul and Conv
+// lowerings. Defined in Math/Elementwise.cpp.
+template <>
+Value emitScalarOpFor<ONNXReluOp>(ConversionPatternRewriter &rewriter,
+    Location loc, Operation *op, Type elementType,
+    ArrayRef<Value> scalarOperands);
+template <>
+Value emitScalarOpFor<ONNXLeakyReluOp>(ConversionPatternRewriter &rewriter,
+    Location loc, Operation *op, Type elementType,
+    ArrayRef<Value> scalarOperands);
+template <>
+Value emitScalarOpFor<ONNXSigmoidOp>(ConversionPatternRewriter &rewriter,
+    Location loc, Operation *op, Type elementType,
+    ArrayRef<Value> scalarOperands);
+
 //===----------------------------------------------------------------------===//
 // Type conversion from Onnx types to Krnl types:
 //   - from Tensor type to the Standard dialect MemRef type
@@ -288,8 +340,14 @@ void populateLoweringONNXCategoryMapperOpPattern(
     RewritePatternSet &, TypeConverter &, MLIRContext *);
 
 // `NN` directory methods:
+void populateLoweringONNXScaledDotProductAttentionOpPattern(
+    RewritePatternSet &, TypeConverter &, MLIRContext *);
 void populateLoweringONNXConvOpPattern(
     RewritePatternSet &, TypeConverter &, MLIRContext *);
+void populateLoweringONNXConvTransposeOpPattern(
+    RewritePatternSet &, TypeConverter &, MLIRContext *);
+void populateLoweringONNXNCHWcOpPattern(
+    RewritePatternSet &, TypeConverter &, MLIRContext *);
 void populateLoweringONNXNormalizationOpPattern(
     RewritePatternSet &, TypeConverter &, MLIRContext *);
 void populateLoweringONNXPoolingOpPattern(
@@ -299,6 +357,18 @@ void populateLoweringONNXPoolingOpPattern(
 void populateLoweringONNXNonMaxSuppressionOpPattern(
     RewritePatternSet &, TypeConverter &, MLIRContext *);
 
+// `Quantization` directory methods:
+void populateLoweringONNXDequantizeLinearOpPattern(
+    RewritePatternSet &, TypeConverter &, MLIRContext *);
+void populateLoweringONNXMatMulIntegerOpPattern(
+    RewritePatternSet &, TypeConverter &, MLIRContext *);
+void populateLoweringONNXQLinearConvOpPattern(
+    RewritePatternSet &, TypeConverter &, MLIRContext *);
+void populateLoweringONNXQLinearMatMulOpPattern(
+    RewritePatternSet &, TypeConverter &, MLIRContext *);
+void populateLoweringONNXQuantizeLinearOpPattern(
+    RewritePatternSet &, TypeConverter &, MLIRContext *);
+
 // `RNN` directory methods:
 void populateLoweringONNXGRUOpPattern(
     RewritePatternSet &, TypeConverter &, MLIRContext *);
@@ -399,3 +469,58 @@ Location ONNXLoc(Operation *op) {
 /// Default value is used in case of NoneType.
 Value getOptionalScalarValue(ConversionPatternRewriter &rewriter, Location loc,
     Value optionalScalar, Type elementType, double defaultValue);
+
+/// Return the number of elements in dimensions [from, rank) of the given
+/// bounds, i.e. the stride of dimension from-1 in an identity layout.
+IndexExpr getNumElementsFrom(MemRefBoundsIndexCapture &bounds, int64_t from);
+
+/// Return true when runs of `runSize` contiguous elements of `memref` should
+/// be moved with a krnl.memcpy rather than element by element. The memref
+/// must have an identity layout and byte sized numerical elements, and the
+/// run must not be known to be shorter than a few cache words.
+bool isWorthMemcpy(Value memref, IndexExpr runSize);
+
+/// Copy one contiguous run of `runSize` elements from `src` to `dest` for
+/// each index of the loops bounded by `outerUbs`. With L the row major
+/// linearized index of these loops, the runs start at element
+/// L * srcRowSize + srcStart of `src` and L * destRowSize + destStart of
+/// `dest`.
+void emitRowRunCopy(KrnlBuilder &createKrnl, Value dest, Value src,
+    ArrayRef<IndexExpr> outerUbs, IndexExpr runSize, IndexExpr destRowSize,
+    IndexExpr destStart, IndexExpr srcRowSize, IndexExpr srcStart);
+
+/// Chain of elementwise ops following a Gemm, MatMul or Conv op, which the
+/// lowering of that op applies to each output element before storing it,
+/// instead of having each op of the chain make its own pass over the output.
+/// The chain starts at the single user of the op result, each op of the chain
+/// is the single user of the previous one, and it ends before the first user
+/// that is not a Relu, LeakyRelu, Sigmoid, Clip with scalar bounds, or Add of
+/// a residual of the same static type. Extra operands must be lowered before
+/// the op. The chain is only collected for data computed in f32.
+class ElementwiseEpilogue {
+public:
+  ElementwiseEpilogue(ConversionPatternRewriter &rewriter, Operation *op);
+
+  bool empty() const { return ops.empty(); }
+
+  /// Return the last op of the chain, or the op itself if the chain is empty,
+  /// whose result is the one computed by the lowering.
+  Operation *getLastOp() const { return ops.empty() ? op : ops.back(); }
+
+  /// Apply the chain to `val`, the value of the output element at `indices`.
+  /// The chain is computed in f32 and the result has the type of `val`.
+  Value emit(ConversionPatternRewriter &rewriter, Location loc, Value val,
+      ValueRange indices) const;
+  Value emitIE(ConversionPatternRewriter &rewriter, Location loc, Value val,
+      ArrayRef<IndexExpr> indices) const;
+
+  /// Replace the op and all the ops of the chain by `alloc`.
+  void replaceOps(ConversionPatternRewriter &rewriter, Value alloc) const;
+
+private:
+  Operation *op;
+  SmallVector<Operation *, 4> ops;
+  // Lowered extra operands of each op of the chain: the residual of an Add,
+  // and the min and max of a Clip, null when absent.
+  SmallVector<SmallVector<Value, 2>, 4> extraOperands;
+};
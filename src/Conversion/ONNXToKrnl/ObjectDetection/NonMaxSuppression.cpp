@@ -17,64 +17,15 @@
 
 using namespace mlir;
 
-using AffineBuilderKrnlMem = GenericAffineBuilder<KrnlLoadOp, KrnlStoreOp>;
-
 /// Compute the intersection-over-union (IOU) score between two boxes.
-/// IOU tells us how much two boxes are overlapped.
+/// IOU tells us how much two boxes are overlapped. Boxes are given as
+/// [y_min, x_min, y_max, x_max] and their areas are precomputed.
 static Value emitIOU(MathBuilder &createMath, SmallVectorImpl<Value> &box1,
-    SmallVectorImpl<Value> &box2, int64_t centerPointBox = 0) {
-  Value area1, area2;
-  Value y1_min, x1_min, y1_max, x1_max;
-  Value y2_min, x2_min, y2_max, x2_max;
-  if (centerPointBox == 0) {
-    // The box data is supplied as [y1, x1, y2, x2]. (y1, x1) and (y2, x2)
-    // are the coordinates of the diagonal pair of bottom-left and top-right
-    // corners.
-    y1_min = box1[0];
-    x1_min = box1[1];
-    y1_max = box1[2];
-    x1_max = box1[3];
-
-    y2_min = box2[0];
-    x2_min = box2[1];
-    y2_max = box2[2];
-    x2_max = box2[3];
-
-    area1 = createMath.mul(
-        createMath.sub(y1_max, y1_min), createMath.sub(x1_max, x1_min));
-    area2 = createMath.mul(
-        createMath.sub(y2_max, y2_min), createMath.sub(x2_max, x2_min));
-  } else {
-    // The box data is supplied as [x_center, y_center, width, height].
-    Value x1_center = box1[0];
-    Value y1_center = box1[1];
-    Value w1 = box1[2];
-    Value h1 = box1[3];
-
-    Value x2_center = box2[0];
-    Value y2_center = box2[1];
-    Value w2 = box2[2];
-    Value h2 = box2[3];
-
-    Value two = createMath.constant(w1.getType(), 2);
-    x1_min = createMath.sub(x1_center, createMath.div(w1, two));
-    x1_max = createMath.add(x1_center, createMath.div(w1, two));
-    y1_min = createMath.sub(y1_center, createMath.div(h1, two));
-    y1_max = createMath.add(y1_center, createMath.div(h1, two));
-
-    y2_min = createMath.sub(y2_center, createMath.div(h2, two));
-    y2_max = createMath.add(y2_center, createMath.div(h2, two));
-    x2_min = createMath.sub(x2_center, createMath.div(w2, two));
-    x2_max = createMath.add(x2_center, createMath.div(w2, two));
-
-    area1 = createMath.mul(h1, w1);
-    area2 = createMath.mul(h2, w2);
-  }
-
-  Value intersection_x_min = createMath.max(x1_min, x2_min);
-  Value intersection_y_min = createMath.max(y1_min, y2_min);
-  Value intersection_x_max = createMath.min(x1_max, x2_max);
-  Value intersection_y_max = createMath.min(y1_max, y2_max);
+    Value area1, SmallVectorImpl<Value> &box2, Value area2) {
+  Value intersection_y_min = createMath.max(box1[0], box2[0]);
+  Value intersection_x_min = createMath.max(box1[1], box2[1]);
+  Value intersection_y_max = createMath.min(box1[2], box2[2]);
+  Value intersection_x_max = createMath.min(box1[3], box2[3]);
 
   Value zero = createMath.constant(intersection_x_min.getType(), 0);
   Value intersection_w = createMath.sub(intersection_x_max, intersection_x_min);
@@ -155,11 +106,15 @@ static void suppressByScores(ConversionPatternRewriter &rewriter, Location loc,
   create.krnl.store(create.math.min(x, y), maxOutputPerClass, {});
 }
 
-/// Bounding boxes may contain a mix of flipped and non-flipped boxes. Try to
-/// flip the flipped boxes back.
+/// Convert bounding boxes into [y_min, x_min, y_max, x_max] corners and
+/// compute their areas, once per box instead of once per IOU.
+/// Boxes given as diagonal corners may contain a mix of flipped and non-flipped
+/// boxes. The flipped boxes are flipped back.
 /// BoundingBoxes: [num_of_batch, spatial_dimension, 4]
-static Value tryToUnflip(
-    ConversionPatternRewriter &rewriter, Location loc, Value boundingBoxes) {
+/// Areas: [num_of_batch, spatial_dimension]
+static Value emitBoxCornersAndAreas(ConversionPatternRewriter &rewriter,
+    Location loc, Operation *op, Value boundingBoxes, int64_t centerPointBox,
+    Value &areas) {
   KrnlBuilder createKrnl(rewriter, loc);
   MemRefBoundsIndexCapture bbBounds(boundingBoxes);
   IndexExpr bs = bbBounds.getDim(0); // batch size.
@@ -168,36 +123,63 @@ static Value tryToUnflip(
   bbBounds.getDimList(ubs);
   LiteralIndexExpr zero(0), one(1), two(2), three(3);
 
-  Value resMemRef = insertAllocAndDeallocSimple(rewriter, nullptr,
-      boundingBoxes.getType().cast<MemRefType>(), loc, ubs,
-      /*insertDealloc=*/false);
+  MemRefType bbType = boundingBoxes.getType().cast<MemRefType>();
+  Value resMemRef = insertAllocAndDeallocSimple(
+      rewriter, op, bbType, loc, ubs, /*insertDealloc=*/true);
+  SmallVector<IndexExpr, 2> areaDims = {bs, ss};
+  MemRefType areaType = MemRefType::get(
+      {bbType.getShape()[0], bbType.getShape()[1]}, bbType.getElementType());
+  areas = insertAllocAndDeallocSimple(
+      rewriter, op, areaType, loc, areaDims, /*insertDealloc=*/true);
 
   ValueRange loopDef = createKrnl.defineLoops(2);
   createKrnl.iterateIE(loopDef, loopDef, {zero, zero}, {bs, ss},
       [&](KrnlBuilder &createKrnl, ValueRange loopInd) {
         MathBuilder createMath(createKrnl);
         DimIndexExpr b(loopInd[0]), s(loopInd[1]);
-        // Load a bounding box.
-        Value y_min = createKrnl.loadIE(boundingBoxes, {b, s, zero});
-        Value x_min = createKrnl.loadIE(boundingBoxes, {b, s, one});
-        Value y_max = createKrnl.loadIE(boundingBoxes, {b, s, two});
-        Value x_max = createKrnl.loadIE(boundingBoxes, {b, s, three});
-
-        // Flip x.
-        Value gtX = createMath.sgt(x_min, x_max);
-        Value newXMin = createMath.select(gtX, x_max, x_min);
-        Value newXMax = createMath.select(gtX, x_min, x_max);
-
-        // Flip y.
-        Value gtY = createMath.sgt(y_min, y_max);
-        Value newYMin = createMath.select(gtY, y_max, y_min);
-        Value newYMax = createMath.select(gtY, y_min, y_max);
+        Value newYMin, newXMin, newYMax, newXMax;
+        if (centerPointBox == 0) {
+          // The box data is supplied as [y1, x1, y2, x2]. (y1, x1) and
+          // (y2, x2) are the coordinates of the diagonal pair of bottom-left
+          // and top-right corners.
+          Value y_min = createKrnl.loadIE(boundingBoxes, {b, s, zero});
+          Value x_min = createKrnl.loadIE(boundingBoxes, {b, s, one});
+          Value y_max = createKrnl.loadIE(boundingBoxes, {b, s, two});
+          Value x_max = createKrnl.loadIE(boundingBoxes, {b, s, three});
+
+          // Flip x.
+          Value gtX = createMath.sgt(x_min, x_max);
+          newXMin = createMath.select(gtX, x_max, x_min);
+          newXMax = createMath.select(gtX, x_min, x_max);
+
+          // Flip y.
+          Value gtY = createMath.sgt(y_min, y_max);
+          newYMin = createMath.select(gtY, y_max, y_min);
+          newYMax = createMath.select(gtY, y_min, y_max);
+        } else {
+          // The box data is supplied as [x_center, y_center, width, height].
+          Value x_center = createKrnl.loadIE(boundingBoxes, {b, s, zero});
+          Value y_center = createKrnl.loadIE(boundingBoxes, {b, s, one});
+          Value w = createKrnl.loadIE(boundingBoxes, {b, s, two});
+          Value h = createKrnl.loadIE(boundingBoxes, {b, s, three});
+
+          Value two = createMath.constant(w.getType(), 2);
+          Value halfW = createMath.div(w, two);
+          Value halfH = createMath.div(h, two);
+          newXMin = createMath.sub(x_center, halfW);
+          newXMax = createMath.add(x_center, halfW);
+          newYMin = createMath.sub(y_center, halfH);
+          newYMax = createMath.add(y_center, halfH);
+        }
 
         // Update the bounding box.
         createKrnl.storeIE(newYMin, resMemRef, {b, s, zero});
         createKrnl.storeIE(newXMin, resMemRef, {b, s, one});
         createKrnl.storeIE(newYMax, resMemRef, {b, s, two});
         createKrnl.storeIE(newXMax, resMemRef, {b, s, three});
+        Value area = createMath.mul(createMath.sub(newYMax, newYMin),
+            createMath.sub(newXMax, newXMin));
+        createKrnl.storeIE(area, areas, {b, s});
       });
   return resMemRef;
 }
@@ -263,7 +245,6 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
     Value two = create.math.constantIndex(2);
     Value three = create.math.constantIndex(3);
     Value falseVal = create.math.constant(boolType, 0);
-    Value trueVal = create.math.constant(boolType, 1);
 
     // Refine the number of output boxes per class by suppressing it using
     // spatial dimension size and score threshold.
@@ -275,13 +256,10 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
     suppressByScores(rewriter, loc, scores, scoreTH, maxOutputPerClass);
     Value MOPC = create.krnl.load(maxOutputPerClass, {});
 
-    // Sort scores in the descending order.
-    Value order = emitArgSort(rewriter, loc, scores, /*axis=*/2);
-
-    // Bounding boxes may contain a mix of flipped and non-flipped boxes. Try to
-    // unflip the flipped boxes.
-    if (centerPointBox == 0)
-      boxes = tryToUnflip(rewriter, loc, boxes);
+    // Convert the boxes into unflipped corners and compute their areas.
+    Value areas;
+    Value corners = emitBoxCornersAndAreas(
+        rewriter, loc, op, boxes, centerPointBox, areas);
 
     // The total number of output selected indices.
     IndexExpr numSelectedIndicesIE = bsIE * csIE * DimIndexExpr(MOPC);
@@ -301,145 +279,155 @@ struct ONNXNonMaxSuppressionOpLowering : public ConversionPattern {
     Value selectedMemRef = insertAllocAndDeallocSimple(rewriter, op,
         MemRefType::get(outputShape, indexType), loc, outputDims,
         /*insertDealloc=*/true);
-    // Initialize with value -1.
-    create.krnl.memset(selectedMemRef, create.math.constantIndex(-1));
 
     // Effective number of selected indices. This is the final value for the 1st
     // dim of the output, which is suppressed by IOU during computation and
-    // cannot be computed in advance.
+    // cannot be computed in advance. Selected indices are stored contiguously,
+    // so this is also the position of the next selected index.
     // Final output shape : [effective_num_selected_indices, 3]
     Value effectiveNumSelectedIndices =
         create.mem.alloca(MemRefType::get({}, indexType));
     create.krnl.store(zero, effectiveNumSelectedIndices, {});
 
-    // Suppress by using IOU.
-    // Iterate over all bounding boxes in the descending order of scores.
+    // Buffers reused for every class:
+    // - candidates: indices of the boxes whose score > score_threshold,
+    //   sorted lazily in the descending order of scores.
+    // - selectedBoxes, selectedAreas: the boxes selected so far, stored as a
+    //   structure of arrays so that the IOU loop has unit stride accesses.
+    DimIndexExpr ssDimIE(ss);
+    int64_t ssShape = ssDimIE.isLiteral() ? ssDimIE.getLiteral() : -1;
+    SmallVector<IndexExpr, 1> ssDims = {ssDimIE};
+    SmallVector<IndexExpr, 2> boxDims = {LiteralIndexExpr(4), ssDimIE};
+    Value candidates = insertAllocAndDeallocSimple(rewriter, op,
+        MemRefType::get({ssShape}, indexType), loc, ssDims,
+        /*insertDealloc=*/true);
+    Value selectedBoxes = insertAllocAndDeallocSimple(rewriter, op,
+        MemRefType::get({4, ssShape}, scoreType), loc, boxDims,
+        /*insertDealloc=*/true);
+    Value selectedAreas = insertAllocAndDeallocSimple(rewriter, op,
+        MemRefType::get({ssShape}, scoreType), loc, ssDims,
+        /*insertDealloc=*/true);
+    Value numCandidates = create.mem.alloca(MemRefType::get({}, indexType));
+    Value numSelected = create.mem.alloca(MemRefType::get({}, indexType));
+    Value isSuppressed = create.mem.alloca(MemRefType::get({}, boolType));
+
     ValueRange bcLoopDef = create.krnl.defineLoops(2);
     create.krnl.iterate(bcLoopDef, bcLoopDef, {zero, zero}, {bs, cs},
         [&](KrnlBuilder &createKrnl, ValueRange bcLoopInd) {
-          MultiDialectBuilder<KrnlBuilder, MathBuilder, MemRefBuilder> create(
+          MultiDialectBuilder<KrnlBuilder, MathBuilder, SCFBuilder> create(
               createKrnl);
-          // Keep trace of the number of output boxes per class.
-          Value effectiveMaxOutputPerClass =
-              create.mem.alloca(MemRefType::get({}, indexType));
-          create.krnl.store(zero, effectiveMaxOutputPerClass, {});
-          // Keep trace of removed indices per class.
-          DimIndexExpr ssIE(ss);
-          SmallVector<IndexExpr, 1> dims = {ssIE};
-          SmallVector<int64_t, 1> shapes = {-1};
-          if (ssIE.isLiteral())
-            shapes[0] = ssIE.getLiteral();
-          Value removedIndices = insertAllocAndDeallocSimple(rewriter, nullptr,
-              MemRefType::get(shapes, boolType), loc, dims,
-              /*insertDealloc=*/true);
-          create.krnl.memset(removedIndices, falseVal);
-
-          // Iterate in the descending order of scores.
+          Value b(bcLoopInd[0]), c(bcLoopInd[1]);
+
+          // Only keep the boxes whose score > score_threshold, so that they
+          // are the only ones to be sorted and compared. The index is always
+          // written and the count only advances for kept boxes, so that this
+          // loop has no branch.
+          create.krnl.store(zero, numCandidates, {});
           ValueRange sLoopDef = create.krnl.defineLoops(1);
           create.krnl.iterate(sLoopDef, sLoopDef, {zero}, {ss},
               [&](KrnlBuilder &createKrnl, ValueRange sLoopInd) {
-                Value b(bcLoopInd[0]), c(bcLoopInd[1]), s(sLoopInd[0]);
-                AffineBuilderKrnlMem createAffine(createKrnl);
                 MathBuilder createMath(createKrnl);
-
-                // Index of the bounding box with the largest score.
-                Value selectedBI = createKrnl.load(order, {b, c, s});
-
-                // Check conditions to select a bounding box.
-                // 1. Only bounding boxes whose score > score_threshold.
-                Value score = createKrnl.load(scores, {b, c, selectedBI});
-                Value checkScore = createMath.sgt(score, scoreTH);
-                // 2. Have not yet got enough outputs.
-                Value currentMOPC =
-                    createKrnl.load(effectiveMaxOutputPerClass, {});
-                Value checkMOPC = createMath.slt(currentMOPC, MOPC);
-                // 3. Bounding box has not yet been removed.
-                Value isRemoved = createKrnl.load(removedIndices, {selectedBI});
-                Value isNotRemoved = createMath.eq(isRemoved, falseVal);
-
-                // Only proceed if the box satisfies the above conditions.
-                Value canSelectBox = createMath._and(
-                    createMath._and(checkScore, checkMOPC), isNotRemoved);
-                auto ifOp = rewriter.create<scf::IfOp>(
-                    loc, canSelectBox, /*withElseRegion=*/false);
-                rewriter.setInsertionPointToStart(
-                    &ifOp.getThenRegion().front());
-
-                // Select the bounding box with the largest score.
-                SmallVector<Value, 4> selectedBox;
-                for (int i = 0; i < 4; ++i) {
-                  Value iVal = createMath.constantIndex(i);
-                  Value x = createKrnl.load(boxes, {b, selectedBI, iVal});
-                  selectedBox.emplace_back(x);
-                }
-
-                // Compute the position to store the selected box.
-                // out_index = b * batch_size + c * max_output_per_class +
-                //             effective_max_output_per_class;
-                DimIndexExpr bIE(b), cIE(c), bsIE(bs);
-                DimIndexExpr MOPCIE(MOPC), effectiveMOPCIE(currentMOPC);
-                IndexExpr soIE = bIE * bsIE + cIE * MOPCIE + effectiveMOPCIE;
-
-                // Store the index of the selected box to the output.
-                // selected_indices[out_index] = [b, c, selected_box_index]
-                Value soVal = soIE.getValue();
-                createKrnl.store(b, selectedMemRef, {soVal, zero});
-                createKrnl.store(c, selectedMemRef, {soVal, one});
-                createKrnl.store(selectedBI, selectedMemRef, {soVal, two});
-
-                // Update the number of output boxes per class.
-                // effective_max_output_per_class += 1
-                IndexExpr newEffectiveMOPCIE =
-                    effectiveMOPCIE + LiteralIndexExpr(1);
-                createKrnl.store(newEffectiveMOPCIE.getValue(),
-                    effectiveMaxOutputPerClass, {});
-
-                // Remove boxes overlapped too much with the selected box,
-                // using IOU.
-                ValueRange oLoopDef = createKrnl.defineLoops(1);
-                createKrnl.iterate(oLoopDef, oLoopDef, {zero}, {ss},
-                    [&](KrnlBuilder &createKrnl, ValueRange oLoopInd) {
-                      Value o(oLoopInd[0]);
-                      MathBuilder createMath(createKrnl);
-
-                      // Only proceed if a box has not yet been removed.
-                      Value isRemoved = createKrnl.load(removedIndices, {o});
-                      Value isNotRemoved = createMath.eq(isRemoved, falseVal);
-                      auto if1Op = rewriter.create<scf::IfOp>(
-                          loc, isNotRemoved, /*withElseRegion=*/false);
-                      rewriter.setInsertionPointToStart(
-                          &if1Op.getThenRegion().front());
-
-                      // Pick the current box.
-                      SmallVector<Value, 4> otherBox;
-                      for (int i = 0; i < 4; ++i) {
-                        Value iVal = createMath.constantIndex(i);
-                        Value x = createKrnl.load(boxes, {b, o, iVal});
-                        otherBox.emplace_back(x);
-                      }
-
-                      // Compute IOU between the selected and current boxes.
-                      Value iou = emitIOU(
-                          createMath, selectedBox, otherBox, centerPointBox);
-
-                      // Only proceed if IOU > iou_threshold.
-                      Value checkIOU = createMath.sgt(iou, iouTH);
-                      auto if2Op = rewriter.create<scf::IfOp>(
-                          loc, checkIOU, /*withElseRegion=*/false);
-                      rewriter.setInsertionPointToStart(
-                          &if2Op.getThenRegion().front());
-
-                      // If IOU is satified, mark the current box as removed.
-                      createKrnl.store(trueVal, removedIndices, {o});
-                    });
+                Value s(sLoopInd[0]);
+                Value score = createKrnl.load(scores, {b, c, s});
+                Value gt = createMath.sgt(score, scoreTH);
+                Value n = createKrnl.load(numCandidates, {});
+                createKrnl.store(s, candidates, {n});
+                Value nPlusOne = createMath.add(n, one);
+                createKrnl.store(
+                    createMath.select(gt, nPlusOne, n), numCandidates, {});
               });
-          // Update the effective numbers of selected indices.
-          Value effectiveMOPC =
-              create.krnl.load(effectiveMaxOutputPerClass, {});
-          Value effectiveNSI =
-              create.krnl.load(effectiveNumSelectedIndices, {});
-          Value newEffectiveNSI = create.math.add(effectiveNSI, effectiveMOPC);
-          create.krnl.store(newEffectiveNSI, effectiveNumSelectedIndices, {});
+
+          // Iterate over the candidates in the descending order of scores.
+          create.krnl.store(zero, numSelected, {});
+          Value nc = create.krnl.load(numCandidates, {});
+          create.scf.forLoop(zero, nc, 1, [&](SCFBuilder &createSCF, Value i) {
+            MultiDialectBuilder<KrnlBuilder, MathBuilder, SCFBuilder> create(
+                createSCF);
+            // Stop as soon as max_output_boxes_per_class boxes are selected.
+            Value ns = create.krnl.load(numSelected, {});
+            Value checkMOPC = create.math.slt(ns, MOPC);
+            create.scf.ifThenElse(checkMOPC, [&](SCFBuilder &createSCF) {
+              MultiDialectBuilder<KrnlBuilder, MathBuilder, SCFBuilder> create(
+                  createSCF);
+              // Move the candidate with the largest remaining score to
+              // position i. Sorting only progresses as far as the candidates
+              // that are visited before stopping.
+              Value iPlusOne = create.math.add(i, one);
+              create.scf.forLoop(
+                  iPlusOne, nc, 1, [&](SCFBuilder &createSCF, Value k) {
+                    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
+                        createSCF);
+                    Value iOrd = create.krnl.load(candidates, {i});
+                    Value kOrd = create.krnl.load(candidates, {k});
+                    Value x = create.krnl.load(scores, {b, c, iOrd});
+                    Value y = create.krnl.load(scores, {b, c, kOrd});
+                    Value lt = create.math.slt(x, y);
+                    create.krnl.store(
+                        create.math.select(lt, kOrd, iOrd), candidates, {i});
+                    create.krnl.store(
+                        create.math.select(lt, iOrd, kOrd), candidates, {k});
+                  });
+
+              // Pick the candidate box with the largest score.
+              Value selectedBI = create.krnl.load(candidates, {i});
+              SmallVector<Value, 4> box;
+              for (int j = 0; j < 4; ++j) {
+                Value jVal = create.math.constantIndex(j);
+                box.emplace_back(
+                    create.krnl.load(corners, {b, selectedBI, jVal}));
+              }
+              Value area = create.krnl.load(areas, {b, selectedBI});
+
+              // Suppress the box if it overlaps too much with an already
+              // selected box. This loop has no branch and reads the selected
+              // boxes with unit stride.
+              create.krnl.store(falseVal, isSuppressed, {});
+              create.scf.forLoop(
+                  zero, ns, 1, [&](SCFBuilder &createSCF, Value k) {
+                    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
+                        createSCF);
+                    SmallVector<Value, 4> otherBox;
+                    for (int j = 0; j < 4; ++j) {
+                      Value jVal = create.math.constantIndex(j);
+                      otherBox.emplace_back(
+                          create.krnl.load(selectedBoxes, {jVal, k}));
+                    }
+                    Value otherArea = create.krnl.load(selectedAreas, {k});
+                    Value iou =
+                        emitIOU(create.math, box, area, otherBox, otherArea);
+                    Value checkIOU = create.math.sgt(iou, iouTH);
+                    Value suppressed = create.krnl.load(isSuppressed, {});
+                    create.krnl.store(create.math._or(suppressed, checkIOU),
+                        isSuppressed, {});
+                  });
+
+              // Select the box if it is not suppressed.
+              Value suppressed = create.krnl.load(isSuppressed, {});
+              Value isNotSuppressed = create.math.eq(suppressed, falseVal);
+              create.scf.ifThenElse(
+                  isNotSuppressed, [&](SCFBuilder &createSCF) {
+                    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(
+                        createSCF);
+                    for (int j = 0; j < 4; ++j) {
+                      Value jVal = create.math.constantIndex(j);
+                      create.krnl.store(box[j], selectedBoxes, {jVal, ns});
+                    }
+                    create.krnl.store(area, selectedAreas, {ns});
+                    create.krnl.store(
+                        create.math.add(ns, one), numSelected, {});
+
+                    // Store the index of the selected box to the output.
+                    // selected_indices[out_index] = [b, c, selected_box_index]
+                    Value so =
+                        create.krnl.load(effectiveNumSelectedIndices, {});
+                    create.krnl.store(b, selectedMemRef, {so, zero});
+                    create.krnl.store(c, selectedMemRef, {so, one});
+                    create.krnl.store(selectedBI, selectedMemRef, {so, two});
+                    create.krnl.store(create.math.add(so, one),
+                        effectiveNumSelectedIndices, {});
+                  });
+            });
+          });
         });
 
     // Insert allocation and deallocation for the final output.
@@ -476,57 +464,48 @@ void populateLoweringONNXNonMaxSuppressionOpPattern(RewritePatternSet &patterns,
 // Below is a python implementation of NonMaxSuppression.
 // import numpy as np
 //
-// def IOU(box1, box2, center_point_box=0):
+// def corners_and_area(box, center_point_box=0):
 //     if center_point_box == 0:
 //         # The box data is supplied as [y1, x1, y2, x2]. (y1, x1) and (y2, x2)
 //         # are the coordinates of the diagonal pair of bottom-left and top-right
-//         # corners.
-//         y1_min, x1_min, y1_max, x1_max = box1
-//         y2_min, x2_min, y2_max, x2_max = box2
-// 
-//         area1 = (y1_max - y1_min) * (x1_max - x1_min)
-//         area2 = (y2_max - y2_min) * (x2_max - x2_min)
+//         # corners. Flip the flipped coordinates back.
+//         y1, x1, y2, x2 = box
+//         y_min, y_max = min(y1, y2), max(y1, y2)
+//         x_min, x_max = min(x1, x2), max(x1, x2)
 //     else:
 //         # The box data is supplied as [x_center, y_center, width, height].
-//         x1_center, y1_center, w1, h1 = box1
-//         x2_center, y2_center, w2, h2 = box2
-// 
-//         x1_min = x1_center - w1 / 2
-//         x1_max = x1_center + w1 / 2
-//         x2_min = x2_center - w2 / 2
-//         x2_max = x2_center + w2 / 2
-// 
-//         y1_min = y1_center - h1 / 2
-//         y1_max = y1_center + h1 / 2
-//         y2_min = y2_center - h2 / 2
-//         y2_max = y2_center + h2 / 2
-// 
-//         area1 = h1 * w1
-//         area2 = h2 * w2
-// 
+//         x_center, y_center, w, h = box
+//         x_min, x_max = x_center - w / 2, x_center + w / 2
+//         y_min, y_max = y_center - h / 2, y_center + h / 2
+//     area = (y_max - y_min) * (x_max - x_min)
+//     return [y_min, x_min, y_max, x_max], area
+//
+// def IOU(box1, area1, box2, area2):
+//     y1_min, x1_min, y1_max, x1_max = box1
+//     y2_min, x2_min, y2_max, x2_max = box2
 //     intersection_x_min = max(x1_min, x2_min)
 //     intersection_y_min = max(y1_min, y2_min)
 //     intersection_x_max = min(x1_max, x2_max)
 //     intersection_y_max = min(y1_max, y2_max)
 //     intersection_area = max(intersection_x_max - intersection_x_min, 0) * \
 //         max(intersection_y_max - intersection_y_min, 0)
-// 
+//
 //     union_area = area1 + area2 - intersection_area + 1e-8
 //     return intersection_area / union_area
-// 
-// 
+//
+//
 // '''
 // boxes :: [num_batch, spatial_dimension, 4]
 // scores :: [num_batch, num_class, spatial_dimension]
 // '''
-// 
-// 
+//
+//
 // def nms(boxes, scores, max_output_boxes_per_class, iou_threshold,
 //         score_threshold, center_point_box=0):
 //     batch_size = scores.shape[0]
 //     class_size = scores.shape[1]
 //     spatial_size = boxes.shape[1]
-// 
+//
 //     score_threshold = score_threshold[0]
 //     iou_threshold = iou_threshold[0]
 //     # Suppress by spatial dimension.
@@ -542,96 +521,75 @@ void populateLoweringONNXNonMaxSuppressionOpPattern(RewritePatternSet &patterns,
 //             max_per_class_by_score = max(max_per_class_by_score, topk)
 //     max_output_per_class = min(
 //         max_output_per_class, max_per_class_by_score)
-// 
-//     # Sort scores in the descending order and get the sorted indices.
-//     # order = np.argsort(-scores, axis=2)
-//     order = np.full(scores.shape, -1)
-//     for b in range(batch_size):
-//         for c in range(class_size):
-//             for i in range(spatial_size):
-//                 order[b, c, i] = i
+//
+//     # Compute corners and areas once per box.
+//     corners = np.empty(boxes.shape)
+//     areas = np.empty(boxes.shape[:2])
 //     for b in range(batch_size):
-//         for c in range(class_size):
-//             for i in range(spatial_size - 1):
-//                 for k in range(i+1, spatial_size):
-//                      xOrd = order[b, c, i]
-//                      yOrd = order[b, c, k]
-//                      if (scores[b, c, xOrd] < scores[b, c, yOrd]):
-//                          tmp = order[b, c, i]
-//                          order[b, c, i] = order[b, c, k] 
-//                          order[b, c, k] = tmp 
-// 
-// 
-//     # Check if the coordinates are flipped. If so, flip them back.
-//     if (center_point_box == 0):
-//         new_boxes = np.empty(boxes.shape)
-//         for b in range(batch_size):
-//             for s in range(spatial_size):
-//                 box = boxes[b, s]
-//                 # Check whether the coordinates are flipped.
-//                 y1_min, x1_min, y1_max, x1_max = box
-//                 if (y1_min > y1_max):
-//                     tmp = y1_min
-//                     y1_min = y1_max
-//                     y1_max = tmp
-//                 if (x1_min > x1_max):
-//                     tmp = x1_min
-//                     x1_min = x1_max
-//                     x1_max = tmp
-//                 new_boxes[b, s] = [y1_min, x1_min, y1_max, x1_max]
-//         boxes = new_boxes
-// 
+//         for s in range(spatial_size):
+//             corners[b, s], areas[b, s] = corners_and_area(
+//                 boxes[b, s], center_point_box)
+//
 //     # Output: [num_selected_indices, 3]
 //     # The selected index format is [batch_index, class_index, box_index].
 //     num_selected_indices = batch_size * max_output_per_class * class_size
 //     selected_indices_shape = (num_selected_indices, 3)
-//     selected_indices = np.full(selected_indices_shape, -1).astype(np.int64)
+//     selected_indices = np.empty(selected_indices_shape).astype(np.int64)
 //     effective_num_selected_indices = 0
 //     for b in range(batch_size):
 //         for c in range(class_size):
-//             effective_max_output_per_class = 0
-//             removed_indices = np.full((spatial_size), False)
+//             # Discard bounding boxes using score threshold.
+//             candidates = np.empty(spatial_size).astype(np.int64)
+//             num_candidates = 0
 //             for s in range(spatial_size):
-//                 # Index of the bounding box with the largest score.
-//                 selected_box_index = order[b, c, s]
+//                 candidates[num_candidates] = s
+//                 if scores[b, c, s] > score_threshold:
+//                     num_candidates += 1
 //
-//                 # Discard bounding boxes using score threshold.
-//                 if (scores[b, c, selected_box_index] <= score_threshold):
-//                     continue
+//             selected_boxes = np.empty((4, spatial_size))
+//             selected_areas = np.empty(spatial_size)
+//             num_selected = 0
+//             for i in range(num_candidates):
 //                 # Have enough the number of outputs.
-//                 if (effective_max_output_per_class >= max_output_per_class):
+//                 if num_selected >= max_output_per_class:
 //                     continue
-//                 # Removed, ignore.
-//                 if removed_indices[selected_box_index]:
+//                 # Move the candidate with the largest score to position i.
+//                 for k in range(i + 1, num_candidates):
+//                     if (scores[b, c, candidates[i]] <
+//                             scores[b, c, candidates[k]]):
+//                         tmp = candidates[i]
+//                         candidates[i] = candidates[k]
+//                         candidates[k] = tmp
+//                 selected_box_index = candidates[i]
+//                 box = corners[b, selected_box_index]
+//                 area = areas[b, selected_box_index]
+//
+//                 # Suppress the box if it overlaps too much with a selected
+//                 # box, using IOU.
+//                 is_suppressed = False
+//                 for k in range(num_selected):
+//                     iou = IOU(box, area, selected_boxes[:, k],
+//                               selected_areas[k])
+//                     is_suppressed = is_suppressed or (iou > iou_threshold)
+//                 if is_suppressed:
 //                     continue
-// 
-//                 # Pick the bounding box with the largest score.
-//                 selected_box = boxes[b, selected_box_index, :]
-// 
-//                 # Store the index of the picked box to the output.
-//                 out_index = b * batch_size + c * max_output_per_class + effective_max_output_per_class
-//                 selected_indices[out_index] = [b, c, selected_box_index]
-//                 effective_max_output_per_class += 1
-// 
-//                 # Remove boxes overlapped too much with the selected box, using
-//                 # IOU.
-//                 for o in range(spatial_size):
-//                     other_box = boxes[b, o, :]
-//                     iou = IOU(selected_box, other_box, center_point_box)
-//                     if (not removed_indices[o]) and (iou > iou_threshold):
-//                         removed_indices[o] = True
-//                     else:
-//                         removed_indices[o] = removed_indices[o]
-//             effective_num_selected_indices += effective_max_output_per_class
-// 
+//
+//                 # Store the index of the selected box to the output.
+//                 selected_boxes[:, num_selected] = box
+//                 selected_areas[num_selected] = area
+//                 num_selected += 1
+//                 selected_indices[effective_num_selected_indices] = [
+//                     b, c, selected_box_index]
+//                 effective_num_selected_indices += 1
+//
 //     # Since we cannot suppress by IOU in advance, so remove redundant score
 //     # now.
 //     res = np.empty((effective_num_selected_indices, 3))
 //     for i in range(effective_num_selected_indices):
 //         res[i] = selected_indices[i]
-//     return res 
-// 
-// 
+//     return res
+//
+//
 // print("testing nonmaxsuppression_center_point_box_format")
 // center_point_box = 1
 // boxes = np.array([[
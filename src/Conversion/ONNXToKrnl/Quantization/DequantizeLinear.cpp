@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===--------- DequantizeLinear.cpp - Lowering DequantizeLinear Op --------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX DequantizeLinear Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+
+using namespace mlir;
+
+struct ONNXDequantizeLinearOpLowering : public ConversionPattern {
+  ONNXDequantizeLinearOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXDequantizeLinearOp::getOperationName(), 1, ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    ONNXDequantizeLinearOpAdaptor operandAdaptor(operands);
+    ONNXDequantizeLinearOp dequantizeOp =
+        llvm::cast<ONNXDequantizeLinearOp>(op);
+    Location loc = op->getLoc();
+    Value X = operandAdaptor.x();
+    Value scale = operandAdaptor.x_scale();
+    Value zeroPoint = operandAdaptor.x_zero_point();
+    bool hasZeroPoint = !zeroPoint.getType().isa<NoneType>();
+
+    // y = (x - x_zero_point) * x_scale, in float.
+    MemRefType outputMemRefType = convertToMemRefType(*op->result_type_begin());
+    Type floatType = outputMemRefType.getElementType();
+
+    IndexExprScope scope(&rewriter, loc);
+    MemRefBoundsIndexCapture xBounds(X);
+    int64_t rank = xBounds.getRank();
+    SmallVector<IndexExpr, 4> ubs, lbs(rank, LiteralIndexExpr(0));
+    xBounds.getDimList(ubs);
+    Value alloc =
+        insertAllocAndDeallocSimple(rewriter, op, outputMemRefType, loc, ubs);
+    int64_t axis = dequantizeOp.axis();
+    if (axis < 0)
+      axis += rank;
+
+    // Per tensor scale and zero point are loaded once, outside of the loops.
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    bool perTensor = isPerTensorQuantParam(scale);
+    Value scaleVal, zeroPointVal;
+    if (perTensor) {
+      scaleVal = loadQuantParam(create.krnl, scale, nullptr);
+      if (hasZeroPoint)
+        zeroPointVal = create.math.cast(
+            floatType, loadQuantParam(create.krnl, zeroPoint, nullptr));
+    }
+
+    ValueRange loopDef = create.krnl.defineLoops(rank);
+    create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          MathBuilder createMath(createKrnl);
+          Value currScale = scaleVal, currZeroPoint = zeroPointVal;
+          if (!perTensor) {
+            currScale = loadQuantParam(createKrnl, scale, indices[axis]);
+            if (hasZeroPoint)
+              currZeroPoint = createMath.cast(floatType,
+                  loadQuantParam(createKrnl, zeroPoint, indices[axis]));
+          }
+          Value x = createMath.cast(floatType, createKrnl.load(X, indices));
+          if (currZeroPoint)
+            x = createMath.sub(x, currZeroPoint);
+          createKrnl.store(createMath.mul(x, currScale), alloc, indices);
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXDequantizeLinearOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXDequantizeLinearOpLowering>(typeConverter, ctx);
+}
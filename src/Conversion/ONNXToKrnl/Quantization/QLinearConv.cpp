@@ -0,0 +1,243 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----------- QLinearConv.cpp - Lowering QLinearConv Op ----------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX QLinearConv Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+#include "src/Dialect/ONNX/ShapeInference/ONNXShapeHelper.hpp"
+
+using namespace mlir;
+
+struct ONNXQLinearConvOpLowering : public ConversionPattern {
+  ONNXQLinearConvOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXQLinearConvOp::getOperationName(), 1, ctx) {}
+
+  // Same loop structure as the float convolution. The input image and the
+  // filter are widened to i32 with their zero point subtracted ahead of the
+  // loops, so that the reduction is a plain i32 multiply-accumulate. The
+  // accumulator is requantized when stored in the result:
+  //   y = saturate(round(acc * x_scale * w_scale[co] / y_scale) + y_zero_point)
+  void qlinearConv(ConversionPatternRewriter &rewriter, Operation *op,
+      ONNXQLinearConvOp &convOp, ONNXQLinearConvOpAdaptor &operandAdaptor,
+      ONNXQLinearConvOpShapeHelper &shapeHelper, MemRefType &memRefType,
+      Value alloc) const {
+    Location loc = convOp.getLoc();
+    KrnlBuilder createKrnl(rewriter, loc);
+    MathBuilder createMath(createKrnl);
+
+    // Spatial data starts from the second dimension.
+    int spatialStartIndex = 2;
+
+    Value inputOperand = emitWidenedCopy(rewriter, loc, op,
+        operandAdaptor.x(), operandAdaptor.x_zero_point(), 0);
+    Value filterOperand = emitWidenedCopy(rewriter, loc, op,
+        operandAdaptor.w(), operandAdaptor.w_zero_point(), 0);
+    Value biasOperand = operandAdaptor.B();
+    Value wScale = operandAdaptor.w_scale();
+    bool hasBias = !biasOperand.getType().isa<NoneType>();
+    int64_t groupNum = convOp.group();
+    IndexExpr G = LiteralIndexExpr(groupNum);
+    Type i32Type = rewriter.getIntegerType(32);
+    Type floatType = rewriter.getF32Type();
+    Type quantType = memRefType.getElementType();
+    Value iZeroVal = createMath.constant(i32Type, 0);
+
+    // Per tensor parameters, loaded once. The filter scale may be given per
+    // output channel.
+    Value xScaleVal =
+        loadQuantParam(createKrnl, operandAdaptor.x_scale(), nullptr);
+    Value yScaleVal =
+        loadQuantParam(createKrnl, operandAdaptor.y_scale(), nullptr);
+    Value yZeroPointVal = createMath.cast(floatType,
+        loadQuantParam(createKrnl, operandAdaptor.y_zero_point(), nullptr));
+    Value inputScaleVal = createMath.div(xScaleVal, yScaleVal);
+
+    // Bounds for output sizes: [N x CO x HO x WO].
+    int outputRank = shapeHelper.dimsForOutput().size();
+    IndexExpr N = shapeHelper.dimsForOutput()[0];
+    IndexExpr CO = shapeHelper.dimsForOutput()[1];
+    IndexExpr COPerGroup = CO.ceilDiv(G);
+
+    // Bounds for input image X: [N x CI x HI x WI], and for filter W:
+    // [CO x CIPerGroup x KH x KW].
+    MemRefBoundsIndexCapture inputBounds(inputOperand);
+    MemRefBoundsIndexCapture filterBounds(filterOperand);
+    IndexExpr CIPerGroup = filterBounds.getSymbol(1);
+
+    // Determine the bounds for the loops over batch & channel out.
+    IndexExpr iZero = LiteralIndexExpr(0);
+    ValueRange outerLoops = createKrnl.defineLoops(3);
+    SmallVector<IndexExpr, 3> outerLbs = {iZero, iZero, iZero};
+    SmallVector<IndexExpr, 3> outerUbs = {N, G, COPerGroup};
+    // for n = 0 .. N:
+    //   for g = 0 .. G:
+    //     for coPerGroup = 0 .. COPerGroup:
+    //       co = g * COPerGroup + coPerGroup;
+    createKrnl.iterateIE(outerLoops, outerLoops, outerLbs, outerUbs,
+        [&](KrnlBuilder &createKrnl, ValueRange outerIndices) {
+          IndexExprScope outerScope(createKrnl);
+          MathBuilder createMath(createKrnl);
+          DimIndexExpr g(outerIndices[1]);
+          DimIndexExpr coPerGroup(outerIndices[2]);
+          IndexExpr co = g * SymbolIndexExpr(COPerGroup) + coPerGroup;
+          IndexExpr gTimesCIPerGroup = g * SymbolIndexExpr(CIPerGroup);
+          // Requantization multiplier of this output channel.
+          Value multiplier = createMath.mul(inputScaleVal,
+              loadQuantParam(createKrnl, wScale, co.getValue()));
+          // Determine the bounds for the output spacial dimensions.
+          int spacialRank = outputRank - spatialStartIndex;
+          ValueRange outputSpacialLoops = createKrnl.defineLoops(spacialRank);
+          SmallVector<IndexExpr, 3> outputSpacialLbs, outputSpacialUbs;
+          for (int i = spatialStartIndex; i < outputRank; ++i) {
+            outputSpacialLbs.emplace_back(iZero);
+            outputSpacialUbs.emplace_back(
+                SymbolIndexExpr(shapeHelper.dimsForOutput()[i]));
+          }
+          // for ho = 0 .. HO:
+          //    for wo = 0 .. WO:
+          createKrnl.iterateIE(outputSpacialLoops, outputSpacialLoops,
+              outputSpacialLbs, outputSpacialUbs,
+              [&](KrnlBuilder &createKrnl, ValueRange outputSpatialIndices) {
+                IndexExprScope outputSpacialScope(createKrnl);
+                MemRefBuilder createMemRef(createKrnl);
+                // Create a local i32 reduction value and set to zero.
+                MemRefType tmpType = MemRefType::get({}, i32Type);
+                Value reductionVal = createMemRef.alloca(tmpType);
+                createKrnl.store(iZeroVal, reductionVal);
+
+                // Bounds for reduction loops.
+                ValueRange redLoops = createKrnl.defineLoops(spacialRank + 1);
+                SmallVector<IndexExpr, 4> redLbs, redUbs, pMinOS;
+                redLbs.emplace_back(iZero);
+                redUbs.emplace_back(SymbolIndexExpr(CIPerGroup));
+                for (int i = 0; i < spacialRank; ++i) {
+                  DimIndexExpr o(outputSpatialIndices[i]);
+                  SymbolIndexExpr I(
+                      inputBounds.getSymbol(spatialStartIndex + i));
+                  SymbolIndexExpr K(
+                      filterBounds.getSymbol(spatialStartIndex + i));
+                  SymbolIndexExpr p(shapeHelper.pads[i]);
+                  LiteralIndexExpr s(shapeHelper.strides[i]);
+                  LiteralIndexExpr d(shapeHelper.dilations[i]);
+                  // lb = ceil((p - o * s) / d)
+                  IndexExpr pos = p - (o * s);
+                  IndexExpr lb = pos.ceilDiv(d);
+                  lb = IndexExpr::max(lb, 0);
+                  redLbs.emplace_back(lb);
+                  // ub = ceil((I + p - o * s) / d)
+                  IndexExpr ipos = I + pos;
+                  IndexExpr ub = ipos.ceilDiv(d);
+                  ub = IndexExpr::min(ub, K);
+                  redUbs.emplace_back(ub);
+                  pMinOS.emplace_back(pos);
+                }
+                // for ciPerGroup = 0 .. CIPerGroup:
+                //   for kh in lb .. ub:
+                //     for kw in lb .. ub:
+                createKrnl.iterateIE(redLoops, redLoops, redLbs, redUbs,
+                    [&](KrnlBuilder &createKrnl, ValueRange redIndices) {
+                      IndexExprScope redScope(createKrnl);
+                      MathBuilder createMath(createKrnl);
+                      // Input image access:
+                      // [n, ci, o * s + k * d - p] for each spacial dim.
+                      SmallVector<IndexExpr, 4> inputAccessFct;
+                      DimIndexExpr n(outerIndices[0]);
+                      inputAccessFct.emplace_back(n);
+                      DimIndexExpr ciPerG(redIndices[0]);
+                      IndexExpr ci = SymbolIndexExpr(gTimesCIPerGroup) + ciPerG;
+                      inputAccessFct.emplace_back(ci);
+                      for (int i = 0; i < spacialRank; ++i) {
+                        DimIndexExpr k(redIndices[1 + i]);
+                        SymbolIndexExpr pos(pMinOS[i]);
+                        LiteralIndexExpr d(shapeHelper.dilations[i]);
+                        IndexExpr t = (k * d) - pos;
+                        inputAccessFct.emplace_back(t);
+                      }
+                      Value image =
+                          createKrnl.loadIE(inputOperand, inputAccessFct);
+                      // Filter access: [co, ciPerG, kh, kw].
+                      SmallVector<IndexExpr, 4> filterAccessFct;
+                      filterAccessFct.emplace_back(DimIndexExpr(co));
+                      filterAccessFct.emplace_back(DimIndexExpr(ciPerG));
+                      for (int i = 0; i < spacialRank; ++i) {
+                        DimIndexExpr k(redIndices[1 + i]);
+                        filterAccessFct.emplace_back(k);
+                      }
+                      Value filter =
+                          createKrnl.loadIE(filterOperand, filterAccessFct);
+                      Value oldRed = createKrnl.load(reductionVal);
+                      Value mul = createMath.mul(image, filter);
+                      Value newRed = createMath.add(oldRed, mul);
+                      createKrnl.store(newRed, reductionVal);
+                    }); // Reduction loops.
+                // Add the i32 bias, requantize, and store in the result.
+                MathBuilder createMath(createKrnl);
+                Value result = createKrnl.load(reductionVal);
+                SymbolIndexExpr coInOutputSpacial(co);
+                if (hasBias) {
+                  Value bias =
+                      createKrnl.loadIE(biasOperand, {coInOutputSpacial});
+                  result = createMath.add(result, bias);
+                }
+                Value x = createMath.mul(
+                    createMath.cast(floatType, result), multiplier);
+                result = emitQuantizeToType(
+                    rewriter, loc, x, yZeroPointVal, quantType);
+                SmallVector<IndexExpr, 4> resAccessFunc;
+                resAccessFunc.emplace_back(SymbolIndexExpr(outerIndices[0]));
+                resAccessFunc.emplace_back(coInOutputSpacial);
+                for (Value o : outputSpatialIndices)
+                  resAccessFunc.emplace_back(DimIndexExpr(o));
+                createKrnl.storeIE(result, alloc, resAccessFunc);
+              }); // Output spacial loops.
+        });       // Outer loops;
+  }
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    Location loc = op->getLoc();
+    ONNXQLinearConvOpAdaptor operandAdaptor(operands);
+    ONNXQLinearConvOp convOp = llvm::cast<ONNXQLinearConvOp>(op);
+
+    // The image and output zero points and scales must be per tensor.
+    if (!isPerTensorQuantParam(operandAdaptor.x_zero_point()) ||
+        !isPerTensorQuantParam(operandAdaptor.x_scale()) ||
+        !isPerTensorQuantParam(operandAdaptor.y_zero_point()) ||
+        !isPerTensorQuantParam(operandAdaptor.y_scale()))
+      return failure();
+
+    // Get shape.
+    ONNXQLinearConvOpShapeHelper shapeHelper(&convOp, &rewriter,
+        getDenseElementAttributeFromKrnlValue,
+        loadDenseElementArrayValueAtIndex);
+    auto shapecomputed = shapeHelper.computeShape(operandAdaptor);
+    assert(succeeded(shapecomputed));
+
+    // Insert an allocation and deallocation for the result of this operation.
+    MemRefType memRefType = convertToMemRefType(*op->result_type_begin());
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, memRefType, loc, shapeHelper.dimsForOutput(0));
+
+    qlinearConv(
+        rewriter, op, convOp, operandAdaptor, shapeHelper, memRefType, alloc);
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXQLinearConvOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXQLinearConvOpLowering>(typeConverter, ctx);
+}
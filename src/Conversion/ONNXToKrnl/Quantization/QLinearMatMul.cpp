@@ -0,0 +1,296 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------- QLinearMatMul.cpp - Lowering Quantized MatMul Ops -----------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX QLinearMatMul and MatMulInteger Operators to Krnl
+// dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+#include "src/Dialect/Krnl/KrnlHelper.hpp"
+
+static constexpr int BUFFER_ALIGN = 128;
+
+using namespace mlir;
+
+// The tiled kernel handles A of rank >= 2 with either B of rank 2 (the
+// common activation x weight case), or B with the same batch dimensions as A.
+static bool isSupportedQuantizedMatMul(Value A, Value B) {
+  ArrayRef<int64_t> aShape = A.getType().cast<MemRefType>().getShape();
+  ArrayRef<int64_t> bShape = B.getType().cast<MemRefType>().getShape();
+  int64_t aRank = aShape.size();
+  int64_t bRank = bShape.size();
+  if (aRank < 2 || (bRank != 2 && bRank != aRank))
+    return false;
+  if (bRank == 2)
+    return true;
+  // No broadcast between batch dimensions.
+  for (int64_t i = 0; i < aRank - 2; ++i)
+    if (aShape[i] != -1 && bShape[i] != -1 && aShape[i] != bShape[i])
+      return false;
+  return true;
+}
+
+// Output dimensions: batch dimensions and rows of A, columns of B.
+static void getQuantizedMatMulOutputDims(
+    Value A, Value B, SmallVectorImpl<IndexExpr> &outputDims) {
+  MemRefBoundsIndexCapture aBounds(A);
+  MemRefBoundsIndexCapture bBounds(B);
+  for (uint64_t i = 0; i < aBounds.getRank() - 1; ++i)
+    outputDims.emplace_back(aBounds.getDim(i));
+  outputDims.emplace_back(bBounds.getDim(bBounds.getRank() - 1));
+}
+
+// Emit the i32 product (A - aZeroPoint) x (B - bZeroPoint) where A and B are
+// int8 or uint8, and zero points are per tensor, per row of A, or per column
+// of B. Both inputs are first widened to i32 with their zero point
+// subtracted, so that the inner kernel is the same tiled KrnlMatMulOp
+// computation as Gemm, on i32 tiles filled by copyToBuffer. Each finished tile
+// of accumulators is handed to storeFn with the output indices, so that the
+// conversion of the accumulators (e.g. requantization) is fused with the store
+// of the result.
+static void emitTiledQuantizedMatMul(ConversionPatternRewriter &rewriter,
+    Operation *op, Location loc, Value A, Value aZeroPoint, Value B,
+    Value bZeroPoint, SmallVectorImpl<IndexExpr> &outputDims,
+    function_ref<void(
+        KrnlBuilder &createKrnl, Value acc, ValueRange outputIndices)>
+        storeFn) {
+  int64_t aRank = A.getType().cast<MemRefType>().getRank();
+  int64_t bRank = B.getType().cast<MemRefType>().getRank();
+  int64_t outputRank = outputDims.size();
+  int64_t batchRank = outputRank - 2;
+  Value aWide = emitWidenedCopy(rewriter, loc, op, A, aZeroPoint, aRank - 2);
+  Value bWide = emitWidenedCopy(rewriter, loc, op, B, bZeroPoint, bRank - 1);
+
+  MemRefBoundsIndexCapture aBounds(A);
+  IndexExpr I = outputDims[outputRank - 2];
+  IndexExpr J = outputDims[outputRank - 1];
+  IndexExpr K = aBounds.getDim(aRank - 1);
+  LiteralIndexExpr zero(0);
+
+  Type i32Type = rewriter.getIntegerType(32);
+  MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+  Value zeroVal = create.math.constant(i32Type, 0);
+
+  // Same blocking as Gemm, with simdization along the j axis. The result is
+  // always tiled, as the accumulators are i32 and the output is not.
+  const int64_t iCacheTile(32), jCacheTile(64), kCacheTile(256);
+  const int64_t iRegTile(4), jRegTile(16);
+  bool simdize = !(J.isLiteral() && J.getLiteral() < jRegTile);
+
+  MemRefType aTileType = MemRefType::get({iCacheTile, kCacheTile}, i32Type);
+  MemRefType bTileType = MemRefType::get({kCacheTile, jCacheTile}, i32Type);
+  MemRefType rTileType = MemRefType::get({iCacheTile, jCacheTile}, i32Type);
+  SmallVector<IndexExpr, 1> empty;
+  Value aBuff = insertAllocAndDeallocSimple(
+      rewriter, op, aTileType, loc, empty, true, BUFFER_ALIGN);
+  Value bBuff = insertAllocAndDeallocSimple(
+      rewriter, op, bTileType, loc, empty, true, BUFFER_ALIGN);
+  Value rBuff = insertAllocAndDeallocSimple(
+      rewriter, op, rTileType, loc, empty, true, BUFFER_ALIGN);
+
+  auto genTiledMatMul = [&](KrnlBuilder &createKrnl, ValueRange batchIndices) {
+    // I, J, K loop, blocked as in Gemm.
+    ValueRange origLoop = createKrnl.defineLoops(3);
+    Value ii(origLoop[0]), jj(origLoop[1]), kk(origLoop[2]);
+    ValueRange iCacheBlock = createKrnl.block(ii, iCacheTile);
+    ValueRange iRegBlock = createKrnl.block(iCacheBlock[1], iRegTile);
+    Value ii1(iCacheBlock[0]), ii2(iRegBlock[0]), ii3(iRegBlock[1]);
+    ValueRange jCacheBlock = createKrnl.block(jj, jCacheTile);
+    ValueRange jRegBlock = createKrnl.block(jCacheBlock[1], jRegTile);
+    Value jj1(jCacheBlock[0]), jj2(jRegBlock[0]), jj3(jRegBlock[1]);
+    ValueRange kCacheBlock = createKrnl.block(kk, kCacheTile);
+    Value kk1(kCacheBlock[0]), kk2(kCacheBlock[1]);
+    // (cache) ii1 jj1 kk1,    (reg) jj2, ii2,    (matmul) ii3, jj3, kk3
+    createKrnl.permute({ii1, ii2, ii3, jj1, jj2, jj3, kk1, kk2},
+        {/*i*/ 0, 4, 5, /*j*/ 1, 3, 6, /*k*/ 2, 7});
+    createKrnl.iterateIE({ii, jj, kk}, {ii1, jj1}, {zero, zero, zero},
+        {I, J, K}, [&](KrnlBuilder &createKrnl, ValueRange i1_j1_indices) {
+          Value i1(i1_j1_indices[0]), j1(i1_j1_indices[1]);
+          createKrnl.memset(rBuff, zeroVal);
+          createKrnl.iterateIE({}, {kk1}, {}, {},
+              [&](KrnlBuilder &createKrnl, ValueRange k1_index) {
+                Value k1(k1_index[0]);
+                SmallVector<Value, 4> aStarts(
+                    batchIndices.begin(), batchIndices.end());
+                aStarts.append({i1, k1});
+                SmallVector<Value, 4> bStarts;
+                if (bRank > 2)
+                  bStarts.append(batchIndices.begin(), batchIndices.end());
+                bStarts.append({k1, j1});
+                createKrnl.copyToBuffer(aBuff, aWide, aStarts, zeroVal, false);
+                createKrnl.copyToBuffer(bBuff, bWide, bStarts, zeroVal, false);
+                createKrnl.iterate({}, {jj2, ii2}, {}, {},
+                    [&](KrnlBuilder &createKrnl, ValueRange j2_i2_indices) {
+                      Value j2(j2_i2_indices[0]), i2(j2_i2_indices[1]);
+                      ArrayRef<int64_t> empty;
+                      createKrnl.matmul(aBuff, {i1, k1}, bBuff, {k1, j1},
+                          rBuff, {i1, j1},
+                          /*loops*/ {ii3, jj3, kk2},
+                          /*compute start*/ {i2, j2, k1},
+                          /*ubs*/ {I.getValue(), J.getValue(), K.getValue()},
+                          /*compute tile*/ {iRegTile, jRegTile, kCacheTile},
+                          /* a/b/c tiles*/ empty, empty, empty, simdize,
+                          /*unroll*/ true, false);
+                    });
+              });
+          // Convert and store the finished tile of accumulators.
+          IndexExprScope tileScope(createKrnl);
+          DimIndexExpr i1Index(i1), j1Index(j1);
+          IndexExpr iTrip =
+              IndexExpr::min(SymbolIndexExpr(I) - i1Index, iCacheTile);
+          IndexExpr jTrip =
+              IndexExpr::min(SymbolIndexExpr(J) - j1Index, jCacheTile);
+          ValueRange tileLoops = createKrnl.defineLoops(2);
+          createKrnl.iterateIE(tileLoops, tileLoops, {zero, zero},
+              {iTrip, jTrip},
+              [&](KrnlBuilder &createKrnl, ValueRange tileIndices) {
+                MathBuilder createMath(createKrnl);
+                Value acc = createKrnl.load(rBuff, tileIndices);
+                SmallVector<Value, 4> outputIndices(
+                    batchIndices.begin(), batchIndices.end());
+                outputIndices.emplace_back(createMath.add(i1, tileIndices[0]));
+                outputIndices.emplace_back(createMath.add(j1, tileIndices[1]));
+                storeFn(createKrnl, acc, outputIndices);
+              });
+        });
+  };
+
+  if (batchRank == 0) {
+    genTiledMatMul(create.krnl, {});
+    return;
+  }
+  // Outer loops over the batch dimensions.
+  SmallVector<IndexExpr, 4> batchLbs(batchRank, zero);
+  SmallVector<IndexExpr, 4> batchUbs(
+      outputDims.begin(), outputDims.begin() + batchRank);
+  ValueRange batchLoops = create.krnl.defineLoops(batchRank);
+  create.krnl.iterateIE(
+      batchLoops, batchLoops, batchLbs, batchUbs, genTiledMatMul);
+}
+
+struct ONNXMatMulIntegerOpLowering : public ConversionPattern {
+  ONNXMatMulIntegerOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXMatMulIntegerOp::getOperationName(), 1, ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    ONNXMatMulIntegerOpAdaptor operandAdaptor(operands);
+    Location loc = op->getLoc();
+    Value A = operandAdaptor.A();
+    Value B = operandAdaptor.B();
+    if (!isSupportedQuantizedMatMul(A, B))
+      return failure();
+
+    IndexExprScope scope(&rewriter, loc);
+    SmallVector<IndexExpr, 4> outputDims;
+    getQuantizedMatMulOutputDims(A, B, outputDims);
+    MemRefType outputMemRefType = convertToMemRefType(*op->result_type_begin());
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, outputMemRefType, loc, outputDims, (int64_t)BUFFER_ALIGN);
+
+    // The i32 accumulators are the result.
+    emitTiledQuantizedMatMul(rewriter, op, loc, A,
+        operandAdaptor.a_zero_point(), B, operandAdaptor.b_zero_point(),
+        outputDims,
+        [&](KrnlBuilder &createKrnl, Value acc, ValueRange outputIndices) {
+          createKrnl.store(acc, alloc, outputIndices);
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+struct ONNXQLinearMatMulOpLowering : public ConversionPattern {
+  ONNXQLinearMatMulOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXQLinearMatMulOp::getOperationName(), 1, ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    ONNXQLinearMatMulOpAdaptor operandAdaptor(operands);
+    Location loc = op->getLoc();
+    Value A = operandAdaptor.a();
+    Value B = operandAdaptor.b();
+    if (!isSupportedQuantizedMatMul(A, B))
+      return failure();
+    Value aScale = operandAdaptor.a_scale();
+    Value bScale = operandAdaptor.b_scale();
+    Value yScale = operandAdaptor.y_scale();
+    Value yZeroPoint = operandAdaptor.y_zero_point();
+
+    IndexExprScope scope(&rewriter, loc);
+    SmallVector<IndexExpr, 4> outputDims;
+    getQuantizedMatMulOutputDims(A, B, outputDims);
+    int64_t outputRank = outputDims.size();
+    MemRefType outputMemRefType = convertToMemRefType(*op->result_type_begin());
+    Type quantType = outputMemRefType.getElementType();
+    Type floatType = rewriter.getF32Type();
+    Value alloc = insertAllocAndDeallocSimple(
+        rewriter, op, outputMemRefType, loc, outputDims, (int64_t)BUFFER_ALIGN);
+
+    // y = saturate(round(acc * a_scale * b_scale / y_scale) + y_zero_point).
+    // With per tensor parameters, the multiplier and zero point are computed
+    // once, outside of the loops.
+    bool perTensor = isPerTensorQuantParam(aScale) &&
+                     isPerTensorQuantParam(bScale) &&
+                     isPerTensorQuantParam(yScale) &&
+                     isPerTensorQuantParam(yZeroPoint);
+    auto emitMultiplierAndZeroPoint = [&](KrnlBuilder &createKrnl, Value row,
+                                          Value col, Value &multiplier,
+                                          Value &zeroPoint) {
+      MathBuilder createMath(createKrnl);
+      Value a = loadQuantParam(createKrnl, aScale, row);
+      Value b = loadQuantParam(createKrnl, bScale, col);
+      Value y = loadQuantParam(createKrnl, yScale, row);
+      multiplier = createMath.div(createMath.mul(a, b), y);
+      zeroPoint = createMath.cast(
+          floatType, loadQuantParam(createKrnl, yZeroPoint, row));
+    };
+    Value multiplierVal, zeroPointVal;
+    if (perTensor) {
+      KrnlBuilder createKrnl(rewriter, loc);
+      emitMultiplierAndZeroPoint(
+          createKrnl, nullptr, nullptr, multiplierVal, zeroPointVal);
+    }
+
+    emitTiledQuantizedMatMul(rewriter, op, loc, A,
+        operandAdaptor.a_zero_point(), B, operandAdaptor.b_zero_point(),
+        outputDims,
+        [&](KrnlBuilder &createKrnl, Value acc, ValueRange outputIndices) {
+          MathBuilder createMath(createKrnl);
+          Value multiplier = multiplierVal, zeroPoint = zeroPointVal;
+          if (!perTensor)
+            emitMultiplierAndZeroPoint(createKrnl,
+                outputIndices[outputRank - 2], outputIndices[outputRank - 1],
+                multiplier, zeroPoint);
+          Value x = createMath.mul(createMath.cast(floatType, acc), multiplier);
+          Value res =
+              emitQuantizeToType(rewriter, loc, x, zeroPoint, quantType);
+          createKrnl.store(res, alloc, outputIndices);
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXQLinearMatMulOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXQLinearMatMulOpLowering>(typeConverter, ctx);
+}
+
+void populateLoweringONNXMatMulIntegerOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXMatMulIntegerOpLowering>(typeConverter, ctx);
+}
@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------ QuantizeHelper.cpp - Lowering Quantized Ops -------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file defines common functions for lowering the ONNX quantized
+// operators.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+
+using namespace mlir;
+
+static constexpr int BUFFER_ALIGN = 128;
+
+bool isPerTensorQuantParam(Value param) {
+  ArrayRef<int64_t> shape = param.getType().cast<ShapedType>().getShape();
+  return shape.size() == 0 || (shape.size() == 1 && shape[0] == 1);
+}
+
+Value loadQuantParam(KrnlBuilder &createKrnl, Value param, Value index) {
+  ArrayRef<int64_t> shape = param.getType().cast<ShapedType>().getShape();
+  if (shape.size() == 0)
+    return createKrnl.load(param);
+  if (isPerTensorQuantParam(param)) {
+    MathBuilder createMath(createKrnl);
+    return createKrnl.load(param, {createMath.constantIndex(0)});
+  }
+  assert(index && "expected an index for a per axis parameter");
+  return createKrnl.load(param, {index});
+}
+
+Value emitWidenAndShift(MathBuilder &createMath, Value val, Value zeroPoint) {
+  Type i32Type = createMath.getBuilder().getIntegerType(32);
+  Value res = createMath.cast(i32Type, val);
+  if (zeroPoint)
+    res = createMath.sub(res, createMath.cast(i32Type, zeroPoint));
+  return res;
+}
+
+Value emitQuantizeToType(ConversionPatternRewriter &rewriter, Location loc,
+    Value x, Value zeroPoint, Type quantType) {
+  MathBuilder createMath(rewriter, loc);
+  Type floatType = x.getType();
+  Value res = emitScalarOpFor<ONNXRoundOp>(rewriter, loc, nullptr, floatType,
+      ArrayRef<Value>{x});
+  if (zeroPoint)
+    res = createMath.add(res, zeroPoint);
+  // Saturate to the range of the quantized type.
+  int64_t width = quantType.getIntOrFloatBitWidth();
+  double qMin, qMax;
+  if (quantType.isUnsignedInteger()) {
+    qMin = 0;
+    qMax = (double)((1ll << width) - 1);
+  } else {
+    qMin = -(double)(1ll << (width - 1));
+    qMax = (double)((1ll << (width - 1)) - 1);
+  }
+  res = createMath.max(res, createMath.constant(floatType, qMin));
+  res = createMath.min(res, createMath.constant(floatType, qMax));
+  return createMath.cast(quantType, res);
+}
+
+Value emitWidenedCopy(ConversionPatternRewriter &rewriter, Location loc,
+    Operation *op, Value input, Value zeroPoint, int64_t zeroPointAxis) {
+  MemRefBoundsIndexCapture inputBounds(input);
+  int64_t rank = inputBounds.getRank();
+  SmallVector<IndexExpr, 4> dims, lbs(rank, LiteralIndexExpr(0));
+  inputBounds.getDimList(dims);
+  MemRefType inputType = input.getType().cast<MemRefType>();
+  MemRefType wideType =
+      MemRefType::get(inputType.getShape(), rewriter.getIntegerType(32));
+  Value wide = insertAllocAndDeallocSimple(
+      rewriter, op, wideType, loc, dims, true, BUFFER_ALIGN);
+
+  bool hasZeroPoint = zeroPoint && !zeroPoint.getType().isa<NoneType>();
+  KrnlBuilder createKrnl(rewriter, loc);
+  // Per tensor zero points are loaded once, outside of the loops.
+  Value zp;
+  if (hasZeroPoint && isPerTensorQuantParam(zeroPoint))
+    zp = loadQuantParam(createKrnl, zeroPoint, nullptr);
+  ValueRange loopDef = createKrnl.defineLoops(rank);
+  createKrnl.iterateIE(loopDef, loopDef, lbs, dims,
+      [&](KrnlBuilder &createKrnl, ValueRange indices) {
+        MathBuilder createMath(createKrnl);
+        Value currZp = zp;
+        if (hasZeroPoint && !zp)
+          currZp =
+              loadQuantParam(createKrnl, zeroPoint, indices[zeroPointAxis]);
+        Value val = createKrnl.load(input, indices);
+        createKrnl.store(
+            emitWidenAndShift(createMath, val, currZp), wide, indices);
+      });
+  return wide;
+}
@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------ QuantizeHelper.hpp - Lowering Quantized Ops -------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file defines common functions for lowering the ONNX quantized
+// operators (QuantizeLinear, DequantizeLinear, QLinearMatMul, MatMulInteger,
+// and QLinearConv).
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+
+using namespace mlir;
+
+/// Load a scale or zero point. Parameters given per tensor (rank 0 or a
+/// single element) ignore the index; parameters given per axis return the
+/// element at the index.
+Value loadQuantParam(KrnlBuilder &createKrnl, Value param, Value index);
+
+/// Return true if the scale or zero point is given per tensor.
+bool isPerTensorQuantParam(Value param);
+
+/// Widen an int8/uint8 value to i32 and subtract its zero point, if any.
+Value emitWidenAndShift(MathBuilder &createMath, Value val, Value zeroPoint);
+
+/// Return saturate(round(x) + zeroPoint) converted to quantType, where x and
+/// zeroPoint are floats and round is round half to even. This is the store
+/// step shared by QuantizeLinear and the requantization of int32
+/// accumulators.
+Value emitQuantizeToType(ConversionPatternRewriter &rewriter, Location loc,
+    Value x, Value zeroPoint, Type quantType);
+
+/// Allocate an i32 copy of the int8/uint8 input with its zero point
+/// subtracted. The zero point is either per tensor, or per axis along
+/// zeroPointAxis of the input. The copy is deallocated at the end of the
+/// function.
+Value emitWidenedCopy(ConversionPatternRewriter &rewriter, Location loc,
+    Operation *op, Value input, Value zeroPoint, int64_t zeroPointAxis);
@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----------- QuantizeLinear.cpp - Lowering QuantizeLinear Op ----------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file lowers the ONNX QuantizeLinear Operator to Krnl dialect.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/Conversion/ONNXToKrnl/ONNXToKrnlCommon.hpp"
+#include "src/Conversion/ONNXToKrnl/Quantization/QuantizeHelper.hpp"
+
+using namespace mlir;
+
+struct ONNXQuantizeLinearOpLowering : public ConversionPattern {
+  ONNXQuantizeLinearOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
+      : ConversionPattern(typeConverter,
+            mlir::ONNXQuantizeLinearOp::getOperationName(), 1, ctx) {}
+
+  LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+      ConversionPatternRewriter &rewriter) const final {
+    ONNXQuantizeLinearOpAdaptor operandAdaptor(operands);
+    ONNXQuantizeLinearOp quantizeOp = llvm::cast<ONNXQuantizeLinearOp>(op);
+    Location loc = op->getLoc();
+    Value X = operandAdaptor.x();
+    Value scale = operandAdaptor.y_scale();
+    Value zeroPoint = operandAdaptor.y_zero_point();
+    bool hasZeroPoint = !zeroPoint.getType().isa<NoneType>();
+
+    // y = saturate(round(x / y_scale) + y_zero_point), into int8 or uint8.
+    MemRefType outputMemRefType = convertToMemRefType(*op->result_type_begin());
+    Type quantType = outputMemRefType.getElementType();
+    Type floatType = rewriter.getF32Type();
+
+    IndexExprScope scope(&rewriter, loc);
+    MemRefBoundsIndexCapture xBounds(X);
+    int64_t rank = xBounds.getRank();
+    SmallVector<IndexExpr, 4> ubs, lbs(rank, LiteralIndexExpr(0));
+    xBounds.getDimList(ubs);
+    Value alloc =
+        insertAllocAndDeallocSimple(rewriter, op, outputMemRefType, loc, ubs);
+    int64_t axis = quantizeOp.axis();
+    if (axis < 0)
+      axis += rank;
+
+    // Per tensor scale and zero point are loaded once, outside of the loops.
+    MultiDialectBuilder<KrnlBuilder, MathBuilder> create(rewriter, loc);
+    bool perTensor = isPerTensorQuantParam(scale);
+    Value scaleVal, zeroPointVal;
+    if (perTensor) {
+      scaleVal = loadQuantParam(create.krnl, scale, nullptr);
+      if (hasZeroPoint)
+        zeroPointVal = create.math.cast(
+            floatType, loadQuantParam(create.krnl, zeroPoint, nullptr));
+    }
+
+    ValueRange loopDef = create.krnl.defineLoops(rank);
+    create.krnl.iterateIE(loopDef, loopDef, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          MathBuilder createMath(createKrnl);
+          Value currScale = scaleVal, currZeroPoint = zeroPointVal;
+          if (!perTensor) {
+            currScale = loadQuantParam(createKrnl, scale, indices[axis]);
+            if (hasZeroPoint)
+              currZeroPoint = createMath.cast(floatType,
+                  loadQuantParam(createKrnl, zeroPoint, indices[axis]));
+          }
+          // Int32 inputs are converted to float before the division.
+          Value x = createMath.cast(floatType, createKrnl.load(X, indices));
+          Value scaled = createMath.div(x, currScale);
+          Value res = emitQuantizeToType(
+              rewriter, loc, scaled, currZeroPoint, quantType);
+          createKrnl.store(res, alloc, indices);
+        });
+
+    rewriter.replaceOp(op, alloc);
+    return success();
+  }
+};
+
+void populateLoweringONNXQuantizeLinearOpPattern(RewritePatternSet &patterns,
+    TypeConverter &typeConverter, MLIRContext *ctx) {
+  patterns.insert<ONNXQuantizeLinearOpLowering>(typeConverter, ctx);
+}
@@ -22,6 +22,36 @@ struct ONNXConcatOpLowering : public ConversionPattern {
       : ConversionPattern(
             typeConverter, mlir::ONNXConcatOp::getOperationName(), 1, ctx) {}
 
+  // Copy input `i` with one memcpy per index of the dimensions before the
+  // axis. Each run lands after the runs of the previous inputs in the output
+  // row. Return false if the runs are too short to be worth a memcpy.
+  static bool emitRunCopyForInput(ConversionPatternRewriter &rewriter,
+      Location loc, ArrayRef<Value> operands, unsigned int i, Value alloc,
+      int64_t axis) {
+    IndexExprScope scope(&rewriter, loc);
+    KrnlBuilder createKrnl(rewriter, loc);
+    MemRefBoundsIndexCapture inputBounds(operands[i]);
+    MemRefBoundsIndexCapture outputBounds(alloc);
+    IndexExpr runSize = getNumElementsFrom(inputBounds, axis);
+    if (!isWorthMemcpy(operands[i], runSize) || !isWorthMemcpy(alloc, runSize))
+      return false;
+
+    IndexExpr axisOffset = LiteralIndexExpr(0);
+    for (unsigned int j = 0; j < i; ++j) {
+      MemRefBoundsIndexCapture operandJBounds(operands[j]);
+      axisOffset = axisOffset + operandJBounds.getSymbol(axis);
+    }
+    IndexExpr destStart =
+        axisOffset * getNumElementsFrom(outputBounds, axis + 1);
+    SmallVector<IndexExpr, 4> outerUbs;
+    for (int64_t r = 0; r < axis; ++r)
+      outerUbs.emplace_back(inputBounds.getSymbol(r));
+    emitRowRunCopy(createKrnl, alloc, operands[i], outerUbs, runSize,
+        getNumElementsFrom(outputBounds, axis), destStart, runSize,
+        LiteralIndexExpr(0));
+    return true;
+  }
+
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     // Gather info.
@@ -43,14 +73,19 @@ struct ONNXConcatOpLowering : public ConversionPattern {
     auto outputMemRefType = convertToMemRefType(*op->result_type_begin());
     auto resultShape = outputMemRefType.getShape();
     unsigned int rank = resultShape.size();
+    if (axis < 0)
+      axis += rank;
 
     Value alloc = insertAllocAndDeallocSimple(
         rewriter, op, outputMemRefType, loc, shapeHelper.dimsForOutput(0));
-    ;
 
     // Creates loops, one for each input.
     for (unsigned int i = 0; i < inputNum; ++i) {
       OpBuilder::InsertionGuard insertGuard(rewriter);
+      // The dimensions from the axis on are a contiguous run in the input
+      // and in the output: copy the runs with memcpy when long enough.
+      if (emitRunCopyForInput(rewriter, loc, operands, i, alloc, axis))
+        continue;
       // Create loop.
       BuildKrnlLoop inputLoops(rewriter, loc, rank);
       inputLoops.createDefineOp();
@@ -23,6 +23,65 @@ struct ONNXExpandOpLowering : public ConversionPattern {
       : ConversionPattern(
             typeConverter, mlir::ONNXExpandOp::getOperationName(), 1, ctx) {}
 
+  // Trailing output dimensions that are not broadcast form a contiguous run
+  // in the input and in the output. Copy each run with a memcpy, iterating
+  // over the remaining outer output dimensions. Return false if the runs are
+  // too short to be worth a memcpy.
+  static bool emitRunCopy(ConversionPatternRewriter &rewriter, Location loc,
+      ONNXExpandOpShapeHelper &shapeHelper, Value input, Value alloc) {
+    IndexExprScope scope(&rewriter, shapeHelper.scope);
+    KrnlBuilder createKrnl(rewriter, loc);
+    MemRefBoundsIndexCapture inputBounds(input);
+    MemRefBoundsIndexCapture outputBounds(alloc);
+    int64_t inputRank = inputBounds.getRank();
+    int64_t outputRank = outputBounds.getRank();
+    int64_t rankDiff = outputRank - inputRank;
+    // Output dims (k, outputRank) are the same as the input dims.
+    int64_t k = outputRank - 1;
+    while (k >= rankDiff && inputBounds.isLiteral(k - rankDiff) &&
+           outputBounds.isLiteral(k) &&
+           inputBounds.getShape(k - rankDiff) == outputBounds.getShape(k))
+      --k;
+    IndexExpr runSize = getNumElementsFrom(outputBounds, k + 1);
+    if (!isWorthMemcpy(input, runSize) || !isWorthMemcpy(alloc, runSize))
+      return false;
+    // Nothing is broadcast: copy the whole input at once.
+    if (k < 0) {
+      LiteralIndexExpr zero(0);
+      createKrnl.memcpyIE(alloc, input, runSize, zero, zero);
+      return true;
+    }
+
+    SmallVector<IndexExpr, 4> lbs(k + 1, LiteralIndexExpr(0)), ubs;
+    for (int64_t i = 0; i <= k; ++i)
+      ubs.emplace_back(outputBounds.getSymbol(i));
+    ValueRange loopDef = createKrnl.defineLoops(k + 1);
+    createKrnl.iterateIE(loopDef, loopDef, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope outputScope(createKrnl, shapeHelper.scope);
+          // Access of the first element of the run, with broadcast dims
+          // reading index 0 of the input.
+          SmallVector<IndexExpr, 4> outputAccessExprs, inputAccessExprs;
+          getIndexExprList<DimIndexExpr>(indices, outputAccessExprs);
+          for (int64_t i = k + 1; i < outputRank; ++i)
+            outputAccessExprs.emplace_back(LiteralIndexExpr(0));
+          LogicalResult res = shapeHelper.GetAccessExprs(
+              input, 0, outputAccessExprs, inputAccessExprs);
+          assert(succeeded(res));
+          IndexExpr srcRow = LiteralIndexExpr(0);
+          IndexExpr destRow = LiteralIndexExpr(0);
+          for (int64_t i = 0; i <= k - rankDiff; ++i)
+            srcRow = srcRow * SymbolIndexExpr(inputBounds.getDim(i)) +
+                     inputAccessExprs[i];
+          for (int64_t i = 0; i <= k; ++i)
+            destRow = destRow * SymbolIndexExpr(outputBounds.getDim(i)) +
+                      outputAccessExprs[i];
+          IndexExpr run = SymbolIndexExpr(runSize);
+          createKrnl.memcpyIE(alloc, input, run, destRow * run, srcRow * run);
+        });
+    return true;
+  }
+
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     // Get shape.
@@ -42,6 +101,11 @@ struct ONNXExpandOpLowering : public ConversionPattern {
     Value alloc = insertAllocAndDeallocSimple(
         rewriter, op, outputMemRefType, loc, shapeHelper.dimsForOutput(0));
 
+    if (emitRunCopy(rewriter, loc, shapeHelper, input, alloc)) {
+      rewriter.replaceOp(op, alloc);
+      return success();
+    }
+
     // Iterate over the output values.
     KrnlBuilder createKrnl(rewriter, loc);
     ValueRange outputLoopDef = createKrnl.defineLoops(outputRank);
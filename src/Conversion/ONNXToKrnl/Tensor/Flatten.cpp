@@ -16,46 +16,6 @@
 
 using namespace mlir;
 
-//===----------------------------------------------------------------------===//
-// Helper function to insert alloc and dealloc ops for memref of dynamic shape.
-//
-// Should namespace or static be used here?
-Value insertAllocAndDeallocForFlatten(MemRefType memRefType, Location loc,
-    ConversionPatternRewriter &rewriter, bool insertDealloc, Value input,
-    int64_t axisValue) {
-  MultiDialectBuilder<MathBuilder, MemRefBuilder> create(rewriter, loc);
-  memref::AllocOp alloc;
-  auto inputShape = input.getType().cast<MemRefType>().getShape();
-  int64_t inputRank = inputShape.size();
-
-  SmallVector<Value, 2> allocOperands;
-  // Compute size for the first dimension when not constant
-  if (memRefType.getShape()[0] == -1) {
-    auto dimVal = create.math.constantIndex(1);
-    for (auto i = 0; i < axisValue; i++) {
-      dimVal = create.math.mul(dimVal, create.mem.dim(input, i));
-    }
-    allocOperands.emplace_back(dimVal);
-  }
-
-  // Compute size for the second dimension when not constant
-  if (memRefType.getShape()[1] == -1) {
-    auto dimVal = create.math.constantIndex(1);
-    for (auto i = axisValue; i < inputRank; i++) {
-      dimVal = create.math.mul(dimVal, create.mem.dim(input, i));
-    }
-    allocOperands.emplace_back(dimVal);
-  }
-
-  alloc = create.mem.alignedAlloc(memRefType, allocOperands);
-  if (insertDealloc) {
-    auto *parentBlock = alloc.getOperation()->getBlock();
-    auto dealloc = create.mem.dealloc(alloc);
-    dealloc.getOperation()->moveBefore(&parentBlock->back());
-  }
-  return alloc;
-}
-
 struct ONNXFlattenOpLowering : public ConversionPattern {
   ONNXFlattenOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
       : ConversionPattern(
@@ -77,95 +37,47 @@ struct ONNXFlattenOpLowering : public ConversionPattern {
     if (axisValue < 0)
       axisValue = inputRank + axisValue;
 
-    // Insert alloc and dealloc
-    bool insertDealloc = checkInsertDealloc(op);
-    MemRefType outputMemRefType = convertToMemRefType(*op->result_type_begin());
-    Value alloc;
-    if (hasAllConstantDimensions(outputMemRefType))
-      alloc =
-          insertAllocAndDealloc(outputMemRefType, loc, rewriter, insertDealloc);
-    else
-      alloc = insertAllocAndDeallocForFlatten(
-          outputMemRefType, loc, rewriter, insertDealloc, input, axisValue);
-
-    // Define loops and iteration trip counts (equivalent to size of input)
-    ValueRange indices;
-    std::vector<Value> originalLoops;
-    defineLoops(rewriter, loc, originalLoops, inputRank);
-    KrnlIterateOperandPack pack(rewriter, originalLoops);
-    for (int i = 0; i < inputRank; ++i)
-      addDimensionToPack(rewriter, loc, pack, input, i);
-
-    // Create the loops
-    auto iterateOp = rewriter.create<KrnlIterateOp>(loc, pack);
-    Block &iterationBlock = iterateOp.bodyRegion().front();
-
-    // Now perform the insertions into the body of the just generated loops.
-    // Insert instructions inside the KernelIterateOp body.
-    rewriter.setInsertionPointToStart(&iterationBlock);
-
-    // Generate the load of input
-    SmallVector<Value, 4> inputMemRefVal(iterationBlock.getArguments().begin(),
-        iterationBlock.getArguments().end());
-    auto inputVal = rewriter.create<KrnlLoadOp>(loc, input, inputMemRefVal);
-
-    // Generate the store for output
-    // Define affine map for first dim of output
-    auto firstIndexAE = rewriter.getAffineConstantExpr(0);
-    auto firstAccumulatedDimSizeAE = rewriter.getAffineConstantExpr(1);
-    for (auto i = axisValue - 1; i >= 0; i--) {
-      auto dimIndexAE = rewriter.getAffineDimExpr(i);
-      firstIndexAE = firstIndexAE + dimIndexAE * firstAccumulatedDimSizeAE;
-      auto dimSizeAE = rewriter.getAffineSymbolExpr(i);
-      firstAccumulatedDimSizeAE = dimSizeAE * firstAccumulatedDimSizeAE;
-    }
-    AffineMap firstDimMap = AffineMap::get(axisValue, axisValue, firstIndexAE);
-
-    // Create the parameter lists for the affine map
-    MemRefBuilder createMemRef(rewriter, loc);
-    SmallVector<Value, 4> firstMapArgList;
-    for (auto i = 0; i < axisValue; i++) {
-      firstMapArgList.emplace_back(iterationBlock.getArguments()[i]);
-    }
-    for (auto i = 0; i < axisValue; i++) {
-      firstMapArgList.emplace_back(createMemRef.dim(input, i));
+    // The output dims are the products of the input dims before and from the
+    // axis.
+    IndexExprScope scope(&rewriter, loc);
+    MemRefBoundsIndexCapture inputBounds(input);
+    SmallVector<IndexExpr, 2> outputDims;
+    outputDims.emplace_back(LiteralIndexExpr(1));
+    for (int64_t i = 0; i < axisValue; ++i)
+      outputDims[0] = outputDims[0] * inputBounds.getSymbol(i);
+    outputDims.emplace_back(getNumElementsFrom(inputBounds, axisValue));
+
+    // The buffer of a function argument belongs to the caller, so the view is
+    // taken on a copy of it.
+    if (isViewOfBlockArgument(flattenOp.input())) {
+      KrnlBuilder createKrnl(rewriter, loc);
+      SmallVector<IndexExpr, 4> inputDims;
+      inputBounds.getDimList(inputDims);
+      Value alloc =
+          insertAllocAndDeallocSimple(rewriter, op, inputTy, loc, inputDims);
+      IndexExpr numElems = getNumElementsFrom(inputBounds, 0);
+      if (isWorthMemcpy(input, numElems)) {
+        LiteralIndexExpr zero(0);
+        createKrnl.memcpyIE(alloc, input, numElems, zero, zero);
+      } else if (inputRank == 0) {
+        createKrnl.store(createKrnl.load(input, {}), alloc, {});
+      } else {
+        SmallVector<IndexExpr, 4> lbs(inputRank, LiteralIndexExpr(0));
+        ValueRange loopDef = createKrnl.defineLoops(inputRank);
+        createKrnl.iterateIE(loopDef, loopDef, lbs, inputDims,
+            [&](KrnlBuilder &createKrnl, ValueRange indices) {
+              Value val = createKrnl.load(input, indices);
+              createKrnl.store(val, alloc, indices);
+            });
+      }
+      input = alloc;
     }
-    auto firstDimVal =
-        rewriter.create<AffineApplyOp>(loc, firstDimMap, firstMapArgList);
 
-    // Generate index for second dim of output
-    auto secondIndexAE = rewriter.getAffineConstantExpr(0);
-    auto secondAccumulatedDimSizeAE = rewriter.getAffineConstantExpr(1);
-    // Can not use auto for i here because i may be negative
-    for (int64_t i = inputRank - 1; i >= axisValue; i--) {
-      auto idx = i - axisValue;
-      auto dimIndexAE = rewriter.getAffineDimExpr(idx);
-      secondIndexAE = secondIndexAE + dimIndexAE * secondAccumulatedDimSizeAE;
-      auto dimSizeAE = rewriter.getAffineSymbolExpr(idx);
-      secondAccumulatedDimSizeAE = dimSizeAE * secondAccumulatedDimSizeAE;
-    }
-    AffineMap secondDimMap = AffineMap::get(
-        inputRank - axisValue, inputRank - axisValue, secondIndexAE);
-
-    // Create the parameter lists for the affine map
-    SmallVector<Value, 4> secondMapArgList;
-    for (auto i = axisValue; i < inputRank; i++) {
-      secondMapArgList.emplace_back(iterationBlock.getArguments()[i]);
-    }
-    for (auto i = axisValue; i < inputRank; i++) {
-      secondMapArgList.emplace_back(createMemRef.dim(input, i));
-    }
-    auto secondDimVal =
-        rewriter.create<AffineApplyOp>(loc, secondDimMap, secondMapArgList);
-
-    // Create the store
-    SmallVector<Value, 2> outputMemRefVal = {firstDimVal, secondDimVal};
-    if (hasAllConstantDimensions(outputMemRefType))
-      rewriter.create<KrnlStoreOp>(loc, inputVal, alloc, outputMemRefVal);
-    else
-      rewriter.create<KrnlStoreOp>(loc, inputVal, alloc, outputMemRefVal);
-
-    rewriter.replaceOp(op, alloc);
+    // Lower to ReinterpretCastOp so that the data is never copied or modified.
+    MemRefType outputMemRefType = convertToMemRefType(*op->result_type_begin());
+    Value newView = emitMemRefReinterpretCastOp(
+        rewriter, loc, input, outputMemRefType, outputDims);
+    rewriter.replaceOp(op, newView);
     return success();
   }
 };
@@ -58,6 +58,53 @@ struct ONNXGatherOpLowering : public ConversionPattern {
           for kk in ndindex(Nk):
             out[ii + jj + kk] = data[ii + (indices[jj],) + kk]
     */
+    // The data dimensions after the axis are a contiguous run in the data
+    // and in the output, e.g. an embedding vector when gathering along axis
+    // 0. Copy them with memcpy when long enough.
+    MemRefBoundsIndexCapture dataBounds(operandAdaptor.data());
+    IndexExpr runSize = getNumElementsFrom(dataBounds, axisLit + 1);
+    if (isWorthMemcpy(operandAdaptor.data(), runSize) &&
+        isWorthMemcpy(alloc, runSize)) {
+      int64_t outerRank = axisLit + indicesRank;
+      SmallVector<IndexExpr, 4> lbs(outerRank, LiteralIndexExpr(0)), ubs;
+      for (int64_t i = 0; i < outerRank; ++i)
+        ubs.emplace_back(shapeHelper.dimsForOutput(0)[i]);
+      auto emitCopy = [&](KrnlBuilder &createKrnl, ValueRange indices) {
+        IndexExprScope innerLoopScope(createKrnl);
+        LiteralIndexExpr zero(0);
+        SymbolIndexExpr axisDim(shapeHelper.dataDims[axisLit]);
+        SmallVector<IndexExpr, 4> indicesAccessFct;
+        for (int j = 0; j < indicesRank; ++j)
+          indicesAccessFct.emplace_back(DimIndexExpr(indices[axisLit + j]));
+        Value indexVal =
+            createKrnl.loadIE(operandAdaptor.indices(), indicesAccessFct);
+        IndexExpr index = NonAffineIndexExpr(indexVal);
+        if (!shapeHelper.positiveConstantIndices)
+          index = index.selectOrSelf(index < zero, index + axisDim);
+        // Row of the data: ii followed by index. Row of the output: ii
+        // followed by jj.
+        IndexExpr srcRow = zero, destRow = zero;
+        for (int i = 0; i < axisLit; ++i)
+          srcRow = srcRow * SymbolIndexExpr(shapeHelper.dataDims[i]) +
+                   DimIndexExpr(indices[i]);
+        srcRow = srcRow * axisDim + index;
+        for (int i = 0; i < outerRank; ++i)
+          destRow =
+              destRow * SymbolIndexExpr(ubs[i]) + DimIndexExpr(indices[i]);
+        IndexExpr run = SymbolIndexExpr(runSize);
+        createKrnl.memcpyIE(
+            alloc, operandAdaptor.data(), run, destRow * run, srcRow * run);
+      };
+      if (outerRank == 0) {
+        emitCopy(createKrnl, {});
+      } else {
+        ValueRange loopDef = createKrnl.defineLoops(outerRank);
+        createKrnl.iterateIE(loopDef, loopDef, lbs, ubs, emitCopy);
+      }
+      rewriter.replaceOp(op, alloc);
+      return success();
+    }
+
     // Define loops and iteration trip counts (equivalent to size of output)
     BuildKrnlLoop outputLoops(rewriter, loc, outputRank);
     outputLoops.createDefineOp();
@@ -22,6 +22,70 @@ struct ONNXSliceOpLowering : public ConversionPattern {
       : ConversionPattern(
             typeConverter, mlir::ONNXSliceOp::getOperationName(), 1, ctx) {}
 
+  // Trailing dimensions that are kept whole (start 0, step 1, full size)
+  // form, together with the unit step dimension right before them, a
+  // contiguous run in the input and in the output. Copy each run with a
+  // memcpy, iterating over the outer output dimensions. Return false if there
+  // is no such run or if it is too short to be worth a memcpy.
+  static bool emitRunCopy(ConversionPatternRewriter &rewriter, Location loc,
+      ONNXSliceOpShapeHelper &shapeHelper, Value data, Value alloc) {
+    IndexExprScope scope(&rewriter, shapeHelper.scope);
+    KrnlBuilder createKrnl(rewriter, loc);
+    MemRefBoundsIndexCapture dataBounds(data);
+    MemRefBoundsIndexCapture outputBounds(alloc);
+    int64_t rank = outputBounds.getRank();
+    if (rank == 0)
+      return false;
+    int64_t k = rank - 1;
+    while (k > 0) {
+      IndexExpr start = shapeHelper.starts[k];
+      IndexExpr step = shapeHelper.steps[k];
+      if (!start.isLiteralAndIdenticalTo(0) ||
+          !step.isLiteralAndIdenticalTo(1) || !dataBounds.isLiteral(k) ||
+          !outputBounds.isLiteral(k) ||
+          dataBounds.getShape(k) != outputBounds.getShape(k))
+        break;
+      --k;
+    }
+    if (!shapeHelper.steps[k].isLiteralAndIdenticalTo(1))
+      return false;
+    IndexExpr runSize = getNumElementsFrom(outputBounds, k);
+    if (!isWorthMemcpy(data, runSize) || !isWorthMemcpy(alloc, runSize))
+      return false;
+
+    LiteralIndexExpr zero(0);
+    SmallVector<IndexExpr, 4> lbs(k, zero), ubs;
+    for (int64_t i = 0; i < k; ++i)
+      ubs.emplace_back(outputBounds.getSymbol(i));
+    auto emitCopy = [&](KrnlBuilder &createKrnl, ValueRange indices) {
+      IndexExprScope childScope(createKrnl);
+      // Read "i * step + start" for the outer dims, and "start" for dim k.
+      IndexExpr srcOffset = zero, destOffset = zero;
+      for (int64_t i = 0; i < k; ++i) {
+        DimIndexExpr index(indices[i]);
+        IndexExpr start = SymbolIndexExpr(shapeHelper.starts[i]);
+        IndexExpr step = SymbolIndexExpr(shapeHelper.steps[i]);
+        srcOffset = srcOffset * SymbolIndexExpr(dataBounds.getDim(i)) +
+                    (index * step + start);
+        destOffset =
+            destOffset * SymbolIndexExpr(outputBounds.getDim(i)) + index;
+      }
+      srcOffset = srcOffset * SymbolIndexExpr(dataBounds.getDim(k)) +
+                  SymbolIndexExpr(shapeHelper.starts[k]);
+      srcOffset = srcOffset * getNumElementsFrom(dataBounds, k + 1);
+      destOffset = destOffset * SymbolIndexExpr(runSize);
+      createKrnl.memcpyIE(
+          alloc, data, SymbolIndexExpr(runSize), destOffset, srcOffset);
+    };
+    if (k == 0) {
+      emitCopy(createKrnl, {});
+      return true;
+    }
+    ValueRange loopDef = createKrnl.defineLoops(k);
+    createKrnl.iterateIE(loopDef, loopDef, lbs, ubs, emitCopy);
+    return true;
+  }
+
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     ONNXSliceOpAdaptor operandAdaptor(operands);
@@ -36,10 +100,29 @@ struct ONNXSliceOpLowering : public ConversionPattern {
 
     auto outputMemRefType = convertToMemRefType(*op->result_type_begin());
     int64_t outputRank = outputMemRefType.getShape().size();
+
+    // A contiguous prefix of the data is lowered to ReinterpretCastOp so that
+    // the data is never copied or modified. Function arguments are still
+    // copied, since their buffers belong to the caller.
+    if (!isViewOfBlockArgument(sliceOp.data()) &&
+        isContiguousPrefixSlice(shapeHelper.starts, shapeHelper.steps,
+            shapeHelper.dimsForOutput(0), operandAdaptor.data())) {
+      Value newView = emitMemRefReinterpretCastOp(rewriter, loc,
+          operandAdaptor.data(), outputMemRefType,
+          shapeHelper.dimsForOutput(0));
+      rewriter.replaceOp(op, newView);
+      return success();
+    }
+
     // Insert an allocation and deallocation for the output of this operation.
     Value alloc = insertAllocAndDeallocSimple(
         rewriter, op, outputMemRefType, loc, shapeHelper.dimsForOutput(0));
 
+    if (emitRunCopy(rewriter, loc, shapeHelper, operandAdaptor.data(), alloc)) {
+      rewriter.replaceOp(op, alloc);
+      return success();
+    }
+
     BuildKrnlLoop outputLoops(rewriter, loc, outputRank);
     outputLoops.createDefineOp();
     outputLoops.pushAllBounds(shapeHelper.dimsForOutput(0));
@@ -47,6 +47,33 @@ LogicalResult ONNXSplitOpLoweringCommon(Operation *op, ArrayRef<Value> operands,
   // Creates loops, one for each output.
   for (unsigned int i = 0; i < outputNum; ++i) {
     OpBuilder::InsertionGuard insertGuard(rewriter);
+    // The dimensions from the axis on are a contiguous run in the input and
+    // in the output: copy the runs with memcpy when long enough.
+    {
+      IndexExprScope childScope(&rewriter, shapeHelper.scope);
+      KrnlBuilder createKrnl(rewriter, loc);
+      MemRefBoundsIndexCapture inputBounds(operandAdaptor.input());
+      MemRefBoundsIndexCapture outputBounds(allocs[i]);
+      IndexExpr runSize = getNumElementsFrom(outputBounds, axis);
+      if (isWorthMemcpy(operandAdaptor.input(), runSize) &&
+          isWorthMemcpy(allocs[i], runSize)) {
+        // Runs are read after the runs of the previous outputs in the
+        // input row.
+        IndexExpr axisOffset = LiteralIndexExpr(0);
+        for (unsigned int k = 0; k < i; ++k)
+          axisOffset =
+              axisOffset + SymbolIndexExpr(shapeHelper.dimsForOutput(k)[axis]);
+        IndexExpr srcStart =
+            axisOffset * getNumElementsFrom(inputBounds, axis + 1);
+        SmallVector<IndexExpr, 4> outerUbs;
+        for (int64_t r = 0; r < axis; ++r)
+          outerUbs.emplace_back(outputBounds.getSymbol(r));
+        emitRowRunCopy(createKrnl, allocs[i], operandAdaptor.input(),
+            outerUbs, runSize, runSize, LiteralIndexExpr(0),
+            getNumElementsFrom(inputBounds, axis), srcStart);
+        continue;
+      }
+    }
     // Create loop.
     BuildKrnlLoop outputLoops(rewriter, loc, rank);
     outputLoops.createDefineAndIterateOp(allocs[i]);
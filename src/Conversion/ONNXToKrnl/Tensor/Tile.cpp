@@ -58,6 +58,63 @@ struct ONNXTileOpLowering : public ConversionPattern {
       : ConversionPattern(
             typeConverter, mlir::ONNXTileOp::getOperationName(), 1, ctx) {}
 
+  // Trailing dimensions with a repeat of 1, together with the dimension k
+  // right before them, form a contiguous run of the input that is repeated
+  // along dimension k of the output. Copy each repetition of each run with a
+  // memcpy, iterating over the outer output dimensions and the repeats of
+  // dimension k. Return false if the runs are too short to be worth a
+  // memcpy.
+  static bool emitRunCopy(ConversionPatternRewriter &rewriter, Location loc,
+      ONNXTileOpShapeHelper &shapeHelper, Value input, Value repeats,
+      Value alloc) {
+    IndexExprScope scope(&rewriter, shapeHelper.scope);
+    KrnlBuilder createKrnl(rewriter, loc);
+    MemRefBoundsIndexCapture inputBounds(input);
+    MemRefBoundsIndexCapture outputBounds(alloc);
+    ArrayValueIndexCapture repeatsCapture(repeats,
+        getDenseElementAttributeFromKrnlValue,
+        loadDenseElementArrayValueAtIndex);
+    int64_t rank = inputBounds.getRank();
+    int64_t k = rank - 1;
+    while (k >= 0 && repeatsCapture.getSymbol(k).isLiteralAndIdenticalTo(1))
+      --k;
+    IndexExpr runSize =
+        getNumElementsFrom(inputBounds, std::max<int64_t>(k, 0));
+    if (!isWorthMemcpy(input, runSize) || !isWorthMemcpy(alloc, runSize))
+      return false;
+    // No dimension is repeated: copy the whole input at once.
+    if (k < 0) {
+      LiteralIndexExpr zero(0);
+      createKrnl.memcpyIE(alloc, input, runSize, zero, zero);
+      return true;
+    }
+
+    // Loops over the outer output dimensions and the repeats of dim k.
+    SmallVector<IndexExpr, 4> lbs(k + 1, LiteralIndexExpr(0)), ubs;
+    for (int64_t i = 0; i < k; ++i)
+      ubs.emplace_back(outputBounds.getSymbol(i));
+    ubs.emplace_back(repeatsCapture.getSymbol(k));
+    ValueRange loopDef = createKrnl.defineLoops(k + 1);
+    createKrnl.iterateIE(loopDef, loopDef, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope childScope(createKrnl);
+          IndexExpr srcRow = LiteralIndexExpr(0);
+          IndexExpr destRow = LiteralIndexExpr(0);
+          for (int64_t i = 0; i < k; ++i) {
+            DimIndexExpr index(indices[i]);
+            SymbolIndexExpr inputDim(inputBounds.getDim(i));
+            srcRow = srcRow * inputDim + index % inputDim;
+            destRow = destRow * SymbolIndexExpr(outputBounds.getDim(i)) + index;
+          }
+          // Each output row holds `repeats[k]` copies of the input run.
+          destRow =
+              destRow * SymbolIndexExpr(ubs[k]) + DimIndexExpr(indices[k]);
+          IndexExpr run = SymbolIndexExpr(runSize);
+          createKrnl.memcpyIE(alloc, input, run, destRow * run, srcRow * run);
+        });
+    return true;
+  }
+
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     ONNXTileOpAdaptor operandAdaptor(operands);
@@ -81,6 +138,12 @@ struct ONNXTileOpLowering : public ConversionPattern {
     Value alloc = insertAllocAndDeallocSimple(
         rewriter, op, outputMemRefType, loc, shapeHelper.dimsForOutput(0));
 
+    if (emitRunCopy(rewriter, loc, shapeHelper, input,
+            operandAdaptor.repeats(), alloc)) {
+      rewriter.replaceOp(op, alloc);
+      return success();
+    }
+
     // Define loops and iteration trip counts (equivalent to size of output)
     BuildKrnlLoop outputLoops(rewriter, loc, outputRank);
     outputLoops.createDefineOp();
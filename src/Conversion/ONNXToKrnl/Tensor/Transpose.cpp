@@ -17,11 +17,143 @@
 
 using namespace mlir;
 
+// Edge of the square register tiles of the blocked transpose.
+static constexpr int64_t REG_TILE = 4;
+
 struct ONNXTransposeOpLowering : public ConversionPattern {
   ONNXTransposeOpLowering(TypeConverter &typeConverter, MLIRContext *ctx)
       : ConversionPattern(
             typeConverter, mlir::ONNXTransposeOp::getOperationName(), 1, ctx) {}
 
+  // Edge of the square cache tiles of the blocked transpose, such that an
+  // input and an output tile fit in half of a 32KB L1 cache.
+  static int64_t getCacheTile(Type elementType) {
+    int64_t eltSize = std::max(elementType.getIntOrFloatBitWidth() / 8, 1u);
+    int64_t tile = 64;
+    while (tile > REG_TILE && 2 * tile * tile * eltSize > 16 * 1024)
+      tile /= 2;
+    return tile;
+  }
+
+  // Number of trailing dimensions left in place by the permutation. These
+  // dimensions form contiguous runs in both the input and the output.
+  static int64_t getNumTrailingIdentityDims(ArrayAttr permAttr, int64_t rank) {
+    int64_t num = 0;
+    while (num < rank && ArrayAttrIntVal(permAttr, rank - 1 - num) ==
+                             rank - 1 - num)
+      ++num;
+    return num;
+  }
+
+  // The permutation keeps the innermost `rank - outerRank` dimensions in
+  // place: copy each contiguous run with a memcpy, iterating over the outer
+  // output dimensions.
+  void emitContiguousRunCopy(ConversionPatternRewriter &rewriter, Location loc,
+      Value data, Value alloc, ArrayAttr permAttr, int64_t outerRank,
+      IndexExpr runSize) const {
+    KrnlBuilder createKrnl(rewriter, loc);
+    int64_t rank = alloc.getType().cast<MemRefType>().getRank();
+    MemRefBoundsIndexCapture inputBounds(data);
+    MemRefBoundsIndexCapture outputBounds(alloc);
+    LiteralIndexExpr zero(0);
+    if (outerRank == 0) {
+      createKrnl.memcpyIE(alloc, data, runSize, zero, zero);
+      return;
+    }
+
+    SmallVector<IndexExpr, 4> lbs(outerRank, zero), ubs;
+    for (int64_t i = 0; i < outerRank; ++i)
+      ubs.emplace_back(outputBounds.getSymbol(i));
+    ValueRange loopDef = createKrnl.defineLoops(outerRank);
+    createKrnl.iterateIE(loopDef, loopDef, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          IndexExprScope scope(createKrnl);
+          // Strides of the input and output dimensions, in elements.
+          SmallVector<IndexExpr, 4> inputStrides(rank), outputStrides(rank);
+          IndexExpr inputStride = SymbolIndexExpr(runSize);
+          IndexExpr outputStride = SymbolIndexExpr(runSize);
+          for (int64_t i = outerRank - 1; i >= 0; --i) {
+            inputStrides[i] = inputStride;
+            outputStrides[i] = outputStride;
+            inputStride = inputStride * SymbolIndexExpr(inputBounds.getDim(i));
+            outputStride =
+                outputStride * SymbolIndexExpr(outputBounds.getDim(i));
+          }
+          // Output dimension i reads input dimension perm[i].
+          IndexExpr srcOffset = zero, destOffset = zero;
+          for (int64_t i = 0; i < outerRank; ++i) {
+            DimIndexExpr index(indices[i]);
+            int64_t inputDim = ArrayAttrIntVal(permAttr, i);
+            srcOffset = srcOffset + index * inputStrides[inputDim];
+            destOffset = destOffset + index * outputStrides[i];
+          }
+          createKrnl.memcpyIE(
+              alloc, data, SymbolIndexExpr(runSize), destOffset, srcOffset);
+        });
+  }
+
+  // The permutation moves the innermost input dimension: iterate in output
+  // order, with the output dimensions that read the innermost input dimension
+  // (q) and that write the innermost output dimension (a) tiled for the cache
+  // and then for registers. The innermost loops move a REG_TILE x REG_TILE
+  // block with unit stride reads along q and unit stride writes along a.
+  void emitBlockedTranspose(ConversionPatternRewriter &rewriter, Location loc,
+      Value data, Value alloc, ArrayAttr permAttr) const {
+    KrnlBuilder createKrnl(rewriter, loc);
+    MemRefType outputType = alloc.getType().cast<MemRefType>();
+    int64_t rank = outputType.getRank();
+    int64_t a = rank - 1;
+    int64_t q = 0;
+    while (ArrayAttrIntVal(permAttr, q) != rank - 1)
+      ++q;
+    int64_t cacheTile = getCacheTile(outputType.getElementType());
+
+    MemRefBoundsIndexCapture outputBounds(alloc);
+    SmallVector<IndexExpr, 4> lbs(rank, LiteralIndexExpr(0)), ubs;
+    outputBounds.getSymbolList(ubs);
+
+    ValueRange loopDef = createKrnl.defineLoops(rank);
+    ValueRange qCacheBlock = createKrnl.block(loopDef[q], cacheTile);
+    ValueRange qRegBlock = createKrnl.block(qCacheBlock[1], REG_TILE);
+    ValueRange aCacheBlock = createKrnl.block(loopDef[a], cacheTile);
+    ValueRange aRegBlock = createKrnl.block(aCacheBlock[1], REG_TILE);
+    // Loop order: untiled dims in output order, then the q/a cache tiles,
+    // the q/a register tiles and the q/a elements.
+    SmallVector<Value, 8> loops;
+    SmallVector<int64_t, 8> map;
+    int64_t pos = 0;
+    for (int64_t i = 0; i < rank; ++i) {
+      if (i == q || i == a)
+        continue;
+      loops.emplace_back(loopDef[i]);
+      map.emplace_back(pos++);
+    }
+    for (Value loop : {qCacheBlock[0], aCacheBlock[0], qRegBlock[0],
+             aRegBlock[0], qRegBlock[1], aRegBlock[1]}) {
+      loops.emplace_back(loop);
+      map.emplace_back(pos++);
+    }
+    createKrnl.permute(loops, map);
+    createKrnl.iterateIE(loopDef, loops, lbs, ubs,
+        [&](KrnlBuilder &createKrnl, ValueRange indices) {
+          // Output indices, from the untiled loops and the element loops,
+          // which give the actual q and a indices.
+          SmallVector<Value, 4> outputIndices(rank);
+          int64_t untiled = 0;
+          for (int64_t i = 0; i < rank; ++i)
+            if (i != q && i != a)
+              outputIndices[i] = indices[untiled++];
+          outputIndices[q] = indices[indices.size() - 2];
+          outputIndices[a] = indices[indices.size() - 1];
+          // Output dimension i reads input dimension perm[i].
+          SmallVector<Value, 4> inputIndices(rank);
+          for (int64_t i = 0; i < rank; ++i)
+            inputIndices[ArrayAttrIntVal(permAttr, i)] = outputIndices[i];
+          Value loadData = createKrnl.load(data, inputIndices);
+          createKrnl.store(loadData, alloc, outputIndices);
+        });
+  }
+
   LogicalResult matchAndRewrite(Operation *op, ArrayRef<Value> operands,
       ConversionPatternRewriter &rewriter) const final {
     ONNXTransposeOpAdaptor operandAdaptor(operands);
@@ -48,6 +180,23 @@ struct ONNXTransposeOpLowering : public ConversionPattern {
     Value alloc = insertAllocAndDeallocSimple(
         rewriter, op, memRefType, loc, shapeHelper.dimsForOutput(0));
 
+    // Contiguous runs are copied with memcpy, when long enough.
+    int64_t numTrailing = getNumTrailingIdentityDims(permAttr, rank);
+    if (numTrailing > 0) {
+      MemRefBoundsIndexCapture inputBounds(data);
+      IndexExpr runSize = getNumElementsFrom(inputBounds, rank - numTrailing);
+      if (isWorthMemcpy(data, runSize) && isWorthMemcpy(alloc, runSize)) {
+        emitContiguousRunCopy(rewriter, loc, data, alloc, permAttr,
+            rank - numTrailing, runSize);
+        rewriter.replaceOp(op, alloc);
+        return success();
+      }
+    } else if (rank >= 2) {
+      emitBlockedTranspose(rewriter, loc, data, alloc, permAttr);
+      rewriter.replaceOp(op, alloc);
+      return success();
+    }
+
     // Create loop.
     BuildKrnlLoop inputLoops(rewriter, loc, rank);
     inputLoops.createDefineAndIterateOp(data);
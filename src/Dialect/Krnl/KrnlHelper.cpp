@@ -522,7 +522,25 @@ Value KrnlBuilder::constant(MemRefType type, StringRef name,
 }
 
 void KrnlBuilder::memcpy(Value dest, Value src, Value size) const {
-  b.create<KrnlMemcpyOp>(loc, dest, src, size);
+  b.create<KrnlMemcpyOp>(loc, dest, src, size, ValueRange());
+}
+
+void KrnlBuilder::memcpy(Value dest, Value src, Value size, Value destOffset,
+    Value srcOffset) const {
+  b.create<KrnlMemcpyOp>(
+      loc, dest, src, size, ValueRange({destOffset, srcOffset}));
+}
+
+void KrnlBuilder::memcpyIE(Value dest, Value src, IndexExpr numElems,
+    IndexExpr destOffset, IndexExpr srcOffset) const {
+  MathBuilder createMath(b, loc);
+  MemRefType destType = dest.getType().cast<MemRefType>();
+  int64_t eltSize = destType.getElementTypeBitWidth() / 8;
+  IndexExpr sizeInBytes = numElems * eltSize;
+  Value size = createMath.cast(b.getI64Type(), sizeInBytes.getValue());
+  Value destOffsetVal = destOffset.getValue();
+  Value srcOffsetVal = srcOffset.getValue();
+  memcpy(dest, src, size, destOffsetVal, srcOffsetVal);
 }
 
 void KrnlBuilder::memset(Value dest, Value val) const {
@@ -361,6 +361,12 @@ struct KrnlBuilder : public DialectBuilder {
 
   // C library functions.
   void memcpy(Value dest, Value src, Value size) const;
+  // Copy size bytes starting at the given element offsets.
+  void memcpy(Value dest, Value src, Value size, Value destOffset,
+      Value srcOffset) const;
+  // Copy numElems elements starting at the given element offsets.
+  void memcpyIE(Value dest, Value src, IndexExpr numElems, IndexExpr destOffset,
+      IndexExpr srcOffset) const;
   void memset(Value dest, Value val) const;
   Value strncmp(Value str1, Value str2, Value len) const;
   Value strlen(Value str) const;
@@ -410,7 +410,7 @@ void KrnlEntryPointOp::build(mlir::OpBuilder &builder, OperationState &state,
 }
 
 void KrnlInstrumentOp::build(mlir::OpBuilder &builder, OperationState &state,
-    Operation *op, int tag = 0) {
+    Operation *op, int tag, StringRef nodeName) {
   const char *opName = op->getName().getStringRef().data();
   int64_t opID = 0;
   // getName() result is "onnx.opName"
@@ -420,6 +420,10 @@ void KrnlInstrumentOp::build(mlir::OpBuilder &builder, OperationState &state,
   auto tagAttr = builder.getI64IntegerAttr(tag);
   state.addAttribute("opID", attr);
   state.addAttribute("tag", tagAttr);
+  if (!nodeName.empty()) {
+    state.addAttribute("opName", builder.getStringAttr(opName + 5));
+    state.addAttribute("nodeName", builder.getStringAttr(nodeName));
+  }
 }
 
 //===----------------------------------------------------------------------===//
@@ -762,6 +766,17 @@ static LogicalResult verify(KrnlCopyFromBufferOp op) {
   return success();
 }
 
+//===----------------------------------------------------------------------===//
+// KrnlMemcpyOp
+//===----------------------------------------------------------------------===//
+
+static LogicalResult verify(KrnlMemcpyOp op) {
+  size_t numOffsets = op.offsets().size();
+  if (numOffsets != 0 && numOffsets != 2)
+    return op.emitOpError("expect no offsets, or dest and src offsets");
+  return success();
+}
+
 } // namespace mlir
 
 #define GET_OP_CLASSES
@@ -168,6 +168,8 @@ Value MathBuilder::constant(Type type, double val) const {
   TypeSwitch<Type>(type)
       .Case<Float16Type>(
           [&](Type) { constantAttr = b.getF16FloatAttr((float)val); })
+      .Case<BFloat16Type>(
+          [&](Type) { constantAttr = b.getFloatAttr(type, val); })
       .Case<Float32Type>(
           [&](Type) { constantAttr = b.getF32FloatAttr((float)val); })
       .Case<Float64Type>(
@@ -301,33 +303,27 @@ Value MathBuilder::cast(Type destType, Value src) const {
 
   // Int to int conversion.
   if (srcType.isa<IntegerType>() && destType.isa<IntegerType>()) {
-    if (srcType.isUnsignedInteger()) {
-      // Unsigned to unsigned conversion. Has to convert to signless first, and
-      // recovert output to unsigned.
-      assert(destType.isUnsignedInteger() && "no unsigned/signed conversion");
-      assert((bitExtend || bitTrunc) && "expected extend or trunc");
-      Value cast = castToSignless(src, srcWidth);
-      Type castType = b.getIntegerType(destWidth);
-      if (bitExtend) {
-        cast = b.create<arith::ExtUIOp>(loc, castType, cast);
-      } else {
-        // TosaToLinalg use a cliping algo, not sure if needed.
-        cast = b.create<arith::TruncIOp>(loc, castType, cast);
-      }
-      return castToUnsigned(cast, destWidth);
-    } else {
-      // Handle signed ingeger
-      assert(!destType.isUnsignedInteger() && "no signed/unsigned conversion");
-      Value dest = src;
-      if (bitExtend)
-        dest = b.create<arith::ExtSIOp>(loc, destType, src);
-      if (bitTrunc)
-        // TosaToLinalg use a cliping algo
-        dest = b.create<arith::TruncIOp>(loc, destType, src);
-      if (destIsIndex)
-        dest = b.create<arith::IndexCastOp>(loc, b.getIndexType(), dest);
-      return dest;
+    // Unsigned values have to go through signless integers, and are zero
+    // extended. Mixed signed/unsigned conversions, as used by quantized ops,
+    // reinterpret the bits after the extension/truncation.
+    bool srcUnsigned = srcType.isUnsignedInteger();
+    bool destUnsigned = destType.isUnsignedInteger();
+    Value dest = srcUnsigned ? castToSignless(src, srcWidth) : src;
+    Type castType = b.getIntegerType(destWidth);
+    if (bitExtend) {
+      if (srcUnsigned)
+        dest = b.create<arith::ExtUIOp>(loc, castType, dest);
+      else
+        dest = b.create<arith::ExtSIOp>(loc, castType, dest);
     }
+    if (bitTrunc)
+      // TosaToLinalg use a cliping algo, not sure if needed.
+      dest = b.create<arith::TruncIOp>(loc, castType, dest);
+    if (destUnsigned)
+      return castToUnsigned(dest, destWidth);
+    if (destIsIndex)
+      dest = b.create<arith::IndexCastOp>(loc, b.getIndexType(), dest);
+    return dest;
   }
 
   // Handled all the cases supported so far.
@@ -434,4 +430,16 @@ void SCFBuilder::ifThenElse(Value cond,
   }
 }
 
+void SCFBuilder::forLoop(Value lb, Value ub, int64_t step,
+    function_ref<void(SCFBuilder &createSCF, Value index)> bodyFn) const {
+  Value stepVal = b.create<arith::ConstantIndexOp>(loc, step);
+  b.create<scf::ForOp>(loc, lb, ub, stepVal, llvm::None,
+      [&](OpBuilder &childBuilder, Location childLoc, Value index,
+          ValueRange iterArgs) {
+        SCFBuilder scfBuilder(childBuilder, childLoc);
+        bodyFn(scfBuilder, index);
+        scfBuilder.yield();
+      });
+}
+
 void SCFBuilder::yield() const { b.create<scf::YieldOp>(loc); }
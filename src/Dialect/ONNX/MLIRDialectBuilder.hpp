@@ -138,6 +138,12 @@ struct SCFBuilder final : DialectBuilder {
   void ifThenElse(Value cond, function_ref<void(SCFBuilder &createSCF)> thenFn,
       function_ref<void(SCFBuilder &createSCF)> elseFn = nullptr) const;
 
+  /// Create a for loop over [lb, ub) with a constant step. Unlike krnl loops,
+  /// the bounds may be any index values, e.g. values loaded inside another
+  /// loop. The yield is introduced automatically.
+  void forLoop(Value lb, Value ub, int64_t step,
+      function_ref<void(SCFBuilder &createSCF, Value index)> bodyFn) const;
+
   void yield() const;
 };
 
@@ -1354,15 +1354,19 @@ LogicalResult ONNXMatMulOp::inferShapes(
 // QLinearMatMul
 //===----------------------------------------------------------------------===//
 
-LogicalResult ONNXQLinearMatMulOp::inferShapes(
-    std::function<void(mlir::Region &)> doShapeInference) {
+// Static shape inference shared by the quantized matmul operations, which
+// follow the numpy matmul rules of MatMul. The result is computed with
+// elementType.
+template <class T>
+static LogicalResult inferQuantizedMatMulShape(
+    T *op, Value lhs, Value rhs, Type elementType) {
   // Cannot infer shape if no shape exists.
-  if (!a().getType().isa<RankedTensorType>() ||
-      !b().getType().isa<RankedTensorType>())
+  if (!lhs.getType().isa<RankedTensorType>() ||
+      !rhs.getType().isa<RankedTensorType>())
     return success();
 
-  auto lhsTy = a().getType().cast<RankedTensorType>();
-  auto rhsTy = b().getType().cast<RankedTensorType>();
+  auto lhsTy = lhs.getType().cast<RankedTensorType>();
+  auto rhsTy = rhs.getType().cast<RankedTensorType>();
 
   SmallVector<int64_t, 2> dims;
   auto lhsShape = lhsTy.getShape();
@@ -1370,14 +1374,14 @@ LogicalResult ONNXQLinearMatMulOp::inferShapes(
 
   if (lhsShape.size() < 1 && rhsShape.size() < 1) {
     // Multiplication by scalars is not allowed.
-    return emitError("Multiplication by scalar arguments not allowed");
+    return op->emitError("Multiplication by scalar arguments not allowed");
   } else if (lhsShape.size() == 1 && rhsShape.size() == 1) {
     // Special case when both arrays are 1-dimensional and according to
     // numpy rules the types need to be extended to 1xN and Nx1. Helper sizes
     // need to be removed after the multiplication but cannot be removed if
     // all sizes are 1.
     if (lhsShape[0] != -1 && rhsShape[0] != -1 && lhsShape[0] != rhsShape[0])
-      return emitError("Attempt to multiply incompatible matrices");
+      return op->emitError("Attempt to multiply incompatible matrices");
     dims.emplace_back(1);
   } else if (lhsShape.size() == 1 && rhsShape.size() >= 2) {
     // If the first argument is 1-D, it is promoted to a matrix by prepending
@@ -1392,7 +1396,7 @@ LogicalResult ONNXQLinearMatMulOp::inferShapes(
     unsigned rhsRank = rhsShape.size();
     if (lhsShape[0] != -1 && rhsShape[rhsRank - 2] != -1 &&
         lhsShape[0] != rhsShape[rhsRank - 2])
-      return emitError("Attempt to multiply incompatible matrices");
+      return op->emitError("Attempt to multiply incompatible matrices");
     for (decltype(rhsRank) i = 0; i < rhsRank - 2; ++i)
       dims.emplace_back(rhsShape[i]);
     dims.emplace_back(rhsShape[rhsRank - 1]);
@@ -1409,7 +1413,7 @@ LogicalResult ONNXQLinearMatMulOp::inferShapes(
     unsigned lhsRank = lhsShape.size();
     if (lhsShape[lhsRank - 1] != -1 && rhsShape[0] != -1 &&
         lhsShape[lhsRank - 1] != rhsShape[0])
-      return emitError("Attempt to multiply incompatible matrices");
+      return op->emitError("Attempt to multiply incompatible matrices");
     for (decltype(lhsRank) i = 0; i < lhsRank - 2; ++i)
       dims.emplace_back(lhsShape[i]);
     dims.emplace_back(lhsShape[lhsRank - 2]);
@@ -1422,7 +1426,7 @@ LogicalResult ONNXQLinearMatMulOp::inferShapes(
     unsigned lhsRank = lhsShape.size();
     if (lhsShape[lhsRank - 1] != -1 && rhsShape[0] != -1 &&
         lhsShape[lhsRank - 1] != rhsShape[0])
-      return emitError("Attempt to multiply incompatible matrices");
+      return op->emitError("Attempt to multiply incompatible matrices");
     for (decltype(lhsRank) i = 0; i < lhsRank - 1; ++i)
       dims.emplace_back(lhsShape[i]);
     dims.emplace_back(rhsShape[1]);
@@ -1435,7 +1439,7 @@ LogicalResult ONNXQLinearMatMulOp::inferShapes(
     unsigned rhsRank = rhsShape.size();
     if (lhsShape[1] != -1 && rhsShape[rhsRank - 2] != -1 &&
         lhsShape[1] != rhsShape[rhsRank - 2])
-      return emitError("Attempt to multiply incompatible matrices");
+      return op->emitError("Attempt to multiply incompatible matrices");
     for (decltype(rhsRank) i = 0; i < rhsRank - 2; ++i)
       dims.emplace_back(rhsShape[i]);
     dims.emplace_back(lhsShape[0]);
@@ -1450,7 +1454,7 @@ LogicalResult ONNXQLinearMatMulOp::inferShapes(
     unsigned rhsRank = rhsShape.size();
     if (lhsShape[lhsRank - 1] != -1 && rhsShape[rhsRank - 2] != -1 &&
         lhsShape[lhsRank - 1] != rhsShape[rhsRank - 2])
-      return emitError("Attempt to multiply incompatible matrices");
+      return op->emitError("Attempt to multiply incompatible matrices");
     // Check and perform broadcasting for the shapes.
     SmallVector<int64_t, 2> lhsBcastShape;
     for (decltype(lhsRank) i = 0; i < lhsRank - 2; ++i)
@@ -1459,7 +1463,7 @@ LogicalResult ONNXQLinearMatMulOp::inferShapes(
     for (decltype(rhsRank) i = 0; i < rhsRank - 2; ++i)
       rhsBcastShape.emplace_back(rhsShape[i]);
     if (!getBroadcastedShape(lhsBcastShape, rhsBcastShape, dims))
-      return emitError("Broadcasted dimensions are incompatible");
+      return op->emitError("Broadcasted dimensions are incompatible");
     dims.emplace_back(lhsShape[lhsRank - 2]);
     dims.emplace_back(rhsShape[rhsRank - 1]);
   } else {
@@ -1473,15 +1477,23 @@ LogicalResult ONNXQLinearMatMulOp::inferShapes(
 
     // Check legality of matrix multiplication.
     if (lhsDim != -1 && rhsDim != -1 && lhsDim != rhsDim)
-      return emitError("Attempt to multiply incompatible matrices");
+      return op->emitError("Attempt to multiply incompatible matrices");
     if (rhsShape.size() > 1)
       dims.emplace_back(rhsShape[1]);
   }
 
-  getResult().setType(RankedTensorType::get(dims, lhsTy.getElementType()));
+  op->getResult().setType(RankedTensorType::get(dims, elementType));
   return success();
 }
 
+LogicalResult ONNXQLinearMatMulOp::inferShapes(
+    std::function<void(mlir::Region &)> doShapeInference) {
+  Type elementType;
+  if (auto aTy = a().getType().dyn_cast<RankedTensorType>())
+    elementType = aTy.getElementType();
+  return inferQuantizedMatMulShape(this, a(), b(), elementType);
+}
+
 // Gemm
 LogicalResult ONNXGemmOp::inferShapes(
     std::function<void(mlir::Region &)> doShapeInference) {
@@ -2060,6 +2072,43 @@ LogicalResult ONNXConvTransposeOp::inferShapes(
     kernelShape = kernel_shape();
   }
 
+  // An output_shape over the spatial dimensions is given by the model, and
+  // defines the pads as in the ONNX specification. A full output_shape is the
+  // one recorded by a previous shape inference, e.g. with a dynamic batch
+  // size, and is simply recomputed.
+  auto outputShape = output_shape();
+  if (outputShape.hasValue() &&
+      (int32_t)ArrayAttrSize(outputShape) == spatialRank) {
+    // A negative total padding enlarges the output at the end, which is
+    // expressed as output padding since pads must be nonnegative.
+    bool isSameUpper = auto_pad() == "SAME_UPPER";
+    SmallVector<int64_t, 4> padsVals(2 * spatialRank, 0);
+    SmallVector<int64_t, 2> outputPadsVals;
+    for (int i = 0; i < spatialRank; ++i) {
+      int64_t inputSize = xShape[spatialOffset + i];
+      if (inputSize < 0)
+        return emitError("output_shape requires static spatial dimensions");
+      int64_t strideVal = strides() ? ArrayAttrIntVal(strides(), i) : 1;
+      int64_t dilationVal = dilations() ? ArrayAttrIntVal(dilations(), i) : 1;
+      int64_t outputPadVal =
+          output_padding() ? ArrayAttrIntVal(output_padding(), i) : 0;
+      int64_t totalPad = strideVal * (inputSize - 1) + outputPadVal +
+                         (ArrayAttrIntVal(kernelShape, i) - 1) * dilationVal +
+                         1 - ArrayAttrIntVal(outputShape, i);
+      if (totalPad < 0) {
+        outputPadsVals.emplace_back(outputPadVal - totalPad);
+        continue;
+      }
+      outputPadsVals.emplace_back(outputPadVal);
+      int64_t smallPad = totalPad / 2, largePad = totalPad - totalPad / 2;
+      padsVals[i] = isSameUpper ? smallPad : largePad;
+      padsVals[spatialRank + i] = isSameUpper ? largePad : smallPad;
+    }
+    padsAttr(builder.getI64ArrayAttr(padsVals));
+    output_paddingAttr(builder.getI64ArrayAttr(outputPadsVals));
+    auto_padAttr(builder.getStringAttr("NOTSET"));
+  }
+
   // Process strides, dilations, and pads.
   LogicalResult res = processConvTypeParams<>(this, X());
   assert(succeeded(res));
@@ -2067,10 +2116,6 @@ LogicalResult ONNXConvTransposeOp::inferShapes(
   auto stridesOpt = strides();
   auto padsOpt = pads();
   auto outputPads = output_padding();
-  auto outputShape = output_shape();
-  // TODO: handle the spatial dimension computation if output shape is
-  // specified
-  assert(!outputShape.hasValue() && "unhandled option in ConvTranspose");
 
   // First two output dimensions consist of the number of batches and the
   // number of kernels being applied.
@@ -2084,10 +2129,8 @@ LogicalResult ONNXConvTransposeOp::inferShapes(
   insertConvTransposeSpatialDim(outputDims, xShape, kernelShape, padsOpt,
       stridesOpt, outputPads, outputShape, dilationsOpt);
 
-  // Set the output shape if it's not already set
-  if (!outputShape.hasValue()) {
-    output_shapeAttr(builder.getI64ArrayAttr(outputDims));
-  }
+  // Record the full output shape.
+  output_shapeAttr(builder.getI64ArrayAttr(outputDims));
 
   getResult().setType(RankedTensorType::get(outputDims, xTy.getElementType()));
   return success();
@@ -3819,7 +3862,9 @@ LogicalResult ONNXLpPoolOp::inferShapes(
 
 LogicalResult ONNXMatMulIntegerOp::inferShapes(
     std::function<void(mlir::Region &)> doShapeInference) {
-  return emitError(NOT_IMPLEMENTED_MESSAGE);
+  // The products are accumulated into 32 bit integers.
+  IntegerType i32Type = IntegerType::get(getContext(), 32);
+  return inferQuantizedMatMulShape(this, A(), B(), i32Type);
 }
 
 LogicalResult ONNXMaxPoolOp::inferShapes(
@@ -4778,6 +4823,218 @@ mlir::Operation::result_range ONNXLoopOp::scan_outputs() {
   return llvm::make_range(results.begin() + v_initial().size(), results.end());
 }
 
+//===----------------------------------------------------------------------===//
+// NCHWc ops
+//===----------------------------------------------------------------------===//
+
+// Output size of a 2D window op along one spatial dimension, with explicit
+// pads and ceil_mode = 0. Returns -1 when the input size is unknown.
+static int64_t getNCHWcSpatialDim(ArrayAttr kernelShape, ArrayAttr pads,
+    ArrayAttr strides, ArrayAttr dilations, int64_t inputDim, int i) {
+  if (inputDim < 0)
+    return -1;
+  int64_t d = dilations ? ArrayAttrIntVal(dilations, i) : 1;
+  int64_t k = (ArrayAttrIntVal(kernelShape, i) - 1) * d + 1;
+  int64_t padded =
+      inputDim + ArrayAttrIntVal(pads, i) + ArrayAttrIntVal(pads, i + 2);
+  return (padded - k) / ArrayAttrIntVal(strides, i) + 1;
+}
+
+static LogicalResult verify(ONNXLayoutTransformOp op) {
+  int64_t blockSize = getNCHWcBlockSize(op.target_layout());
+  if (blockSize < 0)
+    return op.emitError("Unsupported target_layout ") << op.target_layout();
+  if (!hasShapeAndRank(op.data()))
+    return success();
+  ArrayRef<int64_t> shape = op.data().getType().cast<ShapedType>().getShape();
+  if (blockSize > 0) {
+    if (shape.size() != 4)
+      return op.emitError("Expected a 4D NCHW input");
+    if (shape[1] >= 0 && shape[1] % blockSize != 0)
+      return op.emitError("The number of channels is not a multiple of ")
+             << blockSize;
+  } else if (shape.size() != 5) {
+    return op.emitError("Expected a 5D NCHW<b>c input");
+  }
+  return success();
+}
+
+LogicalResult ONNXLayoutTransformOp::inferShapes(
+    std::function<void(mlir::Region &)> doShapeInference) {
+  // Cannot infer shape if no shape exists.
+  if (!data().getType().isa<RankedTensorType>())
+    return success();
+
+  auto dataTy = data().getType().cast<RankedTensorType>();
+  ArrayRef<int64_t> shape = dataTy.getShape();
+  int64_t blockSize = getNCHWcBlockSize(target_layout());
+  SmallVector<int64_t, 5> outputDims;
+  if (blockSize > 0) {
+    // [N x C x H x W] -> [N x C/b x H x W x b]
+    int64_t C = shape[1];
+    outputDims = {
+        shape[0], C < 0 ? -1 : C / blockSize, shape[2], shape[3], blockSize};
+  } else {
+    // [N x C/b x H x W x b] -> [N x C x H x W]
+    int64_t CB = shape[1], B = shape[4];
+    outputDims = {shape[0], (CB < 0 || B < 0) ? -1 : CB * B, shape[2],
+        shape[3]};
+  }
+  getResult().setType(
+      RankedTensorType::get(outputDims, dataTy.getElementType()));
+  return success();
+}
+
+LogicalResult ONNXConvNCHWcOp::inferShapes(
+    std::function<void(mlir::Region &)> doShapeInference) {
+  // Cannot infer shape if no shape exists.
+  if (!X().getType().isa<RankedTensorType>() ||
+      !W().getType().isa<RankedTensorType>())
+    return success();
+
+  // X: [N x C/b x H x W x b], W: [M x C x kH x kW], Y: [N x M/b x HO x WO x b]
+  auto xTy = X().getType().cast<RankedTensorType>();
+  ArrayRef<int64_t> xShape = xTy.getShape();
+  ArrayRef<int64_t> wShape = W().getType().cast<ShapedType>().getShape();
+  int64_t blockSize = xShape[4];
+  SmallVector<int64_t, 5> outputDims;
+  outputDims.emplace_back(xShape[0]);
+  outputDims.emplace_back(wShape[0] < 0 ? -1 : wShape[0] / blockSize);
+  for (int i = 0; i < 2; ++i)
+    outputDims.emplace_back(getNCHWcSpatialDim(kernel_shape(), pads(),
+        strides(), dilations(), xShape[2 + i], i));
+  outputDims.emplace_back(blockSize);
+  getResult().setType(RankedTensorType::get(outputDims, xTy.getElementType()));
+  return success();
+}
+
+static LogicalResult verify(ONNXPoolNCHWcOp op) {
+  if (op.mode() != "max" && op.mode() != "avg")
+    return op.emitError("Unsupported mode ") << op.mode();
+  if (ArrayAttrSize(op.kernel_shape()) != 2 || ArrayAttrSize(op.pads()) != 4 ||
+      ArrayAttrSize(op.strides()) != 2)
+    return op.emitError("Expected 2D kernel_shape, pads and strides");
+  if (hasShapeAndRank(op.X()) &&
+      op.X().getType().cast<ShapedType>().getRank() != 5)
+    return op.emitError("Expected a 5D NCHW<b>c input");
+  return success();
+}
+
+LogicalResult ONNXPoolNCHWcOp::inferShapes(
+    std::function<void(mlir::Region &)> doShapeInference) {
+  // Cannot infer shape if no shape exists.
+  if (!X().getType().isa<RankedTensorType>())
+    return success();
+
+  // X: [N x C/b x H x W x b], Y: [N x C/b x HO x WO x b]
+  auto xTy = X().getType().cast<RankedTensorType>();
+  ArrayRef<int64_t> xShape = xTy.getShape();
+  SmallVector<int64_t, 5> outputDims = {xShape[0], xShape[1]};
+  for (int i = 0; i < 2; ++i)
+    outputDims.emplace_back(getNCHWcSpatialDim(
+        kernel_shape(), pads(), strides(), nullptr, xShape[2 + i], i));
+  outputDims.emplace_back(xShape[4]);
+  getResult().setType(RankedTensorType::get(outputDims, xTy.getElementType()));
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// LayerNormalization
+//===----------------------------------------------------------------------===//
+
+static LogicalResult verify(ONNXLayerNormalizationOp op) {
+  if (op.stash_type() != 1)
+    return op.emitError("Only stash_type = 1 (float) is supported");
+  if (!hasShapeAndRank(op.X()))
+    return success();
+  int64_t rank = op.X().getType().cast<ShapedType>().getRank();
+  int64_t axis = op.axis();
+  if (axis < -rank || axis >= rank)
+    return op.emitError("axis value is out of bound");
+  return success();
+}
+
+LogicalResult ONNXLayerNormalizationOp::inferShapes(
+    std::function<void(mlir::Region &)> doShapeInference) {
+  // Cannot infer shape if no shape exists.
+  if (!X().getType().isa<RankedTensorType>())
+    return success();
+
+  auto xTy = X().getType().cast<RankedTensorType>();
+  int64_t rank = xTy.getRank();
+  int64_t axis = this->axis();
+  axis = axis >= 0 ? axis : rank + axis;
+  if (axis != this->axis()) {
+    auto builder = mlir::Builder(getContext());
+    axisAttr(IntegerAttr::get(builder.getIntegerType(64, /*isSigned=*/true),
+        APInt(64, /*value=*/axis, /*isSigned=*/true)));
+  }
+
+  // Y has the shape of X. Mean and InvStdDev keep the outer dimensions of X
+  // and have ones in the normalized dimensions.
+  getResult(0).setType(xTy);
+  SmallVector<int64_t, 4> statDims(xTy.getShape().begin(),
+      xTy.getShape().begin() + axis);
+  statDims.append(rank - axis, 1);
+  for (unsigned i = 1; i < 3; ++i) {
+    Value stat = getResult(i);
+    if (stat.getType().isa<NoneType>())
+      continue;
+    Type elementType = stat.getType().isa<ShapedType>()
+                           ? stat.getType().cast<ShapedType>().getElementType()
+                           : FloatType::getF32(getContext());
+    stat.setType(RankedTensorType::get(statDims, elementType));
+  }
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// ScaledDotProductAttention
+//===----------------------------------------------------------------------===//
+
+static LogicalResult verify(ONNXScaledDotProductAttentionOp op) {
+  if (!hasShapeAndRank(op.Q()) || !hasShapeAndRank(op.K()) ||
+      !hasShapeAndRank(op.V()))
+    return success();
+  ArrayRef<int64_t> qShape = op.Q().getType().cast<ShapedType>().getShape();
+  ArrayRef<int64_t> kShape = op.K().getType().cast<ShapedType>().getShape();
+  ArrayRef<int64_t> vShape = op.V().getType().cast<ShapedType>().getShape();
+  int64_t rank = qShape.size();
+  if (rank < 2 || (int64_t)kShape.size() != rank ||
+      (int64_t)vShape.size() != rank)
+    return op.emitError("Q, K and V must have the same rank, at least 2");
+  auto mismatch = [](int64_t a, int64_t b) {
+    return a >= 0 && b >= 0 && a != b;
+  };
+  for (int64_t i = 0; i < rank - 2; ++i)
+    if (mismatch(qShape[i], kShape[i]) || mismatch(qShape[i], vShape[i]))
+      return op.emitError("Q, K and V must have the same batch dimensions");
+  if (mismatch(qShape[rank - 1], kShape[rank - 1]))
+    return op.emitError("Q and K must have the same last dimension");
+  if (mismatch(kShape[rank - 2], vShape[rank - 2]))
+    return op.emitError("K and V must have the same number of rows");
+  if (hasShapeAndRank(op.Mask()) &&
+      op.Mask().getType().cast<ShapedType>().getRank() > rank)
+    return op.emitError("Mask has a higher rank than the attention scores");
+  return success();
+}
+
+LogicalResult ONNXScaledDotProductAttentionOp::inferShapes(
+    std::function<void(mlir::Region &)> doShapeInference) {
+  // Cannot infer shape if no shape exists.
+  if (!Q().getType().isa<RankedTensorType>() ||
+      !V().getType().isa<RankedTensorType>())
+    return success();
+
+  // Y has the shape of Q, with the last dimension of V.
+  auto qTy = Q().getType().cast<RankedTensorType>();
+  SmallVector<int64_t, 4> outputDims(qTy.getShape().begin(),
+      qTy.getShape().end());
+  outputDims.back() = V().getType().cast<RankedTensorType>().getShape().back();
+  getResult().setType(RankedTensorType::get(outputDims, qTy.getElementType()));
+  return success();
+}
+
 //===----------------------------------------------------------------------===//
 // CustomOp
 //===----------------------------------------------------------------------===//
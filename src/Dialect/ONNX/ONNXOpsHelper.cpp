@@ -207,6 +207,16 @@ int64_t ArrayAttrIntVal(Optional<ArrayAttr> a, int i) {
   return (a.getValue().getValue()[i]).cast<IntegerAttr>().getInt();
 }
 
+int64_t getNCHWcBlockSize(StringRef layout) {
+  if (layout == "NCHW")
+    return 0;
+  int64_t blockSize;
+  if (!layout.consume_front("NCHW") || !layout.consume_back("c") ||
+      layout.getAsInteger(10, blockSize) || blockSize < 1)
+    return -1;
+  return blockSize;
+}
+
 DenseElementsAttr getDenseElementAttributeFromONNXValue(Value value) {
   ONNXConstantOp constantOp = getONNXConstantOp(value);
   if (constantOp)
@@ -118,6 +118,10 @@ size_t ArrayAttrSize(llvm::Optional<mlir::ArrayAttr> a);
 int64_t ArrayAttrIntVal(mlir::ArrayAttr a, int i);
 int64_t ArrayAttrIntVal(llvm::Optional<mlir::ArrayAttr> a, int i);
 
+// Return the number of channels per block b of the "NCHW<b>c" layout, 0 for
+// the "NCHW" layout, and -1 for any other layout.
+int64_t getNCHWcBlockSize(llvm::StringRef layout);
+
 // This function satisfies the ArrayValueIndexCapture::DenseElementsAttr lambda
 // type, using ONNX operations only.
 mlir::DenseElementsAttr getDenseElementAttributeFromONNXValue(
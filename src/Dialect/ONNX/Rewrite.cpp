@@ -53,6 +53,170 @@ ArrayAttr createArrayAttrOfNToM(PatternRewriter &rewriter, int N, int M) {
   return rewriter.getI64ArrayAttr(vals);
 }
 
+// Return the first axis of a reduction over the trailing dimensions
+// [axis, rank) of 'val', or -1 if 'axes' are not the trailing dimensions.
+int64_t getTrailingAxesStart(Value val, ArrayAttr axes) {
+  if (!hasShapeAndRank(val) || !axes)
+    return -1;
+  int64_t rank = val.getType().cast<ShapedType>().getRank();
+  SmallVector<int64_t, 4> vals;
+  for (auto attr : axes.getValue()) {
+    int64_t axis = attr.cast<IntegerAttr>().getInt();
+    vals.emplace_back(axis < 0 ? axis + rank : axis);
+  }
+  llvm::sort(vals);
+  for (int64_t i = 0, e = vals.size(); i < e; ++i)
+    if (vals[i] != rank - e + i)
+      return -1;
+  return vals.empty() ? -1 : vals[0];
+}
+
+// Return true if 'val' is a constant holding a single float equal to 'cst'.
+bool isConstantScalarOf(Value val, double cst) {
+  DenseElementsAttr attr = getDenseElementAttributeFromONNXValue(val);
+  if (!attr || attr.getNumElements() != 1 ||
+      !attr.getType().getElementType().isa<FloatType>())
+    return false;
+  return (*attr.getValues<APFloat>().begin()).convertToDouble() == cst;
+}
+
+// Return true if 'val' is a constant holding a single float.
+bool isConstantScalar(Value val) {
+  DenseElementsAttr attr = getDenseElementAttributeFromONNXValue(val);
+  return attr && attr.getNumElements() == 1 &&
+         attr.getType().getElementType().isa<FloatType>();
+}
+
+// Return true if 'param' broadcasts to the dimensions of 'x' reduced over
+// 'axes' without broadcasting 'x', i.e. it is a valid Scale or B input of a
+// LayerNormalization of 'x'.
+bool isLayerNormParam(Value param, Value x, ArrayAttr axes) {
+  int64_t axis = getTrailingAxesStart(x, axes);
+  if (axis < 0 || !hasShapeAndRank(param))
+    return false;
+  ArrayRef<int64_t> xShape = x.getType().cast<ShapedType>().getShape();
+  ArrayRef<int64_t> shape = param.getType().cast<ShapedType>().getShape();
+  int64_t rank = xShape.size();
+  int64_t paramRank = shape.size();
+  if (paramRank > rank)
+    return false;
+  for (int64_t i = 0; i < paramRank; ++i) {
+    int64_t d = shape[paramRank - 1 - i];
+    int64_t xd = xShape[rank - 1 - i];
+    if (rank - 1 - i < axis ? d != 1 : (d != 1 && d != xd))
+      return false;
+  }
+  return true;
+}
+
+// Create a LayerNormalization of 'x' over the reduced 'axes', whose Y result
+// replaces 'res'.
+Value createLayerNormalization(PatternRewriter &rewriter, Location loc,
+    Value res, Value x, Value scale, Value bias, ArrayAttr axes, Value eps) {
+  DenseElementsAttr epsAttr = getDenseElementAttributeFromONNXValue(eps);
+  double epsilon = (*epsAttr.getValues<APFloat>().begin()).convertToDouble();
+  Type si64Type = rewriter.getIntegerType(64, /*isSigned=*/true);
+  Type noneType = rewriter.getNoneType();
+  auto layerNorm = rewriter.create<ONNXLayerNormalizationOp>(loc,
+      res.getType(), noneType, noneType, x, scale, bias,
+      rewriter.getIntegerAttr(si64Type, getTrailingAxesStart(x, axes)),
+      rewriter.getF32FloatAttr(epsilon), rewriter.getIntegerAttr(si64Type, 1));
+  return layerNorm.Y();
+}
+
+// Return true if 'q', 'kt' and 'v' are the f32 operands of the
+// MatMul(Softmax(MatMul(q, kt)), v) of an attention: they have the same rank
+// and batch dimensions, compatible matrix dimensions, and the last dimensions
+// of 'q' and 'v' are known.
+bool areAttentionOperands(Value q, Value kt, Value v) {
+  if (!hasShapeAndRank(q) || !hasShapeAndRank(kt) || !hasShapeAndRank(v))
+    return false;
+  auto qType = q.getType().cast<ShapedType>();
+  auto ktType = kt.getType().cast<ShapedType>();
+  auto vType = v.getType().cast<ShapedType>();
+  if (!qType.getElementType().isF32() || !ktType.getElementType().isF32() ||
+      !vType.getElementType().isF32())
+    return false;
+  int64_t rank = qType.getRank();
+  if (rank < 2 || ktType.getRank() != rank || vType.getRank() != rank)
+    return false;
+  ArrayRef<int64_t> qShape = qType.getShape();
+  ArrayRef<int64_t> ktShape = ktType.getShape();
+  ArrayRef<int64_t> vShape = vType.getShape();
+  for (int64_t i = 0; i < rank - 2; ++i)
+    if (ktShape[i] != qShape[i] || vShape[i] != qShape[i])
+      return false;
+  if (qShape[rank - 1] < 0 || vShape[rank - 1] < 0)
+    return false;
+  if (ktShape[rank - 2] >= 0 && ktShape[rank - 2] != qShape[rank - 1])
+    return false;
+  if (ktShape[rank - 1] >= 0 && vShape[rank - 2] >= 0 &&
+      ktShape[rank - 1] != vShape[rank - 2])
+    return false;
+  return true;
+}
+
+// Return true if 'axis' is the last axis of 'val'.
+bool isLastAxis(Value val, IntegerAttr axis) {
+  if (!hasShapeAndRank(val))
+    return false;
+  int64_t rank = val.getType().cast<ShapedType>().getRank();
+  int64_t axisVal = axis.getValue().getSExtValue();
+  return (axisVal < 0 ? axisVal + rank : axisVal) == rank - 1;
+}
+
+// Return true if 'mask' is an f32 additive mask of the attention 'scores',
+// which it broadcasts to without being broadcast.
+bool isAttentionMask(Value mask, Value scores) {
+  if (!hasShapeAndRank(mask) || !hasShapeAndRank(scores))
+    return false;
+  auto maskType = mask.getType().cast<ShapedType>();
+  if (!maskType.getElementType().isF32())
+    return false;
+  ArrayRef<int64_t> maskShape = maskType.getShape();
+  ArrayRef<int64_t> shape = scores.getType().cast<ShapedType>().getShape();
+  int64_t rank = shape.size();
+  int64_t maskRank = maskShape.size();
+  if (maskRank > rank)
+    return false;
+  for (int64_t i = 0; i < maskRank; ++i) {
+    int64_t d = maskShape[maskRank - 1 - i];
+    if (d != 1 && d != shape[rank - 1 - i])
+      return false;
+  }
+  return true;
+}
+
+// Create a ScaledDotProductAttention of 'q', 'kt' and 'v', whose result
+// replaces 'res'. The scores are multiplied by the constant 'scale', or
+// divided by it if 'isDivision'. A null 'mask' or 'scale' is absent.
+Value createAttention(PatternRewriter &rewriter, Location loc, Value res,
+    Value q, Value kt, Value v, Value mask, Value scale, bool isDivision) {
+  double scaleVal = 1.0;
+  if (scale) {
+    DenseElementsAttr scaleAttr = getDenseElementAttributeFromONNXValue(scale);
+    double cst = (*scaleAttr.getValues<APFloat>().begin()).convertToDouble();
+    scaleVal = isDivision ? 1.0 / cst : cst;
+  }
+  if (!mask)
+    mask = rewriter.create<ConstantOp>(loc, rewriter.getUnitAttr());
+  // Transpose kt back into k. This transpose folds with the one producing kt,
+  // if any.
+  auto ktType = kt.getType().cast<ShapedType>();
+  int64_t rank = ktType.getRank();
+  SmallVector<int64_t, 4> perm, kShape(ktType.getShape().begin(),
+                                    ktType.getShape().end());
+  for (int64_t i = 0; i < rank; ++i)
+    perm.emplace_back(i);
+  std::swap(perm[rank - 2], perm[rank - 1]);
+  std::swap(kShape[rank - 2], kShape[rank - 1]);
+  Value k = rewriter.create<ONNXTransposeOp>(loc,
+      RankedTensorType::get(kShape, ktType.getElementType()), kt,
+      rewriter.getI64ArrayAttr(perm));
+  return rewriter.create<ONNXScaledDotProductAttentionOp>(loc, res.getType(),
+      q, k, v, mask, rewriter.getF32FloatAttr(scaleVal));
+}
+
 /// Include the patterns defined in the Declarative Rewrite framework.
 #include "src/Dialect/ONNX/ONNXRewrite.inc"
 
@@ -67,6 +231,19 @@ void ONNXAddOp::getCanonicalizationPatterns(
   results.insert<FuseGemmFollowedByAddition>(context);
   results.insert<FuseAddConvPattern>(context);
   results.insert<FuseAddConvNullBiasPattern>(context);
+  results.insert<LayerNormalizationPattern>(context);
+  results.insert<LayerNormalizationScaleFirstPattern>(context);
+}
+
+/// on the ONNXMatMulOp.
+void ONNXMatMulOp::getCanonicalizationPatterns(
+    RewritePatternSet &results, MLIRContext *context) {
+  results.insert<AttentionPattern>(context);
+  results.insert<AttentionDivPattern>(context);
+  results.insert<AttentionMulPattern>(context);
+  results.insert<AttentionMaskPattern>(context);
+  results.insert<AttentionDivMaskPattern>(context);
+  results.insert<AttentionMulMaskPattern>(context);
 }
 
 /// on the ONNXIdentityOp.
@@ -131,6 +308,12 @@ void ONNXBatchNormalizationInferenceModeOp::getCanonicalizationPatterns(
   results.insert<RewriteBatchNormInferenceModeConvPattern2>(context);
 }
 
+/// on the ONNXLayoutTransformOp.
+void ONNXLayoutTransformOp::getCanonicalizationPatterns(
+    RewritePatternSet &results, MLIRContext *context) {
+  results.insert<RemoveLayoutTransformPairPattern>(context);
+}
+
 /// on the ONNXShapeOp.
 void ONNXShapeOp::getCanonicalizationPatterns(
     RewritePatternSet &results, MLIRContext *context) {
@@ -4,7 +4,8 @@
 
 //===------------- Conv.cpp - Shape Inference for Conv Op ---------------===//
 //
-// This file implements shape inference for the ONNX Conv Operator.
+// This file implements shape inference for the ONNX Conv and QLinearConv
+// Operators.
 //
 //===----------------------------------------------------------------------===//
 
@@ -27,3 +28,24 @@ LogicalResult ONNXConvOpShapeHelper::computeShape(
       ONNXConvOpAdaptor>::computeShape(operandAdaptor, operandAdaptor.W(),
       op->kernel_shape(), op->pads(), op->strides(), op->dilations());
 }
+
+ONNXQLinearConvOpShapeHelper::ONNXQLinearConvOpShapeHelper(
+    ONNXQLinearConvOp *newOp)
+    : ONNXGenericPoolShapeHelper<ONNXQLinearConvOp, ONNXQLinearConvOpAdaptor>(
+          newOp, true /*hasFilter*/, false /*hasCeil*/) {}
+
+ONNXQLinearConvOpShapeHelper::ONNXQLinearConvOpShapeHelper(
+    ONNXQLinearConvOp *newOp, OpBuilder *rewriter,
+    ArrayValueIndexCapture::GetDenseVal fGetDenseVal,
+    ArrayValueIndexCapture::LoadVal fLoadVal)
+    : ONNXGenericPoolShapeHelper<ONNXQLinearConvOp, ONNXQLinearConvOpAdaptor>(
+          newOp, true /*hasFilter*/, false /*hasCeil*/, rewriter, fGetDenseVal,
+          fLoadVal) {}
+
+LogicalResult ONNXQLinearConvOpShapeHelper::computeShape(
+    ONNXQLinearConvOpAdaptor operandAdaptor) {
+  return ONNXGenericPoolShapeHelper<ONNXQLinearConvOp,
+      ONNXQLinearConvOpAdaptor>::computeShape(operandAdaptor,
+      operandAdaptor.w(), op->kernel_shape(), op->pads(), op->strides(),
+      op->dilations());
+}
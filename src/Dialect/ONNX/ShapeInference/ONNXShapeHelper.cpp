@@ -261,13 +261,14 @@ LogicalResult ONNXGenericPoolShapeHelper<OP_TYPE, OP_ADAPTOR>::computeShape(
     Optional<ArrayAttr> kernelShapeOpt, Optional<ArrayAttr> padOpt,
     Optional<ArrayAttr> strideOpt, Optional<ArrayAttr> dilationOpt) {
   // Shape inference indicated by passing a null rewriter pointer.
-  // Basic information.
-  Value xValue = (Value)operandAdaptor.X();
+  // Basic information. The data input is the first operand of all the
+  // pool/conv ops (named X, or x for QLinearConv).
+  Value xValue = operandAdaptor.getOperands()[0];
   int64_t rank = xValue.getType().cast<ShapedType>().getRank();
   int64_t spatialOffset = 2;
   int64_t spatialRank = rank - spatialOffset;
 
-  MemRefBoundsIndexCapture XBounds(operandAdaptor.X());
+  MemRefBoundsIndexCapture XBounds(xValue);
   MemRefBoundsIndexCapture WBounds(filterValue);
 
   // Fill the stride, dilation, kernel.
@@ -416,6 +417,7 @@ template struct ONNXOpShapeHelper<ONNXMatMulOp>;
 template struct ONNXOpShapeHelper<ONNXMaxPoolSingleOutOp>;
 template struct ONNXOpShapeHelper<ONNXOneHotOp>;
 template struct ONNXOpShapeHelper<ONNXPadOp>;
+template struct ONNXOpShapeHelper<ONNXQLinearConvOp>;
 template struct ONNXOpShapeHelper<ONNXReshapeOp>;
 template struct ONNXOpShapeHelper<ONNXLRNOp>;
 template struct ONNXOpShapeHelper<ONNXReverseSequenceOp>;
@@ -440,5 +442,7 @@ template struct ONNXGenericPoolShapeHelper<ONNXAveragePoolOp,
 template struct ONNXGenericPoolShapeHelper<ONNXConvOp, ONNXConvOpAdaptor>;
 template struct ONNXGenericPoolShapeHelper<ONNXMaxPoolSingleOutOp,
     ONNXMaxPoolSingleOutOpAdaptor>;
+template struct ONNXGenericPoolShapeHelper<ONNXQLinearConvOp,
+    ONNXQLinearConvOpAdaptor>;
 
 // Keep template instantiation at the end of the file.
@@ -351,6 +351,17 @@ struct ONNXConvOpShapeHelper
   LogicalResult computeShape(ONNXConvOpAdaptor operandAdaptor);
 };
 
+// Shape for QLinearConv.
+struct ONNXQLinearConvOpShapeHelper
+    : public ONNXGenericPoolShapeHelper<ONNXQLinearConvOp,
+          ONNXQLinearConvOpAdaptor> {
+  ONNXQLinearConvOpShapeHelper(ONNXQLinearConvOp *newOp);
+  ONNXQLinearConvOpShapeHelper(ONNXQLinearConvOp *newOp, OpBuilder *rewriter,
+      ArrayValueIndexCapture::GetDenseVal fGetDenseVal,
+      ArrayValueIndexCapture::LoadVal fLoadVal);
+  LogicalResult computeShape(ONNXQLinearConvOpAdaptor operandAdaptor);
+};
+
 // Shape for MaxPoolSingleOut.
 struct ONNXMaxPoolSingleOutOpShapeHelper
     : public ONNXGenericPoolShapeHelper<ONNXMaxPoolSingleOutOp,
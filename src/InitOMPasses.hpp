@@ -49,6 +49,10 @@ void initOMPasses(int optLevel) {
     return mlir::createConstPropONNXToONNXPass();
   });
 
+  mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
+    return mlir::createONNXToNCHWcPass();
+  });
+
   mlir::registerPass([]() -> std::unique_ptr<mlir::Pass> {
     return mlir::createElideConstantValuePass();
   });
@@ -40,6 +40,10 @@ std::unique_ptr<Pass> createShapeInferencePass(
 
 std::unique_ptr<Pass> createConstPropONNXToONNXPass();
 
+/// Pass for rewriting convolutions to the NCHW<b>c blocked layout.
+std::unique_ptr<Pass> createONNXToNCHWcPass();
+std::unique_ptr<Pass> createONNXToNCHWcPass(int blockSize);
+
 /// Pass for eliding the values of constant operations.
 std::unique_ptr<Pass> createElideConstantValuePass();
 
@@ -78,5 +82,7 @@ std::unique_ptr<Pass> createElideConstGlobalValuePass();
 
 /// Pass for lowering Krnl dialect to LLVM dialect.
 std::unique_ptr<Pass> createConvertKrnlToLLVMPass();
+std::unique_ptr<Pass> createConvertKrnlToLLVMPass(
+    bool alignedEntryPoint, std::string symbolPrefix);
 
 } // end namespace mlir
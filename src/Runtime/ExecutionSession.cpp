@@ -13,54 +13,102 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <thread>
 #include <vector>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
 #include "ExecutionSession.hpp"
-#include "llvm/Support/ManagedStatic.h"
 
 namespace onnx_mlir {
 const std::string ExecutionSession::_inputSignatureName = "omInputSignature";
 const std::string ExecutionSession::_outputSignatureName = "omOutputSignature";
 
-ExecutionSession::ExecutionSession(
-    std::string sharedLibPath, std::string entryPointName) {
+// The library is loaded with local symbol visibility, so that the symbols of
+// several models, and of the runtime embedded in each of them, do not
+// interpose each other.
+static void *openLibrary(const std::string &path) {
+#ifdef _WIN32
+  return (void *)LoadLibraryA(path.c_str());
+#else
+  return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+}
 
-  _sharedLibraryHandle =
-      llvm::sys::DynamicLibrary::getPermanentLibrary(sharedLibPath.c_str());
-  if (!_sharedLibraryHandle.isValid()) {
+static void *getLibrarySymbol(void *handle, const std::string &name) {
+#ifdef _WIN32
+  return (void *)GetProcAddress((HMODULE)handle, name.c_str());
+#else
+  return dlsym(handle, name.c_str());
+#endif
+}
+
+static void closeLibrary(void *handle) {
+#ifdef _WIN32
+  FreeLibrary((HMODULE)handle);
+#else
+  dlclose(handle);
+#endif
+}
+
+ExecutionSession::ExecutionSession(std::string sharedLibPath,
+    std::string entryPointName, std::string symbolPrefix) {
+
+  _sharedLibraryHandle = openLibrary(sharedLibPath);
+  if (!_sharedLibraryHandle) {
     std::stringstream errStr;
     errStr << "Cannot open library: '" << sharedLibPath << "'" << std::endl;
     throw std::runtime_error(errStr.str());
   }
 
-  _entryPointFunc = reinterpret_cast<entryPointFuncType>(
-      _sharedLibraryHandle.getAddressOfSymbol(entryPointName.c_str()));
-  if (!_entryPointFunc) {
-    std::stringstream errStr;
-    errStr << "Cannot load symbol: '" << entryPointName << "'" << std::endl;
-    throw std::runtime_error(errStr.str());
-  }
+  // Look up a symbol, unloading the library if it is missing.
+  auto getSymbol = [&](const std::string &name) {
+    void *symbol = getLibrarySymbol(_sharedLibraryHandle, symbolPrefix + name);
+    if (!symbol) {
+      closeLibrary(_sharedLibraryHandle);
+      std::stringstream errStr;
+      errStr << "Cannot load symbol: '" << symbolPrefix + name << "'"
+             << std::endl;
+      throw std::runtime_error(errStr.str());
+    }
+    return symbol;
+  };
+
+  _entryPointFunc =
+      reinterpret_cast<entryPointFuncType>(getSymbol(entryPointName));
+  _inputSignatureFunc =
+      reinterpret_cast<signatureFuncType>(getSymbol(_inputSignatureName));
+  _outputSignatureFunc =
+      reinterpret_cast<signatureFuncType>(getSymbol(_outputSignatureName));
+}
 
-  _inputSignatureFunc = reinterpret_cast<signatureFuncType>(
-      _sharedLibraryHandle.getAddressOfSymbol(_inputSignatureName.c_str()));
-  if (!_inputSignatureFunc) {
-    std::stringstream errStr;
-    errStr << "Cannot load symbol: '" << _inputSignatureName << "'"
-           << std::endl;
-    throw std::runtime_error(errStr.str());
-  }
+typedef std::unique_ptr<OMTensor, decltype(&omTensorDestroy)> OMTensorPtr;
 
-  _outputSignatureFunc = reinterpret_cast<signatureFuncType>(
-      _sharedLibraryHandle.getAddressOfSymbol(_outputSignatureName.c_str()));
-  if (!_outputSignatureFunc) {
-    std::stringstream errStr;
-    errStr << "Cannot load symbol: '" << _outputSignatureName << "'"
-           << std::endl;
-    throw std::runtime_error(errStr.str());
+// Destroy a list, but not the tensors it holds.
+static void releaseList(OMTensorList *list) {
+  OMTensor **omts = omTensorListGetOmtArray(list);
+  for (int64_t i = 0; i < omTensorListGetSize(list); i++)
+    omts[i] = nullptr;
+  omTensorListDestroy(list);
+}
+
+// Hand the output tensors over to unique pointers.
+static std::vector<OMTensorPtr> unwrapOutput(OMTensorList *wrappedOutput) {
+  std::vector<OMTensorPtr> outs;
+  for (int64_t i = 0; i < omTensorListGetSize(wrappedOutput); i++) {
+    outs.emplace_back(OMTensorPtr(
+        omTensorListGetOmtByIndex(wrappedOutput, i), omTensorDestroy));
   }
+  releaseList(wrappedOutput);
+  return outs;
 }
 
 std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>>
@@ -70,17 +118,66 @@ ExecutionSession::run(
   std::vector<OMTensor *> omts;
   for (const auto &inOmt : ins)
     omts.emplace_back(inOmt.get());
-  auto *wrappedInput = omTensorListCreate(&omts[0], (int64_t)omts.size());
+  auto *wrappedInput = omTensorListCreate(omts.data(), (int64_t)omts.size());
 
   auto *wrappedOutput = _entryPointFunc(wrappedInput);
+  releaseList(wrappedInput);
 
-  std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>> outs;
+  return unwrapOutput(wrappedOutput);
+}
 
-  for (int64_t i = 0; i < omTensorListGetSize(wrappedOutput); i++) {
-    outs.emplace_back(std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
-        omTensorListGetOmtByIndex(wrappedOutput, i), omTensorDestroy));
+namespace {
+// State of an asynchronous inference, from submission to completion.
+struct AsyncRequest {
+  // The input list takes over the input tensors, using this array.
+  std::vector<OMTensor *> omts;
+  OMTensorList *wrappedInput;
+  std::promise<std::vector<OMTensorPtr>> promise;
+  // Kept alive until the inference completes.
+  std::shared_ptr<void> owner;
+};
+} // namespace
+
+static void asyncRequestDone(OMTensorList *wrappedOutput, void *userData) {
+  std::unique_ptr<AsyncRequest> request(static_cast<AsyncRequest *>(userData));
+  omTensorListDestroy(request->wrappedInput);
+  request->promise.set_value(unwrapOutput(wrappedOutput));
+}
+
+OMAsyncQueue *ExecutionSession::getAsyncQueue() {
+  std::lock_guard<std::mutex> lock(_asyncQueueMutex);
+  if (!_asyncQueue) {
+    int64_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    _asyncQueue = omAsyncQueueCreate(_entryPointFunc, numThreads);
+    if (!_asyncQueue)
+      throw std::runtime_error("Cannot create asynchronous inference queue");
   }
-  return outs;
+  return _asyncQueue;
+}
+
+std::future<std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>>>
+ExecutionSession::runAsync(
+    std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>> ins) {
+  return runAsyncOn(getAsyncQueue(), nullptr, std::move(ins));
+}
+
+std::future<std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>>>
+ExecutionSession::runAsyncOn(OMAsyncQueue *queue, std::shared_ptr<void> owner,
+    std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>> ins) {
+  auto *request = new AsyncRequest();
+  for (auto &inOmt : ins)
+    request->omts.emplace_back(inOmt.release());
+  request->wrappedInput = omTensorListCreate(
+      request->omts.data(), (int64_t)request->omts.size());
+  request->owner = std::move(owner);
+  auto future = request->promise.get_future();
+  if (omRunAsyncWithEntryPoint(queue, _entryPointFunc, request->wrappedInput,
+          asyncRequestDone, request)) {
+    omTensorListDestroy(request->wrappedInput);
+    delete request;
+    throw std::runtime_error("Cannot submit asynchronous inference");
+  }
+  return future;
 }
 
 std::string ExecutionSession::inputSignature() { return _inputSignatureFunc(); }
@@ -90,8 +187,10 @@ std::string ExecutionSession::outputSignature() {
 }
 
 ExecutionSession::~ExecutionSession() {
-  // Call llvm_shutdown which will take care of cleaning up our shared library
-  // handles
-  llvm::llvm_shutdown();
+  // Wait for pending asynchronous inferences.
+  omAsyncQueueDestroy(_asyncQueue);
+  // Only this session's copy of the library is unloaded, other sessions and
+  // global state are left untouched.
+  closeLibrary(_sharedLibraryHandle);
 }
 } // namespace onnx_mlir
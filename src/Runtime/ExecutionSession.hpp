@@ -16,11 +16,13 @@
 #pragma once
 
 #include <cassert>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "OnnxMlirRuntime.h"
-#include "llvm/Support/DynamicLibrary.h"
 
 namespace onnx_mlir {
 
@@ -29,12 +31,27 @@ typedef const char *(*signatureFuncType)();
 
 class ExecutionSession {
 public:
-  ExecutionSession(std::string sharedLibPath, std::string entryPointName);
+  // Load the model library at sharedLibPath. Models compiled with
+  // --symbol-prefix export all their symbols, including the entry point,
+  // with that prefix, which must then be given as symbolPrefix. The library
+  // is loaded with local symbol visibility, so that different libraries do
+  // not interpose each other. Loading is reference-counted: sessions created
+  // from the same path share one instance of the library, including its
+  // global state, which is unloaded when the last of them is destroyed.
+  ExecutionSession(std::string sharedLibPath, std::string entryPointName,
+      std::string symbolPrefix = "");
 
   // Use custom deleter since forward declared OMTensor hides destructor
   std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>> run(
       std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>>);
 
+  // Enqueue an inference on a pool of worker threads and return without
+  // waiting for it. The future is ready once the inference completes.
+  std::future<
+      std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>>>
+  runAsync(
+      std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>>);
+
   // Get input and output signature as a Json string. For example for nminst:
   // `[ { "type" : "f32" , "dims" : [1 , 1 , 28 , 28] , "name" : "image" } ]`
   std::string inputSignature();
@@ -43,8 +60,17 @@ public:
   ~ExecutionSession();
 
 protected:
+  friend class MultiModelSession;
+
+  // Enqueue an inference on the given queue, which may be shared with other
+  // sessions. The owner is released once the inference completes.
+  std::future<
+      std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>>>
+  runAsyncOn(OMAsyncQueue *queue, std::shared_ptr<void> owner,
+      std::vector<std::unique_ptr<OMTensor, decltype(&omTensorDestroy)>>);
+
   // Handler to the shared library file being loaded.
-  llvm::sys::DynamicLibrary _sharedLibraryHandle;
+  void *_sharedLibraryHandle = nullptr;
 
   // Entry point function.
   entryPointFuncType _entryPointFunc = nullptr;
@@ -54,5 +80,10 @@ protected:
   static const std::string _outputSignatureName;
   signatureFuncType _inputSignatureFunc = nullptr;
   signatureFuncType _outputSignatureFunc = nullptr;
+
+  // Queue of asynchronous inferences, created on first use.
+  OMAsyncQueue *getAsyncQueue();
+  OMAsyncQueue *_asyncQueue = nullptr;
+  std::mutex _asyncQueueMutex;
 };
 } // namespace onnx_mlir
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------ MultiModelSession.cpp - MultiModelSession Implementation ------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains implementations of MultiModelSession class, which helps
+// C++ programs serve several compiled binary model libraries in one process.
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+#include "MultiModelSession.hpp"
+
+namespace onnx_mlir {
+
+// The shared queue is only given entry points along with each request.
+static OMTensorList *noEntryPoint(OMTensorList *input) { return nullptr; }
+
+MultiModelSession::MultiModelSession(int64_t numThreads) {
+  if (numThreads <= 0)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  _asyncQueue = omAsyncQueueCreate(noEntryPoint, numThreads);
+}
+
+void MultiModelSession::load(const std::string &modelName,
+    const std::string &sharedLibPath, const std::string &symbolPrefix,
+    const std::string &entryPointName) {
+  // Load outside of the lock, loading may take a while.
+  auto session = std::make_shared<ExecutionSession>(
+      sharedLibPath, entryPointName, symbolPrefix);
+  std::lock_guard<std::mutex> lock(_sessionsMutex);
+  _sessions[modelName] = session;
+}
+
+void MultiModelSession::unload(const std::string &modelName) {
+  std::shared_ptr<ExecutionSession> session;
+  {
+    std::lock_guard<std::mutex> lock(_sessionsMutex);
+    auto it = _sessions.find(modelName);
+    if (it == _sessions.end())
+      return;
+    session = std::move(it->second);
+    _sessions.erase(it);
+  }
+  // Running inferences hold their own reference to the session.
+}
+
+bool MultiModelSession::isLoaded(const std::string &modelName) {
+  std::lock_guard<std::mutex> lock(_sessionsMutex);
+  return _sessions.count(modelName) != 0;
+}
+
+std::vector<std::string> MultiModelSession::getModelNames() {
+  std::lock_guard<std::mutex> lock(_sessionsMutex);
+  std::vector<std::string> names;
+  for (const auto &entry : _sessions)
+    names.emplace_back(entry.first);
+  return names;
+}
+
+std::shared_ptr<ExecutionSession> MultiModelSession::getSession(
+    const std::string &modelName) {
+  std::lock_guard<std::mutex> lock(_sessionsMutex);
+  auto it = _sessions.find(modelName);
+  if (it == _sessions.end()) {
+    std::stringstream errStr;
+    errStr << "Model not loaded: '" << modelName << "'" << std::endl;
+    throw std::runtime_error(errStr.str());
+  }
+  return it->second;
+}
+
+std::vector<MultiModelSession::OMTensorPtr> MultiModelSession::run(
+    const std::string &modelName, std::vector<OMTensorPtr> ins) {
+  auto session = getSession(modelName);
+  return session->run(std::move(ins));
+}
+
+std::future<std::vector<MultiModelSession::OMTensorPtr>>
+MultiModelSession::runAsync(
+    const std::string &modelName, std::vector<OMTensorPtr> ins) {
+  if (!_asyncQueue)
+    throw std::runtime_error("Cannot create asynchronous inference queue");
+  auto session = getSession(modelName);
+  return session->runAsyncOn(_asyncQueue, session, std::move(ins));
+}
+
+std::string MultiModelSession::inputSignature(const std::string &modelName) {
+  return getSession(modelName)->inputSignature();
+}
+
+std::string MultiModelSession::outputSignature(const std::string &modelName) {
+  return getSession(modelName)->outputSignature();
+}
+
+MultiModelSession::~MultiModelSession() {
+  // Wait for pending asynchronous inferences, which may release the last
+  // references to some sessions, then unload the remaining models.
+  omAsyncQueueDestroy(_asyncQueue);
+  _sessions.clear();
+}
+} // namespace onnx_mlir
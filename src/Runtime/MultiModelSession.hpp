@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------- MultiModelSession.hpp - MultiModelSession Declaration --------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declarations of MultiModelSession class, which helps C++
+// programs serve several compiled binary model libraries in one process.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ExecutionSession.hpp"
+
+namespace onnx_mlir {
+
+// A set of models, loaded and unloaded by name, whose asynchronous
+// inferences share one pool of worker threads.
+class MultiModelSession {
+public:
+  typedef std::unique_ptr<OMTensor, decltype(&omTensorDestroy)> OMTensorPtr;
+
+  // Use numThreads worker threads for asynchronous inferences, or one per
+  // hardware thread if numThreads is 0.
+  MultiModelSession(int64_t numThreads = 0);
+
+  // Load a model library under modelName, replacing any model already
+  // loaded under that name. See ExecutionSession for symbolPrefix.
+  void load(const std::string &modelName, const std::string &sharedLibPath,
+      const std::string &symbolPrefix = "",
+      const std::string &entryPointName = "run_main_graph");
+
+  // Unload the model. Inferences already running or queued complete first,
+  // and the library is unloaded once the last one is done. Outputs that are
+  // constants of the model must not be used after that.
+  void unload(const std::string &modelName);
+
+  bool isLoaded(const std::string &modelName);
+  std::vector<std::string> getModelNames();
+
+  std::vector<OMTensorPtr> run(
+      const std::string &modelName, std::vector<OMTensorPtr> ins);
+  std::future<std::vector<OMTensorPtr>> runAsync(
+      const std::string &modelName, std::vector<OMTensorPtr> ins);
+
+  std::string inputSignature(const std::string &modelName);
+  std::string outputSignature(const std::string &modelName);
+
+  ~MultiModelSession();
+
+private:
+  std::shared_ptr<ExecutionSession> getSession(const std::string &modelName);
+
+  std::map<std::string, std::shared_ptr<ExecutionSession>> _sessions;
+  std::mutex _sessionsMutex;
+
+  // Queue of asynchronous inferences of all the models.
+  OMAsyncQueue *_asyncQueue = nullptr;
+};
+} // namespace onnx_mlir
@@ -0,0 +1,15 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===--------------- OMAsync.c - OMAsyncQueue C Implementation ------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains implementation of the asynchronous inference API.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OMAsync.inc"
@@ -0,0 +1,15 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===---------- OMTensorArena.c - OMTensorArena C Implementation ----------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains implementation of OMTensorArena.
+//
+//===----------------------------------------------------------------------===//
+
+#include "OMTensorArena.inc"
@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===----- OMTensorArenaInternal.h - OMTensorArena Runtime Internals ------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains declaration of OMTensorArena functions used by the
+// OMTensor and OMTensorList implementations.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef ONNX_MLIR_OMTENSORARENAINTERNAL_H
+#define ONNX_MLIR_OMTENSORARENAINTERNAL_H
+
+#include "onnx-mlir/Runtime/OMTensorArena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Allocate size bytes, aligned on 16 bytes, from the current arena of the
+ * thread if any, from the heap otherwise. *inArena tells which one.
+ */
+void *omTensorArenaAllocate(int64_t size, int64_t *inArena);
+
+/* Whether ptr was allocated from the current arena of the thread */
+int64_t omTensorArenaOwns(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONNX_MLIR_OMTENSORARENAINTERNAL_H
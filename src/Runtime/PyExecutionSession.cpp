@@ -13,33 +13,31 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <unordered_map>
+
 #include "onnx/onnx_pb.h"
 
 #include "PyExecutionSession.hpp"
 
 namespace onnx_mlir {
 
-std::vector<py::array> PyExecutionSession::pyRun(
-    const std::vector<py::array> &inputsPyArray) {
-  assert(_entryPointFunc && "Entry point not loaded.");
+// Python objects keeping alive the buffers that outputs may point to,
+// indexed by allocated pointer.
+typedef std::unordered_map<void *, py::object> BufferOwners;
 
-  std::vector<OMTensor *> omts;
+// Wrap the input arrays into OMTensors, appended to omts, and return the
+// input list using omts.
+static OMTensorList *wrapPyInputs(const std::vector<py::array> &inputsPyArray,
+    std::vector<OMTensor *> &omts, BufferOwners &bufferOwners) {
   for (auto inputPyArray : inputsPyArray) {
     assert(inputPyArray.flags() && py::array::c_style &&
            "Expect contiguous python array.");
 
-    void *dataPtr;
-    int64_t ownData = 0;
-    if (inputPyArray.writeable()) {
-      dataPtr = inputPyArray.mutable_data();
-    } else {
-      // If data is not writable, copy them to a writable buffer.
-      auto *copiedData = (float *)malloc(inputPyArray.nbytes());
-      memcpy(copiedData, inputPyArray.data(), inputPyArray.nbytes());
-      dataPtr = copiedData;
-      // We want OMTensor to free up the memory space upon destruction.
-      ownData = 1;
-    }
+    // Compiled models never write into their inputs, so read-only arrays are
+    // passed through without a copy. The OMTensor does not own the data.
+    void *dataPtr = const_cast<void *>(inputPyArray.data());
+    // Outputs that alias an input keep that input array alive.
+    bufferOwners[dataPtr] = inputPyArray;
 
     // Borrowed from:
     // https://github.com/pybind/pybind11/issues/563#issuecomment-267835542
@@ -60,7 +58,10 @@ std::vector<py::array> PyExecutionSession::pyRun(
       dtype = ONNX_TYPE_INT64;
     else if (py::isinstance<py::array_t<bool>>(inputPyArray))
       dtype = ONNX_TYPE_BOOL;
-    // Missing fp16 support.
+    // Numpy has no native fp16 scalar type usable with py::array_t, so
+    // compare the dtype by value. Bfloat16 has no numpy equivalent.
+    else if (inputPyArray.dtype().equal(py::dtype("float16")))
+      dtype = ONNX_TYPE_FLOAT16;
     else if (py::isinstance<py::array_t<double>>(inputPyArray))
       dtype = ONNX_TYPE_DOUBLE;
     else if (py::isinstance<py::array_t<std::uint32_t>>(inputPyArray))
@@ -75,16 +76,19 @@ std::vector<py::array> PyExecutionSession::pyRun(
 
     auto *inputOMTensor = omTensorCreateWithOwnership(dataPtr,
         (int64_t *)(const_cast<ssize_t *>(inputPyArray.shape())),
-        (int64_t)inputPyArray.ndim(), dtype, ownData);
+        (int64_t)inputPyArray.ndim(), dtype, /*owning=*/0);
     omTensorSetStridesWithPyArrayStrides(inputOMTensor,
         (int64_t *)const_cast<ssize_t *>(inputPyArray.strides()));
 
     omts.emplace_back(inputOMTensor);
   }
 
-  auto *wrappedInput = omTensorListCreate(&omts[0], omts.size());
-  auto *wrappedOutput = _entryPointFunc(wrappedInput);
+  return omTensorListCreate(omts.data(), omts.size());
+}
 
+// Convert the output list into arrays and destroy it.
+static std::vector<py::array> unwrapPyOutputs(
+    OMTensorList *wrappedOutput, BufferOwners &bufferOwners) {
   std::vector<py::array> outputPyArrays;
   for (int64_t i = 0; i < omTensorListGetSize(wrappedOutput); i++) {
     auto *omt = omTensorListGetOmtByIndex(wrappedOutput, i);
@@ -113,7 +117,22 @@ std::vector<py::array> PyExecutionSession::pyRun(
       dtype = py::dtype("bool_");
     else if (omTensorGetDataType(omt) ==
              (OM_DATA_TYPE)onnx::TensorProto::FLOAT16)
-      dtype = py::dtype("float32");
+      dtype = py::dtype("float16");
+    else if (omTensorGetDataType(omt) ==
+             (OM_DATA_TYPE)onnx::TensorProto::BFLOAT16) {
+      // Numpy has no bfloat16 type: widen the values into a float32 array,
+      // bfloat16 being the upper half of the float32 bit pattern.
+      py::array_t<float> widened(shape);
+      const uint16_t *src =
+          reinterpret_cast<const uint16_t *>(omTensorGetDataPtr(omt));
+      float *dst = widened.mutable_data();
+      for (int64_t e = 0; e < omTensorGetNumElems(omt); ++e) {
+        uint32_t bits = ((uint32_t)src[e]) << 16;
+        memcpy(&dst[e], &bits, sizeof(float));
+      }
+      outputPyArrays.emplace_back(widened);
+      continue;
+    }
     else if (omTensorGetDataType(omt) ==
              (OM_DATA_TYPE)onnx::TensorProto::DOUBLE)
       dtype = py::dtype("float64");
@@ -128,13 +147,104 @@ std::vector<py::array> PyExecutionSession::pyRun(
       exit(1);
     }
 
+    // Hand the output buffer over to numpy without a copy: a capsule frees it
+    // once the last array viewing it is gone. Buffers already handed over,
+    // e.g. outputs returned twice, and inputs are shared with their owner.
+    // Constant outputs are not owned by the OMTensor and are copied, since
+    // they live in the model library.
+    void *allocatedPtr = omTensorGetAllocatedPtr(omt);
+    py::object base;
+    auto owner = bufferOwners.find(allocatedPtr);
+    if (owner != bufferOwners.end())
+      base = owner->second;
+    else if (omTensorGetOwning(omt)) {
+      base = py::capsule(allocatedPtr, [](void *ptr) { free(ptr); });
+      bufferOwners[allocatedPtr] = base;
+    }
+    if (base)
+      omTensorSetOwning(omt, /*owning=*/0);
     outputPyArrays.emplace_back(
-        py::array(dtype, shape, omTensorGetDataPtr(omt)));
+        py::array(dtype, shape, omTensorGetDataPtr(omt), base));
   }
+  omTensorListDestroy(wrappedOutput);
 
   return outputPyArrays;
 }
 
+std::vector<py::array> PyExecutionSession::pyRun(
+    const std::vector<py::array> &inputsPyArray) {
+  assert(_entryPointFunc && "Entry point not loaded.");
+
+  std::vector<OMTensor *> omts;
+  BufferOwners bufferOwners;
+  auto *wrappedInput = wrapPyInputs(inputsPyArray, omts, bufferOwners);
+  OMTensorList *wrappedOutput;
+  {
+    // The inference only touches OMTensors, so other Python threads may run
+    // meanwhile, including other inferences.
+    py::gil_scoped_release release;
+    wrappedOutput = _entryPointFunc(wrappedInput);
+  }
+  omTensorListDestroy(wrappedInput);
+
+  return unwrapPyOutputs(wrappedOutput, bufferOwners);
+}
+
+namespace {
+// State of an asynchronous inference, from submission to completion.
+struct PyAsyncRequest {
+  std::vector<OMTensor *> omts;
+  OMTensorList *wrappedInput;
+  // Also keeps the input arrays alive until completion.
+  BufferOwners bufferOwners;
+  py::object future;
+};
+} // namespace
+
+// Called from a worker thread once the inference completes.
+static void pyAsyncRequestDone(OMTensorList *wrappedOutput, void *userData) {
+  py::gil_scoped_acquire acquire;
+  std::unique_ptr<PyAsyncRequest> request(
+      static_cast<PyAsyncRequest *>(userData));
+  omTensorListDestroy(request->wrappedInput);
+  auto outputPyArrays = unwrapPyOutputs(wrappedOutput, request->bufferOwners);
+  try {
+    // The future may have been cancelled meanwhile.
+    if (request->future.attr("set_running_or_notify_cancel")().cast<bool>())
+      request->future.attr("set_result")(outputPyArrays);
+  } catch (py::error_already_set &e) {
+    // There is no Python caller on this thread to raise to.
+    e.restore();
+    PyErr_WriteUnraisable(request->future.ptr());
+  }
+}
+
+py::object PyExecutionSession::pyRunAsync(
+    const std::vector<py::array> &inputsPyArray) {
+  assert(_entryPointFunc && "Entry point not loaded.");
+
+  auto request = std::make_unique<PyAsyncRequest>();
+  request->wrappedInput =
+      wrapPyInputs(inputsPyArray, request->omts, request->bufferOwners);
+  request->future = py::module::import("concurrent.futures").attr("Future")();
+  py::object future = request->future;
+  if (omRunAsync(getAsyncQueue(), request->wrappedInput, pyAsyncRequestDone,
+          request.get())) {
+    omTensorListDestroy(request->wrappedInput);
+    throw std::runtime_error("Cannot submit asynchronous inference");
+  }
+  request.release();
+  return future;
+}
+
+PyExecutionSession::~PyExecutionSession() {
+  // Pending inferences need the GIL to complete: release it while waiting
+  // for them, before the base class destroys the queue.
+  py::gil_scoped_release release;
+  omAsyncQueueDestroy(_asyncQueue);
+  _asyncQueue = nullptr;
+}
+
 std::string PyExecutionSession::pyInputSignature() {
   assert(_inputSignatureFunc && "Input signature entry point not loaded.");
   return inputSignature();
@@ -25,10 +25,17 @@ namespace onnx_mlir {
 
 class PyExecutionSession : public onnx_mlir::ExecutionSession {
 public:
-  PyExecutionSession(std::string sharedLibPath, std::string entryPointName)
-      : onnx_mlir::ExecutionSession(sharedLibPath, entryPointName){};
+  PyExecutionSession(std::string sharedLibPath, std::string entryPointName,
+      std::string symbolPrefix = "")
+      : onnx_mlir::ExecutionSession(
+            sharedLibPath, entryPointName, symbolPrefix){};
+
+  ~PyExecutionSession();
 
   std::vector<py::array> pyRun(const std::vector<py::array> &inputsPyArray);
+  // Return a concurrent.futures.Future set to the outputs once the
+  // inference, run by a worker thread, completes.
+  py::object pyRunAsync(const std::vector<py::array> &inputsPyArray);
 
   std::string pyInputSignature();
   std::string pyOutputSignature();
@@ -37,8 +44,12 @@ public:
 
 PYBIND11_MODULE(PyRuntime, m) {
   py::class_<onnx_mlir::PyExecutionSession>(m, "ExecutionSession")
-      .def(py::init<const std::string &, const std::string &>())
+      .def(py::init<const std::string &, const std::string &,
+               const std::string &>(),
+          py::arg("path"), py::arg("entry_point"),
+          py::arg("symbol_prefix") = "")
       .def("run", &onnx_mlir::PyExecutionSession::pyRun)
+      .def("run_async", &onnx_mlir::PyExecutionSession::pyRunAsync)
       .def("input_signature", &onnx_mlir::PyExecutionSession::pyInputSignature)
       .def("output_signature",
           &onnx_mlir::PyExecutionSession::pyOutputSignature);
@@ -0,0 +1,21 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_ibm_onnxmlir_OMTensor */
+
+#ifndef _Included_com_ibm_onnxmlir_OMTensor
+#define _Included_com_ibm_onnxmlir_OMTensor
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     com_ibm_onnxmlir_OMTensor
+ * Method:    free_data_jni
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_ibm_onnxmlir_OMTensor_free_1data_1jni(
+    JNIEnv *, jclass, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
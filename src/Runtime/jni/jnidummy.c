@@ -14,6 +14,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "com_ibm_onnxmlir_OMModel.h"
+#include "com_ibm_onnxmlir_OMTensor.h"
 
 /* Dummy routine to force the link editor to embed code in libjniruntime.a
    into libmodel.so */
@@ -21,4 +22,5 @@ void __dummy_do_not_call__(JNIEnv *env, jclass cls, jobject obj) {
   Java_com_ibm_onnxmlir_OMModel_main_1graph_1jni(NULL, NULL, NULL);
   Java_com_ibm_onnxmlir_OMModel_input_1signature_1jni(NULL, NULL);
   Java_com_ibm_onnxmlir_OMModel_output_1signature_1jni(NULL, NULL);
+  Java_com_ibm_onnxmlir_OMTensor_free_1data_1jni(NULL, NULL, 0);
 }
@@ -84,6 +84,11 @@ enum { LOG_TRACE, LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_FATAL };
     case ONNX_TYPE_DOUBLE:                                                     \
       LOG_BUF_C_TYPE(double, hex ? " %016x" : " %lf", buf, data, n);           \
       break;                                                                   \
+    /* No C type for half precision, always print the bit patterns. */         \
+    case ONNX_TYPE_FLOAT16:                                                    \
+    case ONNX_TYPE_BFLOAT16:                                                   \
+      LOG_BUF_C_TYPE(short, " %04x", buf, data, n);                            \
+      break;                                                                   \
     default:                                                                   \
       sprintf(buf, " unsupported data type %d ", type);                        \
     }                                                                          \
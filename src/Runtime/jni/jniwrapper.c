@@ -15,6 +15,7 @@
 
 #include <assert.h>
 #include <limits.h>
+#include <stdint.h>
 #if defined(__APPLE__) || defined(__MVS__)
 #include <stdlib.h>
 #else
@@ -24,6 +25,7 @@
 
 #include "OnnxMlirRuntime.h"
 #include "com_ibm_onnxmlir_OMModel.h"
+#include "com_ibm_onnxmlir_OMTensor.h"
 #include "jnilog.h"
 
 extern OMTensorList *run_main_graph(OMTensorList *);
@@ -183,7 +185,7 @@ jniapi_t *fill_jniapi(JNIEnv *env, jniapi_t *japi) {
   /* Get method ID of constructor and various methods in OMTensor */
   JNI_VAR_CALL(env, japi->jomt_constructor,
       (*env)->GetMethodID(
-          env, japi->jomt_cls, "<init>", "(Ljava/nio/ByteBuffer;[J[JI)V"),
+          env, japi->jomt_cls, "<init>", "(Ljava/nio/ByteBuffer;[J[JIJ)V"),
       japi->jomt_constructor != NULL, japi->jecpt_cls,
       "Method OMTensor.<init> not found");
   JNI_VAR_CALL(env, japi->jomt_getData,
@@ -248,6 +250,76 @@ jniapi_t *fill_jniapi(JNIEnv *env, jniapi_t *japi) {
   return japi;
 }
 
+/* Java classes and method IDs are looked up once, when the model library
+ * is loaded, instead of on every inference. Method IDs can be shared
+ * across threads. Apparently J9 cannot have the return pointer of
+ * FindClass shared across threads, so the classes are kept as global
+ * references.
+ */
+static jniapi_t jniapi;
+
+/* Replace the local class references in japi by global references */
+jniapi_t *globalize_jniapi(JNIEnv *env, jniapi_t *japi) {
+  jclass *clss[] = {&japi->jecpt_cls, &japi->jlong_cls, &japi->jstring_cls,
+      &japi->jomt_cls, &japi->jomtl_cls};
+
+  for (int i = 0; i < (int)(sizeof(clss) / sizeof(clss[0])); i++) {
+    JNI_TYPE_VAR_CALL(env, jclass, global_cls,
+        (*env)->NewGlobalRef(env, *clss[i]), global_cls != NULL, NULL,
+        "global_cls[%d]=%p", i, global_cls);
+    (*env)->DeleteLocalRef(env, *clss[i]);
+    *clss[i] = global_cls;
+  }
+  return japi;
+}
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
+  JNIEnv *env;
+
+  log_init();
+
+  if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_6) != JNI_OK) {
+    LOG_PRINTF(LOG_ERROR, "JNI version 1.6 not supported");
+    return JNI_ERR;
+  }
+
+  /* Find and initialize Java method IDs in struct jniapi */
+  if (!fill_jniapi(env, &jniapi) || !globalize_jniapi(env, &jniapi))
+    return JNI_ERR;
+
+  return JNI_VERSION_1_6;
+}
+
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
+  JNIEnv *env;
+
+  if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_6) != JNI_OK)
+    return;
+
+  (*env)->DeleteGlobalRef(env, jniapi.jecpt_cls);
+  (*env)->DeleteGlobalRef(env, jniapi.jlong_cls);
+  (*env)->DeleteGlobalRef(env, jniapi.jstring_cls);
+  (*env)->DeleteGlobalRef(env, jniapi.jomt_cls);
+  (*env)->DeleteGlobalRef(env, jniapi.jomtl_cls);
+}
+
+/* Check whether a native output buffer is also the buffer of an input,
+ * e.g. for an Identity model, or of an earlier output. Such a buffer
+ * must not be handed over to Java, which would free it twice.
+ */
+int is_shared_buffer(
+    void *ptr, OMTensorList *jni_iomtl, OMTensor **jni_omts, int n) {
+  OMTensor **jni_iomts = omTensorListGetOmtArray(jni_iomtl);
+
+  for (int64_t i = 0; i < omTensorListGetSize(jni_iomtl); i++)
+    if (omTensorGetAllocatedPtr(jni_iomts[i]) == ptr)
+      return 1;
+  for (int i = 0; i < n; i++)
+    if (omTensorGetAllocatedPtr(jni_omts[i]) == ptr)
+      return 1;
+  return 0;
+}
+
 /* Convert Java object to native data structure
  *
  *          +---------------------------+
@@ -429,7 +501,8 @@ OMTensorList *omtl_java_to_native(
  *                            +--------------------+ (constructed by
  *                            | native buffer      |  model runtime)
  *                            +--------------------+
- *                            ^ ownership true -> false, xferred to Java
+ *                            ^ ownership true -> false, xferred to Java,
+ *                            | freed by the Java OMTensor buffer cleaner
  *                      +-----|---------+
  *                      | _allocatedPtr | (constructed by model runtime)
  *                      |               |<---+
@@ -443,8 +516,8 @@ OMTensorList *omtl_java_to_native(
  *        | omTensorList                | (constructed by model runtime)
  *        +-----------------------------+
  */
-jobject omtl_native_to_java(
-    JNIEnv *env, jclass cls, OMTensorList *jni_omtl, jniapi_t *japi) {
+jobject omtl_native_to_java(JNIEnv *env, jclass cls, OMTensorList *jni_omtl,
+    OMTensorList *jni_iomtl, jniapi_t *japi) {
 
   /* Get the OMTensor array in the OMTensorList */
   LIB_TYPE_VAR_CALL(OMTensor **, jni_omts, omTensorListGetOmtArray(jni_omtl),
@@ -465,6 +538,9 @@ jobject omtl_native_to_java(
 
     LIB_TYPE_VAR_CALL(void *, jni_data, omTensorGetDataPtr(jni_omts[i]),
         jni_data != NULL, env, japi->jecpt_cls, "omt[%d]:data=%p", i, jni_data);
+    LIB_TYPE_VAR_CALL(void *, jni_allocatedPtr,
+        omTensorGetAllocatedPtr(jni_omts[i]), jni_allocatedPtr != NULL, env,
+        japi->jecpt_cls, "omt[%d]:allocatedPtr=%p", i, jni_allocatedPtr);
     LIB_TYPE_VAR_CALL(int64_t *, jni_shape, omTensorGetShape(jni_omts[i]),
         jni_shape != NULL, env, japi->jecpt_cls, "omt[%d]:shape=%p", i,
         jni_shape);
@@ -501,9 +577,10 @@ jobject omtl_native_to_java(
      * If jni_owning is true, we take ownership by setting owner flag
      * to false. This means that when we call omTensorListDestroy
      * the data buffer will not be freed since it has been given to
-     * the Java direct byte buffer and the Java GC will be responsible
-     * for freeing the data buffer. This way we avoid copying the data
-     * buffer.
+     * the Java direct byte buffer. The Java OMTensor registers the
+     * allocated pointer with its buffer cleaner, which frees the data
+     * buffer once the direct byte buffer is garbage collected. This
+     * way we avoid copying the data buffer.
      *
      * If jni_owning is false, it means the data buffer is not freeable
      * due to one of the two following cases:
@@ -513,12 +590,17 @@ jobject omtl_native_to_java(
      *   - the data buffer is static
      *
      * Either way, since the data buffer will be given to Java and is
-     * subject to GC, we must make a copy of the data buffer.
+     * subject to GC, we must make a copy of the data buffer. The same
+     * goes for a buffer shared with an input or an earlier output.
      */
     void *jbytebuffer_data = jni_data;
+    void *jbytebuffer_allocatedPtr = jni_allocatedPtr;
     if (jni_owning) {
       LIB_CALL(omTensorSetOwning(jni_omts[i], (int64_t)0), 1, env,
           japi->jecpt_cls, "");
+    }
+    if (jni_owning &&
+        !is_shared_buffer(jni_allocatedPtr, jni_iomtl, jni_omts, i)) {
       LOG_PRINTF(LOG_DEBUG, "omt[%d]:%p data %p ownership taken", i,
           jni_omts[i], jni_data);
     } else {
@@ -526,6 +608,7 @@ jobject omtl_native_to_java(
           jbytebuffer_data != NULL, env, japi->jecpt_cls, "jbytebuffer_data=%p",
           jbytebuffer_data);
       memcpy(jbytebuffer_data, jni_data, jni_bufferSize);
+      jbytebuffer_allocatedPtr = jbytebuffer_data;
       LOG_PRINTF(LOG_DEBUG, "omt[%d]:%p data %p copied into %p", i, jni_omts[i],
           jni_data, jbytebuffer_data);
     }
@@ -555,7 +638,8 @@ jobject omtl_native_to_java(
     /* Create the OMTensor Java object */
     JNI_TYPE_VAR_CALL(env, jobject, jobj_omt,
         (*env)->NewObject(env, japi->jomt_cls, japi->jomt_constructor,
-            jomt_data, jomt_shape, jomt_strides, jomt_dataType),
+            jomt_data, jomt_shape, jomt_strides, jomt_dataType,
+            (jlong)(intptr_t)jbytebuffer_allocatedPtr),
         jobj_omt != NULL, japi->jecpt_cls, "omt[%d]:jobj_omt=%p", i, jobj_omt);
 
     /* Set the OMTensor object in the object array */
@@ -575,18 +659,11 @@ jobject omtl_native_to_java(
 JNIEXPORT jobject JNICALL Java_com_ibm_onnxmlir_OMModel_main_1graph_1jni(
     JNIEnv *env, jclass cls, jobject java_iomtl) {
 
-  /* Apparently J9 cannot have the return pointer of FindClass shared
-   * across threads. So move jniapi into stack so each thread has its
-   * own copy.
-   */
-  jniapi_t jniapi;
+  /* Java classes and method IDs cached by JNI_OnLoad */
+  jniapi_t *japi = &jniapi;
 
   log_init();
 
-  /* Find and initialize Java method IDs in struct jniapi */
-  CHECK_CALL(jniapi_t *, japi, fill_jniapi(env, &jniapi), japi != NULL,
-      "japi=%p", japi);
-
   /* Convert Java object to native data structure */
   CHECK_CALL(OMTensorList *, jni_iomtl,
       omtl_java_to_native(env, cls, java_iomtl, japi), jni_iomtl != NULL,
@@ -598,7 +675,8 @@ JNIEXPORT jobject JNICALL Java_com_ibm_onnxmlir_OMModel_main_1graph_1jni(
 
   /* Convert native data structure to Java object */
   CHECK_CALL(jobject, java_oomtl,
-      omtl_native_to_java(env, cls, jni_oomtl, japi), java_oomtl != NULL,
+      omtl_native_to_java(env, cls, jni_oomtl, jni_iomtl, japi),
+      java_oomtl != NULL,
       "java_oomtl=%p", java_oomtl);
 
   /* Free intermediate data structures and return Java object */
@@ -652,3 +730,12 @@ JNIEXPORT jstring JNICALL Java_com_ibm_onnxmlir_OMModel_output_1signature_1jni(
 
   return jstr_osig;
 }
+
+JNIEXPORT void JNICALL Java_com_ibm_onnxmlir_OMTensor_free_1data_1jni(
+    JNIEnv *env, jclass cls, jlong allocatedPtr) {
+
+  log_init();
+
+  LOG_PRINTF(LOG_DEBUG, "data %p freed", (void *)(intptr_t)allocatedPtr);
+  free((void *)(intptr_t)allocatedPtr);
+}
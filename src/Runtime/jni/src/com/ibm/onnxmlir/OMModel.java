@@ -12,6 +12,9 @@ import java.nio.file.StandardCopyOption;
 import java.nio.file.attribute.PosixFilePermissions;
 import java.util.Comparator;
 import java.util.Enumeration;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
 import java.util.jar.JarEntry;
 import java.util.jar.JarFile;
 import java.util.logging.Logger;
@@ -89,6 +92,32 @@ public class OMModel {
         return main_graph_jni(list);
     }
 
+    /* Worker threads running asynchronous inferences. They are daemon
+     * threads so that they never keep the JVM alive. Created when the
+     * first asynchronous inference is submitted.
+     */
+    private static final class AsyncWorkers {
+        static final ExecutorService pool = Executors.newFixedThreadPool(
+            Runtime.getRuntime().availableProcessors(), r -> {
+                Thread t = new Thread(r, "OMModel async worker");
+                t.setDaemon(true);
+                return t;
+            });
+    }
+
+    /**
+     * Asynchronous inference
+     *
+     * @param list input tensor list, must not be modified until the
+     *        inference completes
+     * @return future completed with the output tensor list, or
+     *         exceptionally if the inference throws
+     */
+    public static CompletableFuture<OMTensorList> mainGraphAsync(OMTensorList list) {
+        return CompletableFuture.supplyAsync(() -> main_graph_jni(list),
+                                             AsyncWorkers.pool);
+    }
+
     public static String inputSignature() {
         return input_signature_jni();
     }
@@ -73,6 +73,7 @@ public class OMRunner
 	    put("u4", OMTensor.ONNX_TYPE_UINT32);
 	    put("i8", OMTensor.ONNX_TYPE_INT64);
 	    put("u8", OMTensor.ONNX_TYPE_UINT64);
+	    put("f2", OMTensor.ONNX_TYPE_FLOAT16);
 	    put("f4", OMTensor.ONNX_TYPE_FLOAT);
 	    put("f8", OMTensor.ONNX_TYPE_DOUBLE);
 	}};
@@ -88,6 +89,7 @@ public class OMRunner
 	    put(OMTensor.ONNX_TYPE_UINT32, numpyEndian+"u4");
 	    put(OMTensor.ONNX_TYPE_INT64,  numpyEndian+"i8");
 	    put(OMTensor.ONNX_TYPE_UINT64, numpyEndian+"u8");
+	    put(OMTensor.ONNX_TYPE_FLOAT16, numpyEndian+"f2");
 	    put(OMTensor.ONNX_TYPE_FLOAT,  numpyEndian+"f4");
 	    put(OMTensor.ONNX_TYPE_DOUBLE, numpyEndian+"f8");
 	}};
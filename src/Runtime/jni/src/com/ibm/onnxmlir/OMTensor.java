@@ -2,6 +2,8 @@
 
 package com.ibm.onnxmlir;
 
+import java.lang.ref.PhantomReference;
+import java.lang.ref.ReferenceQueue;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.nio.DoubleBuffer;
@@ -9,6 +11,8 @@ import java.nio.FloatBuffer;
 import java.nio.IntBuffer;
 import java.nio.LongBuffer;
 import java.nio.ShortBuffer;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
 
 public class OMTensor {
 
@@ -87,6 +91,52 @@ public class OMTensor {
      */
     private int _rank;
 
+    /* Native data buffers handed over by the JNI wrapper without a copy.
+     * They are freed by a daemon thread once their direct ByteBuffer has
+     * been garbage collected. A PhantomReference is used rather than
+     * java.lang.ref.Cleaner so that Java 8 is still supported. The
+     * thread is only started when the first native buffer is registered.
+     */
+    private static final class NativeBufferCleaner {
+        private static final class NativeBufferRef
+            extends PhantomReference<ByteBuffer> {
+            private final long _allocatedPtr;
+
+            NativeBufferRef(ByteBuffer data, long allocatedPtr) {
+                super(data, _queue);
+                _allocatedPtr = allocatedPtr;
+            }
+        }
+
+        private static final ReferenceQueue<ByteBuffer> _queue =
+            new ReferenceQueue<ByteBuffer>();
+        /* Keep the references reachable until they are enqueued */
+        private static final Set<NativeBufferRef> _refs =
+            ConcurrentHashMap.newKeySet();
+
+        static {
+            Thread cleaner = new Thread(() -> {
+                while (true) {
+                    try {
+                        NativeBufferRef ref = (NativeBufferRef)_queue.remove();
+                        _refs.remove(ref);
+                        free_data_jni(ref._allocatedPtr);
+                    } catch (InterruptedException e) {
+                        return;
+                    }
+                }
+            }, "OMTensor native buffer cleaner");
+            cleaner.setDaemon(true);
+            cleaner.start();
+        }
+
+        static void register(ByteBuffer data, long allocatedPtr) {
+            _refs.add(new NativeBufferRef(data, allocatedPtr));
+        }
+    }
+
+    private static native void free_data_jni(long allocatedPtr);
+
     /**
      * Constructor
      *
@@ -259,12 +309,14 @@ public class OMTensor {
     /* ---------- Short data getter and setter ---------- */
 
     /**
-     * Short data getter
+     * Short data getter. For FLOAT16 and BFLOAT16 tensors, the raw
+     * 16-bit patterns are returned.
      *
      * @return short data array
      */
     public short[] getShortData() {
-	if (_dataType != ONNX_TYPE_INT16 && _dataType != ONNX_TYPE_UINT16)
+	if (_dataType != ONNX_TYPE_INT16 && _dataType != ONNX_TYPE_UINT16 &&
+	    _dataType != ONNX_TYPE_FLOAT16 && _dataType != ONNX_TYPE_BFLOAT16)
 	    throw new NumberFormatException("Data type is " +
 					    ONNX_TYPE_NAME[_dataType]);
         if (_data == null) return null;
@@ -367,14 +419,60 @@ public class OMTensor {
         _dataType = ONNX_TYPE_INT64;
     }
 
+    /* ---------- Half precision data getter and setter ---------- */
+
+    /**
+     * Convert a FLOAT16 bit pattern to float
+     *
+     * @param h FLOAT16 bit pattern
+     *
+     * @return float value
+     */
+    private static float float16ToFloat(short h) {
+        int sign = (h & 0x8000) << 16;
+        int exp = (h >>> 10) & 0x1f;
+        int mant = h & 0x3ff;
+        if (exp == 0x1f) /* Inf or NaN */
+            return Float.intBitsToFloat(sign | 0x7f800000 | (mant << 13));
+        if (exp == 0) { /* Zero or subnormal */
+            float f = mant * (1.0f / (1 << 24));
+            return sign != 0 ? -f : f;
+        }
+        return Float.intBitsToFloat(sign | ((exp + 112) << 23) | (mant << 13));
+    }
+
+    /**
+     * Half precision data setter
+     *
+     * @param data FLOAT16 or BFLOAT16 bit patterns to be set
+     * @param dataType ONNX_TYPE_FLOAT16 or ONNX_TYPE_BFLOAT16
+     */
+    public void setHalfData(short[] data, int dataType) {
+	if (dataType != ONNX_TYPE_FLOAT16 && dataType != ONNX_TYPE_BFLOAT16)
+	    throw new IllegalArgumentException("Data type is " +
+					       ONNX_TYPE_NAME[dataType]);
+        setShortData(data);
+        _dataType = dataType;
+    }
+
     /* ---------- Float data getter and setter ---------- */
 
     /**
-     * Float data getter
+     * Float data getter. FLOAT16 and BFLOAT16 data are widened to float.
      *
      * @return float data array
      */
     public float[] getFloatData() {
+	if (_dataType == ONNX_TYPE_FLOAT16 || _dataType == ONNX_TYPE_BFLOAT16) {
+	    short[] s = getShortData();
+	    if (s == null) return null;
+	    float[] f = new float[s.length];
+	    for (int i = 0; i < s.length; i++)
+		f[i] = _dataType == ONNX_TYPE_BFLOAT16 ?
+		    Float.intBitsToFloat((s[i] & 0xffff) << 16) :
+		    float16ToFloat(s[i]);
+	    return f;
+	}
 	if (_dataType != ONNX_TYPE_FLOAT)
 	    throw new NumberFormatException("Data type is " +
 					    ONNX_TYPE_NAME[_dataType]);
@@ -607,6 +705,22 @@ public class OMTensor {
         _strides = strides;
     }
 
+    /**
+     * Constructor (For JNI wrapper only. Not intended for end user)
+     *
+     * @param data data buffer, a direct buffer over native memory
+     * @param shape data shape
+     * @param strides data strides
+     * @param dataType data type
+     * @param allocatedPtr native pointer to free once data is garbage
+     *        collected
+     */
+    protected OMTensor(ByteBuffer data, long[] shape, long[] strides,
+                       int dataType, long allocatedPtr) {
+        this(data, shape, strides, dataType);
+        NativeBufferCleaner.register(_data, allocatedPtr);
+    }
+
     /**
      * Raw data getter (For JNI wrapper only. Not intended for end user)
      *
@@ -65,6 +65,8 @@ Value emitConstantOp(
   TypeSwitch<Type>(type)
       .Case<Float16Type>(
           [&](Type) { constantAttr = rewriter.getF16FloatAttr((float)value); })
+      .Case<BFloat16Type>(
+          [&](Type) { constantAttr = rewriter.getFloatAttr(type, value); })
       .Case<Float32Type>(
           [&](Type) { constantAttr = rewriter.getF32FloatAttr((float)value); })
       .Case<Float64Type>(
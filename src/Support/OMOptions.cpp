@@ -30,6 +30,19 @@ llvm::cl::opt<bool> enableMemoryBundling("enable-memory-bundling",
         "Set to 'false' if you experience significant compile time."),
     llvm::cl::init(false), llvm::cl::cat(OMPassOptions));
 
+llvm::cl::opt<bool> alignedEntryPoint("aligned-entry-point",
+    llvm::cl::desc(
+        "Allocate buffers on 64 bytes and specialize the model for inputs\n"
+        "aligned on 64 bytes, checked at run time (default=false)."),
+    llvm::cl::init(false), llvm::cl::cat(OMPassOptions));
+
+llvm::cl::opt<std::string> modelSymbolPrefix("symbol-prefix",
+    llvm::cl::desc(
+        "Prefix of the symbols exported by the model, e.g. 'mnist_' exports\n"
+        "mnist_run_main_graph and mnist_omInputSignature. Allows loading or\n"
+        "linking several models in the same process (default='')."),
+    llvm::cl::init(""), llvm::cl::cat(OMPassOptions));
+
 llvm::cl::opt<int> onnxOpTransformThreshold("onnx-op-transform-threshold",
     llvm::cl::desc(
         "Max iteration for dynamic op transform passes (default=3).\n"
@@ -37,6 +50,21 @@ llvm::cl::opt<int> onnxOpTransformThreshold("onnx-op-transform-threshold",
         "static iteration will be used"),
     llvm::cl::init(3), llvm::cl::cat(OMPassOptions));
 
+llvm::cl::opt<int> nchwcLayout("nchwc-layout",
+    llvm::cl::desc(
+        "Rewrite the 2D convolutions, and the elementwise and pooling ops\n"
+        "that follow them, to the NCHW<b>c blocked layout with the given\n"
+        "number of channels b per block, e.g. 8 for AVX2 or 16 for AVX-512\n"
+        "(default=0, which keeps the NCHW layout)."),
+    llvm::cl::init(0), llvm::cl::cat(OMPassOptions));
+
+llvm::cl::opt<int> winogradTile("winograd-tile",
+    llvm::cl::desc(
+        "Output tile size m of the Winograd F(mxm,3x3) lowering of the 3x3\n"
+        "convolutions with unit strides and dilations: 2, 4 (fewer\n"
+        "multiplies, lower accuracy), or 0 to disable it (default=0)."),
+    llvm::cl::init(0), llvm::cl::cat(OMPassOptions));
+
 llvm::cl::opt<bool> onnxOpTransformReport("onnx-op-transform-report",
     llvm::cl::desc("Report diagnostic info for op transform passes."),
     llvm::cl::init(false), llvm::cl::cat(OMPassOptions));
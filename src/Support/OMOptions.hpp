@@ -22,5 +22,9 @@ extern llvm::cl::OptionCategory OMPassOptions;
 // Declare options.
 extern llvm::cl::opt<std::string> instrumentONNXOps;
 extern llvm::cl::opt<bool> enableMemoryBundling;
+extern llvm::cl::opt<bool> alignedEntryPoint;
+extern llvm::cl::opt<std::string> modelSymbolPrefix;
 extern llvm::cl::opt<int> onnxOpTransformThreshold;
 extern llvm::cl::opt<bool> onnxOpTransformReport;
+extern llvm::cl::opt<int> nchwcLayout;
+extern llvm::cl::opt<int> winogradTile;
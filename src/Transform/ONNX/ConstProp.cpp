@@ -77,6 +77,9 @@ const StringRef BUFFER_ID_ATTR = "buffer_id";
 ///
 /// Buffer pool to store buffer pointers.
 SmallVector<char *, 4> bufferPtrs;
+/// Reverse map from a buffer pointer to its id in the buffer pool, so that
+/// graphs with many folded constants do not pay a linear search per op.
+llvm::DenseMap<char *, unsigned> bufferIds;
 
 /// A helper function to get a value of a given type from an attribute.
 template <typename T>
@@ -126,6 +129,7 @@ char *getArrayFromAttributeOrBuffer(PatternRewriter &rewriter, Operation *op) {
     res = createArrayFromDenseElementsAttr(dataAttr);
     bufferPtrs.emplace_back(res);
     unsigned bufferId = bufferPtrs.size() - 1;
+    bufferIds[res] = bufferId;
     // Add an attribute to store the buffer id.
     op->setAttr(BUFFER_ID_ATTR,
         IntegerAttr::get(
@@ -190,6 +194,50 @@ bool isFromDenseONNXConstantOp(Value result) {
   return true;
 }
 
+/// A helper function to check whether a value has a static shape and an element
+/// type that constant propagation knows how to compute with.
+bool isConstPropFoldableResult(Value result) {
+  ShapedType type = result.getType().dyn_cast<ShapedType>();
+  return type && type.hasStaticShape() &&
+         isConstPropSupportedType(type.getElementType());
+}
+
+/// A helper function to check whether a Cast of a constant can be folded. A
+/// float to integer conversion of a NaN, an infinity or a value out of the
+/// integer range is undefined, so such casts are left to the runtime.
+bool isConstPropCastFoldable(Value input, Value result) {
+  Type srcElementType = input.getType().cast<ShapedType>().getElementType();
+  IntegerType intTy = result.getType()
+                          .cast<ShapedType>()
+                          .getElementType()
+                          .dyn_cast<IntegerType>();
+  if (!srcElementType.isa<FloatType>() || !intTy)
+    return true;
+
+  Operation *op = input.getDefiningOp();
+  Attribute bufferIDAttr = op->getAttrOfType<::mlir::Attribute>(BUFFER_ID_ATTR);
+  if (bufferIDAttr) {
+    unsigned bufferId = bufferIDAttr.cast<IntegerAttr>().getUInt();
+    double *values = reinterpret_cast<double *>(bufferPtrs[bufferId]);
+    int64_t numElements =
+        getNumberOfElements(input.getType().cast<ShapedType>().getShape());
+    for (int64_t i = 0; i < numElements; ++i)
+      if (!isFloatToIntegerCastDefined(values[i], intTy))
+        return false;
+    return true;
+  }
+  DenseElementsAttr dataAttr = op->getAttrOfType<::mlir::Attribute>("value")
+                                   .cast<mlir::DenseElementsAttr>();
+  for (APFloat value : dataAttr.getValues<APFloat>()) {
+    bool losesInfo;
+    value.convert(
+        APFloat::IEEEdouble(), APFloat::rmNearestTiesToEven, &losesInfo);
+    if (!isFloatToIntegerCastDefined(value.convertToDouble(), intTy))
+      return false;
+  }
+  return true;
+}
+
 /// A helper function to create an ONNXConstantOp for a given data array.
 /// This ONNXConstantOp is only used internally.
 ONNXConstantOp createConstantOpAndStoreBufferPtr(
@@ -202,17 +250,14 @@ ONNXConstantOp createConstantOpAndStoreBufferPtr(
       ArrayAttr(), IntegerAttr(), ArrayAttr(), StringAttr(), ArrayAttr());
 
   // Store the buffer pointer.
-  unsigned bufferId = (unsigned)-1;
-  for (unsigned i = 0; i < bufferPtrs.size(); ++i) {
-    if (bufferPtrs[i] == vt) {
-      bufferId = i;
-      break;
-    }
-  }
-
-  if (bufferId == (unsigned)-1) {
+  unsigned bufferId;
+  auto it = bufferIds.find(vt);
+  if (it != bufferIds.end()) {
+    bufferId = it->second;
+  } else {
     bufferPtrs.emplace_back(vt);
     bufferId = bufferPtrs.size() - 1;
+    bufferIds[vt] = bufferId;
   }
   // Store the buffer id.
   constOp.getOperation()->setAttr(BUFFER_ID_ATTR,
@@ -261,17 +306,14 @@ T ComputeConstPropElementwiseBinary(T lhs, T rhs) {
 }
 
 template <typename ElementwiseBinaryOp, typename T>
-void IterateConstPropElementwiseBinary(char *lhs, char *rhs,
-    ArrayRef<int64_t> lhsShape, ArrayRef<int64_t> rhsShape, char *res,
-    ArrayRef<int64_t> outputShape) {
+void IterateConstPropElementwiseBinary(MLIRContext *context, char *lhs,
+    char *rhs, ArrayRef<int64_t> lhsShape, ArrayRef<int64_t> rhsShape,
+    char *res, ArrayRef<int64_t> outputShape) {
   // Rank info.
   int lhsRank = lhsShape.size();
   int rhsRank = rhsShape.size();
   int outputRank = outputShape.size();
-  // Strides info.
-  std::vector<int64_t> outputStrides = getStrides(outputShape);
-  std::vector<int64_t> lhsStrides = getStrides(lhsShape);
-  std::vector<int64_t> rhsStrides = getStrides(rhsShape);
+  int64_t numElements = getNumberOfElements(outputShape);
   // Data pointers.
   T *lhsArray = reinterpret_cast<T *>(lhs);
   T *rhsArray = reinterpret_cast<T *>(rhs);
@@ -288,51 +330,49 @@ void IterateConstPropElementwiseBinary(char *lhs, char *rhs,
         break;
       }
 
+  if (!broadcasting) {
+    parallelForEachChunk(context, numElements, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i)
+        *(resArray + i) =
+            ComputeConstPropElementwiseBinary<ElementwiseBinaryOp, T>(
+                *(lhsArray + i), *(rhsArray + i));
+    });
+    return;
+  }
+
+  // Strides of the inputs expressed in the output index space. Broadcasted
+  // dimensions get a zero stride, so that the input offset is a dot product
+  // with the output indices.
+  std::vector<int64_t> lhsStrides = getStrides(lhsShape);
+  std::vector<int64_t> rhsStrides = getStrides(rhsShape);
+  SmallVector<int64_t, 4> lhsBroadcastStrides(outputRank, 0);
+  SmallVector<int64_t, 4> rhsBroadcastStrides(outputRank, 0);
+  for (int k = 0; k < outputRank; ++k) {
+    int lhsIndex = k - outputRank + lhsRank;
+    if (lhsIndex >= 0 && lhsShape[lhsIndex] != 1)
+      lhsBroadcastStrides[k] = lhsStrides[lhsIndex];
+    int rhsIndex = k - outputRank + rhsRank;
+    if (rhsIndex >= 0 && rhsShape[rhsIndex] != 1)
+      rhsBroadcastStrides[k] = rhsStrides[rhsIndex];
+  }
+
   // Do computation.
-  for (int64_t i = 0; i < getNumberOfElements(outputShape); ++i) {
-    // Compute indices to access the output.
-    std::vector<int64_t> outputIndices = getAccessIndex(i, outputStrides);
-
-    // Compute indices to access inputs.
-    SmallVector<int64_t, 4> lhsIndices(lhsRank, 0);
-    SmallVector<int64_t, 4> rhsIndices(rhsRank, 0);
-    if (!broadcasting) {
-      for (int k = 0; k < outputRank; ++k) {
-        lhsIndices[k] = outputIndices[k];
-        rhsIndices[k] = outputIndices[k];
-      }
-    } else {
-      for (int k = 0; k < outputRank; ++k) {
-        // in the lhs index range.
-        if (k >= outputRank - lhsRank) {
-          int lhsIndex = k - outputRank + lhsRank;
-          if (lhsShape[lhsIndex] == 1)
-            // broadcast
-            lhsIndices[lhsIndex] = 0;
-          else
-            lhsIndices[lhsIndex] = outputIndices[k];
-        }
-        // in the rhs index range.
-        if (k >= outputRank - rhsRank) {
-          int rhsIndex = k - outputRank + rhsRank;
-          if (rhsShape[rhsIndex] == 1)
-            // broadcast
-            rhsIndices[rhsIndex] = 0;
-          else
-            rhsIndices[rhsIndex] = outputIndices[k];
-        }
+  parallelForEachChunk(context, numElements, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      // Compute offsets to access inputs.
+      int64_t lhsOffset = 0, rhsOffset = 0, rem = i;
+      for (int k = outputRank - 1; k >= 0; --k) {
+        int64_t idx = rem % outputShape[k];
+        rem /= outputShape[k];
+        lhsOffset += idx * lhsBroadcastStrides[k];
+        rhsOffset += idx * rhsBroadcastStrides[k];
       }
+      // Calculate element-wise binary result.
+      *(resArray + i) =
+          ComputeConstPropElementwiseBinary<ElementwiseBinaryOp, T>(
+              *(lhsArray + lhsOffset), *(rhsArray + rhsOffset));
     }
-
-    // Calculate element-wise binary result.
-    int64_t lhsOffset = getLinearAccessIndex(lhsIndices, lhsStrides);
-    int64_t rhsOffset = getLinearAccessIndex(rhsIndices, rhsStrides);
-
-    T lhsValue = *(lhsArray + lhsOffset);
-    T rhsValue = *(rhsArray + rhsOffset);
-    *(resArray + i) = ComputeConstPropElementwiseBinary<ElementwiseBinaryOp, T>(
-        lhsValue, rhsValue);
-  }
+  });
 }
 
 /// Do element-wise binary calculation of 'lhs' and 'rhs' values and create an
@@ -358,11 +398,13 @@ ONNXConstantOp ConstPropElementwiseBinary(
   if (elementType.isa<FloatType>()) {
     // Use double to avoid the precision loss during computation.
     IterateConstPropElementwiseBinary<ElementwiseBinaryOp, double>(
-        lhsArray, rhsArray, lhsShape, rhsShape, resArray, outputShape);
+        rewriter.getContext(), lhsArray, rhsArray, lhsShape, rhsShape,
+        resArray, outputShape);
   } else if (elementType.isa<IntegerType>()) {
     // Use int64_t to avoid the precision loss during computation.
     IterateConstPropElementwiseBinary<ElementwiseBinaryOp, int64_t>(
-        lhsArray, rhsArray, lhsShape, rhsShape, resArray, outputShape);
+        rewriter.getContext(), lhsArray, rhsArray, lhsShape, rhsShape,
+        resArray, outputShape);
   } else
     llvm_unreachable("Unknown data type");
 
@@ -397,17 +439,20 @@ T ComputeConstPropElementwiseUnary(T val) {
 }
 
 template <typename ElementwiseUnaryOp, typename T>
-void IterateConstPropElementwiseUnary(
-    char *input, char *res, ArrayRef<int64_t> outputShape) {
+void IterateConstPropElementwiseUnary(MLIRContext *context, char *input,
+    char *res, ArrayRef<int64_t> outputShape) {
   // Data pointers.
   T *inputArray = reinterpret_cast<T *>(input);
   T *resArray = reinterpret_cast<T *>(res);
 
   // Calculate element-wise unary result.
-  for (int64_t i = 0; i < getNumberOfElements(outputShape); ++i) {
-    *(resArray + i) = ComputeConstPropElementwiseUnary<ElementwiseUnaryOp, T>(
-        *(inputArray + i));
-  }
+  parallelForEachChunk(context, getNumberOfElements(outputShape),
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i)
+          *(resArray + i) =
+              ComputeConstPropElementwiseUnary<ElementwiseUnaryOp, T>(
+                  *(inputArray + i));
+      });
 }
 
 /// Do element-wise unary calculation of 'input' value and create an
@@ -430,11 +475,11 @@ ONNXConstantOp ConstPropElementwiseUnary(
   if (elementType.isa<FloatType>()) {
     // Use double to avoid the precision loss during computation.
     IterateConstPropElementwiseUnary<ElementwiseUnaryOp, double>(
-        constArray, resArray, replacingShape);
+        rewriter.getContext(), constArray, resArray, replacingShape);
   } else if (elementType.isa<IntegerType>()) {
     // Use int64_t to avoid the precision loss during computation.
     IterateConstPropElementwiseUnary<ElementwiseUnaryOp, int64_t>(
-        constArray, resArray, replacingShape);
+        rewriter.getContext(), constArray, resArray, replacingShape);
   } else
     llvm_unreachable("Unknown data type");
 
@@ -518,6 +563,146 @@ ONNXConstantOp ConstPropSqueeze(
   return res;
 }
 
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for Cast.
+//===----------------------------------------------------------------------===//
+
+ONNXConstantOp ConstPropCast(
+    PatternRewriter &rewriter, Value replacingValue, Value input) {
+  Type srcElementType = input.getType().cast<ShapedType>().getElementType();
+  ShapedType replacingType = replacingValue.getType().cast<ShapedType>();
+  Type dstElementType = replacingType.getElementType();
+
+  char *inputArray =
+      getArrayFromAttributeOrBuffer(rewriter, input.getDefiningOp());
+
+  // Use maximum size (double or int64_t) to avoid the precision loss.
+  char *resArray = allocateBufferFor(replacingType, /*useMaxSize=*/true);
+  ConstPropCastImpl(srcElementType, dstElementType, inputArray,
+      getNumberOfElements(replacingType.getShape()), resArray);
+
+  // Construct a new ONNXConstantOp.
+  return createConstantOpAndStoreBufferPtr(rewriter, replacingValue, resArray);
+}
+
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for MatMul.
+//===----------------------------------------------------------------------===//
+
+ONNXConstantOp ConstPropMatMul(
+    PatternRewriter &rewriter, Value replacingValue, Value A, Value B) {
+  Type elementType =
+      replacingValue.getType().cast<ShapedType>().getElementType();
+  ArrayRef<int64_t> aShape = A.getType().cast<ShapedType>().getShape();
+  ArrayRef<int64_t> bShape = B.getType().cast<ShapedType>().getShape();
+
+  char *aArray = getArrayFromAttributeOrBuffer(rewriter, A.getDefiningOp());
+  char *bArray = getArrayFromAttributeOrBuffer(rewriter, B.getDefiningOp());
+
+  // Use maximum size (double or int64_t) to avoid the precision loss.
+  char *resArray =
+      allocateBufferFor(replacingValue.getType(), /*useMaxSize=*/true);
+  ConstPropMatMulImpl(rewriter.getContext(), elementType, aArray, aShape,
+      bArray, bShape, resArray);
+
+  // Construct a new ONNXConstantOp.
+  return createConstantOpAndStoreBufferPtr(rewriter, replacingValue, resArray);
+}
+
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for Gemm.
+//===----------------------------------------------------------------------===//
+
+class ConstPropGemmPattern : public OpRewritePattern<ONNXGemmOp> {
+public:
+  using OpRewritePattern<ONNXGemmOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(
+      ONNXGemmOp gemmOp, PatternRewriter &rewriter) const override {
+    Value A = gemmOp.A(), B = gemmOp.B(), C = gemmOp.C();
+    bool hasBias = !C.getType().isa<NoneType>();
+    // Match
+    if (!isConstPropFoldableResult(gemmOp.getResult()))
+      return failure();
+    if (!isFromDenseONNXConstantOp(A) || !isFromDenseONNXConstantOp(B))
+      return failure();
+    if (hasBias && !isFromDenseONNXConstantOp(C))
+      return failure();
+
+    Type elementType =
+        gemmOp.getResult().getType().cast<ShapedType>().getElementType();
+    char *aArray = getArrayFromAttributeOrBuffer(rewriter, A.getDefiningOp());
+    char *bArray = getArrayFromAttributeOrBuffer(rewriter, B.getDefiningOp());
+    char *cArray = nullptr;
+    ArrayRef<int64_t> cShape;
+    if (hasBias) {
+      cArray = getArrayFromAttributeOrBuffer(rewriter, C.getDefiningOp());
+      cShape = C.getType().cast<ShapedType>().getShape();
+    }
+
+    // Use maximum size (double or int64_t) to avoid the precision loss.
+    char *resArray =
+        allocateBufferFor(gemmOp.getResult().getType(), /*useMaxSize=*/true);
+    ConstPropGemmImpl(rewriter.getContext(), elementType, aArray,
+        A.getType().cast<ShapedType>().getShape(), gemmOp.transA() != 0,
+        bArray, B.getType().cast<ShapedType>().getShape(),
+        gemmOp.transB() != 0, cArray, cShape,
+        (double)gemmOp.alpha().convertToFloat(),
+        (double)gemmOp.beta().convertToFloat(),
+        resArray);
+
+    // Construct result values.
+    ONNXConstantOp res = createConstantOpAndStoreBufferPtr(
+        rewriter, gemmOp.getResult(), resArray);
+    rewriter.replaceOp(gemmOp, res.getResult());
+    return success();
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for Gather.
+//===----------------------------------------------------------------------===//
+
+class ConstPropGatherPattern : public OpRewritePattern<ONNXGatherOp> {
+public:
+  using OpRewritePattern<ONNXGatherOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(
+      ONNXGatherOp gatherOp, PatternRewriter &rewriter) const override {
+    Value data = gatherOp.data(), indices = gatherOp.indices();
+    // Match
+    if (!isConstPropFoldableResult(gatherOp.getResult()))
+      return failure();
+    if (!isFromDenseONNXConstantOp(data) ||
+        !isFromDenseONNXConstantOp(indices))
+      return failure();
+
+    ArrayRef<int64_t> dataShape = data.getType().cast<ShapedType>().getShape();
+    ArrayRef<int64_t> indicesShape =
+        indices.getType().cast<ShapedType>().getShape();
+    int64_t axis = gatherOp.axis();
+    if (axis < 0)
+      axis += dataShape.size();
+
+    char *dataArray =
+        getArrayFromAttributeOrBuffer(rewriter, data.getDefiningOp());
+    char *indicesArray =
+        getArrayFromAttributeOrBuffer(rewriter, indices.getDefiningOp());
+
+    // Use maximum size (double or int64_t) to avoid the precision loss.
+    char *resArray =
+        allocateBufferFor(gatherOp.getResult().getType(), /*useMaxSize=*/true);
+    ConstPropGatherImpl(
+        dataArray, dataShape, indicesArray, indicesShape, axis, resArray);
+
+    // Construct result values.
+    ONNXConstantOp res = createConstantOpAndStoreBufferPtr(
+        rewriter, gatherOp.getResult(), resArray);
+    rewriter.replaceOp(gatherOp, res.getResult());
+    return success();
+  }
+};
+
 //===----------------------------------------------------------------------===//
 // Code to perform constant propagation for split.
 //===----------------------------------------------------------------------===//
@@ -770,6 +955,8 @@ void ConstPropONNXToONNXPass::runOnFunction() {
   patterns.insert<ConstPropSplitPattern>(&getContext());
   patterns.insert<ConstPropSplitV11Pattern>(&getContext());
   patterns.insert<ConstPropScatterNDPattern>(&getContext());
+  patterns.insert<ConstPropGemmPattern>(&getContext());
+  patterns.insert<ConstPropGatherPattern>(&getContext());
   if (failed(applyPatternsAndFoldGreedily(function, std::move(patterns))))
     signalPassFailure();
 
@@ -792,6 +979,7 @@ void ConstPropONNXToONNXPass::runOnFunction() {
     free(ptr);
   }
   bufferPtrs.clear();
+  bufferIds.clear();
 
 } // end anonymous namespace
 
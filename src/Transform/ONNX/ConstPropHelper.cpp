@@ -17,8 +17,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "mlir/IR/Threading.h"
+
 #include "src/Transform/ONNX/ConstPropHelper.hpp"
 
+#include <cmath>
+#include <cstring>
+
 using namespace mlir;
 
 /// Get the element size in bytes. Use the biggest size to avoid loss in
@@ -109,6 +114,35 @@ char *allocateBufferFor(Type type, bool useMaxSize) {
   return res;
 }
 
+/// Return true if constant propagation can hold the elements of the given
+/// type in its double/int64_t buffers and convert them back.
+bool isConstPropSupportedType(Type elementType) {
+  if (FloatType floatTy = elementType.dyn_cast<FloatType>())
+    return floatTy.getWidth() == 16 || floatTy.getWidth() == 32 ||
+           floatTy.getWidth() == 64;
+  if (IntegerType intTy = elementType.dyn_cast<IntegerType>())
+    return intTy.getWidth() == 8 || intTy.getWidth() == 16 ||
+           intTy.getWidth() == 32 || intTy.getWidth() == 64;
+  return false;
+}
+
+/// Run 'fn' on consecutive chunks of [0, numElements). Chunks are processed in
+/// parallel when multithreading is enabled in 'context'.
+void parallelForEachChunk(MLIRContext *context, int64_t numElements,
+    llvm::function_ref<void(int64_t begin, int64_t end)> fn) {
+  // Small tensors are not worth the thread dispatch.
+  static constexpr int64_t chunkSize = 4096;
+  int64_t numChunks = llvm::divideCeil(numElements, chunkSize);
+  if (numChunks <= 1) {
+    fn(0, numElements);
+    return;
+  }
+  parallelForEachN(context, 0, numChunks, [&](size_t chunk) {
+    int64_t begin = chunk * chunkSize;
+    fn(begin, std::min(begin + chunkSize, numElements));
+  });
+}
+
 /// Get a data array from a given ONNXConstantOp.
 char *createArrayFromDenseElementsAttr(DenseElementsAttr dataAttr) {
   Type elementType = dataAttr.getType().getElementType();
@@ -117,18 +151,33 @@ char *createArrayFromDenseElementsAttr(DenseElementsAttr dataAttr) {
   if (elementType.isa<FloatType>()) {
     // Use double to avoid the precision loss during computation.
     double *resArr = (double *)res;
-    auto valueIt = dataAttr.getValues<APFloat>().begin();
-    for (int64_t i = 0; i < numElements; ++i) {
-      double val = (double)(*valueIt++).convertToFloat();
-      *(resArr + i) = val;
+    if (elementType.isF32()) {
+      auto valueIt = dataAttr.getValues<float>().begin();
+      for (int64_t i = 0; i < numElements; ++i)
+        *(resArr + i) = (double)(*valueIt++);
+    } else if (elementType.isF64()) {
+      auto valueIt = dataAttr.getValues<double>().begin();
+      for (int64_t i = 0; i < numElements; ++i)
+        *(resArr + i) = *valueIt++;
+    } else {
+      // Half precision types go through APFloat.
+      auto valueIt = dataAttr.getValues<APFloat>().begin();
+      for (int64_t i = 0; i < numElements; ++i) {
+        bool ignored;
+        APFloat val = *valueIt++;
+        val.convert(APFloat::IEEEdouble(), APFloat::rmNearestTiesToEven,
+            &ignored);
+        *(resArr + i) = val.convertToDouble();
+      }
     }
   } else if (elementType.isa<IntegerType>()) {
     // Use int64_t to avoid the precision loss during computation.
     int64_t *resArr = (int64_t *)res;
+    bool isUnsigned = elementType.isUnsignedInteger();
     auto valueIt = dataAttr.getValues<APInt>().begin();
     for (int64_t i = 0; i < numElements; ++i) {
-      int64_t val = (*valueIt++).getSExtValue();
-      *(resArr + i) = val;
+      APInt val = *valueIt++;
+      *(resArr + i) = isUnsigned ? val.getZExtValue() : val.getSExtValue();
     }
   } else
     llvm_unreachable("Unknown data type");
@@ -176,8 +225,18 @@ void convertDoubleInt64ToExactType(Type outType, char *inArr, char *outArr) {
 
   if (elementType.isa<FloatType>()) {
     FloatType floatTy = elementType.cast<FloatType>();
-    if (floatTy.getWidth() == 32) {
-      double *inArrDouble = (double *)inArr;
+    double *inArrDouble = (double *)inArr;
+    if (floatTy.getWidth() == 16) {
+      // f16 and bf16 are stored as their raw bit pattern.
+      uint16_t *outArrHalf = (uint16_t *)outArr;
+      for (int64_t i = 0; i < numElements; ++i) {
+        bool ignored;
+        APFloat val(*(inArrDouble + i));
+        val.convert(floatTy.getFloatSemantics(), APFloat::rmNearestTiesToEven,
+            &ignored);
+        *(outArrHalf + i) = (uint16_t)val.bitcastToAPInt().getZExtValue();
+      }
+    } else if (floatTy.getWidth() == 32) {
       float *inArrFloat = (float *)outArr;
       for (int64_t i = 0; i < numElements; ++i)
         *(inArrFloat + i) = (float)*(inArrDouble + i);
@@ -187,8 +246,16 @@ void convertDoubleInt64ToExactType(Type outType, char *inArr, char *outArr) {
       llvm_unreachable("Unknown data type");
   } else if (elementType.isa<IntegerType>()) {
     IntegerType intTy = elementType.cast<IntegerType>();
-    if (intTy.getWidth() == 32) {
-      int64_t *inArrInt64 = (int64_t *)inArr;
+    int64_t *inArrInt64 = (int64_t *)inArr;
+    if (intTy.getWidth() == 8) {
+      int8_t *outArrInt8 = (int8_t *)outArr;
+      for (int64_t i = 0; i < numElements; ++i)
+        *(outArrInt8 + i) = (int8_t)(*(inArrInt64 + i));
+    } else if (intTy.getWidth() == 16) {
+      int16_t *outArrInt16 = (int16_t *)outArr;
+      for (int64_t i = 0; i < numElements; ++i)
+        *(outArrInt16 + i) = (int16_t)(*(inArrInt64 + i));
+    } else if (intTy.getWidth() == 32) {
       int32_t *inArrInt32 = (int32_t *)outArr;
       for (int64_t i = 0; i < numElements; ++i)
         *(inArrInt32 + i) = (int32_t)(*(inArrInt64 + i));
@@ -326,3 +393,242 @@ void ConstPropTransposeImpl(Type elementType, char *constArray,
   } else
     llvm_unreachable("Unknown data type");
 }
+
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for cast.
+//===----------------------------------------------------------------------===//
+
+/// Wrap a value to the range of a given integer type, the way a C cast would.
+static int64_t wrapToIntegerType(int64_t val, IntegerType intTy) {
+  unsigned width = intTy.getWidth();
+  if (width >= 64)
+    return val;
+  uint64_t mask = (1ULL << width) - 1;
+  uint64_t bits = (uint64_t)val & mask;
+  if (intTy.isUnsigned())
+    return (int64_t)bits;
+  // Sign extend from 'width' bits.
+  uint64_t signBit = 1ULL << (width - 1);
+  return (int64_t)((bits ^ signBit) - signBit);
+}
+
+bool isFloatToIntegerCastDefined(double val, IntegerType intTy) {
+  if (!std::isfinite(val))
+    return false;
+  // The conversion truncates toward zero, so bound the truncated value.
+  double truncated = std::trunc(val);
+  unsigned width = intTy.getWidth();
+  if (intTy.isUnsigned())
+    return truncated >= 0.0 && truncated < std::ldexp(1.0, width);
+  return truncated >= -std::ldexp(1.0, width - 1) &&
+         truncated < std::ldexp(1.0, width - 1);
+}
+
+void ConstPropCastImpl(Type srcElementType, Type dstElementType,
+    char *constArray, int64_t numElements, char *resArray) {
+  if (srcElementType.isa<FloatType>()) {
+    double *src = reinterpret_cast<double *>(constArray);
+    if (FloatType floatTy = dstElementType.dyn_cast<FloatType>()) {
+      double *res = reinterpret_cast<double *>(resArray);
+      for (int64_t i = 0; i < numElements; ++i)
+        res[i] = (floatTy.getWidth() < 64) ? (double)(float)src[i] : src[i];
+    } else {
+      IntegerType intTy = dstElementType.cast<IntegerType>();
+      int64_t *res = reinterpret_cast<int64_t *>(resArray);
+      for (int64_t i = 0; i < numElements; ++i) {
+        assert(isFloatToIntegerCastDefined(src[i], intTy) &&
+               "float value out of the range of the integer type");
+        // Go through uint64_t so that unsigned values above INT64_MAX are
+        // converted without overflow.
+        res[i] = intTy.isUnsigned() ? (int64_t)(uint64_t)src[i]
+                                    : (int64_t)src[i];
+      }
+    }
+  } else if (srcElementType.isa<IntegerType>()) {
+    int64_t *src = reinterpret_cast<int64_t *>(constArray);
+    if (dstElementType.isa<FloatType>()) {
+      double *res = reinterpret_cast<double *>(resArray);
+      for (int64_t i = 0; i < numElements; ++i)
+        res[i] = (double)src[i];
+    } else {
+      IntegerType intTy = dstElementType.cast<IntegerType>();
+      int64_t *res = reinterpret_cast<int64_t *>(resArray);
+      for (int64_t i = 0; i < numElements; ++i)
+        res[i] = wrapToIntegerType(src[i], intTy);
+    }
+  } else
+    llvm_unreachable("Unknown data type");
+}
+
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for matmul and gemm.
+//===----------------------------------------------------------------------===//
+
+template <typename T>
+void IterateConstPropMatMul(MLIRContext *context, char *aArray,
+    ArrayRef<int64_t> aShape, char *bArray, ArrayRef<int64_t> bShape,
+    char *resArray) {
+  T *aArrayT = reinterpret_cast<T *>(aArray);
+  T *bArrayT = reinterpret_cast<T *>(bArray);
+  T *resArrayT = reinterpret_cast<T *>(resArray);
+
+  // Promote 1-D operands as numpy.matmul does: A to [1, K] and B to [K, 1].
+  SmallVector<int64_t, 4> aDims(aShape.begin(), aShape.end());
+  SmallVector<int64_t, 4> bDims(bShape.begin(), bShape.end());
+  if (aDims.size() == 1)
+    aDims.insert(aDims.begin(), 1);
+  if (bDims.size() == 1)
+    bDims.emplace_back(1);
+  int aRank = aDims.size();
+  int bRank = bDims.size();
+  int64_t M = aDims[aRank - 2], K = aDims[aRank - 1], N = bDims[bRank - 1];
+
+  // Broadcast the batch dimensions.
+  int batchRank = std::max(aRank, bRank) - 2;
+  SmallVector<int64_t, 4> batchDims(batchRank, 1);
+  SmallVector<int64_t, 4> aBatchStrides(batchRank, 0);
+  SmallVector<int64_t, 4> bBatchStrides(batchRank, 0);
+  int64_t aStride = M * K, bStride = K * N;
+  for (int d = batchRank - 1; d >= 0; --d) {
+    int aDim = d - (batchRank - (aRank - 2));
+    int bDim = d - (batchRank - (bRank - 2));
+    int64_t aSize = (aDim >= 0) ? aDims[aDim] : 1;
+    int64_t bSize = (bDim >= 0) ? bDims[bDim] : 1;
+    batchDims[d] = std::max(aSize, bSize);
+    aBatchStrides[d] = (aSize == 1) ? 0 : aStride;
+    bBatchStrides[d] = (bSize == 1) ? 0 : bStride;
+    aStride *= aSize;
+    bStride *= bSize;
+  }
+  int64_t numBatches = getNumberOfElements(batchDims);
+
+  // One unit of work is one row of the result.
+  parallelForEachChunk(
+      context, numBatches * M, [&](int64_t begin, int64_t end) {
+        for (int64_t row = begin; row < end; ++row) {
+          int64_t batch = row / M, i = row % M;
+          int64_t aOffset = 0, bOffset = 0, rem = batch;
+          for (int d = batchRank - 1; d >= 0; --d) {
+            int64_t idx = rem % batchDims[d];
+            rem /= batchDims[d];
+            aOffset += idx * aBatchStrides[d];
+            bOffset += idx * bBatchStrides[d];
+          }
+          T *aRow = aArrayT + aOffset + i * K;
+          T *bMat = bArrayT + bOffset;
+          T *resRow = resArrayT + row * N;
+          std::fill(resRow, resRow + N, 0);
+          // i-k-j order to stream through B and the result row.
+          for (int64_t k = 0; k < K; ++k) {
+            T aVal = aRow[k];
+            T *bRow = bMat + k * N;
+            for (int64_t j = 0; j < N; ++j)
+              resRow[j] += aVal * bRow[j];
+          }
+        }
+      });
+}
+
+void ConstPropMatMulImpl(MLIRContext *context, Type elementType, char *aArray,
+    ArrayRef<int64_t> aShape, char *bArray, ArrayRef<int64_t> bShape,
+    char *resArray) {
+  if (elementType.isa<FloatType>()) {
+    // Use double to avoid the precision loss during computation.
+    IterateConstPropMatMul<double>(
+        context, aArray, aShape, bArray, bShape, resArray);
+  } else if (elementType.isa<IntegerType>()) {
+    // Use int64_t to avoid the precision loss during computation.
+    IterateConstPropMatMul<int64_t>(
+        context, aArray, aShape, bArray, bShape, resArray);
+  } else
+    llvm_unreachable("Unknown data type");
+}
+
+template <typename T>
+void IterateConstPropGemm(MLIRContext *context, char *aArray,
+    ArrayRef<int64_t> aShape, bool transA, char *bArray,
+    ArrayRef<int64_t> bShape, bool transB, char *cArray,
+    ArrayRef<int64_t> cShape, double alpha, double beta, char *resArray) {
+  T *aArrayT = reinterpret_cast<T *>(aArray);
+  T *bArrayT = reinterpret_cast<T *>(bArray);
+  T *cArrayT = reinterpret_cast<T *>(cArray);
+  T *resArrayT = reinterpret_cast<T *>(resArray);
+
+  int64_t M = transA ? aShape[1] : aShape[0];
+  int64_t K = transA ? aShape[0] : aShape[1];
+  int64_t N = transB ? bShape[0] : bShape[1];
+
+  // Unidirectional broadcast of C to [M, N].
+  int64_t cRowStride = 0, cColStride = 0;
+  if (cArray) {
+    int cRank = cShape.size();
+    if (cRank == 2) {
+      cRowStride = (cShape[0] == 1) ? 0 : cShape[1];
+      cColStride = (cShape[1] == 1) ? 0 : 1;
+    } else if (cRank == 1) {
+      cColStride = (cShape[0] == 1) ? 0 : 1;
+    }
+  }
+
+  parallelForEachChunk(context, M, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      for (int64_t j = 0; j < N; ++j) {
+        T acc = 0;
+        for (int64_t k = 0; k < K; ++k) {
+          T aVal = transA ? aArrayT[k * M + i] : aArrayT[i * K + k];
+          T bVal = transB ? bArrayT[j * K + k] : bArrayT[k * N + j];
+          acc += aVal * bVal;
+        }
+        T res = (T)(alpha * acc);
+        if (cArray)
+          res += (T)(beta * cArrayT[i * cRowStride + j * cColStride]);
+        resArrayT[i * N + j] = res;
+      }
+    }
+  });
+}
+
+void ConstPropGemmImpl(MLIRContext *context, Type elementType, char *aArray,
+    ArrayRef<int64_t> aShape, bool transA, char *bArray,
+    ArrayRef<int64_t> bShape, bool transB, char *cArray,
+    ArrayRef<int64_t> cShape, double alpha, double beta, char *resArray) {
+  if (elementType.isa<FloatType>()) {
+    IterateConstPropGemm<double>(context, aArray, aShape, transA, bArray,
+        bShape, transB, cArray, cShape, alpha, beta, resArray);
+  } else if (elementType.isa<IntegerType>()) {
+    IterateConstPropGemm<int64_t>(context, aArray, aShape, transA, bArray,
+        bShape, transB, cArray, cShape, alpha, beta, resArray);
+  } else
+    llvm_unreachable("Unknown data type");
+}
+
+//===----------------------------------------------------------------------===//
+// Code to perform constant propagation for gather.
+//===----------------------------------------------------------------------===//
+
+void ConstPropGatherImpl(char *dataArray, ArrayRef<int64_t> dataShape,
+    char *indicesArray, ArrayRef<int64_t> indicesShape, int64_t axis,
+    char *resArray) {
+  // Buffers always hold 8-byte elements (double or int64_t), so gather can
+  // move data without knowing the element type.
+  const int64_t eltSize = 8;
+  int64_t *indices = reinterpret_cast<int64_t *>(indicesArray);
+  int64_t numIndices = getNumberOfElements(indicesShape);
+  int64_t axisSize = dataShape[axis];
+  int64_t outer = getNumberOfElements(dataShape.take_front(axis));
+  int64_t inner = getNumberOfElements(dataShape.drop_front(axis + 1));
+
+  // Every gathered index moves a contiguous block of 'inner' elements.
+  char *res = resArray;
+  for (int64_t o = 0; o < outer; ++o) {
+    char *dataBlock = dataArray + o * axisSize * inner * eltSize;
+    for (int64_t n = 0; n < numIndices; ++n) {
+      int64_t idx = indices[n];
+      if (idx < 0)
+        idx += axisSize;
+      assert(idx >= 0 && idx < axisSize && "gather index out of bound");
+      std::memcpy(res, dataBlock + idx * inner * eltSize, inner * eltSize);
+      res += inner * eltSize;
+    }
+  }
+}
@@ -59,6 +59,15 @@ mlir::RankedTensorType constructRankedTensorType(mlir::ShapedType type);
 /// Allocate a buffer whose size is getting from a given Value's type.
 char *allocateBufferFor(mlir::Type type, bool useMaxSize = false);
 
+/// Return true if constant propagation can hold the elements of the given
+/// type in its double/int64_t buffers and convert them back.
+bool isConstPropSupportedType(mlir::Type elementType);
+
+/// Run 'fn' on consecutive chunks of [0, numElements). Chunks are processed in
+/// parallel when multithreading is enabled in 'context'.
+void parallelForEachChunk(mlir::MLIRContext *context, int64_t numElements,
+    llvm::function_ref<void(int64_t begin, int64_t end)> fn);
+
 /// Get a data array from a given ONNXConstantOp.
 char *createArrayFromDenseElementsAttr(mlir::DenseElementsAttr dataAttr);
 
@@ -86,3 +95,29 @@ void ConstPropSplitImpl(Type elementType, char *constArray,
 void ConstPropTransposeImpl(Type elementType, char *constArray,
     llvm::ArrayRef<int64_t> constShape, llvm::ArrayRef<uint64_t> perm,
     llvm::ArrayRef<int64_t> resShape, char *resArray);
+
+/// Return true if converting 'val' to 'intTy' is defined, i.e. 'val' is finite
+/// and its truncation fits in the integer type.
+bool isFloatToIntegerCastDefined(double val, mlir::IntegerType intTy);
+
+/// Constant propagation for cast. Buffers hold double for floating point
+/// types and int64_t for integer types. Float to integer casts require every
+/// element to satisfy isFloatToIntegerCastDefined.
+void ConstPropCastImpl(Type srcElementType, Type dstElementType,
+    char *constArray, int64_t numElements, char *resArray);
+
+/// Constant propagation for matmul, with numpy-style batch broadcasting.
+void ConstPropMatMulImpl(mlir::MLIRContext *context, Type elementType,
+    char *aArray, llvm::ArrayRef<int64_t> aShape, char *bArray,
+    llvm::ArrayRef<int64_t> bShape, char *resArray);
+
+/// Constant propagation for gemm. 'cArray' is null when there is no bias.
+void ConstPropGemmImpl(mlir::MLIRContext *context, Type elementType,
+    char *aArray, llvm::ArrayRef<int64_t> aShape, bool transA, char *bArray,
+    llvm::ArrayRef<int64_t> bShape, bool transB, char *cArray,
+    llvm::ArrayRef<int64_t> cShape, double alpha, double beta, char *resArray);
+
+/// Constant propagation for gather.
+void ConstPropGatherImpl(char *dataArray, llvm::ArrayRef<int64_t> dataShape,
+    char *indicesArray, llvm::ArrayRef<int64_t> indicesShape, int64_t axis,
+    char *resArray);
@@ -41,7 +41,8 @@ enum InstrumentActions {
   InstrumentBeforeOp,
   InstrumentAfterOp,
   InstrumentReportTime,
-  InstrumentReportMemory
+  InstrumentReportMemory,
+  InstrumentReportPerf
 };
 
 // Inherited issue: no default value support for cl::bits
@@ -53,9 +54,28 @@ llvm::cl::bits<InstrumentActions> InstrumentControlBits(
         clEnumVal(
             InstrumentReportTime, "instrument runtime reports time usage"),
         clEnumVal(
-            InstrumentReportMemory, "instrument runtime reports memory usage")),
+            InstrumentReportMemory, "instrument runtime reports memory usage"),
+        clEnumVal(InstrumentReportPerf,
+            "instrument runtime reports hardware performance counters")),
     llvm::cl::cat(OMPassOptions));
 
+// Return a stable identifier for the node of op: its ONNX node name when it
+// has one, its location when it is named or has a file position, and
+// otherwise its op name followed by its rank among the ops of the function.
+std::string getNodeName(Operation *op, const char *opName, unsigned index) {
+  if (auto nodeName = op->getAttrOfType<StringAttr>("onnx_node_name"))
+    if (!nodeName.getValue().empty())
+      return nodeName.getValue().str();
+  Location loc = op->getLoc();
+  if (auto nameLoc = loc.dyn_cast<NameLoc>())
+    return nameLoc.getName().str();
+  if (auto fileLoc = loc.dyn_cast<FileLineColLoc>())
+    return (fileLoc.getFilename().strref() + ":" + Twine(fileLoc.getLine()) +
+            ":" + Twine(fileLoc.getColumn()))
+        .str();
+  return (Twine(opName) + "_" + Twine(index)).str();
+}
+
 class InstrumentONNXPass
     : public mlir::PassWrapper<InstrumentONNXPass, FunctionPass> {
 
@@ -90,10 +110,12 @@ public:
     init(instrumentONNXOps);
 
     // Iterate on the operations nested in this function
+    unsigned index = 0;
     getFunction().walk([&](mlir::Operation *op) {
       if (isa<mlir::ONNXOpsDialect>(op->getDialect())) {
         // Skip the prefix "onnx." of onnx op name
         const char *opName = op->getName().getStringRef().data() + 5;
+        std::string nodeName = getNodeName(op, opName, index++);
         if (!allOpsAllowed && allowedOps.find(opName) == allowedOps.end())
           return;
 
@@ -102,7 +124,7 @@ public:
         if (InstrumentControlBits.isSet(InstrumentBeforeOp)) {
           uint64_t tag =
               runtimeActions & (~(1 << static_cast<int>(InstrumentAfterOp)));
-          opBuilder.create<mlir::KrnlInstrumentOp>(loc, op, tag);
+          opBuilder.create<mlir::KrnlInstrumentOp>(loc, op, tag, nodeName);
         }
 
         // Can not insert after Op (e.g. ONNXReturnOP) with IsTerminator Trait
@@ -111,7 +133,7 @@ public:
           opBuilder.setInsertionPointAfter(op);
           uint64_t tag =
               runtimeActions & (~(1 << static_cast<int>(InstrumentBeforeOp)));
-          opBuilder.create<mlir::KrnlInstrumentOp>(loc, op, tag);
+          opBuilder.create<mlir::KrnlInstrumentOp>(loc, op, tag, nodeName);
         }
       }
     });
@@ -0,0 +1,451 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------------- NCHWcLayout.cpp - NCHW<b>c Layout Pass ----------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file implements a pass that rewrites 2D convolutions to operate on
+// channel blocked NCHW<b>c tensors, and propagates this layout through the
+// elementwise and pooling ops that follow them, so that the layout is only
+// converted at the boundaries of the convolutional part of the network.
+//
+// Each rewritten op X -> Y becomes
+//   LayoutTransform(NCHW) <- blocked op <- LayoutTransform(NCHW<b>c)
+// and a pair of back to back LayoutTransform ops, as created between two
+// rewritten ops, is removed by canonicalization.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "src/Dialect/ONNX/ONNXOps.hpp"
+#include "src/Dialect/ONNX/ONNXOpsHelper.hpp"
+#include "src/Pass/Passes.hpp"
+
+using namespace mlir;
+
+namespace {
+
+// Return true if type is a static 4D f32 tensor whose channels are a multiple
+// of blockSize.
+static bool isBlockableType(Type type, int64_t blockSize) {
+  auto tensorType = type.dyn_cast<RankedTensorType>();
+  if (!tensorType || !tensorType.hasStaticShape() ||
+      tensorType.getRank() != 4 || !tensorType.getElementType().isF32())
+    return false;
+  return tensorType.getShape()[1] % blockSize == 0;
+}
+
+// Return the NCHW<b>c type [N x C/b x H x W x b] of a NCHW type.
+static RankedTensorType getBlockedType(Type type, int64_t blockSize) {
+  auto tensorType = type.cast<RankedTensorType>();
+  ArrayRef<int64_t> shape = tensorType.getShape();
+  return RankedTensorType::get(
+      {shape[0], shape[1] / blockSize, shape[2], shape[3], blockSize},
+      tensorType.getElementType());
+}
+
+static Value emitToBlocked(
+    PatternRewriter &rewriter, Location loc, Value data, int64_t blockSize) {
+  std::string layout = "NCHW" + std::to_string(blockSize) + "c";
+  return rewriter.create<ONNXLayoutTransformOp>(loc,
+      getBlockedType(data.getType(), blockSize), data,
+      rewriter.getStringAttr(layout));
+}
+
+static Value emitToNCHW(
+    PatternRewriter &rewriter, Location loc, Type nchwType, Value data) {
+  return rewriter.create<ONNXLayoutTransformOp>(
+      loc, nchwType, data, rewriter.getStringAttr("NCHW"));
+}
+
+// If value is the conversion of a NCHW<b>c tensor back to NCHW, return the
+// NCHW<b>c tensor, so that the consumer can use it directly.
+static Value getBlockedSource(Value value, int64_t blockSize) {
+  auto transformOp =
+      dyn_cast_or_null<ONNXLayoutTransformOp>(value.getDefiningOp());
+  if (!transformOp || getNCHWcBlockSize(transformOp.target_layout()) != 0)
+    return nullptr;
+  auto sourceType = transformOp.data().getType().dyn_cast<RankedTensorType>();
+  if (!sourceType || sourceType.getRank() != 5 ||
+      sourceType.getShape()[4] != blockSize)
+    return nullptr;
+  return transformOp.data();
+}
+
+// Return the values of an optional array attribute, or numValues copies of
+// defaultValue when it is absent.
+static ArrayAttr getArrayAttrOrDefault(PatternRewriter &rewriter,
+    Optional<ArrayAttr> attr, int64_t numValues, int64_t defaultValue) {
+  if (attr.hasValue())
+    return attr.getValue();
+  SmallVector<int64_t, 4> values(numValues, defaultValue);
+  return rewriter.getI64ArrayAttr(values);
+}
+
+static bool isAllOnes(Optional<ArrayAttr> attr) {
+  if (!attr.hasValue())
+    return true;
+  for (int i = 0, e = ArrayAttrSize(attr); i < e; ++i)
+    if (ArrayAttrIntVal(attr, i) != 1)
+      return false;
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Conv
+//===----------------------------------------------------------------------===//
+
+class ConvToNCHWcPattern : public OpRewritePattern<ONNXConvOp> {
+public:
+  ConvToNCHWcPattern(MLIRContext *context, int64_t blockSize)
+      : OpRewritePattern<ONNXConvOp>(context), blockSize(blockSize) {}
+
+  LogicalResult matchAndRewrite(
+      ONNXConvOp convOp, PatternRewriter &rewriter) const override {
+    Location loc = convOp.getLoc();
+    Value X = convOp.X(), W = convOp.W(), Y = convOp.Y();
+    // The first convolution of a network usually has 3 channels, and stays
+    // in NCHW.
+    if (!isBlockableType(X.getType(), blockSize) ||
+        !isBlockableType(W.getType(), blockSize) ||
+        !isBlockableType(Y.getType(), blockSize))
+      return failure();
+    if (convOp.group() != 1)
+      return failure();
+    StringRef autoPad = convOp.auto_pad();
+    if (autoPad != "NOTSET" && autoPad != "VALID")
+      return failure();
+
+    ArrayRef<int64_t> wShape = W.getType().cast<ShapedType>().getShape();
+    ArrayAttr kernelShape = convOp.kernel_shape().hasValue()
+                                ? convOp.kernel_shape().getValue()
+                                : rewriter.getI64ArrayAttr(
+                                      {wShape[2], wShape[3]});
+    ArrayAttr pads = autoPad == "VALID"
+                         ? rewriter.getI64ArrayAttr({0, 0, 0, 0})
+                         : getArrayAttrOrDefault(rewriter, convOp.pads(), 4, 0);
+    ArrayAttr strides =
+        getArrayAttrOrDefault(rewriter, convOp.strides(), 2, 1);
+    ArrayAttr dilations =
+        getArrayAttrOrDefault(rewriter, convOp.dilations(), 2, 1);
+
+    Value blockedX = getBlockedSource(X, blockSize);
+    if (!blockedX)
+      blockedX = emitToBlocked(rewriter, loc, X, blockSize);
+    Value blockedY = rewriter.create<ONNXConvNCHWcOp>(loc,
+        getBlockedType(Y.getType(), blockSize), blockedX, W, convOp.B(),
+        dilations, kernelShape, pads, strides);
+    rewriter.replaceOp(
+        convOp, emitToNCHW(rewriter, loc, Y.getType(), blockedY));
+    return success();
+  }
+
+private:
+  int64_t blockSize;
+};
+
+//===----------------------------------------------------------------------===//
+// Elementwise ops
+//===----------------------------------------------------------------------===//
+
+// Rewrite an elementwise op, one of whose operands is produced by a blocked
+// op, to operate on NCHW<b>c tensors. The other operands must be either
+// broadcast scalars, which are kept as is, per channel tensors of shape
+// [C x 1 x 1] or [1 x C x 1 x 1], or full tensors of the result shape.
+template <typename OP>
+class ElementwiseToNCHWcPattern : public OpRewritePattern<OP> {
+public:
+  ElementwiseToNCHWcPattern(MLIRContext *context, int64_t blockSize)
+      : OpRewritePattern<OP>(context), blockSize(blockSize) {}
+
+  LogicalResult matchAndRewrite(
+      OP elementwiseOp, PatternRewriter &rewriter) const override {
+    Operation *op = elementwiseOp.getOperation();
+    Location loc = op->getLoc();
+    if (op->getNumResults() != 1)
+      return failure();
+    Type resultType = op->getResult(0).getType();
+    if (!isBlockableType(resultType, blockSize))
+      return failure();
+    ArrayRef<int64_t> resultShape =
+        resultType.cast<ShapedType>().getShape();
+    int64_t C = resultShape[1];
+
+    // Check the operands before creating any op.
+    bool hasBlockedOperand = false;
+    for (Value operand : op->getOperands()) {
+      if (operand.getType().isa<NoneType>())
+        continue;
+      if (getBlockedSource(operand, blockSize)) {
+        hasBlockedOperand = true;
+        continue;
+      }
+      auto operandType = operand.getType().dyn_cast<RankedTensorType>();
+      if (!operandType || !operandType.hasStaticShape())
+        return failure();
+      ArrayRef<int64_t> shape = operandType.getShape();
+      if (operandType.getNumElements() != 1 && !isPerChannel(shape, C) &&
+          shape != resultShape)
+        return failure();
+    }
+    if (!hasBlockedOperand)
+      return failure();
+
+    SmallVector<Value, 4> blockedOperands;
+    for (Value operand : op->getOperands()) {
+      if (operand.getType().isa<NoneType>()) {
+        blockedOperands.emplace_back(operand);
+      } else if (Value blocked = getBlockedSource(operand, blockSize)) {
+        blockedOperands.emplace_back(blocked);
+      } else {
+        auto operandType = operand.getType().cast<RankedTensorType>();
+        ArrayRef<int64_t> shape = operandType.getShape();
+        if (operandType.getNumElements() == 1) {
+          // Broadcast the same way against the NCHW<b>c result.
+          blockedOperands.emplace_back(operand);
+        } else if (isPerChannel(shape, C)) {
+          // [C x 1 x 1] -> [1 x C x 1 x 1] -> [1 x C/b x 1 x 1 x b]
+          SmallVector<int64_t, 4> nchwShape = {1, C, 1, 1};
+          Value reshaped = operand;
+          if (shape.size() != 4) {
+            OnnxBuilder createONNX(rewriter, loc);
+            Value shapeConst = createONNX.constant(DenseElementsAttr::get(
+                RankedTensorType::get({4}, rewriter.getI64Type()),
+                llvm::makeArrayRef(nchwShape)));
+            reshaped = createONNX.reshape(
+                RankedTensorType::get(nchwShape, operandType.getElementType()),
+                operand, shapeConst);
+          }
+          blockedOperands.emplace_back(
+              emitToBlocked(rewriter, loc, reshaped, blockSize));
+        } else {
+          blockedOperands.emplace_back(
+              emitToBlocked(rewriter, loc, operand, blockSize));
+        }
+      }
+    }
+
+    OperationState state(loc, op->getName());
+    state.addOperands(blockedOperands);
+    state.addAttributes(op->getAttrs());
+    state.addTypes(getBlockedType(resultType, blockSize));
+    Operation *blockedOp = rewriter.createOperation(state);
+    rewriter.replaceOp(
+        op, emitToNCHW(rewriter, loc, resultType, blockedOp->getResult(0)));
+    return success();
+  }
+
+private:
+  // Shape [C x 1 x 1] or [1 x C x 1 x 1].
+  static bool isPerChannel(ArrayRef<int64_t> shape, int64_t C) {
+    if (shape.size() == 4 && shape[0] != 1)
+      return false;
+    if (shape.size() != 3 && shape.size() != 4)
+      return false;
+    ArrayRef<int64_t> chw = shape.take_back(3);
+    return chw[0] == C && chw[1] == 1 && chw[2] == 1;
+  }
+
+  int64_t blockSize;
+};
+
+//===----------------------------------------------------------------------===//
+// Pooling
+//===----------------------------------------------------------------------===//
+
+// Common rewriting of the pooling ops whose input is produced by a blocked op.
+static LogicalResult rewritePoolToNCHWc(PatternRewriter &rewriter,
+    Operation *op, Value X, StringRef mode, int64_t countIncludePad,
+    ArrayAttr kernelShape, ArrayAttr pads, ArrayAttr strides,
+    int64_t blockSize) {
+  Value blockedX = getBlockedSource(X, blockSize);
+  Type resultType = op->getResult(0).getType();
+  if (!blockedX || !isBlockableType(resultType, blockSize))
+    return failure();
+  Location loc = op->getLoc();
+  Value blockedY = rewriter.create<ONNXPoolNCHWcOp>(loc,
+      getBlockedType(resultType, blockSize), blockedX,
+      rewriter.getStringAttr(mode),
+      rewriter.getIntegerAttr(
+          rewriter.getIntegerType(64, /*isSigned=*/true), countIncludePad),
+      kernelShape, pads, strides);
+  rewriter.replaceOp(op, emitToNCHW(rewriter, loc, resultType, blockedY));
+  return success();
+}
+
+// Return the explicit pads and the strides of a pooling op with auto_pad
+// NOTSET or VALID.
+template <typename OP>
+static void getPoolPadsAndStrides(PatternRewriter &rewriter, OP poolOp,
+    ArrayAttr &pads, ArrayAttr &strides) {
+  pads = poolOp.auto_pad() == "VALID"
+             ? rewriter.getI64ArrayAttr({0, 0, 0, 0})
+             : getArrayAttrOrDefault(rewriter, poolOp.pads(), 4, 0);
+  strides = getArrayAttrOrDefault(rewriter, poolOp.strides(), 2, 1);
+}
+
+template <typename OP>
+static bool isSupportedPool(OP poolOp) {
+  StringRef autoPad = poolOp.auto_pad();
+  return (autoPad == "NOTSET" || autoPad == "VALID") &&
+         poolOp.ceil_mode() == 0 && ArrayAttrSize(poolOp.kernel_shape()) == 2;
+}
+
+class MaxPoolToNCHWcPattern : public OpRewritePattern<ONNXMaxPoolSingleOutOp> {
+public:
+  MaxPoolToNCHWcPattern(MLIRContext *context, int64_t blockSize)
+      : OpRewritePattern<ONNXMaxPoolSingleOutOp>(context),
+        blockSize(blockSize) {}
+
+  LogicalResult matchAndRewrite(ONNXMaxPoolSingleOutOp poolOp,
+      PatternRewriter &rewriter) const override {
+    if (!isSupportedPool(poolOp) || poolOp.storage_order() != 0 ||
+        !isAllOnes(poolOp.dilations()))
+      return failure();
+    ArrayAttr pads, strides;
+    getPoolPadsAndStrides(rewriter, poolOp, pads, strides);
+    return rewritePoolToNCHWc(rewriter, poolOp.getOperation(), poolOp.X(),
+        "max", 0, poolOp.kernel_shape(), pads, strides, blockSize);
+  }
+
+private:
+  int64_t blockSize;
+};
+
+class AveragePoolToNCHWcPattern : public OpRewritePattern<ONNXAveragePoolOp> {
+public:
+  AveragePoolToNCHWcPattern(MLIRContext *context, int64_t blockSize)
+      : OpRewritePattern<ONNXAveragePoolOp>(context), blockSize(blockSize) {}
+
+  LogicalResult matchAndRewrite(
+      ONNXAveragePoolOp poolOp, PatternRewriter &rewriter) const override {
+    if (!isSupportedPool(poolOp))
+      return failure();
+    ArrayAttr pads, strides;
+    getPoolPadsAndStrides(rewriter, poolOp, pads, strides);
+    return rewritePoolToNCHWc(rewriter, poolOp.getOperation(), poolOp.X(),
+        "avg", poolOp.count_include_pad(), poolOp.kernel_shape(), pads,
+        strides, blockSize);
+  }
+
+private:
+  int64_t blockSize;
+};
+
+// GlobalAveragePool and GlobalMaxPool are pools whose kernel is the whole
+// image.
+template <typename OP>
+class GlobalPoolToNCHWcPattern : public OpRewritePattern<OP> {
+public:
+  GlobalPoolToNCHWcPattern(
+      MLIRContext *context, int64_t blockSize, StringRef mode)
+      : OpRewritePattern<OP>(context), blockSize(blockSize), mode(mode) {}
+
+  LogicalResult matchAndRewrite(
+      OP poolOp, PatternRewriter &rewriter) const override {
+    auto xType = poolOp.X().getType().template dyn_cast<RankedTensorType>();
+    if (!xType || !xType.hasStaticShape() || xType.getRank() != 4)
+      return failure();
+    ArrayRef<int64_t> xShape = xType.getShape();
+    return rewritePoolToNCHWc(rewriter, poolOp.getOperation(), poolOp.X(),
+        mode, 0, rewriter.getI64ArrayAttr({xShape[2], xShape[3]}),
+        rewriter.getI64ArrayAttr({0, 0, 0, 0}),
+        rewriter.getI64ArrayAttr({1, 1}), blockSize);
+  }
+
+private:
+  int64_t blockSize;
+  std::string mode;
+};
+
+//===----------------------------------------------------------------------===//
+// Pass
+//===----------------------------------------------------------------------===//
+
+struct ONNXToNCHWcPass
+    : public PassWrapper<ONNXToNCHWcPass, FunctionPass> {
+
+  StringRef getArgument() const override { return "convert-onnx-to-nchwc"; }
+
+  StringRef getDescription() const override {
+    return "Rewrite 2D convolutions, and the elementwise and pooling ops that "
+           "follow them, to operate on channel blocked NCHW<b>c tensors.";
+  }
+
+  Option<int> blockSize{*this, "block-size",
+      llvm::cl::desc("number of channels b of a block, e.g. 8 for AVX2 or 16 "
+                     "for AVX-512 with f32 data."),
+      llvm::cl::init(8)};
+
+  ONNXToNCHWcPass() = default;
+  ONNXToNCHWcPass(const ONNXToNCHWcPass &pass)
+      : PassWrapper<ONNXToNCHWcPass, FunctionPass>() {}
+  ONNXToNCHWcPass(int blockSize_) { this->blockSize = blockSize_; }
+
+  void runOnFunction() final {
+    if (blockSize < 1) {
+      getFunction().emitError("Invalid NCHWc block size ") << blockSize;
+      return signalPassFailure();
+    }
+    MLIRContext *context = &getContext();
+    RewritePatternSet patterns(context);
+    patterns.insert<ConvToNCHWcPattern>(context, blockSize);
+    patterns.insert<ElementwiseToNCHWcPattern<ONNXReluOp>,
+        ElementwiseToNCHWcPattern<ONNXLeakyReluOp>,
+        ElementwiseToNCHWcPattern<ONNXSigmoidOp>,
+        ElementwiseToNCHWcPattern<ONNXHardSigmoidOp>,
+        ElementwiseToNCHWcPattern<ONNXTanhOp>,
+        ElementwiseToNCHWcPattern<ONNXEluOp>,
+        ElementwiseToNCHWcPattern<ONNXSeluOp>,
+        ElementwiseToNCHWcPattern<ONNXSoftplusOp>,
+        ElementwiseToNCHWcPattern<ONNXSoftsignOp>,
+        ElementwiseToNCHWcPattern<ONNXExpOp>,
+        ElementwiseToNCHWcPattern<ONNXLogOp>,
+        ElementwiseToNCHWcPattern<ONNXNegOp>,
+        ElementwiseToNCHWcPattern<ONNXAbsOp>,
+        ElementwiseToNCHWcPattern<ONNXSqrtOp>,
+        ElementwiseToNCHWcPattern<ONNXReciprocalOp>,
+        ElementwiseToNCHWcPattern<ONNXErfOp>,
+        ElementwiseToNCHWcPattern<ONNXClipOp>,
+        ElementwiseToNCHWcPattern<ONNXPReluOp>,
+        ElementwiseToNCHWcPattern<ONNXAddOp>,
+        ElementwiseToNCHWcPattern<ONNXSubOp>,
+        ElementwiseToNCHWcPattern<ONNXMulOp>,
+        ElementwiseToNCHWcPattern<ONNXDivOp>,
+        ElementwiseToNCHWcPattern<ONNXMaxOp>,
+        ElementwiseToNCHWcPattern<ONNXMinOp>,
+        ElementwiseToNCHWcPattern<ONNXSumOp>>(context, blockSize);
+    patterns.insert<MaxPoolToNCHWcPattern, AveragePoolToNCHWcPattern>(
+        context, blockSize);
+    patterns.insert<GlobalPoolToNCHWcPattern<ONNXGlobalAveragePoolOp>>(
+        context, blockSize, "avg");
+    patterns.insert<GlobalPoolToNCHWcPattern<ONNXGlobalMaxPoolOp>>(
+        context, blockSize, "max");
+    // Remove the conversions back and forth between two blocked ops.
+    ONNXLayoutTransformOp::getCanonicalizationPatterns(patterns, context);
+    if (failed(applyPatternsAndFoldGreedily(
+            getFunction(), std::move(patterns))))
+      signalPassFailure();
+  }
+};
+
+} // end anonymous namespace
+
+/*!
+ * Create a NCHWc layout pass.
+ */
+std::unique_ptr<mlir::Pass> mlir::createONNXToNCHWcPass() {
+  return std::make_unique<ONNXToNCHWcPass>();
+}
+
+std::unique_ptr<mlir::Pass> mlir::createONNXToNCHWcPass(int blockSize) {
+  return std::make_unique<ONNXToNCHWcPass>(blockSize);
+}
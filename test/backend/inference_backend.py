@@ -191,6 +191,15 @@ def get_test_models():
         # ConvInteger
 
         # ConvTranspose
+        # CONSTANT_INPUT for weight. Only the batch size may be dynamic.
+        "test_convtranspose_1d_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{0}}, CONSTANT_INPUT:{1}},
+        "test_convtranspose_3d_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{0}}, CONSTANT_INPUT:{1}},
+        "test_convtranspose_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{0}}, CONSTANT_INPUT:{1}},
+        "test_convtranspose_dilations_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{0}}, CONSTANT_INPUT:{1}},
+        "test_convtranspose_kernel_shape_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{0}}, CONSTANT_INPUT:{1}},
+        "test_convtranspose_output_shape_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{0}}, CONSTANT_INPUT:{1}},
+        "test_convtranspose_pad_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{0}}, CONSTANT_INPUT:{1}},
+        "test_convtranspose_pads_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{0:{0}}, CONSTANT_INPUT:{1}},
 
         # Cos
         "test_cos_example_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
@@ -213,7 +222,9 @@ def get_test_models():
         "test_depthtospace_example_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
         "test_depthtospace_crd_mode_example_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
-        # DequatizeLinear
+        # DequantizeLinear
+        "test_dequantizelinear_cpu": {STATIC_SHAPE:{}},
+        "test_dequantizelinear_axis_cpu": {STATIC_SHAPE:{}},
 
         # Det
 
@@ -397,6 +408,7 @@ def get_test_models():
         "test_matmul_4d_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
         # Matmul Integer
+        "test_matmulinteger_cpu": {STATIC_SHAPE:{}},
 
         # Max
         "test_max_example_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
@@ -539,10 +551,15 @@ def get_test_models():
         "test_prelu_broadcast_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
 
         # QLinear Conv
+        "test_qlinearconv_cpu": {STATIC_SHAPE:{}},
 
         # QLinear Matmul
+        "test_qlinearmatmul_2D_cpu": {STATIC_SHAPE:{}},
+        "test_qlinearmatmul_3D_cpu": {STATIC_SHAPE:{}},
 
         # Quantize Linear
+        "test_quantizelinear_cpu": {STATIC_SHAPE:{}},
+        "test_quantizelinear_axis_cpu": {STATIC_SHAPE:{}},
 
         # Range
         "test_range_float_type_positive_delta_cpu": {STATIC_SHAPE:{}, DYNAMIC_SHAPE:{-1:{-1}}, CONSTANT_INPUT:{-1}},
@@ -489,6 +489,30 @@ func @copy_to_nested_partial(%p0 : index, %p1 : index) -> () {
 // CHECK:         }
 }
 
+// -----
+
+// Half precision source extended into a f32 buffer.
+func private @copy_to_f16_source(%p0 : index, %p1 : index) -> () {
+  //A source, B buffer
+  %A = memref.alloca() : memref<40x60xf16>
+  %B = memref.alloca() : memref<4x6xf32>
+  %f0 = arith.constant 0.0 : f32
+
+  %i10 = arith.constant 10 : index
+  %i12 = arith.constant 12 : index
+  krnl.copy_to_tile_buffer %B, %A [%i10, %i12], %f0 : memref<4x6xf32>, memref<40x60xf16>
+  return
+
+// CHECK-LABEL:  func private @copy_to_f16_source
+// CHECK-DAG:       [[ORGINAL_:%.+]] = memref.alloca() : memref<40x60xf16>
+// CHECK-DAG:       [[BUFFER_:%.+]] = memref.alloca() : memref<4x6xf32>
+// CHECK:           affine.for [[I_0_:%.+]] = 0 to 4 {
+// CHECK:             affine.for [[I_1_:%.+]] = 0 to 6 {
+// CHECK:               [[LOAD_ORGINAL_MEM_:%.+]] = affine.load [[ORGINAL_]]{{.}}[[I_0_]] + 10, [[I_1_]] + 12] : memref<40x60xf16>
+// CHECK:               [[EXT_:%.+]] = arith.extf [[LOAD_ORGINAL_MEM_]] : f16 to f32
+// CHECK:               affine.store [[EXT_]], [[BUFFER_]]{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<4x6xf32>
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // COPY FROM
 
@@ -659,3 +683,25 @@ func private @copy_from_partial_runtime(%p0 : index, %p1 : index) -> () {
 // CHECK:           return
 // CHECK:         }
 }
+
+// -----
+
+// f32 buffer truncated into a half precision destination.
+func private @copy_from_bf16_dest(%p0 : index, %p1 : index) -> () {
+  %A = memref.alloca() : memref<40x60xbf16>
+  %B = memref.alloca() : memref<4x6xf32>
+
+  %i10 = arith.constant 10 : index
+  %i12 = arith.constant 12 : index
+  krnl.copy_from_tile_buffer %B, %A [%i10, %i12]: memref<4x6xf32>, memref<40x60xbf16>
+  return
+
+// CHECK-LABEL:  func private @copy_from_bf16_dest
+// CHECK-DAG:       [[ORGINAL_:%.+]] = memref.alloca() : memref<40x60xbf16>
+// CHECK-DAG:       [[BUFFER_:%.+]] = memref.alloca() : memref<4x6xf32>
+// CHECK:           affine.for [[I_0_:%.+]] = 0 to 4 {
+// CHECK:             affine.for [[I_1_:%.+]] = 0 to 6 {
+// CHECK:               [[LOAD_BUFFER_MEM_:%.+]] = affine.load [[BUFFER_]]{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<4x6xf32>
+// CHECK:               [[TRUNC_:%.+]] = arith.truncf [[LOAD_BUFFER_MEM_]] : f32 to bf16
+// CHECK:               affine.store [[TRUNC_]], [[ORGINAL_]]{{.}}[[I_0_]] + 10, [[I_1_]] + 12] : memref<40x60xbf16>
+}
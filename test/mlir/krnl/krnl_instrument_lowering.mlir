@@ -0,0 +1,18 @@
+// RUN: onnx-mlir-opt --convert-krnl-to-llvm %s -split-input-file | FileCheck %s
+
+// Check that named instrumentation points pass their op and node names as
+// null terminated strings, shared by the points of the same node.
+func @test_instrument_named_point() {
+  "krnl.runtime_instrument"() {nodeName = "conv_1", opID = 1986948931 : i64, opName = "Conv", tag = 5 : i64} : () -> ()
+  "krnl.runtime_instrument"() {nodeName = "conv_1", opID = 1986948931 : i64, opName = "Conv", tag = 6 : i64} : () -> ()
+  return
+
+// CHECK-DAG:   llvm.mlir.global internal constant @om_instrument_op_Conv("Conv\00")
+// CHECK-DAG:   llvm.mlir.global internal constant @om_instrument_node_conv_1("conv_1\00")
+// CHECK-DAG:   llvm.func @OMInstrumentNamedPoint(!llvm.ptr<i8>, !llvm.ptr<i8>, i64)
+// CHECK-LABEL: llvm.func @test_instrument_named_point
+// CHECK:         [[TAG0:%.+]] = llvm.mlir.constant(5 : i64) : i64
+// CHECK:         llvm.call @OMInstrumentNamedPoint({{.*}}, {{.*}}, [[TAG0]]) : (!llvm.ptr<i8>, !llvm.ptr<i8>, i64) -> ()
+// CHECK:         [[TAG1:%.+]] = llvm.mlir.constant(6 : i64) : i64
+// CHECK:         llvm.call @OMInstrumentNamedPoint({{.*}}, {{.*}}, [[TAG1]]) : (!llvm.ptr<i8>, !llvm.ptr<i8>, i64) -> ()
+}
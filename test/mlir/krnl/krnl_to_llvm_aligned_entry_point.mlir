@@ -0,0 +1,45 @@
+// RUN: onnx-mlir-opt --convert-krnl-to-llvm='aligned-entry-point' %s -split-input-file | FileCheck %s
+
+module {
+// Check that the entry point dispatches to the aligned variant of the entry
+// function when its inputs are aligned on 64 bytes.
+  func @add(%arg0: memref<16xf32>, %arg1: memref<16xf32>) -> memref<16xf32> {
+    %0 = memref.alloc() : memref<16xf32>
+    affine.for %i = 0 to 16 {
+      %1 = affine.load %arg0[%i] : memref<16xf32>
+      %2 = affine.load %arg1[%i] : memref<16xf32>
+      %3 = arith.addf %1, %2 : f32
+      affine.store %3, %0[%i] : memref<16xf32>
+    }
+    return %0 : memref<16xf32>
+  }
+  "krnl.entry_point"() {func = @add, numInputs = 2 : i32, numOutputs = 1 : i32, signature = ""} : () -> ()
+
+  // CHECK-LABEL: llvm.func @add
+  // CHECK:         llvm.mlir.constant(64 : index) : i64
+  // CHECK:         llvm.call @malloc
+
+  // CHECK:       llvm.func @add_aligned(%arg0: !llvm.ptr<f32>, %arg1: !llvm.ptr<f32> {llvm.align = 64 : i64, llvm.noalias}, {{.*}}, %arg6: !llvm.ptr<f32> {llvm.align = 64 : i64, llvm.noalias}
+
+  // CHECK:       llvm.func @_mlir_ciface_add_aligned
+  // CHECK:         llvm.call @add_aligned
+
+  // CHECK-LABEL: llvm.func @run_add
+  // CHECK:         [[MASK:%.+]] = llvm.mlir.constant(63 : i64) : i64
+  // CHECK:         [[ADDR0:%.+]] = llvm.ptrtoint {{.*}} : !llvm.ptr<i8> to i64
+  // CHECK:         [[LOW0:%.+]] = llvm.and [[ADDR0]], [[MASK]] : i64
+  // CHECK:         [[OK0:%.+]] = llvm.icmp "eq" [[LOW0]], {{.*}} : i64
+  // CHECK:         [[ADDR1:%.+]] = llvm.ptrtoint {{.*}} : !llvm.ptr<i8> to i64
+  // CHECK:         [[LOW1:%.+]] = llvm.and [[ADDR1]], [[MASK]] : i64
+  // CHECK:         [[OK1:%.+]] = llvm.icmp "eq" [[LOW1]], {{.*}} : i64
+  // CHECK:         [[ALL:%.+]] = llvm.and [[OK0]], [[OK1]] : i1
+  // CHECK:         llvm.cond_br [[ALL]], ^bb1, ^bb2
+  // CHECK:       ^bb1:
+  // CHECK:         llvm.call @_mlir_ciface_add_aligned
+  // CHECK:         llvm.br ^bb3
+  // CHECK:       ^bb2:
+  // CHECK:         llvm.call @_mlir_ciface_add(
+  // CHECK:         llvm.br ^bb3
+  // CHECK:       ^bb3:
+  // CHECK:         llvm.call @omTensorArrayCreate
+}
@@ -0,0 +1,20 @@
+// RUN: onnx-mlir-opt --convert-krnl-to-llvm='symbol-prefix=mnist_' %s -split-input-file | FileCheck %s
+
+module {
+// Check that the symbols exported for the entry point are prefixed, and that
+// the entry function itself is no longer exported.
+  func @main_graph(%arg0: memref<10xf32>) -> memref<10xf32> {
+    return %arg0 : memref<10xf32>
+  }
+  "krnl.entry_point"() {func = @main_graph, numInputs = 1 : i32, numOutputs = 1 : i32, signature = "[in]@[out]"} : () -> ()
+
+  // CHECK-DAG:   llvm.func internal @main_graph
+  // CHECK-DAG:   llvm.func internal @_mlir_ciface_main_graph
+  // CHECK-DAG:   llvm.mlir.global external constant @mnist__in_signature("[in]")
+  // CHECK-DAG:   llvm.mlir.global external constant @mnist__out_signature("[out]")
+  // CHECK-DAG:   func @mnist_omInputSignature() -> !llvm.ptr<i8>
+  // CHECK-DAG:   func @mnist_omOutputSignature() -> !llvm.ptr<i8>
+  // CHECK-DAG:   llvm.func @mnist_run_main_graph(%arg0: !llvm.ptr<i8>) -> !llvm.ptr<i8>
+  // CHECK-NOT:   @run_main_graph
+  // CHECK-NOT:   @omInputSignature
+}
@@ -576,3 +576,154 @@ func @test_fuse_add_conv(%arg0 : tensor<1x1x28x28xf32>, %arg1 : tensor<8x1x5x5xf
     // CHECK: return [[RES]] : tensor<1x8x28x28xf32>
     // CHECK: }
 }
+
+// -----
+
+func @test_remove_layout_transform_pair(%arg0 : tensor<1x2x4x4x8xf32>) -> tensor<1x2x4x4x8xf32> {
+    %0 = "onnx.LayoutTransform"(%arg0) {target_layout = "NCHW"} : (tensor<1x2x4x4x8xf32>) -> tensor<1x16x4x4xf32>
+    %1 = "onnx.LayoutTransform"(%0) {target_layout = "NCHW8c"} : (tensor<1x16x4x4xf32>) -> tensor<1x2x4x4x8xf32>
+    return %1 : tensor<1x2x4x4x8xf32>
+
+    // CHECK-LABEL: test_remove_layout_transform_pair
+    // CHECK-NOT: onnx.LayoutTransform
+    // CHECK: return %arg0 : tensor<1x2x4x4x8xf32>
+}
+
+// -----
+
+func @test_keep_layout_transform_pair(%arg0 : tensor<1x2x4x4x8xf32>) -> tensor<1x1x4x4x16xf32> {
+    %0 = "onnx.LayoutTransform"(%arg0) {target_layout = "NCHW"} : (tensor<1x2x4x4x8xf32>) -> tensor<1x16x4x4xf32>
+    %1 = "onnx.LayoutTransform"(%0) {target_layout = "NCHW16c"} : (tensor<1x16x4x4xf32>) -> tensor<1x1x4x4x16xf32>
+    return %1 : tensor<1x1x4x4x16xf32>
+
+    // CHECK-LABEL: test_keep_layout_transform_pair
+    // CHECK: [[NCHW:%.+]] = "onnx.LayoutTransform"(%arg0) {target_layout = "NCHW"} : (tensor<1x2x4x4x8xf32>) -> tensor<1x16x4x4xf32>
+    // CHECK: [[RES:%.+]] = "onnx.LayoutTransform"([[NCHW]]) {target_layout = "NCHW16c"} : (tensor<1x16x4x4xf32>) -> tensor<1x1x4x4x16xf32>
+    // CHECK: return [[RES]] : tensor<1x1x4x4x16xf32>
+}
+
+// -----
+
+func @test_fuse_layer_normalization(%arg0 : tensor<2x4x8xf32>, %arg1 : tensor<8xf32>, %arg2 : tensor<8xf32>) -> tensor<2x4x8xf32> {
+    %two = "onnx.Constant"() {value = dense<2.0> : tensor<f32>} : () -> tensor<f32>
+    %eps = "onnx.Constant"() {value = dense<1.0e-5> : tensor<f32>} : () -> tensor<f32>
+    %0 = "onnx.ReduceMean"(%arg0) {axes = [-1], keepdims = 1 : si64} : (tensor<2x4x8xf32>) -> tensor<2x4x1xf32>
+    %1 = "onnx.Sub"(%arg0, %0) : (tensor<2x4x8xf32>, tensor<2x4x1xf32>) -> tensor<2x4x8xf32>
+    %2 = "onnx.Pow"(%1, %two) : (tensor<2x4x8xf32>, tensor<f32>) -> tensor<2x4x8xf32>
+    %3 = "onnx.ReduceMean"(%2) {axes = [-1], keepdims = 1 : si64} : (tensor<2x4x8xf32>) -> tensor<2x4x1xf32>
+    %4 = "onnx.Add"(%3, %eps) : (tensor<2x4x1xf32>, tensor<f32>) -> tensor<2x4x1xf32>
+    %5 = "onnx.Sqrt"(%4) : (tensor<2x4x1xf32>) -> tensor<2x4x1xf32>
+    %6 = "onnx.Div"(%1, %5) : (tensor<2x4x8xf32>, tensor<2x4x1xf32>) -> tensor<2x4x8xf32>
+    %7 = "onnx.Mul"(%6, %arg1) : (tensor<2x4x8xf32>, tensor<8xf32>) -> tensor<2x4x8xf32>
+    %8 = "onnx.Add"(%7, %arg2) : (tensor<2x4x8xf32>, tensor<8xf32>) -> tensor<2x4x8xf32>
+    return %8 : tensor<2x4x8xf32>
+
+    // CHECK-LABEL: test_fuse_layer_normalization
+    // CHECK-SAME:  ([[X:%.+]]: tensor<2x4x8xf32>, [[SCALE:%.+]]: tensor<8xf32>, [[BIAS:%.+]]: tensor<8xf32>) -> tensor<2x4x8xf32> {
+    // CHECK: [[RES:%.+]]:3 = "onnx.LayerNormalization"([[X]], [[SCALE]], [[BIAS]]) {axis = 2 : si64, epsilon = 9.99999974E-6 : f32, stash_type = 1 : si64} : (tensor<2x4x8xf32>, tensor<8xf32>, tensor<8xf32>) -> (tensor<2x4x8xf32>, none, none)
+    // CHECK-NOT: onnx.ReduceMean
+    // CHECK: return [[RES]]#0 : tensor<2x4x8xf32>
+}
+
+// -----
+
+// Scale first in Mul, and normalization over the two last dimensions.
+func @test_fuse_layer_normalization_scale_first(%arg0 : tensor<2x4x8xf32>, %arg1 : tensor<4x8xf32>) -> tensor<2x4x8xf32> {
+    %two = "onnx.Constant"() {value = dense<2.0> : tensor<1xf32>} : () -> tensor<1xf32>
+    %eps = "onnx.Constant"() {value = dense<1.0e-12> : tensor<f32>} : () -> tensor<f32>
+    %bias = "onnx.Constant"() {value = dense<0.5> : tensor<8xf32>} : () -> tensor<8xf32>
+    %0 = "onnx.ReduceMean"(%arg0) {axes = [1, 2]} : (tensor<2x4x8xf32>) -> tensor<2x1x1xf32>
+    %1 = "onnx.Sub"(%arg0, %0) : (tensor<2x4x8xf32>, tensor<2x1x1xf32>) -> tensor<2x4x8xf32>
+    %2 = "onnx.Pow"(%1, %two) : (tensor<2x4x8xf32>, tensor<1xf32>) -> tensor<2x4x8xf32>
+    %3 = "onnx.ReduceMean"(%2) {axes = [-2, -1]} : (tensor<2x4x8xf32>) -> tensor<2x1x1xf32>
+    %4 = "onnx.Add"(%3, %eps) : (tensor<2x1x1xf32>, tensor<f32>) -> tensor<2x1x1xf32>
+    %5 = "onnx.Sqrt"(%4) : (tensor<2x1x1xf32>) -> tensor<2x1x1xf32>
+    %6 = "onnx.Div"(%1, %5) : (tensor<2x4x8xf32>, tensor<2x1x1xf32>) -> tensor<2x4x8xf32>
+    %7 = "onnx.Mul"(%arg1, %6) : (tensor<4x8xf32>, tensor<2x4x8xf32>) -> tensor<2x4x8xf32>
+    %8 = "onnx.Add"(%7, %bias) : (tensor<2x4x8xf32>, tensor<8xf32>) -> tensor<2x4x8xf32>
+    return %8 : tensor<2x4x8xf32>
+
+    // CHECK-LABEL: test_fuse_layer_normalization_scale_first
+    // CHECK-SAME:  ([[X:%.+]]: tensor<2x4x8xf32>, [[SCALE:%.+]]: tensor<4x8xf32>) -> tensor<2x4x8xf32> {
+    // CHECK: [[BIAS:%.+]] = "onnx.Constant"() {value = dense<5.000000e-01> : tensor<8xf32>} : () -> tensor<8xf32>
+    // CHECK: [[RES:%.+]]:3 = "onnx.LayerNormalization"([[X]], [[SCALE]], [[BIAS]]) {axis = 1 : si64, epsilon = 9.99999996E-13 : f32, stash_type = 1 : si64} : (tensor<2x4x8xf32>, tensor<4x8xf32>, tensor<8xf32>) -> (tensor<2x4x8xf32>, none, none)
+    // CHECK: return [[RES]]#0 : tensor<2x4x8xf32>
+}
+
+// -----
+
+// The reduction is not over the trailing dimensions: no fusion.
+func @test_keep_layer_normalization_leading_axes(%arg0 : tensor<2x4x8xf32>, %arg1 : tensor<2x1x1xf32>, %arg2 : tensor<2x1x1xf32>) -> tensor<2x4x8xf32> {
+    %two = "onnx.Constant"() {value = dense<2.0> : tensor<f32>} : () -> tensor<f32>
+    %eps = "onnx.Constant"() {value = dense<1.0e-5> : tensor<f32>} : () -> tensor<f32>
+    %0 = "onnx.ReduceMean"(%arg0) {axes = [1], keepdims = 1 : si64} : (tensor<2x4x8xf32>) -> tensor<2x1x8xf32>
+    %1 = "onnx.Sub"(%arg0, %0) : (tensor<2x4x8xf32>, tensor<2x1x8xf32>) -> tensor<2x4x8xf32>
+    %2 = "onnx.Pow"(%1, %two) : (tensor<2x4x8xf32>, tensor<f32>) -> tensor<2x4x8xf32>
+    %3 = "onnx.ReduceMean"(%2) {axes = [1], keepdims = 1 : si64} : (tensor<2x4x8xf32>) -> tensor<2x1x8xf32>
+    %4 = "onnx.Add"(%3, %eps) : (tensor<2x1x8xf32>, tensor<f32>) -> tensor<2x1x8xf32>
+    %5 = "onnx.Sqrt"(%4) : (tensor<2x1x8xf32>) -> tensor<2x1x8xf32>
+    %6 = "onnx.Div"(%1, %5) : (tensor<2x4x8xf32>, tensor<2x1x8xf32>) -> tensor<2x4x8xf32>
+    %7 = "onnx.Mul"(%6, %arg1) : (tensor<2x4x8xf32>, tensor<2x1x1xf32>) -> tensor<2x4x8xf32>
+    %8 = "onnx.Add"(%7, %arg2) : (tensor<2x4x8xf32>, tensor<2x1x1xf32>) -> tensor<2x4x8xf32>
+    return %8 : tensor<2x4x8xf32>
+
+    // CHECK-LABEL: test_keep_layer_normalization_leading_axes
+    // CHECK-NOT: onnx.LayerNormalization
+    // CHECK: onnx.ReduceMean
+    // CHECK: return
+}
+
+// -----
+
+// Attention with scaled scores and a mask, with keys transposed by the model.
+func @test_fuse_attention(%arg0 : tensor<2x4x16x8xf32>, %arg1 : tensor<2x4x32x8xf32>, %arg2 : tensor<2x4x32x8xf32>, %arg3 : tensor<2x1x1x32xf32>) -> tensor<2x4x16x8xf32> {
+    %c = "onnx.Constant"() {value = dense<2.0> : tensor<f32>} : () -> tensor<f32>
+    %0 = "onnx.Transpose"(%arg1) {perm = [0, 1, 3, 2]} : (tensor<2x4x32x8xf32>) -> tensor<2x4x8x32xf32>
+    %1 = "onnx.MatMul"(%arg0, %0) : (tensor<2x4x16x8xf32>, tensor<2x4x8x32xf32>) -> tensor<2x4x16x32xf32>
+    %2 = "onnx.Div"(%1, %c) : (tensor<2x4x16x32xf32>, tensor<f32>) -> tensor<2x4x16x32xf32>
+    %3 = "onnx.Add"(%2, %arg3) : (tensor<2x4x16x32xf32>, tensor<2x1x1x32xf32>) -> tensor<2x4x16x32xf32>
+    %4 = "onnx.Softmax"(%3) {axis = -1 : si64} : (tensor<2x4x16x32xf32>) -> tensor<2x4x16x32xf32>
+    %5 = "onnx.MatMul"(%4, %arg2) : (tensor<2x4x16x32xf32>, tensor<2x4x32x8xf32>) -> tensor<2x4x16x8xf32>
+    return %5 : tensor<2x4x16x8xf32>
+
+    // CHECK-LABEL: test_fuse_attention
+    // CHECK-SAME:  ([[Q:%.+]]: tensor<2x4x16x8xf32>, [[K:%.+]]: tensor<2x4x32x8xf32>, [[V:%.+]]: tensor<2x4x32x8xf32>, [[MASK:%.+]]: tensor<2x1x1x32xf32>) -> tensor<2x4x16x8xf32> {
+    // CHECK-NOT: onnx.Transpose
+    // CHECK: [[RES:%.+]] = "onnx.ScaledDotProductAttention"([[Q]], [[K]], [[V]], [[MASK]]) {scale = 5.000000e-01 : f32} : (tensor<2x4x16x8xf32>, tensor<2x4x32x8xf32>, tensor<2x4x32x8xf32>, tensor<2x1x1x32xf32>) -> tensor<2x4x16x8xf32>
+    // CHECK-NOT: onnx.Softmax
+    // CHECK: return [[RES]] : tensor<2x4x16x8xf32>
+}
+
+// -----
+
+// Attention with scores multiplied by a constant, and no mask.
+func @test_fuse_attention_mul(%arg0 : tensor<4x16x8xf32>, %arg1 : tensor<4x8x20xf32>, %arg2 : tensor<4x20x6xf32>) -> tensor<4x16x6xf32> {
+    %c = "onnx.Constant"() {value = dense<0.125> : tensor<1xf32>} : () -> tensor<1xf32>
+    %0 = "onnx.MatMul"(%arg0, %arg1) : (tensor<4x16x8xf32>, tensor<4x8x20xf32>) -> tensor<4x16x20xf32>
+    %1 = "onnx.Mul"(%0, %c) : (tensor<4x16x20xf32>, tensor<1xf32>) -> tensor<4x16x20xf32>
+    %2 = "onnx.Softmax"(%1) {axis = 2 : si64} : (tensor<4x16x20xf32>) -> tensor<4x16x20xf32>
+    %3 = "onnx.MatMul"(%2, %arg2) : (tensor<4x16x20xf32>, tensor<4x20x6xf32>) -> tensor<4x16x6xf32>
+    return %3 : tensor<4x16x6xf32>
+
+    // CHECK-LABEL: test_fuse_attention_mul
+    // CHECK-SAME:  ([[Q:%.+]]: tensor<4x16x8xf32>, [[KT:%.+]]: tensor<4x8x20xf32>, [[V:%.+]]: tensor<4x20x6xf32>) -> tensor<4x16x6xf32> {
+    // CHECK-DAG: [[NONE:%.+]] = constant unit
+    // CHECK-DAG: [[K:%.+]] = "onnx.Transpose"([[KT]]) {perm = [0, 2, 1]} : (tensor<4x8x20xf32>) -> tensor<4x20x8xf32>
+    // CHECK: [[RES:%.+]] = "onnx.ScaledDotProductAttention"([[Q]], [[K]], [[V]], [[NONE]]) {scale = 1.250000e-01 : f32} : (tensor<4x16x8xf32>, tensor<4x20x8xf32>, tensor<4x20x6xf32>, none) -> tensor<4x16x6xf32>
+    // CHECK: return [[RES]] : tensor<4x16x6xf32>
+}
+
+// -----
+
+// The softmax is not along the last axis: no fusion.
+func @test_keep_attention_softmax_axis(%arg0 : tensor<4x16x8xf32>, %arg1 : tensor<4x8x20xf32>, %arg2 : tensor<4x20x6xf32>) -> tensor<4x16x6xf32> {
+    %0 = "onnx.MatMul"(%arg0, %arg1) : (tensor<4x16x8xf32>, tensor<4x8x20xf32>) -> tensor<4x16x20xf32>
+    %1 = "onnx.Softmax"(%0) {axis = 1 : si64} : (tensor<4x16x20xf32>) -> tensor<4x16x20xf32>
+    %2 = "onnx.MatMul"(%1, %arg2) : (tensor<4x16x20xf32>, tensor<4x20x6xf32>) -> tensor<4x16x6xf32>
+    return %2 : tensor<4x16x6xf32>
+
+    // CHECK-LABEL: test_keep_attention_softmax_axis
+    // CHECK-NOT: onnx.ScaledDotProductAttention
+    // CHECK: onnx.Softmax
+    // CHECK: return
+}
@@ -440,3 +440,90 @@ func @test_splitv11_axis_2(%arg0 : tensor<2x10xf32>) -> (tensor<2x5xf32>, tensor
 
   // CHECK: {{.*}} = "onnx.SplitV11"(%arg0) {axis = 1 : si64, split = [5, 5]} : (tensor<2x10xf32>) -> (tensor<2x5xf32>, tensor<2x5xf32>)
 }
+
+//===----------------------------------------------------------------------===//
+/// Cast tests
+
+// -----
+
+// CHECK-LABEL: @test_cast_f32_i32() -> tensor<3xi32>
+func @test_cast_f32_i32() -> tensor<3xi32> {
+  %0 = "onnx.Constant"() {value = dense<[-1.5, 0.5, 2.7]> : tensor<3xf32>} : () -> tensor<3xf32>
+  %1 = "onnx.Cast"(%0) {to = i32} : (tensor<3xf32>) -> tensor<3xi32>
+  "std.return"(%1) : (tensor<3xi32>) -> ()
+
+  // CHECK: {{.*}} = "onnx.Constant"() {value = dense<[-1, 0, 2]> : tensor<3xi32>} : () -> tensor<3xi32>
+  // CHECK-NOT: {{.*}} = "onnx.Cast"{{.*}}
+}
+
+// -----
+
+// CHECK-LABEL: @test_cast_i64_f32() -> tensor<2xf32>
+func @test_cast_i64_f32() -> tensor<2xf32> {
+  %0 = "onnx.Constant"() {value = dense<[3, -4]> : tensor<2xi64>} : () -> tensor<2xi64>
+  %1 = "onnx.Cast"(%0) {to = f32} : (tensor<2xi64>) -> tensor<2xf32>
+  "std.return"(%1) : (tensor<2xf32>) -> ()
+
+  // CHECK: {{.*}} = "onnx.Constant"() {value = dense<[3.000000e+00, -4.000000e+00]> : tensor<2xf32>} : () -> tensor<2xf32>
+  // CHECK-NOT: {{.*}} = "onnx.Cast"{{.*}}
+}
+
+// -----
+
+// A NaN or an out of range value has no defined integer result, so the Cast
+// is not folded.
+// CHECK-LABEL: @test_cast_f32_i32_out_of_range() -> tensor<2xi32>
+func @test_cast_f32_i32_out_of_range() -> tensor<2xi32> {
+  %0 = "onnx.Constant"() {value = dense<[0x7FC00000, 3.0e+10]> : tensor<2xf32>} : () -> tensor<2xf32>
+  %1 = "onnx.Cast"(%0) {to = i32} : (tensor<2xf32>) -> tensor<2xi32>
+  "std.return"(%1) : (tensor<2xi32>) -> ()
+
+  // CHECK: [[CST:%.+]] = "onnx.Constant"() {value = dense<[0x7FC00000, 3.000000e+10]> : tensor<2xf32>} : () -> tensor<2xf32>
+  // CHECK: {{.*}} = "onnx.Cast"([[CST]]) {to = i32} : (tensor<2xf32>) -> tensor<2xi32>
+}
+
+//===----------------------------------------------------------------------===//
+/// MatMul and Gemm tests
+
+// -----
+
+// CHECK-LABEL: @test_matmul_2d() -> tensor<2x2xf32>
+func @test_matmul_2d() -> tensor<2x2xf32> {
+  %0 = "onnx.Constant"() {value = dense<[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]]> : tensor<2x3xf32>} : () -> tensor<2x3xf32>
+  %1 = "onnx.Constant"() {value = dense<[[1.0, 0.0], [0.0, 1.0], [1.0, 1.0]]> : tensor<3x2xf32>} : () -> tensor<3x2xf32>
+  %2 = "onnx.MatMul"(%0, %1) : (tensor<2x3xf32>, tensor<3x2xf32>) -> tensor<2x2xf32>
+  "std.return"(%2) : (tensor<2x2xf32>) -> ()
+
+  // CHECK: {{.*}} = "onnx.Constant"() {value = dense<{{\[}}[4.000000e+00, 5.000000e+00], [1.000000e+01, 1.100000e+01]]> : tensor<2x2xf32>} : () -> tensor<2x2xf32>
+  // CHECK-NOT: {{.*}} = "onnx.MatMul"{{.*}}
+}
+
+// -----
+
+// CHECK-LABEL: @test_gemm_transB_bias() -> tensor<2x2xf32>
+func @test_gemm_transB_bias() -> tensor<2x2xf32> {
+  %0 = "onnx.Constant"() {value = dense<[[1.0, 2.0], [3.0, 4.0]]> : tensor<2x2xf32>} : () -> tensor<2x2xf32>
+  %1 = "onnx.Constant"() {value = dense<[[1.0, 0.0], [1.0, 1.0]]> : tensor<2x2xf32>} : () -> tensor<2x2xf32>
+  %2 = "onnx.Constant"() {value = dense<[10.0, 20.0]> : tensor<2xf32>} : () -> tensor<2xf32>
+  %3 = "onnx.Gemm"(%0, %1, %2) {alpha = 2.0 : f32, beta = 1.0 : f32, transB = 1 : si64} : (tensor<2x2xf32>, tensor<2x2xf32>, tensor<2xf32>) -> tensor<2x2xf32>
+  "std.return"(%3) : (tensor<2x2xf32>) -> ()
+
+  // CHECK: {{.*}} = "onnx.Constant"() {value = dense<{{\[}}[1.200000e+01, 2.600000e+01], [1.600000e+01, 3.400000e+01]]> : tensor<2x2xf32>} : () -> tensor<2x2xf32>
+  // CHECK-NOT: {{.*}} = "onnx.Gemm"{{.*}}
+}
+
+//===----------------------------------------------------------------------===//
+/// Gather tests
+
+// -----
+
+// CHECK-LABEL: @test_gather_axis_0() -> tensor<2x2xf32>
+func @test_gather_axis_0() -> tensor<2x2xf32> {
+  %0 = "onnx.Constant"() {value = dense<[[1.0, 1.2], [2.3, 3.4], [4.5, 5.7]]> : tensor<3x2xf32>} : () -> tensor<3x2xf32>
+  %1 = "onnx.Constant"() {value = dense<[2, -3]> : tensor<2xi64>} : () -> tensor<2xi64>
+  %2 = "onnx.Gather"(%0, %1) {axis = 0 : si64} : (tensor<3x2xf32>, tensor<2xi64>) -> tensor<2x2xf32>
+  "std.return"(%2) : (tensor<2x2xf32>) -> ()
+
+  // CHECK: {{.*}} = "onnx.Constant"() {value = dense<{{\[}}[4.500000e+00, 5.700000e+00], [1.000000e+00, 1.200000e+00]]> : tensor<2x2xf32>} : () -> tensor<2x2xf32>
+  // CHECK-NOT: {{.*}} = "onnx.Gather"{{.*}}
+}
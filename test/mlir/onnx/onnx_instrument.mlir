@@ -0,0 +1,27 @@
+// RUN: onnx-mlir-opt --instrument-onnx-ops="ALL" --InstrumentBeforeOp --InstrumentAfterOp --InstrumentReportTime --instrument-onnx %s -split-input-file | FileCheck %s
+// RUN: onnx-mlir-opt --instrument-onnx-ops="Add" --InstrumentAfterOp --InstrumentReportPerf --instrument-onnx %s -split-input-file | FileCheck %s --check-prefix=PERF
+
+// Check that each instrumentation point carries a stable node name: the ONNX
+// node name, else the location name, else the op name and its rank.
+func @test_instrument_node_names(%arg0 : tensor<10x10xf32>) -> tensor<10x10xf32> {
+  %0 = "onnx.Add"(%arg0, %arg0) {onnx_node_name = "add_0"} : (tensor<10x10xf32>, tensor<10x10xf32>) -> tensor<10x10xf32>
+  %1 = "onnx.Relu"(%0) : (tensor<10x10xf32>) -> tensor<10x10xf32> loc("relu_1")
+  %2 = "onnx.Relu"(%1) : (tensor<10x10xf32>) -> tensor<10x10xf32>
+  return %2 : tensor<10x10xf32>
+
+// CHECK-LABEL: test_instrument_node_names
+// CHECK:       "krnl.runtime_instrument"() {nodeName = "add_0", opID = {{.*}} : i64, opName = "Add", tag = 5 : i64} : () -> ()
+// CHECK:       "onnx.Add"
+// CHECK:       "krnl.runtime_instrument"() {nodeName = "add_0", opID = {{.*}} : i64, opName = "Add", tag = 6 : i64} : () -> ()
+// CHECK:       "krnl.runtime_instrument"() {nodeName = "relu_1", opID = {{.*}} : i64, opName = "Relu", tag = 5 : i64} : () -> ()
+// CHECK:       "onnx.Relu"
+// CHECK:       "krnl.runtime_instrument"() {nodeName = "relu_1", opID = {{.*}} : i64, opName = "Relu", tag = 6 : i64} : () -> ()
+// CHECK:       "krnl.runtime_instrument"() {nodeName = "Relu_2", opID = {{.*}} : i64, opName = "Relu", tag = 5 : i64} : () -> ()
+// CHECK:       "onnx.Relu"
+// CHECK:       "krnl.runtime_instrument"() {nodeName = "Relu_2", opID = {{.*}} : i64, opName = "Relu", tag = 6 : i64} : () -> ()
+
+// PERF-LABEL:  test_instrument_node_names
+// PERF:        "onnx.Add"
+// PERF-NEXT:   "krnl.runtime_instrument"() {nodeName = "add_0", opID = {{.*}} : i64, opName = "Add", tag = 18 : i64} : () -> ()
+// PERF-NOT:    "krnl.runtime_instrument"
+}
@@ -1002,17 +1002,25 @@ func private @test_transpose(%arg0 : tensor<10x20x30x40xf32>) -> tensor<*xf32> {
 
   // CHECK-LABEL: test_transpose
   // CHECK: [[RES1:%.+]] = memref.alloc() {{.*}}: memref<40x30x20x10xf32>
-
   // CHECK: [[DEF_LOOPS:%.+]]:4 = krnl.define_loops 4
-  // CHECK: krnl.iterate([[DEF_LOOPS]]#0, [[DEF_LOOPS]]#1, [[DEF_LOOPS]]#2, [[DEF_LOOPS]]#3) with ([[DEF_LOOPS]]#0 -> %arg1 = 0 to 10, [[DEF_LOOPS]]#1 -> %arg2 = 0 to 20, [[DEF_LOOPS]]#2 -> %arg3 = 0 to 30, [[DEF_LOOPS]]#3 -> %arg4 = 0 to 40) {
-  // CHECK: [[LOAD:%.+]] = krnl.load %arg0[%arg1, %arg2, %arg3, %arg4] : memref<10x20x30x40xf32>
-  // CHECK: krnl.store [[LOAD]], [[RES1]][%arg4, %arg3, %arg2, %arg1] : memref<40x30x20x10xf32>
+  // CHECK: [[Q_CACHE:%.+]], [[Q_CACHE_IN:%.+]] = krnl.block [[DEF_LOOPS]]#0 32 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+  // CHECK: [[Q_REG:%.+]], [[Q_ELEM:%.+]] = krnl.block [[Q_CACHE_IN]] 4 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+  // CHECK: [[A_CACHE:%.+]], [[A_CACHE_IN:%.+]] = krnl.block [[DEF_LOOPS]]#3 32 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+  // CHECK: [[A_REG:%.+]], [[A_ELEM:%.+]] = krnl.block [[A_CACHE_IN]] 4 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+  // CHECK: krnl.permute([[DEF_LOOPS]]#1, [[DEF_LOOPS]]#2, [[Q_CACHE]], [[A_CACHE]], [[Q_REG]], [[A_REG]], [[Q_ELEM]], [[A_ELEM]]) [0, 1, 2, 3, 4, 5, 6, 7]
+  // CHECK: krnl.iterate([[DEF_LOOPS]]#1, [[DEF_LOOPS]]#2, [[Q_CACHE]], [[A_CACHE]], [[Q_REG]], [[A_REG]], [[Q_ELEM]], [[A_ELEM]]) with ([[DEF_LOOPS]]#0 -> [[I0:%.+]] = 0 to 40, [[DEF_LOOPS]]#1 -> [[I1:%.+]] = 0 to 30, [[DEF_LOOPS]]#2 -> [[I2:%.+]] = 0 to 20, [[DEF_LOOPS]]#3 -> [[I3:%.+]] = 0 to 10) {
+  // CHECK: [[IV:%.+]]:8 = krnl.get_induction_var_value
+  // CHECK: [[LOAD:%.+]] = krnl.load %arg0{{.}}[[IV]]#7, [[IV]]#1, [[IV]]#0, [[IV]]#6{{.}} : memref<10x20x30x40xf32>
+  // CHECK: krnl.store [[LOAD]], [[RES1]]{{.}}[[IV]]#6, [[IV]]#0, [[IV]]#1, [[IV]]#7{{.}} : memref<40x30x20x10xf32>
 
   // CHECK: [[RES0:%.+]] = memref.alloc() {{.*}}: memref<40x10x30x20xf32>
   // CHECK: [[DEF_LOOPS:%.+]]:4 = krnl.define_loops 4
-  // CHECK: krnl.iterate([[DEF_LOOPS]]#0, [[DEF_LOOPS]]#1, [[DEF_LOOPS]]#2, [[DEF_LOOPS]]#3) with ([[DEF_LOOPS]]#0 -> %arg1 = 0 to 40, [[DEF_LOOPS]]#1 -> %arg2 = 0 to 30, [[DEF_LOOPS]]#2 -> %arg3 = 0 to 20, [[DEF_LOOPS]]#3 -> %arg4 = 0 to 10) {
-  // CHECK: [[LOAD:%.+]] = krnl.load [[RES1]][%arg1, %arg2, %arg3, %arg4] : memref<40x30x20x10xf32>
-  // CHECK: krnl.store [[LOAD]], [[RES0]][%arg1, %arg4, %arg2, %arg3] : memref<40x10x30x20xf32>
+  // CHECK: krnl.block [[DEF_LOOPS]]#2 32
+  // CHECK: krnl.block [[DEF_LOOPS]]#3 32
+  // CHECK: krnl.iterate
+  // CHECK: [[IV:%.+]]:8 = krnl.get_induction_var_value
+  // CHECK: [[LOAD:%.+]] = krnl.load [[RES1]]{{.}}[[IV]]#0, [[IV]]#6, [[IV]]#7, [[IV]]#1{{.}} : memref<40x30x20x10xf32>
+  // CHECK: krnl.store [[LOAD]], [[RES0]]{{.}}[[IV]]#0, [[IV]]#1, [[IV]]#6, [[IV]]#7{{.}} : memref<40x10x30x20xf32>
 
   // CHECK: return [[RES0]] : memref<40x10x30x20xf32>
 }
@@ -1025,18 +1033,29 @@ func private @test_transpose_dynamic_dims(%arg0 : tensor<10x?x30x40xf32>) -> ten
   "std.return"(%0) : (tensor<*xf32>) -> ()
   // CHECK-LABEL:  func private @test_transpose_dynamic_dims
   // CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<10x?x30x40xf32>) -> memref<10x40x?x30xf32> {
-  // CHECK:           [[CST_1_:%.+]] = arith.constant 1 : index
-  // CHECK:           [[DIM_0_:%.+]] = memref.dim [[PARAM_0_]], [[CST_1_]] : memref<10x?x30x40xf32>
-  // CHECK-DAG:       [[RES_:%.+]] = memref.alloc([[DIM_0_]]) {{.*}}: memref<10x40x?x30xf32>
-  // CHECK-DAG:       [[LOOP_0_:%.+]]:4 = krnl.define_loops 4
-  // CHECK-DAG:       [[CST_1_1_:%.+]] = arith.constant 1 : index
-  // CHECK:           [[DIM_1_:%.+]] = memref.dim [[PARAM_0_]], [[CST_1_1_]] : memref<10x?x30x40xf32>
-  // CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1, [[LOOP_0_]]#2, [[LOOP_0_]]#3) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to 10, [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to [[DIM_1_]], [[LOOP_0_]]#2 -> [[I_2_:%.+]] = 0 to 30, [[LOOP_0_]]#3 -> [[I_3_:%.+]] = 0 to 40) {
-  // CHECK:             [[LOAD_PARAM_0_MEM_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]], [[I_3_]]{{.}} : memref<10x?x30x40xf32>
-  // CHECK:             krnl.store [[LOAD_PARAM_0_MEM_]], [[RES_]]{{.}}[[I_0_]], [[I_3_]], [[I_1_]], [[I_2_]]{{.}} : memref<10x40x?x30xf32>
-  // CHECK:           }
+  // CHECK:           [[RES_:%.+]] = memref.alloc({{.*}}) {{.*}}: memref<10x40x?x30xf32>
+  // CHECK:           [[LOOP_0_:%.+]]:4 = krnl.define_loops 4
+  // CHECK:           krnl.block [[LOOP_0_]]#1 32
+  // CHECK:           krnl.block [[LOOP_0_]]#3 32
+  // CHECK:           krnl.iterate
+  // CHECK:             [[IV:%.+]]:8 = krnl.get_induction_var_value
+  // CHECK:             [[LOAD_PARAM_0_MEM_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[IV]]#0, [[IV]]#1, [[IV]]#7, [[IV]]#6{{.}} : memref<10x?x30x40xf32>
+  // CHECK:             krnl.store [[LOAD_PARAM_0_MEM_]], [[RES_]]{{.}}[[IV]]#0, [[IV]]#6, [[IV]]#1, [[IV]]#7{{.}} : memref<10x40x?x30xf32>
   // CHECK:           return [[RES_]] : memref<10x40x?x30xf32>
-  // CHECK:         }
+}
+
+// -----
+
+// COM: The innermost dimension is left in place: each row is copied with a memcpy.
+func private @test_transpose_contiguous_rows(%arg0 : tensor<2x8x4x64xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Transpose"(%arg0) {perm = [0, 2, 1, 3]} : (tensor<2x8x4x64xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+  // CHECK-LABEL:  func private @test_transpose_contiguous_rows
+  // CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<2x4x8x64xf32>
+  // CHECK:           [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
+  // CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1, [[LOOP_0_]]#2) with ({{.*}} = 0 to 2, {{.*}} = 0 to 4, {{.*}} = 0 to 8) {
+  // CHECK:             "krnl.memcpy"([[RES_]], %arg0, {{.*}}, {{.*}}, {{.*}}) : (memref<2x4x8x64xf32>, memref<2x8x4x64xf32>, i64, index, index) -> ()
+  // CHECK:           return [[RES_]] : memref<2x4x8x64xf32>
 }
 
 // -----
@@ -1467,22 +1486,15 @@ func private @test_split_equal(%arg0 : tensor<16x32x64xf32>) -> (tensor<*xf32>,
   %0, %1 = "onnx.Split"(%arg0, %cst) { axis = 0 : si64} : (tensor<16x32x64xf32>, none) -> (tensor<*xf32>, tensor<*xf32>)
   "std.return"(%0, %1) : (tensor<*xf32>, tensor<*xf32>) -> ()
 
-  // CHECK: [[INDEX_MAP:#.+]] = affine_map<(d0) -> (d0 + 8)>
   // CHECK-LABEL: @test_split_equal
 
   // CHECK: [[RES_0:%.+]] = memref.alloc() {{.*}}: memref<8x32x64xf32>
   // CHECK: [[RES_1:%.+]] = memref.alloc() {{.*}}: memref<8x32x64xf32>
-  // CHECK: [[DEF_LOOP_0:%.+]]:3 = krnl.define_loops 3
-  // CHECK: krnl.iterate([[DEF_LOOP_0]]#0, [[DEF_LOOP_0]]#1, [[DEF_LOOP_0]]#2) with ([[DEF_LOOP_0]]#0 -> %arg1 = 0 to 8, [[DEF_LOOP_0]]#1 -> %arg2 = 0 to 32, [[DEF_LOOP_0]]#2 -> %arg3 = 0 to 64) {
-  // CHECK:   [[LOAD_0:%.+]] = krnl.load %arg0[%arg1, %arg2, %arg3] : memref<16x32x64xf32>
-  // CHECK:   krnl.store [[LOAD_0]], [[RES_0]][%arg1, %arg2, %arg3] : memref<8x32x64xf32>
-  // CHECK: }
-  // CHECK: [[DEF_LOOP_1:%.+]]:3 = krnl.define_loops 3
-  // CHECK: krnl.iterate([[DEF_LOOP_1]]#0, [[DEF_LOOP_1]]#1, [[DEF_LOOP_1]]#2) with ([[DEF_LOOP_1]]#0 -> %arg1 = 0 to 8, [[DEF_LOOP_1]]#1 -> %arg2 = 0 to 32, [[DEF_LOOP_1]]#2 -> %arg3 = 0 to 64) {
-  // CHECK:   %[[INDEX:.+]] = affine.apply [[INDEX_MAP]](%arg1)
-  // CHECK:   [[LOAD_1:%.+]] = krnl.load %arg0[%[[INDEX]], %arg2, %arg3] : memref<16x32x64xf32>
-  // CHECK:   krnl.store [[LOAD_1]], [[RES_1]][%arg1, %arg2, %arg3] : memref<8x32x64xf32>
-  // CHECK: }
+  // CHECK-NOT: krnl.iterate
+  // CHECK: [[SIZE_0:%.+]] = arith.index_cast {{.*}} : index to i64
+  // CHECK: "krnl.memcpy"([[RES_0]], %arg0, [[SIZE_0]], {{.*}}, {{.*}}) : (memref<8x32x64xf32>, memref<16x32x64xf32>, i64, index, index) -> ()
+  // CHECK: [[SRC_OFFSET:%.+]] = arith.constant 16384 : index
+  // CHECK: "krnl.memcpy"([[RES_1]], %arg0, {{.*}}, {{.*}}, [[SRC_OFFSET]]) : (memref<8x32x64xf32>, memref<16x32x64xf32>, i64, index, index) -> ()
   // CHECK: return [[RES_0]], [[RES_1]] : memref<8x32x64xf32>, memref<8x32x64xf32>
 }
 
@@ -1493,21 +1505,25 @@ func private @test_split_variable(%arg0 : tensor<16x32x64xf32>) -> (tensor<*xf32
   %0, %1 = "onnx.Split"(%arg0, %split) { axis = 1 : si64} : (tensor<16x32x64xf32>, tensor<2xi64>) -> (tensor<*xf32>, tensor<*xf32>)
   "std.return"(%0, %1) : (tensor<*xf32>, tensor<*xf32>) -> ()
 
-  // CHECK: [[INDEX_MAP:#.+]] = affine_map<(d0) -> (d0 + 2)>
+  // CHECK-DAG: [[DEST_MAP_0:#.+]] = affine_map<(d0) -> (d0 * 128)>
+  // CHECK-DAG: [[SRC_MAP_0:#.+]] = affine_map<(d0) -> (d0 * 2048)>
+  // CHECK-DAG: [[DEST_MAP_1:#.+]] = affine_map<(d0) -> (d0 * 1920)>
+  // CHECK-DAG: [[SRC_MAP_1:#.+]] = affine_map<(d0) -> (d0 * 2048 + 128)>
   // CHECK-LABEL: @test_split_variable
 
   // CHECK: [[RES_0:%.+]] = memref.alloc() {{.*}}: memref<16x2x64xf32>
   // CHECK: [[RES_1:%.+]] = memref.alloc() {{.*}}: memref<16x30x64xf32>
-  // CHECK: [[DEF_LOOP_0:%.+]]:3 = krnl.define_loops 3
-  // CHECK: krnl.iterate([[DEF_LOOP_0]]#0, [[DEF_LOOP_0]]#1, [[DEF_LOOP_0]]#2) with ([[DEF_LOOP_0]]#0 -> %arg1 = 0 to 16, [[DEF_LOOP_0]]#1 -> %arg2 = 0 to 2, [[DEF_LOOP_0]]#2 -> %arg3 = 0 to 64) {
-  // CHECK:   [[LOAD_0:%.+]] = krnl.load %arg0[%arg1, %arg2, %arg3] : memref<16x32x64xf32>
-  // CHECK:   krnl.store [[LOAD_0]], [[RES_0]][%arg1, %arg2, %arg3] : memref<16x2x64xf32>
+  // CHECK: [[DEF_LOOP_0:%.+]] = krnl.define_loops 1
+  // CHECK: krnl.iterate([[DEF_LOOP_0]]) with ([[DEF_LOOP_0]] -> %arg1 = 0 to 16) {
+  // CHECK:   [[DEST_0:%.+]] = affine.apply [[DEST_MAP_0]](%arg1)
+  // CHECK:   [[SRC_0:%.+]] = affine.apply [[SRC_MAP_0]](%arg1)
+  // CHECK:   "krnl.memcpy"([[RES_0]], %arg0, {{.*}}, [[DEST_0]], [[SRC_0]]) : (memref<16x2x64xf32>, memref<16x32x64xf32>, i64, index, index) -> ()
   // CHECK: }
-  // CHECK: [[DEF_LOOP_1:%.+]]:3 = krnl.define_loops 3
-  // CHECK: krnl.iterate([[DEF_LOOP_1]]#0, [[DEF_LOOP_1]]#1, [[DEF_LOOP_1]]#2) with ([[DEF_LOOP_1]]#0 -> %arg1 = 0 to 16, [[DEF_LOOP_1]]#1 -> %arg2 = 0 to 30, [[DEF_LOOP_1]]#2 -> %arg3 = 0 to 64) {
-  // CHECK:   %[[INDEX:.+]] = affine.apply [[INDEX_MAP]](%arg2)
-  // CHECK:   [[LOAD_1:%.+]] = krnl.load %arg0[%arg1, %[[INDEX]], %arg3] : memref<16x32x64xf32>
-  // CHECK:   krnl.store [[LOAD_1]], [[RES_1]][%arg1, %arg2, %arg3] : memref<16x30x64xf32>
+  // CHECK: [[DEF_LOOP_1:%.+]] = krnl.define_loops 1
+  // CHECK: krnl.iterate([[DEF_LOOP_1]]) with ([[DEF_LOOP_1]] -> %arg1 = 0 to 16) {
+  // CHECK:   [[DEST_1:%.+]] = affine.apply [[DEST_MAP_1]](%arg1)
+  // CHECK:   [[SRC_1:%.+]] = affine.apply [[SRC_MAP_1]](%arg1)
+  // CHECK:   "krnl.memcpy"([[RES_1]], %arg0, {{.*}}, [[DEST_1]], [[SRC_1]]) : (memref<16x30x64xf32>, memref<16x32x64xf32>, i64, index, index) -> ()
   // CHECK: }
   // CHECK: return [[RES_0]], [[RES_1]] : memref<16x2x64xf32>, memref<16x30x64xf32>
 }
@@ -1518,22 +1534,15 @@ func private @test_splitv11_equal(%arg0 : tensor<16x32x64xf32>) -> (tensor<*xf32
   %0, %1 = "onnx.SplitV11"(%arg0) { axis = 0 : si64} : (tensor<16x32x64xf32>) -> (tensor<*xf32>, tensor<*xf32>)
   "std.return"(%0, %1) : (tensor<*xf32>, tensor<*xf32>) -> ()
 
-  // CHECK: [[INDEX_MAP:#.+]] = affine_map<(d0) -> (d0 + 8)>
   // CHECK-LABEL: @test_splitv11_equal
 
   // CHECK: [[RES_0:%.+]] = memref.alloc() {{.*}}: memref<8x32x64xf32>
   // CHECK: [[RES_1:%.+]] = memref.alloc() {{.*}}: memref<8x32x64xf32>
-  // CHECK: [[DEF_LOOP_0:%.+]]:3 = krnl.define_loops 3
-  // CHECK: krnl.iterate([[DEF_LOOP_0]]#0, [[DEF_LOOP_0]]#1, [[DEF_LOOP_0]]#2) with ([[DEF_LOOP_0]]#0 -> %arg1 = 0 to 8, [[DEF_LOOP_0]]#1 -> %arg2 = 0 to 32, [[DEF_LOOP_0]]#2 -> %arg3 = 0 to 64) {
-  // CHECK:   [[LOAD_0:%.+]] = krnl.load %arg0[%arg1, %arg2, %arg3] : memref<16x32x64xf32>
-  // CHECK:   krnl.store [[LOAD_0]], [[RES_0]][%arg1, %arg2, %arg3] : memref<8x32x64xf32>
-  // CHECK: }
-  // CHECK: [[DEF_LOOP_1:%.+]]:3 = krnl.define_loops 3
-  // CHECK: krnl.iterate([[DEF_LOOP_1]]#0, [[DEF_LOOP_1]]#1, [[DEF_LOOP_1]]#2) with ([[DEF_LOOP_1]]#0 -> %arg1 = 0 to 8, [[DEF_LOOP_1]]#1 -> %arg2 = 0 to 32, [[DEF_LOOP_1]]#2 -> %arg3 = 0 to 64) {
-  // CHECK:   %[[INDEX:.+]] = affine.apply [[INDEX_MAP]](%arg1)
-  // CHECK:   [[LOAD_1:%.+]] = krnl.load %arg0[%[[INDEX]], %arg2, %arg3] : memref<16x32x64xf32>
-  // CHECK:   krnl.store [[LOAD_1]], [[RES_1]][%arg1, %arg2, %arg3] : memref<8x32x64xf32>
-  // CHECK: }
+  // CHECK-NOT: krnl.iterate
+  // CHECK: [[SIZE_0:%.+]] = arith.index_cast {{.*}} : index to i64
+  // CHECK: "krnl.memcpy"([[RES_0]], %arg0, [[SIZE_0]], {{.*}}, {{.*}}) : (memref<8x32x64xf32>, memref<16x32x64xf32>, i64, index, index) -> ()
+  // CHECK: [[SRC_OFFSET:%.+]] = arith.constant 16384 : index
+  // CHECK: "krnl.memcpy"([[RES_1]], %arg0, {{.*}}, {{.*}}, [[SRC_OFFSET]]) : (memref<8x32x64xf32>, memref<16x32x64xf32>, i64, index, index) -> ()
   // CHECK: return [[RES_0]], [[RES_1]] : memref<8x32x64xf32>, memref<8x32x64xf32>
 }
 
@@ -1543,21 +1552,25 @@ func private @test_splitv11_variable(%arg0 : tensor<16x32x64xf32>) -> (tensor<*x
   %0, %1 = "onnx.SplitV11"(%arg0) { axis = 1 : si64, split = [2, 30]} : (tensor<16x32x64xf32>) -> (tensor<*xf32>, tensor<*xf32>)
   "std.return"(%0, %1) : (tensor<*xf32>, tensor<*xf32>) -> ()
 
-  // CHECK: [[INDEX_MAP:#.+]] = affine_map<(d0) -> (d0 + 2)>
+  // CHECK-DAG: [[DEST_MAP_0:#.+]] = affine_map<(d0) -> (d0 * 128)>
+  // CHECK-DAG: [[SRC_MAP_0:#.+]] = affine_map<(d0) -> (d0 * 2048)>
+  // CHECK-DAG: [[DEST_MAP_1:#.+]] = affine_map<(d0) -> (d0 * 1920)>
+  // CHECK-DAG: [[SRC_MAP_1:#.+]] = affine_map<(d0) -> (d0 * 2048 + 128)>
   // CHECK-LABEL: @test_splitv11_variable
 
   // CHECK: [[RES_0:%.+]] = memref.alloc() {{.*}}: memref<16x2x64xf32>
   // CHECK: [[RES_1:%.+]] = memref.alloc() {{.*}}: memref<16x30x64xf32>
-  // CHECK: [[DEF_LOOP_0:%.+]]:3 = krnl.define_loops 3
-  // CHECK: krnl.iterate([[DEF_LOOP_0]]#0, [[DEF_LOOP_0]]#1, [[DEF_LOOP_0]]#2) with ([[DEF_LOOP_0]]#0 -> %arg1 = 0 to 16, [[DEF_LOOP_0]]#1 -> %arg2 = 0 to 2, [[DEF_LOOP_0]]#2 -> %arg3 = 0 to 64) {
-  // CHECK:   [[LOAD_0:%.+]] = krnl.load %arg0[%arg1, %arg2, %arg3] : memref<16x32x64xf32>
-  // CHECK:   krnl.store [[LOAD_0]], [[RES_0]][%arg1, %arg2, %arg3] : memref<16x2x64xf32>
+  // CHECK: [[DEF_LOOP_0:%.+]] = krnl.define_loops 1
+  // CHECK: krnl.iterate([[DEF_LOOP_0]]) with ([[DEF_LOOP_0]] -> %arg1 = 0 to 16) {
+  // CHECK:   [[DEST_0:%.+]] = affine.apply [[DEST_MAP_0]](%arg1)
+  // CHECK:   [[SRC_0:%.+]] = affine.apply [[SRC_MAP_0]](%arg1)
+  // CHECK:   "krnl.memcpy"([[RES_0]], %arg0, {{.*}}, [[DEST_0]], [[SRC_0]]) : (memref<16x2x64xf32>, memref<16x32x64xf32>, i64, index, index) -> ()
   // CHECK: }
-  // CHECK: [[DEF_LOOP_1:%.+]]:3 = krnl.define_loops 3
-  // CHECK: krnl.iterate([[DEF_LOOP_1]]#0, [[DEF_LOOP_1]]#1, [[DEF_LOOP_1]]#2) with ([[DEF_LOOP_1]]#0 -> %arg1 = 0 to 16, [[DEF_LOOP_1]]#1 -> %arg2 = 0 to 30, [[DEF_LOOP_1]]#2 -> %arg3 = 0 to 64) {
-  // CHECK:   %[[INDEX:.+]] = affine.apply [[INDEX_MAP]](%arg2)
-  // CHECK:   [[LOAD_1:%.+]] = krnl.load %arg0[%arg1, %[[INDEX]], %arg3] : memref<16x32x64xf32>
-  // CHECK:   krnl.store [[LOAD_1]], [[RES_1]][%arg1, %arg2, %arg3] : memref<16x30x64xf32>
+  // CHECK: [[DEF_LOOP_1:%.+]] = krnl.define_loops 1
+  // CHECK: krnl.iterate([[DEF_LOOP_1]]) with ([[DEF_LOOP_1]] -> %arg1 = 0 to 16) {
+  // CHECK:   [[DEST_1:%.+]] = affine.apply [[DEST_MAP_1]](%arg1)
+  // CHECK:   [[SRC_1:%.+]] = affine.apply [[SRC_MAP_1]](%arg1)
+  // CHECK:   "krnl.memcpy"([[RES_1]], %arg0, {{.*}}, [[DEST_1]], [[SRC_1]]) : (memref<16x30x64xf32>, memref<16x32x64xf32>, i64, index, index) -> ()
   // CHECK: }
   // CHECK: return [[RES_0]], [[RES_1]] : memref<16x2x64xf32>, memref<16x30x64xf32>
 }
@@ -1863,22 +1876,12 @@ func private @test_constant_of_shape_static_dims() -> tensor<*xf32> {
 func private @test_flatten0(%arg0 : tensor<2x3x4xf32>) -> tensor<*xf32> {
   %1 = "onnx.Flatten"(%arg0) {axis = 0 : si64} : (tensor<2x3x4xf32>) -> tensor<*xf32>
   "std.return"(%1) : (tensor<*xf32>) -> ()
-  // CHECK: [[MAP_FIRST:#.+]] = affine_map<() -> (0)>
-  // CHECK: [[MAP_SECOND:#.+]] = affine_map<(d0, d1, d2)[s0, s1, s2] -> (d2 + d1 * s2 + d0 * (s1 * s2))>
-  // CHECK-LABEL test_flatten0
-  // CHECK:  [[ALLOC:%.+]] = memref.alloc() {{.*}}: memref<1x24xf32>
-  // CHECK:  [[LOOP:%.+]]:3 = krnl.define_loops 3
-  // CHECK:  krnl.iterate([[LOOP]]#0, [[LOOP]]#1, [[LOOP]]#2) with ([[LOOP]]#0 -> [[LOOPARG1:%.+]] = 0 to 2, [[LOOP]]#1 -> [[LOOPARG2:%.+]] = 0 to 3, [[LOOP]]#2 -> [[LOOPARG3:%.+]] = 0 to 4) {
-  // CHECK:    [[LOAD:%.+]] = krnl.load %arg0{{\[}}[[LOOPARG1]], [[LOOPARG2]], [[LOOPARG3]]{{\]}} : memref<2x3x4xf32>
-  // CHECK:    [[FIRSTDIM:%.+]] = affine.apply [[MAP_FIRST]]()
-  // CHECK:    [[C0:%.+]] = arith.constant 0 : index
-  // CHECK:    [[R4:%.+]] = arith.constant 2 : index
-  // CHECK:    [[C1:%.+]] = arith.constant 1 : index
-  // CHECK:    [[R5:%.+]] = arith.constant 3 : index
-  // CHECK:    [[C2:%.+]] = arith.constant 2 : index
-  // CHECK:    [[R6:%.+]] = arith.constant 4 : index
-  // CHECK:    [[SECONDDIM:%.+]] = affine.apply [[MAP_SECOND]]([[LOOPARG1]], [[LOOPARG2]], [[LOOPARG3]]){{\[}}[[R4]], [[R5]], [[R6]]{{\]}}
-  // CHECK:    krnl.store [[LOAD]], [[ALLOC]]{{\[}}[[FIRSTDIM]], [[SECONDDIM]]{{\]}} : memref<1x24xf32>
+  // The buffer of %arg0 belongs to the caller: the view is taken on a copy.
+  // CHECK-LABEL: test_flatten0
+  // CHECK: [[COPY:%.+]] = memref.alloc() {{.*}}: memref<2x3x4xf32>
+  // CHECK: "krnl.memcpy"([[COPY]], %arg0, {{.*}}, {{.*}}, {{.*}}) : (memref<2x3x4xf32>, memref<2x3x4xf32>, i64, index, index) -> ()
+  // CHECK: [[RES:%.+]] = memref.reinterpret_cast [[COPY]] to offset: [0], sizes: [1, 24], strides: [24, 1] : memref<2x3x4xf32> to memref<1x24xf32>
+  // CHECK: return [[RES]] : memref<1x24xf32>
 }
 
 // -----
@@ -1890,36 +1893,32 @@ func private @test_flatten1(%arg0 : tensor<2x?x4xf32>) -> tensor<*xf32> {
 
 // CHECK-LABEL:  func private @test_flatten1
 // CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<2x?x4xf32>) -> memref<?x4xf32> {
-// CHECK-DAG:       [[CST_1_:%.+]] = arith.constant 1 : index
-// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0 : index
-// CHECK-DAG:       [[CST_2_:%.+]] = arith.constant 2 : index
-// CHECK-NOT: separator of consecutive DAGs
-// CHECK-DAG:       [[VAR_0_:%.+]] = arith.muli [[CST_1_]], [[CST_2_]] : index
-// CHECK-DAG:       [[CST_1_1_:%.+]] = arith.constant 1 : index
-// CHECK:           [[VAR_1_:%.+]] = memref.dim [[PARAM_0_]], [[CST_1_1_]] : memref<2x?x4xf32>
-// CHECK:           [[VAR_2_:%.+]] = arith.muli [[VAR_0_]], [[VAR_1_]] : index
-// CHECK-DAG:       [[RES_:%.+]] = memref.alloc([[VAR_2_]]) {{.*}}: memref<?x4xf32>
-// CHECK-DAG:       [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
-// CHECK-DAG:       [[CST_1_2_:%.+]] = arith.constant 1 : index
-// CHECK:           [[VAR_5_:%.+]] = memref.dim [[PARAM_0_]], [[CST_1_2_]] : memref<2x?x4xf32>
-// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1, [[LOOP_0_]]#2) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to 2, [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to [[VAR_5_]], [[LOOP_0_]]#2 -> [[I_2_:%.+]] = 0 to 4) {
-// CHECK-DAG:         [[LOAD_PARAM_0_MEM_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<2x?x4xf32>
-// CHECK-DAG:         [[CST_0_1_:%.+]] = arith.constant 0 : index
-// CHECK-DAG:         [[CST_2_1_:%.+]] = arith.constant 2 : index
-// CHECK-DAG:         [[CST_1_3_:%.+]] = arith.constant 1 : index
-// CHECK:             [[VAR_7_:%.+]] = memref.dim [[PARAM_0_]], [[CST_1_3_]] : memref<2x?x4xf32>
-// CHECK-DAG:         [[VAR_8_:%.+]] = affine.apply #map0([[I_0_]], [[I_1_]]){{.}}[[CST_2_1_]], [[VAR_7_]]{{.}}
-// CHECK-DAG:         [[CST_2_2_:%.+]] = arith.constant 2 : index
-// CHECK-DAG:         [[CST_4_:%.+]] = arith.constant 4 : index
-// CHECK:             [[VAR_9_:%.+]] = affine.apply #map1([[I_2_]]){{.}}[[CST_4_]]{{.}}
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_]], [[RES_]]{{.}}[[VAR_8_]], [[VAR_9_]]{{.}} : memref<?x4xf32>
-// CHECK:           }
+// CHECK:           [[COPY_:%.+]] = memref.alloc({{.*}}) {{.*}}: memref<2x?x4xf32>
+// CHECK:           "krnl.memcpy"([[COPY_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<2x?x4xf32>, memref<2x?x4xf32>, i64, index, index) -> ()
+// CHECK:           [[RES_:%.+]] = memref.reinterpret_cast [[COPY_]] to offset: [0], sizes: [{{.*}}, 4], strides: [4, 1] : memref<2x?x4xf32> to memref<?x4xf32>
 // CHECK:           return [[RES_]] : memref<?x4xf32>
 // CHECK:         }
 }
 
 // -----
 
+// `Flatten` and `Identity` ops share the buffer of their input, also when chained.
+// So, input memref should not be deallocated if a view of it is returned.
+func private @test_flatten_identity_dealloc(%arg0 : tensor<4x2x8xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Transpose"(%arg0) {perm = [1, 0, 2]} : (tensor<4x2x8xf32>) -> tensor<*xf32>
+  %1 = "onnx.Flatten"(%0) {axis = 1 : si64} : (tensor<*xf32>) -> tensor<*xf32>
+  %2 = "onnx.Identity"(%1) : (tensor<*xf32>) -> tensor<*xf32>
+  "std.return"(%2) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: func private @test_flatten_identity_dealloc
+  // CHECK:       [[VAR_0_:%.+]] = memref.alloc() {{.*}}: memref<2x4x8xf32>
+  // CHECK:       [[VAR_1_:%.+]] = memref.reinterpret_cast [[VAR_0_]] to offset: [0], sizes: [2, 32], strides: [32, 1] : memref<2x4x8xf32> to memref<2x32xf32>
+  // CHECK-NOT:   memref.dealloc [[VAR_0_]] : memref<2x4x8xf32>
+  // CHECK:       return [[VAR_1_]] : memref<2x32xf32>
+}
+
+// -----
+
 func private @test_less(%arg0: tensor<3x4x5xf32>, %arg1: tensor<3x4x5xf32>) -> tensor<3x4x5xi1> {
   %0 = "onnx.Less"(%arg0, %arg1) : (tensor<3x4x5xf32>, tensor<3x4x5xf32>) -> tensor<3x4x5xi1>
   return %0 : tensor<3x4x5xi1>
@@ -0,0 +1,58 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+// Blocks of 32 query rows are packed and scaled, then the keys and values are
+// streamed in blocks of 64 rows. The scores of a block are computed by a
+// krnl.matmul into a 32x64 buffer, updated by the online softmax, and
+// multiplied with the values into the 32x8 output block. Rows whose running
+// maximum is -inf get no contribution.
+func private @test_attention(%arg0 : tensor<2x100x8xf32>, %arg1 : tensor<2x130x8xf32>, %arg2 : tensor<2x130x8xf32>, %arg3 : tensor<100x130xf32>) -> tensor<*xf32> {
+  %0 = "onnx.ScaledDotProductAttention"(%arg0, %arg1, %arg2, %arg3) {scale = 0.125 : f32} : (tensor<2x100x8xf32>, tensor<2x130x8xf32>, tensor<2x130x8xf32>, tensor<100x130xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_attention
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<2x100x8xf32>
+  // CHECK-DAG:   [[QP:%.+]] = memref.alloc() {{.*}}: memref<32x8xf32>
+  // CHECK-DAG:   [[KT:%.+]] = memref.alloc() {{.*}}: memref<8x64xf32>
+  // CHECK-DAG:   [[VP:%.+]] = memref.alloc() {{.*}}: memref<64x8xf32>
+  // CHECK-DAG:   [[P:%.+]] = memref.alloc() {{.*}}: memref<32x64xf32>
+  // CHECK-DAG:   [[O:%.+]] = memref.alloc() {{.*}}: memref<32x8xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.store {{.*}}, [[QP]]{{.*}} : memref<32x8xf32>
+  // CHECK:         krnl.memset [[O]]
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.store {{.*}}, [[KT]]{{.*}} : memref<8x64xf32>
+  // CHECK:           krnl.store {{.*}}, [[VP]]{{.*}} : memref<64x8xf32>
+  // CHECK:           krnl.matmul [[QP]]{{.*}}, [[KT]]{{.*}}, [[P]]
+  // CHECK:           krnl.iterate
+  // CHECK:             krnl.load %arg3{{.*}} : memref<100x130xf32>
+  // CHECK:             [[IS_MAX_INF:%.+]] = arith.cmpf oeq
+  // CHECK:             math.exp
+  // CHECK:             select [[IS_MAX_INF]]
+  // CHECK:               math.exp
+  // CHECK:               select [[IS_MAX_INF]]
+  // CHECK:           krnl.matmul [[P]]{{.*}}, [[VP]]{{.*}}, [[O]]
+  // CHECK:         krnl.iterate
+  // CHECK:           [[Y:%.+]] = arith.divf
+  // CHECK:           krnl.store [[Y]], [[RES]]{{.*}} : memref<2x100x8xf32>
+  // CHECK:       return [[RES]] : memref<2x100x8xf32>
+}
+
+// -----
+
+// Dynamic sequence lengths and no mask.
+func private @test_attention_dynamic(%arg0 : tensor<4x?x16xf32>, %arg1 : tensor<4x?x16xf32>, %arg2 : tensor<4x?x8xf32>) -> tensor<*xf32> {
+  %cst = constant unit
+  %0 = "onnx.ScaledDotProductAttention"(%arg0, %arg1, %arg2, %cst) : (tensor<4x?x16xf32>, tensor<4x?x16xf32>, tensor<4x?x8xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_attention_dynamic
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc({{.*}}) {{.*}}: memref<4x?x8xf32>
+  // CHECK-DAG:   [[P:%.+]] = memref.alloc() {{.*}}: memref<32x64xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.matmul {{.*}}, [[P]]
+  // CHECK:           krnl.matmul [[P]]
+  // CHECK:       return [[RES]] : memref<4x?x8xf32>
+}
@@ -0,0 +1,52 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+// 2x2 upsampling: a GEMM into the Col buffer, then a col2im accumulation into
+// the output initialized with the bias.
+func private @test_conv_transpose(%arg0 : tensor<1x4x3x3xf32>, %arg1 : tensor<4x2x2x2xf32>, %arg2 : tensor<2xf32>) -> tensor<*xf32> {
+  %0 = "onnx.ConvTranspose"(%arg0, %arg1, %arg2) {kernel_shape = [2, 2], strides = [2, 2]} : (tensor<1x4x3x3xf32>, tensor<4x2x2x2xf32>, tensor<2xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_conv_transpose
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x2x6x6xf32>
+  // CHECK-DAG:   [[WT:%.+]] = memref.alloc() {{.*}}: memref<1x8x4xf32>
+  // CHECK-DAG:   [[COL:%.+]] = memref.alloc() {{.*}}: memref<8x9xf32>
+  // CHECK-DAG:   [[W:%.+]] = memref.reinterpret_cast %arg1 to offset: [0], sizes: [4, 8], strides: [8, 1] : memref<4x2x2x2xf32> to memref<4x8xf32>
+  // CHECK-DAG:   [[X:%.+]] = memref.reinterpret_cast %arg0 to offset: [0], sizes: [1, 1, 4, 9], strides: [36, 36, 9, 1] : memref<1x4x3x3xf32> to memref<1x1x4x9xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[B:%.+]] = krnl.load %arg2{{.*}} : memref<2xf32>
+  // CHECK:         krnl.store [[B]], [[RES]]{{.*}} : memref<1x2x6x6xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[VAL:%.+]] = krnl.load [[W]]{{.*}} : memref<4x8xf32>
+  // CHECK:         krnl.store [[VAL]], [[WT]]{{.*}} : memref<1x8x4xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.memset [[COL]]
+  // CHECK:         krnl.matmul [[WT]][{{.*}}], [[X]][{{.*}}], [[COL]][{{.*}}]
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.iterate
+  // CHECK:             [[C:%.+]] = krnl.load [[COL]]{{.*}} : memref<8x9xf32>
+  // CHECK:             [[Y:%.+]] = krnl.load [[RES]]{{.*}} : memref<1x2x6x6xf32>
+  // CHECK:             [[SUM:%.+]] = arith.addf [[Y]], [[C]] : f32
+  // CHECK:             krnl.store [[SUM]], [[RES]]{{.*}} : memref<1x2x6x6xf32>
+  // CHECK:       return [[RES]] : memref<1x2x6x6xf32>
+}
+
+// -----
+
+// Dynamic batch size, with groups, dilations, pads and output padding.
+func private @test_conv_transpose_dynamic_batch(%arg0 : tensor<?x4x3x3xf32>, %arg1 : tensor<4x3x3x3xf32>) -> tensor<*xf32> {
+  %cst = constant unit
+  %0 = "onnx.ConvTranspose"(%arg0, %arg1, %cst) {dilations = [2, 2], group = 2 : si64, kernel_shape = [3, 3], output_padding = [1, 1], pads = [1, 1, 1, 1], strides = [2, 2]} : (tensor<?x4x3x3xf32>, tensor<4x3x3x3xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_conv_transpose_dynamic_batch
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc({{.*}}) {{.*}}: memref<?x6x8x8xf32>
+  // CHECK-DAG:   [[WT:%.+]] = memref.alloc() {{.*}}: memref<2x27x2xf32>
+  // CHECK-DAG:   [[COL:%.+]] = memref.alloc() {{.*}}: memref<27x9xf32>
+  // CHECK-DAG:   [[X:%.+]] = memref.reinterpret_cast %arg0 {{.*}} : memref<?x4x3x3xf32> to memref<?x2x2x9xf32>
+  // CHECK:       krnl.memset [[RES]]
+  // CHECK:       krnl.matmul [[WT]][{{.*}}], [[X]][{{.*}}], [[COL]][{{.*}}]
+  // CHECK:       krnl.store {{.*}}, [[RES]]{{.*}} : memref<?x6x8x8xf32>
+  // CHECK:       return [[RES]] : memref<?x6x8x8xf32>
+}
@@ -0,0 +1,64 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+// Pointwise convolution: a tiled matmul per image on views of the data, into
+// an output initialized with the bias.
+func private @test_pointwise_conv(%arg0 : tensor<1x8x4x6xf32>, %arg1 : tensor<16x8x1x1xf32>, %arg2 : tensor<16xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Conv"(%arg0, %arg1, %arg2) {kernel_shape = [1, 1]} : (tensor<1x8x4x6xf32>, tensor<16x8x1x1xf32>, tensor<16xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_pointwise_conv
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x16x4x6xf32>
+  // CHECK-DAG:   [[X:%.+]] = memref.reinterpret_cast %arg0 to offset: [0], sizes: [1, 8, 24], strides: [192, 24, 1] : memref<1x8x4x6xf32> to memref<1x8x24xf32>
+  // CHECK-DAG:   [[W:%.+]] = memref.reinterpret_cast %arg1 to offset: [0], sizes: [16, 8], strides: [8, 1] : memref<16x8x1x1xf32> to memref<16x8xf32>
+  // CHECK-DAG:   [[Y:%.+]] = memref.reinterpret_cast [[RES]] to offset: [0], sizes: [1, 16, 24], strides: [384, 24, 1] : memref<1x16x4x6xf32> to memref<1x16x24xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[B:%.+]] = krnl.load %arg2{{.*}} : memref<16xf32>
+  // CHECK:         krnl.store [[B]], [[Y]]{{.*}} : memref<1x16x24xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.matmul [[W]][{{.*}}], [[X]][{{.*}}], [[Y]][{{.*}}]
+  // CHECK:       return [[RES]] : memref<1x16x4x6xf32>
+}
+
+// -----
+
+// Pointwise convolution with dynamic batch and image sizes.
+func private @test_pointwise_conv_dynamic(%arg0 : tensor<?x8x?x?xf32>, %arg1 : tensor<16x8x1x1xf32>) -> tensor<*xf32> {
+  %cst = constant unit
+  %0 = "onnx.Conv"(%arg0, %arg1, %cst) {kernel_shape = [1, 1]} : (tensor<?x8x?x?xf32>, tensor<16x8x1x1xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_pointwise_conv_dynamic
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc({{.*}}) {{.*}}: memref<?x16x?x?xf32>
+  // CHECK-DAG:   [[X:%.+]] = memref.reinterpret_cast %arg0 {{.*}} : memref<?x8x?x?xf32> to memref<?x8x?xf32>
+  // CHECK-DAG:   [[Y:%.+]] = memref.reinterpret_cast [[RES]] {{.*}} : memref<?x16x?x?xf32> to memref<?x16x?xf32>
+  // CHECK:       krnl.memset [[RES]]
+  // CHECK:       krnl.matmul {{.*}}, [[X]][{{.*}}], [[Y]][{{.*}}]
+  // CHECK:       return [[RES]] : memref<?x16x?x?xf32>
+}
+
+// -----
+
+// Depthwise convolution: each (n, c) plane is copied into a zero padded
+// buffer, the filter taps are loaded once, and the output width is blocked.
+func private @test_depthwise_conv(%arg0 : tensor<1x4x8x8xf32>, %arg1 : tensor<4x1x3x3xf32>) -> tensor<*xf32> {
+  %cst = constant unit
+  %0 = "onnx.Conv"(%arg0, %arg1, %cst) {group = 4 : si64, kernel_shape = [3, 3], pads = [1, 1, 1, 1], strides = [2, 2]} : (tensor<1x4x8x8xf32>, tensor<4x1x3x3xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_depthwise_conv
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x4x4x4xf32>
+  // CHECK-DAG:   [[PLANE:%.+]] = memref.alloc() {{.*}}: memref<9x9xf32>
+  // CHECK:       krnl.memset [[PLANE]]
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.iterate
+  // CHECK:           [[VAL:%.+]] = krnl.load %arg0{{.*}} : memref<1x4x8x8xf32>
+  // CHECK:           krnl.store [[VAL]], [[PLANE]]{{.*}} : memref<9x9xf32>
+  // CHECK-COUNT-9:   krnl.load %arg1{{.*}} : memref<4x1x3x3xf32>
+  // CHECK:         krnl.block {{.*}} 8 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+  // CHECK:         krnl.iterate
+  // CHECK-COUNT-9:   krnl.load [[PLANE]]{{.*}} : memref<9x9xf32>
+  // CHECK:           krnl.store {{.*}}, [[RES]]{{.*}} : memref<1x4x4x4xf32>
+  // CHECK:       return [[RES]] : memref<1x4x4x4xf32>
+}
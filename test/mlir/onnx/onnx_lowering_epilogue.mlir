@@ -0,0 +1,116 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+// The Relu and the residual Add are applied, after the alpha/beta computations,
+// to each R tile while it is still in the tile buffer, and no other pass is
+// made over the output.
+func private @test_gemm_relu_add(%arg0 : tensor<10x5xf32>, %arg1 : tensor<5x10xf32>, %arg2 : tensor<10xf32>, %arg3 : tensor<10x10xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Gemm"(%arg0, %arg1, %arg2) : (tensor<10x5xf32>, tensor<5x10xf32>, tensor<10xf32>) -> tensor<*xf32>
+  %1 = "onnx.Relu"(%0) : (tensor<*xf32>) -> tensor<*xf32>
+  %2 = "onnx.Add"(%1, %arg3) : (tensor<*xf32>, tensor<10x10xf32>) -> tensor<*xf32>
+  "std.return"(%2) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_gemm_relu_add
+  // CHECK:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<10x10xf32>
+  // CHECK:       krnl.copy_to_tile_buffer [[R_BUF:%[0-9]+]], [[RES]]
+  // CHECK:       krnl.matmul {{.*}}, [[R_BUF]]
+  // CHECK:       krnl.iterate
+  // CHECK:         [[R:%.+]] = krnl.load [[R_BUF]]
+  // CHECK:         [[C:%.+]] = krnl.load %arg2
+  // CHECK:         [[SUM:%.+]] = arith.addf [[R]], [[C]] : f32
+  // CHECK:         arith.cmpf olt, [[SUM]]
+  // CHECK:         [[RELU:%.+]] = select
+  // CHECK:         [[RESIDUAL:%.+]] = krnl.load %arg3
+  // CHECK:         [[Y:%.+]] = arith.addf [[RELU]], [[RESIDUAL]] : f32
+  // CHECK:         krnl.store [[Y]], [[R_BUF]]
+  // CHECK:       krnl.copy_from_tile_buffer [[R_BUF]], [[RES]]
+  // CHECK-NOT:   krnl.iterate
+  // CHECK:       return [[RES]] : memref<10x10xf32>
+}
+
+// -----
+
+// The K loop is nested in the register tile loops, and the Sigmoid is applied
+// to each register tile of the result once it is complete.
+func private @test_matmul_sigmoid(%arg0 : tensor<16x32xf32>, %arg1 : tensor<32x24xf32>) -> tensor<*xf32> {
+  %0 = "onnx.MatMul"(%arg0, %arg1) : (tensor<16x32xf32>, tensor<32x24xf32>) -> tensor<*xf32>
+  %1 = "onnx.Sigmoid"(%0) : (tensor<*xf32>) -> tensor<*xf32>
+  "std.return"(%1) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_matmul_sigmoid
+  // CHECK:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<16x24xf32>
+  // CHECK:       krnl.memset [[RES]]
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.matmul %arg0{{.*}}, %arg1{{.*}}, [[RES]]
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.load [[RES]]
+  // CHECK:           math.exp
+  // CHECK:           [[Y:%.+]] = arith.divf
+  // CHECK:           krnl.store [[Y]], [[RES]]
+  // CHECK-NOT:   krnl.iterate
+  // CHECK:       return [[RES]] : memref<16x24xf32>
+}
+
+// -----
+
+// The result of the MatMul is also returned, so the Relu is not fused.
+func private @test_matmul_relu_multiple_uses(%arg0 : tensor<16x32xf32>, %arg1 : tensor<32x24xf32>) -> (tensor<*xf32>, tensor<*xf32>) {
+  %0 = "onnx.MatMul"(%arg0, %arg1) : (tensor<16x32xf32>, tensor<32x24xf32>) -> tensor<*xf32>
+  %1 = "onnx.Relu"(%0) : (tensor<*xf32>) -> tensor<*xf32>
+  "std.return"(%0, %1) : (tensor<*xf32>, tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_matmul_relu_multiple_uses
+  // CHECK:       krnl.matmul %arg0{{.*}}, %arg1{{.*}}, [[MATMUL:%[0-9]+]]
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.load [[MATMUL]]
+  // CHECK:         arith.cmpf olt
+  // CHECK:         krnl.store {{.*}}, [[RELU:%[0-9]+]]
+  // CHECK:       return [[MATMUL]], [[RELU]] : memref<16x24xf32>, memref<16x24xf32>
+}
+
+// -----
+
+// Pointwise convolution: the Clip is applied to each image right after its
+// matmul.
+func private @test_conv_pointwise_clip(%arg0 : tensor<1x16x8x8xf32>, %arg1 : tensor<8x16x1x1xf32>, %arg2 : tensor<8xf32>, %arg3 : tensor<f32>, %arg4 : tensor<f32>) -> tensor<*xf32> {
+  %0 = "onnx.Conv"(%arg0, %arg1, %arg2) {auto_pad = "NOTSET", group = 1 : si64} : (tensor<1x16x8x8xf32>, tensor<8x16x1x1xf32>, tensor<8xf32>) -> tensor<*xf32>
+  %1 = "onnx.Clip"(%0, %arg3, %arg4) : (tensor<*xf32>, tensor<f32>, tensor<f32>) -> tensor<*xf32>
+  "std.return"(%1) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_conv_pointwise_clip
+  // CHECK:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x8x8x8xf32>
+  // CHECK:       krnl.matmul
+  // CHECK:       krnl.iterate
+  // CHECK:         [[Y:%.+]] = krnl.load [[RES]]
+  // CHECK:         [[MIN:%.+]] = krnl.load %arg3[] : memref<f32>
+  // CHECK:         arith.cmpf olt, [[Y]], [[MIN]] : f32
+  // CHECK:         [[MAX:%.+]] = krnl.load %arg4[] : memref<f32>
+  // CHECK:         [[CLIP:%.+]] = select {{.*}}, [[MAX]] : f32
+  // CHECK:         krnl.store [[CLIP]], [[RES]]
+  // CHECK:       return [[RES]] : memref<1x8x8x8xf32>
+}
+
+// -----
+
+// Direct convolution: the LeakyRelu is applied before each output element is
+// stored.
+func private @test_conv_leakyrelu(%arg0 : tensor<1x2x8x8xf32>, %arg1 : tensor<4x2x5x5xf32>) -> tensor<*xf32> {
+  %cst = constant unit
+  %0 = "onnx.Conv"(%arg0, %arg1, %cst) {auto_pad = "NOTSET", group = 1 : si64} : (tensor<1x2x8x8xf32>, tensor<4x2x5x5xf32>, none) -> tensor<*xf32>
+  %1 = "onnx.LeakyRelu"(%0) {alpha = 0.1 : f32} : (tensor<*xf32>) -> tensor<*xf32>
+  "std.return"(%1) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_conv_leakyrelu
+  // CHECK:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x4x4x4xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.iterate
+  // CHECK:           [[CMP:%.+]] = arith.cmpf olt, [[RED:%.+]], {{.*}} : f32
+  // CHECK:           [[MUL:%.+]] = arith.mulf {{.*}}, [[RED]] : f32
+  // CHECK:           [[Y:%.+]] = select [[CMP]], [[MUL]], [[RED]] : f32
+  // CHECK:           krnl.store [[Y]], [[RES]]
+  // CHECK-NOT:   krnl.iterate
+  // CHECK:       return [[RES]] : memref<1x4x4x4xf32>
+}
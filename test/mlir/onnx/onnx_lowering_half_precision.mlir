@@ -0,0 +1,84 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl='emit-intermediate-ir' --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+func private @test_add_f16(%arg0 : tensor<10x10xf16>, %arg1 : tensor<10x10xf16>) -> tensor<*xf16> {
+  %0 = "onnx.Add"(%arg0, %arg1) : (tensor<10x10xf16>, tensor<10x10xf16>) -> tensor<*xf16>
+  "std.return"(%0) : (tensor<*xf16>) -> ()
+
+  // CHECK-LABEL: test_add_f16
+  // CHECK:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<10x10xf16>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[LHS:%.+]] = krnl.load %arg0{{.*}} : memref<10x10xf16>
+  // CHECK:         [[LHS_F32:%.+]] = arith.extf [[LHS]] : f16 to f32
+  // CHECK:         [[RHS:%.+]] = krnl.load %arg1{{.*}} : memref<10x10xf16>
+  // CHECK:         [[RHS_F32:%.+]] = arith.extf [[RHS]] : f16 to f32
+  // CHECK:         [[ADD:%.+]] = arith.addf [[LHS_F32]], [[RHS_F32]] : f32
+  // CHECK:         [[ADD_F16:%.+]] = arith.truncf [[ADD]] : f32 to f16
+  // CHECK:         krnl.store [[ADD_F16]], [[RES]]{{.*}} : memref<10x10xf16>
+}
+
+// -----
+
+func private @test_relu_bf16(%arg0 : tensor<10x10xbf16>) -> tensor<*xbf16> {
+  %0 = "onnx.Relu"(%arg0) : (tensor<10x10xbf16>) -> tensor<*xbf16>
+  "std.return"(%0) : (tensor<*xbf16>) -> ()
+
+  // CHECK-LABEL: test_relu_bf16
+  // CHECK-DAG:   [[ZERO:%.+]] = arith.constant 0.000000e+00 : f32
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<10x10xbf16>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[X:%.+]] = krnl.load %arg0{{.*}} : memref<10x10xbf16>
+  // CHECK:         [[X_F32:%.+]] = arith.extf [[X]] : bf16 to f32
+  // CHECK:         arith.cmpf olt, [[X_F32]], [[ZERO]] : f32
+  // CHECK:         [[Y:%.+]] = arith.truncf {{.*}} : f32 to bf16
+  // CHECK:         krnl.store [[Y]], [[RES]]{{.*}} : memref<10x10xbf16>
+}
+
+// -----
+
+func private @test_gemm_f16(%arg0 : tensor<64x128xf16>, %arg1 : tensor<128x32xf16>, %arg2: tensor<32xf16>) -> tensor<*xf16> {
+  %0 ="onnx.Gemm"(%arg0, %arg1, %arg2) {alpha = 1.0 : f32, beta = 1.0 : f32} : (tensor<64x128xf16>, tensor<128x32xf16>, tensor<32xf16>) -> tensor<*xf16>
+  "std.return"(%0) : (tensor<*xf16>) -> ()
+
+  // CHECK-LABEL: test_gemm_f16
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<64x32xf16>
+  // CHECK-DAG:   [[A_BUF:%.+]] = memref.alloc() {{.*}}: memref<32x256xf32>
+  // CHECK-DAG:   [[B_BUF:%.+]] = memref.alloc() {{.*}}: memref<256x64xf32>
+  // CHECK-DAG:   [[R_BUF:%.+]] = memref.alloc() {{.*}}: memref<32x256xf32>
+  // CHECK:       krnl.copy_to_tile_buffer [[R_BUF]], [[RES]]{{.*}} : memref<32x256xf32>, memref<64x32xf16>
+  // CHECK:       krnl.copy_to_tile_buffer [[A_BUF]], %arg0{{.*}} : memref<32x256xf32>, memref<64x128xf16>
+  // CHECK:       krnl.copy_to_tile_buffer [[B_BUF]], %arg1{{.*}} : memref<256x64xf32>, memref<128x32xf16>
+  // CHECK:       krnl.matmul [[A_BUF]]{{.*}}, [[B_BUF]]{{.*}}, [[R_BUF]]{{.*}} : memref<32x256xf32>, memref<256x64xf32>, memref<32x256xf32>
+  // CHECK:       krnl.copy_from_tile_buffer [[R_BUF]], [[RES]]{{.*}} : memref<32x256xf32>, memref<64x32xf16>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[R:%.+]] = krnl.load [[RES]]{{.*}} : memref<64x32xf16>
+  // CHECK:         [[R_F32:%.+]] = arith.extf [[R]] : f16 to f32
+  // CHECK:         [[C:%.+]] = krnl.load %arg2{{.*}} : memref<32xf16>
+  // CHECK:         [[C_F32:%.+]] = arith.extf [[C]] : f16 to f32
+  // CHECK:         [[SUM:%.+]] = arith.addf [[R_F32]], [[C_F32]] : f32
+  // CHECK:         [[SUM_F16:%.+]] = arith.truncf [[SUM]] : f32 to f16
+  // CHECK:         krnl.store [[SUM_F16]], [[RES]]{{.*}} : memref<64x32xf16>
+}
+
+// -----
+
+func private @test_conv_bf16(%arg0 : tensor<1x2x8x8xbf16>, %arg1 : tensor<4x2x3x3xbf16>) -> tensor<*xbf16> {
+  %cst = constant unit
+  %0 = "onnx.Conv"(%arg0, %arg1, %cst) {auto_pad = "NOTSET", group = 1 : si64} : (tensor<1x2x8x8xbf16>, tensor<4x2x3x3xbf16>, none) -> tensor<*xbf16>
+  "std.return"(%0) : (tensor<*xbf16>) -> ()
+
+  // CHECK-LABEL: test_conv_bf16
+  // CHECK-DAG:   [[ZERO:%.+]] = arith.constant 0.000000e+00 : f32
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x4x6x6xbf16>
+  // CHECK:       [[RED:%.+]] = memref.alloca() : memref<f32>
+  // CHECK:       krnl.store [[ZERO]], [[RED]][] : memref<f32>
+  // CHECK:       [[IMG:%.+]] = krnl.load %arg0{{.*}} : memref<1x2x8x8xbf16>
+  // CHECK:       [[IMG_F32:%.+]] = arith.extf [[IMG]] : bf16 to f32
+  // CHECK:       [[FILTER:%.+]] = krnl.load %arg1{{.*}} : memref<4x2x3x3xbf16>
+  // CHECK:       [[FILTER_F32:%.+]] = arith.extf [[FILTER]] : bf16 to f32
+  // CHECK:       arith.mulf [[IMG_F32]], [[FILTER_F32]] : f32
+  // CHECK:       [[ACC:%.+]] = krnl.load [[RED]][] : memref<f32>
+  // CHECK:       [[ACC_BF16:%.+]] = arith.truncf [[ACC]] : f32 to bf16
+  // CHECK:       krnl.store [[ACC_BF16]], [[RES]]{{.*}} : memref<1x4x6x6xbf16>
+}
@@ -0,0 +1,55 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+// Each row of X is swept twice: once to accumulate the sums of x - x0 and
+// (x - x0)^2 in 8 lanes, and once to normalize, scale and shift.
+func private @test_layer_normalization(%arg0 : tensor<2x4x8xf32>, %arg1 : tensor<8xf32>, %arg2 : tensor<8xf32>) -> tensor<*xf32> {
+  %Y, %Mean, %InvStdDev = "onnx.LayerNormalization"(%arg0, %arg1, %arg2) {axis = -1 : si64, epsilon = 1.0e-5 : f32} : (tensor<2x4x8xf32>, tensor<8xf32>, tensor<8xf32>) -> (tensor<*xf32>, none, none)
+  "std.return"(%Y) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_layer_normalization
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<2x4x8xf32>
+  // CHECK-DAG:   [[X:%.+]] = memref.reinterpret_cast %arg0 to offset: [0], sizes: [8, 8], strides: [8, 1] : memref<2x4x8xf32> to memref<8x8xf32>
+  // CHECK-DAG:   [[Y:%.+]] = memref.reinterpret_cast [[RES]] to offset: [0], sizes: [8, 8], strides: [8, 1] : memref<2x4x8xf32> to memref<8x8xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[LANES:%.+]] = memref.alloca() : memref<2x8xf32>
+  // CHECK:         krnl.memset [[LANES]]
+  // CHECK:         krnl.block {{.*}} 8 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.load [[X]]{{.*}} : memref<8x8xf32>
+  // CHECK:           krnl.store {{.*}}, [[LANES]]{{.*}} : memref<2x8xf32>
+  // CHECK-COUNT-16:  krnl.load [[LANES]]{{.*}} : memref<2x8xf32>
+  // CHECK:         math.sqrt
+  // CHECK:         krnl.block {{.*}} 8 : (!krnl.loop) -> (!krnl.loop, !krnl.loop)
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.load [[X]]{{.*}} : memref<8x8xf32>
+  // CHECK:           krnl.store {{.*}}, [[Y]]{{.*}} : memref<8x8xf32>
+  // CHECK:       return [[RES]] : memref<2x4x8xf32>
+}
+
+// -----
+
+// Dynamic rows, a scale broadcast along the first normalized dimension, and
+// the Mean and InvStdDev outputs.
+func private @test_layer_normalization_dynamic(%arg0 : tensor<?x4x8xf32>, %arg1 : tensor<1x8xf32>) -> (tensor<*xf32>, tensor<*xf32>, tensor<*xf32>) {
+  %cst = constant unit
+  %Y, %Mean, %InvStdDev = "onnx.LayerNormalization"(%arg0, %arg1, %cst) {axis = 1 : si64} : (tensor<?x4x8xf32>, tensor<1x8xf32>, none) -> (tensor<*xf32>, tensor<*xf32>, tensor<*xf32>)
+  "std.return"(%Y, %Mean, %InvStdDev) : (tensor<*xf32>, tensor<*xf32>, tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_layer_normalization_dynamic
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc({{.*}}) {{.*}}: memref<?x4x8xf32>
+  // CHECK-DAG:   [[SCALE:%.+]] = memref.alloc() {{.*}}: memref<32xf32>
+  // CHECK-DAG:   [[MEAN:%.+]] = memref.alloc({{.*}}) {{.*}}: memref<?x1x1xf32>
+  // CHECK-DAG:   [[INV_STD_DEV:%.+]] = memref.alloc({{.*}}) {{.*}}: memref<?x1x1xf32>
+  // CHECK-DAG:   [[X:%.+]] = memref.reinterpret_cast %arg0 {{.*}} : memref<?x4x8xf32> to memref<?x32xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[VAL:%.+]] = krnl.load %arg1{{.*}} : memref<1x8xf32>
+  // CHECK:         krnl.store [[VAL]], [[SCALE]]{{.*}} : memref<32xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.store {{.*}} : memref<?xf32>
+  // CHECK:         krnl.store {{.*}} : memref<?xf32>
+  // CHECK:         krnl.iterate
+  // CHECK:           krnl.load [[SCALE]]{{.*}} : memref<32xf32>
+  // CHECK:       return [[RES]], [[MEAN]], [[INV_STD_DEV]] : memref<?x4x8xf32>, memref<?x1x1xf32>, memref<?x1x1xf32>
+}
@@ -0,0 +1,82 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+func private @test_layout_transform_to_blocked(%arg0 : tensor<1x16x4x4xf32>) -> tensor<*xf32> {
+  %0 = "onnx.LayoutTransform"(%arg0) {target_layout = "NCHW8c"} : (tensor<1x16x4x4xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_layout_transform_to_blocked
+  // CHECK:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x2x4x4x8xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[VAL:%.+]] = krnl.load %arg0{{.*}} : memref<1x16x4x4xf32>
+  // CHECK:         krnl.store [[VAL]], [[RES]]{{.*}} : memref<1x2x4x4x8xf32>
+  // CHECK:       return [[RES]] : memref<1x2x4x4x8xf32>
+}
+
+// -----
+
+func private @test_layout_transform_to_nchw(%arg0 : tensor<1x2x4x4x8xf32>) -> tensor<*xf32> {
+  %0 = "onnx.LayoutTransform"(%arg0) {target_layout = "NCHW"} : (tensor<1x2x4x4x8xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_layout_transform_to_nchw
+  // CHECK:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x16x4x4xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[VAL:%.+]] = krnl.load %arg0{{.*}} : memref<1x2x4x4x8xf32>
+  // CHECK:         krnl.store [[VAL]], [[RES]]{{.*}} : memref<1x16x4x4xf32>
+  // CHECK:       return [[RES]] : memref<1x16x4x4xf32>
+}
+
+// -----
+
+func private @test_conv_nchwc(%arg0 : tensor<1x2x6x6x8xf32>, %arg1 : tensor<16x16x3x3xf32>, %arg2 : tensor<16xf32>) -> tensor<*xf32> {
+  %0 = "onnx.ConvNCHWc"(%arg0, %arg1, %arg2) {dilations = [1, 1], kernel_shape = [3, 3], pads = [1, 1, 1, 1], strides = [1, 1]} : (tensor<1x2x6x6x8xf32>, tensor<16x16x3x3xf32>, tensor<16xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_conv_nchwc
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x2x6x6x8xf32>
+  // CHECK-DAG:   [[PACKED:%.+]] = memref.alloc() {{.*}}: memref<2x2x3x3x8x8xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[W:%.+]] = krnl.load %arg1{{.*}} : memref<16x16x3x3xf32>
+  // CHECK:         krnl.store [[W]], [[PACKED]]{{.*}} : memref<2x2x3x3x8x8xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[ACC:%.+]] = memref.alloca() {{.*}}: memref<8xf32>
+  // CHECK:         krnl.iterate
+  // CHECK:           [[BIAS:%.+]] = krnl.load %arg2{{.*}} : memref<16xf32>
+  // CHECK:           krnl.store [[BIAS]], [[ACC]]{{.*}} : memref<8xf32>
+  // CHECK:         krnl.iterate
+  // CHECK:           [[X:%.+]] = krnl.load %arg0{{.*}} : memref<1x2x6x6x8xf32>
+  // CHECK:           krnl.iterate
+  // CHECK:             [[FILTER:%.+]] = krnl.load [[PACKED]]{{.*}} : memref<2x2x3x3x8x8xf32>
+  // CHECK:             [[OLD:%.+]] = krnl.load [[ACC]]{{.*}} : memref<8xf32>
+  // CHECK:             [[MUL:%.+]] = arith.mulf [[X]], [[FILTER]] : f32
+  // CHECK:             [[ADD:%.+]] = arith.addf [[OLD]], [[MUL]] : f32
+  // CHECK:             krnl.store [[ADD]], [[ACC]]{{.*}} : memref<8xf32>
+  // CHECK:         krnl.iterate
+  // CHECK:           [[VAL:%.+]] = krnl.load [[ACC]]{{.*}} : memref<8xf32>
+  // CHECK:           krnl.store [[VAL]], [[RES]]{{.*}} : memref<1x2x6x6x8xf32>
+  // CHECK:       return [[RES]] : memref<1x2x6x6x8xf32>
+}
+
+// -----
+
+func private @test_pool_nchwc_avg(%arg0 : tensor<1x2x4x4x8xf32>) -> tensor<*xf32> {
+  %0 = "onnx.PoolNCHWc"(%arg0) {kernel_shape = [2, 2], mode = "avg", pads = [0, 0, 0, 0], strides = [2, 2]} : (tensor<1x2x4x4x8xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_pool_nchwc_avg
+  // CHECK:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x2x2x2x8xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         [[ACC:%.+]] = memref.alloca() {{.*}}: memref<8xf32>
+  // CHECK:         krnl.iterate
+  // CHECK:           [[X:%.+]] = krnl.load %arg0{{.*}} : memref<1x2x4x4x8xf32>
+  // CHECK:           [[OLD:%.+]] = krnl.load [[ACC]]{{.*}} : memref<8xf32>
+  // CHECK:           [[ADD:%.+]] = arith.addf [[OLD]], [[X]] : f32
+  // CHECK:           krnl.store [[ADD]], [[ACC]]{{.*}} : memref<8xf32>
+  // CHECK:         krnl.iterate
+  // CHECK:           [[SUM:%.+]] = krnl.load [[ACC]]{{.*}} : memref<8xf32>
+  // CHECK:           [[AVG:%.+]] = arith.divf [[SUM]], {{.*}} : f32
+  // CHECK:           krnl.store [[AVG]], [[RES]]{{.*}} : memref<1x2x2x2x8xf32>
+  // CHECK:       return [[RES]] : memref<1x2x2x2x8xf32>
+}
@@ -0,0 +1,94 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+// 3x3 windows with unit strides are reduced with a row pass followed by a
+// column pass.
+func private @test_maxpool_separable(%arg0 : tensor<1x3x32x32xf32>) -> tensor<*xf32> {
+  %0 = "onnx.MaxPoolSingleOut"(%arg0) {auto_pad = "NOTSET", kernel_shape = [3, 3]} : (tensor<1x3x32x32xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_maxpool_separable
+  // CHECK-DAG:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x3x30x30xf32>
+  // CHECK-DAG:       [[TMP:%.+]] = memref.alloc() {{.*}}: memref<32x30xf32>
+  // CHECK-DAG:       [[IDENTITY:%.+]] = arith.constant 0xFF800000 : f32
+  // CHECK:           krnl.iterate
+  // CHECK:             krnl.memset [[TMP]], [[IDENTITY]] : memref<32x30xf32>
+  // CHECK:             krnl.iterate
+  // CHECK:               krnl.iterate
+  // CHECK:                 [[X:%.+]] = krnl.load %arg0{{.*}} : memref<1x3x32x32xf32>
+  // CHECK:                 [[ROW:%.+]] = krnl.load [[TMP]]{{.*}} : memref<32x30xf32>
+  // CHECK:                 [[CMP:%.+]] = arith.cmpf ogt, [[ROW]], [[X]] : f32
+  // CHECK:                 [[MAX:%.+]] = select [[CMP]], [[ROW]], [[X]] : f32
+  // CHECK:                 krnl.store [[MAX]], [[TMP]]{{.*}} : memref<32x30xf32>
+  // CHECK:             krnl.iterate
+  // CHECK:               krnl.iterate
+  // CHECK:                 krnl.store [[IDENTITY]], [[RES]]{{.*}} : memref<1x3x30x30xf32>
+  // CHECK:               krnl.iterate
+  // CHECK:                 [[COL:%.+]] = krnl.load [[TMP]]{{.*}} : memref<32x30xf32>
+  // CHECK:                 [[OUT:%.+]] = krnl.load [[RES]]{{.*}} : memref<1x3x30x30xf32>
+  // CHECK:                 arith.cmpf ogt, [[OUT]], [[COL]] : f32
+  // CHECK:                 krnl.store {{.*}}, [[RES]]{{.*}} : memref<1x3x30x30xf32>
+  // CHECK:           return [[RES]] : memref<1x3x30x30xf32>
+}
+
+// -----
+
+// With count_include_pad, the average uses a single reciprocal.
+func private @test_averagepool_separable_include_pad(%arg0 : tensor<1x3x32x32xf32>) -> tensor<*xf32> {
+  %0 = "onnx.AveragePool"(%arg0) {auto_pad = "NOTSET", kernel_shape = [3, 3], pads = [1, 1, 1, 1], count_include_pad = 1 : si64} : (tensor<1x3x32x32xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_averagepool_separable_include_pad
+  // CHECK-DAG:       [[RECIP:%.+]] = arith.constant 0.111111112 : f32
+  // CHECK-DAG:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x3x32x32xf32>
+  // CHECK-DAG:       [[TMP:%.+]] = memref.alloc() {{.*}}: memref<32x32xf32>
+  // CHECK:           krnl.iterate
+  // CHECK:             krnl.memset [[TMP]]
+  // CHECK:             krnl.iterate
+  // CHECK:               krnl.iterate
+  // CHECK:                 arith.addf
+  // CHECK:                 krnl.store {{.*}}, [[TMP]]{{.*}} : memref<32x32xf32>
+  // CHECK:             krnl.iterate
+  // CHECK:               krnl.iterate
+  // CHECK:                 arith.addf
+  // CHECK:               krnl.iterate
+  // CHECK:                 [[SUM:%.+]] = krnl.load [[RES]]{{.*}} : memref<1x3x32x32xf32>
+  // CHECK:                 [[AVG:%.+]] = arith.mulf [[SUM]], [[RECIP]] : f32
+  // CHECK:                 krnl.store [[AVG]], [[RES]]{{.*}} : memref<1x3x32x32xf32>
+}
+
+// -----
+
+// Without count_include_pad, reciprocals of the window widths are computed
+// once, before the image loops.
+func private @test_averagepool_separable_exclude_pad(%arg0 : tensor<1x3x32x32xf32>) -> tensor<*xf32> {
+  %0 = "onnx.AveragePool"(%arg0) {auto_pad = "NOTSET", kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x3x32x32xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_averagepool_separable_exclude_pad
+  // CHECK-DAG:       [[RECIP_W:%.+]] = memref.alloc() {{.*}}: memref<32xf32>
+  // CHECK:           krnl.iterate
+  // CHECK:             arith.divf
+  // CHECK:             krnl.store {{.*}}, [[RECIP_W]]{{.*}} : memref<32xf32>
+  // CHECK:           krnl.iterate
+  // CHECK:             krnl.memset
+  // CHECK:             krnl.iterate
+  // CHECK:               [[RECIP_H:%.+]] = arith.divf
+  // CHECK:               krnl.iterate
+  // CHECK:                 [[RW:%.+]] = krnl.load [[RECIP_W]]{{.*}} : memref<32xf32>
+  // CHECK:                 [[SCALE:%.+]] = arith.mulf [[RECIP_H]], [[RW]] : f32
+  // CHECK:                 arith.mulf {{.*}}, [[SCALE]] : f32
+}
+
+// -----
+
+// 3x3 windows with a stride of 2 do not benefit from the separable passes.
+func private @test_maxpool_not_separable(%arg0 : tensor<1x3x32x32xf32>) -> tensor<*xf32> {
+  %0 = "onnx.MaxPoolSingleOut"(%arg0) {auto_pad = "NOTSET", kernel_shape = [3, 3], strides = [2, 2]} : (tensor<1x3x32x32xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_maxpool_not_separable
+  // CHECK-NOT:       krnl.memset
+  // CHECK:           return
+}
@@ -0,0 +1,102 @@
+// RUN: onnx-mlir-opt --shape-inference --convert-onnx-to-krnl='emit-intermediate-ir' --canonicalize %s -split-input-file | FileCheck %s
+
+// -----
+
+func private @test_quantize_linear(%arg0 : tensor<4x8xf32>, %arg1 : tensor<f32>, %arg2 : tensor<ui8>) -> tensor<4x8xui8> {
+  %0 = "onnx.QuantizeLinear"(%arg0, %arg1, %arg2) : (tensor<4x8xf32>, tensor<f32>, tensor<ui8>) -> tensor<4x8xui8>
+  "std.return"(%0) : (tensor<4x8xui8>) -> ()
+
+  // CHECK-LABEL: test_quantize_linear
+  // CHECK-DAG:       [[MIN:%.+]] = arith.constant 0.000000e+00 : f32
+  // CHECK-DAG:       [[MAX:%.+]] = arith.constant 2.550000e+02 : f32
+  // CHECK-DAG:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<4x8xui8>
+  // CHECK-DAG:       [[SCALE:%.+]] = krnl.load %arg1[] : memref<f32>
+  // CHECK:           krnl.iterate
+  // CHECK:             [[X:%.+]] = krnl.load %arg0{{.*}} : memref<4x8xf32>
+  // CHECK:             [[DIV:%.+]] = arith.divf [[X]], [[SCALE]] : f32
+  // CHECK:             math.floor
+  // CHECK:             [[CLAMP_LO:%.+]] = arith.maxf {{.*}}, [[MIN]] : f32
+  // CHECK:             [[CLAMP_HI:%.+]] = arith.minf [[CLAMP_LO]], [[MAX]] : f32
+  // CHECK:             [[Q:%.+]] = arith.fptoui
+  // CHECK:             krnl.store {{.*}}, [[RES]]{{.*}} : memref<4x8xui8>
+}
+
+// -----
+
+func private @test_dequantize_linear(%arg0 : tensor<4x8xi8>, %arg1 : tensor<f32>, %arg2 : tensor<i8>) -> tensor<4x8xf32> {
+  %0 = "onnx.DequantizeLinear"(%arg0, %arg1, %arg2) : (tensor<4x8xi8>, tensor<f32>, tensor<i8>) -> tensor<4x8xf32>
+  "std.return"(%0) : (tensor<4x8xf32>) -> ()
+
+  // CHECK-LABEL: test_dequantize_linear
+  // CHECK-DAG:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<4x8xf32>
+  // CHECK-DAG:       [[SCALE:%.+]] = krnl.load %arg1[] : memref<f32>
+  // CHECK-DAG:       [[ZP:%.+]] = krnl.load %arg2[] : memref<i8>
+  // CHECK-DAG:       [[ZP_F:%.+]] = arith.sitofp [[ZP]] : i8 to f32
+  // CHECK:           krnl.iterate
+  // CHECK:             [[X:%.+]] = krnl.load %arg0{{.*}} : memref<4x8xi8>
+  // CHECK:             [[X_F:%.+]] = arith.sitofp [[X]] : i8 to f32
+  // CHECK:             [[SUB:%.+]] = arith.subf [[X_F]], [[ZP_F]] : f32
+  // CHECK:             [[MUL:%.+]] = arith.mulf [[SUB]], [[SCALE]] : f32
+  // CHECK:             krnl.store [[MUL]], [[RES]]{{.*}} : memref<4x8xf32>
+}
+
+// -----
+
+func private @test_matmulinteger(%arg0 : tensor<16x64xi8>, %arg1 : tensor<64x32xi8>, %arg2 : tensor<i8>, %arg3 : tensor<i8>) -> tensor<*xi32> {
+  %0 = "onnx.MatMulInteger"(%arg0, %arg1, %arg2, %arg3) : (tensor<16x64xi8>, tensor<64x32xi8>, tensor<i8>, tensor<i8>) -> tensor<*xi32>
+  "std.return"(%0) : (tensor<*xi32>) -> ()
+
+  // CHECK-LABEL: test_matmulinteger
+  // CHECK-DAG:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<16x32xi32>
+  // CHECK-DAG:       [[A_WIDE:%.+]] = memref.alloc() {{.*}}: memref<16x64xi32>
+  // CHECK-DAG:       [[B_WIDE:%.+]] = memref.alloc() {{.*}}: memref<64x32xi32>
+  // CHECK:           krnl.iterate
+  // CHECK:             [[A:%.+]] = krnl.load %arg0{{.*}} : memref<16x64xi8>
+  // CHECK:             [[A_EXT:%.+]] = arith.extsi [[A]] : i8 to i32
+  // CHECK:             [[A_SUB:%.+]] = arith.subi [[A_EXT]], {{.*}} : i32
+  // CHECK:             krnl.store [[A_SUB]], [[A_WIDE]]{{.*}} : memref<16x64xi32>
+  // CHECK:           krnl.copy_to_tile_buffer {{.*}}, [[A_WIDE]]
+  // CHECK:           krnl.copy_to_tile_buffer {{.*}}, [[B_WIDE]]
+  // CHECK:           krnl.matmul {{.*}} : memref<32x256xi32>, memref<256x64xi32>, memref<32x64xi32>
+  // CHECK:           krnl.store {{.*}}, [[RES]]{{.*}} : memref<16x32xi32>
+}
+
+// -----
+
+func private @test_qlinearmatmul(%arg0 : tensor<16x64xui8>, %arg1 : tensor<f32>, %arg2 : tensor<ui8>, %arg3 : tensor<64x32xui8>, %arg4 : tensor<f32>, %arg5 : tensor<ui8>, %arg6 : tensor<f32>, %arg7 : tensor<ui8>) -> tensor<16x32xui8> {
+  %0 = "onnx.QLinearMatMul"(%arg0, %arg1, %arg2, %arg3, %arg4, %arg5, %arg6, %arg7) : (tensor<16x64xui8>, tensor<f32>, tensor<ui8>, tensor<64x32xui8>, tensor<f32>, tensor<ui8>, tensor<f32>, tensor<ui8>) -> tensor<16x32xui8>
+  "std.return"(%0) : (tensor<16x32xui8>) -> ()
+
+  // CHECK-LABEL: test_qlinearmatmul
+  // CHECK-DAG:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<16x32xui8>
+  // CHECK:           arith.extui {{.*}} : i8 to i32
+  // CHECK:           krnl.matmul {{.*}} : memref<32x256xi32>, memref<256x64xi32>, memref<32x64xi32>
+  // CHECK:           [[ACC:%.+]] = krnl.load {{.*}} : memref<32x64xi32>
+  // CHECK:           arith.sitofp [[ACC]] : i32 to f32
+  // CHECK:           math.floor
+  // CHECK:           arith.fptoui
+  // CHECK:           krnl.store {{.*}}, [[RES]]{{.*}} : memref<16x32xui8>
+}
+
+// -----
+
+func private @test_qlinearconv(%arg0 : tensor<1x2x6x6xi8>, %arg1 : tensor<f32>, %arg2 : tensor<i8>, %arg3 : tensor<4x2x3x3xi8>, %arg4 : tensor<4xf32>, %arg5 : tensor<4xi8>, %arg6 : tensor<f32>, %arg7 : tensor<i8>, %arg8 : tensor<4xi32>) -> tensor<*xi8> {
+  %0 = "onnx.QLinearConv"(%arg0, %arg1, %arg2, %arg3, %arg4, %arg5, %arg6, %arg7, %arg8) : (tensor<1x2x6x6xi8>, tensor<f32>, tensor<i8>, tensor<4x2x3x3xi8>, tensor<4xf32>, tensor<4xi8>, tensor<f32>, tensor<i8>, tensor<4xi32>) -> tensor<*xi8>
+  "std.return"(%0) : (tensor<*xi8>) -> ()
+
+  // CHECK-LABEL: test_qlinearconv
+  // CHECK-DAG:       [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x4x4x4xi8>
+  // CHECK-DAG:       [[X_WIDE:%.+]] = memref.alloc() {{.*}}: memref<1x2x6x6xi32>
+  // CHECK-DAG:       [[W_WIDE:%.+]] = memref.alloc() {{.*}}: memref<4x2x3x3xi32>
+  // CHECK:           krnl.iterate
+  // CHECK:             [[W_SCALE:%.+]] = krnl.load %arg4{{.*}} : memref<4xf32>
+  // CHECK:             krnl.iterate
+  // CHECK:               krnl.iterate
+  // CHECK:                 [[IMG:%.+]] = krnl.load [[X_WIDE]]{{.*}} : memref<1x2x6x6xi32>
+  // CHECK:                 [[FILTER:%.+]] = krnl.load [[W_WIDE]]{{.*}} : memref<4x2x3x3xi32>
+  // CHECK:                 arith.muli [[IMG]], [[FILTER]] : i32
+  // CHECK:               [[BIAS:%.+]] = krnl.load %arg8{{.*}} : memref<4xi32>
+  // CHECK:               arith.addi {{.*}}, [[BIAS]] : i32
+  // CHECK:               arith.fptosi {{.*}} : f32 to i8
+  // CHECK:               krnl.store {{.*}}, [[RES]]{{.*}} : memref<1x4x4x4xi8>
+}
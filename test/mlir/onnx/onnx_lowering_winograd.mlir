@@ -0,0 +1,81 @@
+// RUN: onnx-mlir-opt --winograd-tile=2 --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck %s
+// RUN: onnx-mlir-opt --winograd-tile=4 --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck --check-prefix=F4 %s
+// RUN: onnx-mlir-opt --winograd-tile=0 --shape-inference --convert-onnx-to-krnl --canonicalize %s -split-input-file | FileCheck --check-prefix=DIRECT %s
+
+// -----
+
+// 3x3 convolution with a runtime filter: the filter is transformed by loops,
+// and the output is made of full 2x2 (F2) or 4x4 (F4) tiles.
+func private @test_winograd_conv(%arg0 : tensor<1x2x8x8xf32>, %arg1 : tensor<4x2x3x3xf32>, %arg2 : tensor<4xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Conv"(%arg0, %arg1, %arg2) {kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x2x8x8xf32>, tensor<4x2x3x3xf32>, tensor<4xf32>) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_winograd_conv
+  // CHECK-DAG:   [[RES:%.+]] = memref.alloc() {{.*}}: memref<1x4x8x8xf32>
+  // CHECK-DAG:   [[U:%.+]] = memref.alloc() {{.*}}: memref<4x4x4x2xf32>
+  // CHECK-DAG:   [[XP:%.+]] = memref.alloc() {{.*}}: memref<1x2x10x10xf32>
+  // CHECK-DAG:   [[V:%.+]] = memref.alloc() {{.*}}: memref<4x4x2x16xf32>
+  // CHECK-DAG:   [[Z:%.+]] = memref.alloc() {{.*}}: memref<4x4x4x16xf32>
+  // CHECK:       krnl.load %arg1{{.*}} : memref<4x2x3x3xf32>
+  // CHECK:       krnl.store {{.*}}, [[U]]{{.*}} : memref<4x4x4x2xf32>
+  // CHECK:       krnl.memset [[XP]]
+  // CHECK:       krnl.store {{.*}}, [[XP]]{{.*}} : memref<1x2x10x10xf32>
+  // CHECK:       krnl.store {{.*}}, [[V]]{{.*}} : memref<4x4x2x16xf32>
+  // CHECK:       krnl.memset [[Z]]
+  // CHECK:       krnl.matmul [[U]]{{.*}}, [[V]]{{.*}}, [[Z]]
+  // CHECK:       krnl.load [[Z]]{{.*}} : memref<4x4x4x16xf32>
+  // CHECK:       krnl.load %arg2{{.*}} : memref<4xf32>
+  // CHECK:       krnl.store {{.*}}, [[RES]]{{.*}} : memref<1x4x8x8xf32>
+  // CHECK-NOT:   memref.alloca
+  // CHECK:       return [[RES]] : memref<1x4x8x8xf32>
+
+  // F4-LABEL:    test_winograd_conv
+  // F4-DAG:      memref.alloc() {{.*}}: memref<6x6x4x2xf32>
+  // F4-DAG:      memref.alloc() {{.*}}: memref<1x2x10x10xf32>
+  // F4-DAG:      memref.alloc() {{.*}}: memref<6x6x2x4xf32>
+  // F4-DAG:      memref.alloc() {{.*}}: memref<6x6x4x4xf32>
+  // F4:          krnl.matmul
+
+  // DIRECT-LABEL: test_winograd_conv
+  // DIRECT-NOT:   krnl.matmul
+  // DIRECT:       return
+}
+
+// -----
+
+// 3x3 convolution with a constant filter: the filter transform G W GT is
+// computed at compile time. The 3x3 output is made of partial 2x2 tiles.
+func private @test_winograd_conv_constant_filter(%arg0 : tensor<1x1x5x5xf32>) -> tensor<*xf32> {
+  %w = "onnx.Constant"() {value = dense<1.0> : tensor<1x1x3x3xf32>} : () -> tensor<1x1x3x3xf32>
+  %b = constant unit
+  %0 = "onnx.Conv"(%arg0, %w, %b) {kernel_shape = [3, 3]} : (tensor<1x1x5x5xf32>, tensor<1x1x3x3xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_winograd_conv_constant_filter
+  // CHECK:       [[U:%.+]] = "krnl.global"() {name = "winograd_filter_{{[0-9]+}}", shape = [4, 4, 1, 1], value = dense<{{.*}}1.500000e+00{{.*}}2.250000e+00{{.*}}> : tensor<4x4x1x1xf32>} : () -> memref<4x4x1x1xf32>
+  // CHECK:       krnl.matmul [[U]]
+  // CHECK:       memref.alloca() {{.*}}: memref<2x2xf32>
+  // CHECK:       krnl.iterate
+  // CHECK:         krnl.load {{.*}} : memref<2x2xf32>
+  // CHECK:         krnl.store {{.*}} : memref<1x1x3x3xf32>
+
+  // F4-LABEL:    test_winograd_conv_constant_filter
+  // F4:          "krnl.global"() {name = "winograd_filter_{{[0-9]+}}", shape = [4, 4, 1, 1]
+
+  // DIRECT-LABEL: test_winograd_conv_constant_filter
+  // DIRECT-NOT:   winograd_filter
+  // DIRECT:       return
+}
+
+// -----
+
+// Strided convolutions keep the direct algorithm.
+func private @test_winograd_conv_strided(%arg0 : tensor<1x2x8x8xf32>, %arg1 : tensor<4x2x3x3xf32>) -> tensor<*xf32> {
+  %b = constant unit
+  %0 = "onnx.Conv"(%arg0, %arg1, %b) {kernel_shape = [3, 3], strides = [2, 2]} : (tensor<1x2x8x8xf32>, tensor<4x2x3x3xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_winograd_conv_strided
+  // CHECK-NOT:   krnl.matmul
+  // CHECK:       return
+}
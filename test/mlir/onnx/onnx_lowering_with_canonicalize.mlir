@@ -53,6 +53,76 @@ func @test_slice_constant_default_steps(%arg0 : tensor<2x4xf32>) -> tensor<*xf32
 
 // -----
 
+// Slice of a contiguous prefix: lowered to a view of the data.
+func @test_slice_contiguous_prefix(%arg0 : tensor<16x32xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Add"(%arg0, %arg0) : (tensor<16x32xf32>, tensor<16x32xf32>) -> tensor<16x32xf32>
+  %axes = "onnx.Constant"() {value = dense<[0]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %starts = "onnx.Constant"() {value = dense<[0]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %ends = "onnx.Constant"() {value = dense<[8]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %steps = constant unit
+  %1 = "onnx.Slice"(%0, %starts, %ends, %axes, %steps) : (tensor<16x32xf32>, tensor<1xi64>, tensor<1xi64>, tensor<1xi64>, none) -> tensor<*xf32>
+  "std.return"(%1) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_slice_contiguous_prefix
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<16x32xf32>) -> memref<8x32xf32> {
+// CHECK:           [[ADD_:%.+]] = memref.alloc() {{.*}}: memref<16x32xf32>
+// CHECK:           krnl.iterate
+// CHECK:           [[RES_:%.+]] = memref.reinterpret_cast [[ADD_]] to offset: [0], sizes: [8, 32], strides: [32, 1] : memref<16x32xf32> to memref<8x32xf32>
+// CHECK-NOT:       memref.alloc
+// CHECK:           return [[RES_]] : memref<8x32xf32>
+// CHECK:         }
+}
+
+// -----
+
+// Slice of a contiguous prefix of a function argument: the buffer belongs to
+// the caller, so the slice is copied rather than returned as a view of it.
+func @test_slice_contiguous_prefix_argument(%arg0 : tensor<16x32xf32>) -> tensor<*xf32> {
+  %axes = "onnx.Constant"() {value = dense<[0]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %starts = "onnx.Constant"() {value = dense<[0]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %ends = "onnx.Constant"() {value = dense<[8]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %steps = constant unit
+  %1 = "onnx.Slice"(%arg0, %starts, %ends, %axes, %steps) : (tensor<16x32xf32>, tensor<1xi64>, tensor<1xi64>, tensor<1xi64>, none) -> tensor<*xf32>
+  "std.return"(%1) : (tensor<*xf32>) -> ()
+
+// CHECK-LABEL:  func @test_slice_contiguous_prefix_argument
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<16x32xf32>) -> memref<8x32xf32> {
+// CHECK:           [[RES_:%.+]] = memref.alloc() {{.*}}: memref<8x32xf32>
+// CHECK:           "krnl.memcpy"([[RES_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<8x32xf32>, memref<16x32xf32>, i64, index, index) -> ()
+// CHECK-NOT:       memref.reinterpret_cast
+// CHECK:           return [[RES_]] : memref<8x32xf32>
+// CHECK:         }
+}
+
+// -----
+
+// Slice of whole rows: each run of 8x64 contiguous elements is copied with a memcpy.
+func @test_slice_contiguous_rows(%arg0 : tensor<4x16x64xf32>) -> tensor<*xf32> {
+  %axes = "onnx.Constant"() {value = dense<[1]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %starts = "onnx.Constant"() {value = dense<[4]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %ends = "onnx.Constant"() {value = dense<[12]> : tensor<1xi64> } : () -> tensor<1xi64>
+  %steps = constant unit
+  %1 = "onnx.Slice"(%arg0, %starts, %ends, %axes, %steps) : (tensor<4x16x64xf32>, tensor<1xi64>, tensor<1xi64>, tensor<1xi64>, none) -> tensor<*xf32>
+  "std.return"(%1) : (tensor<*xf32>) -> ()
+
+// CHECK-DAG:   [[MAP_DEST_:#.+]] = affine_map<(d0) -> (d0 * 512)>
+// CHECK-DAG:   [[MAP_SRC_:#.+]] = affine_map<(d0) -> (d0 * 1024 + 256)>
+// CHECK-LABEL:  func @test_slice_contiguous_rows
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<4x16x64xf32>) -> memref<4x8x64xf32> {
+// CHECK-DAG:       [[CST_2048_:%.+]] = arith.constant 2048 : i64
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<4x8x64xf32>
+// CHECK-DAG:       [[LOOP_0_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_0_]]) with ([[LOOP_0_]] -> [[I_0_:%.+]] = 0 to 4) {
+// CHECK-DAG:         [[VAR_DEST_:%.+]] = affine.apply [[MAP_DEST_]]([[I_0_]])
+// CHECK-DAG:         [[VAR_SRC_:%.+]] = affine.apply [[MAP_SRC_]]([[I_0_]])
+// CHECK:             "krnl.memcpy"([[RES_]], [[PARAM_0_]], [[CST_2048_]], [[VAR_DEST_]], [[VAR_SRC_]]) : (memref<4x8x64xf32>, memref<4x16x64xf32>, i64, index, index) -> ()
+// CHECK:           }
+// CHECK:           return [[RES_]] : memref<4x8x64xf32>
+// CHECK:         }
+}
+
+// -----
+
 func @test_slice_all_constant(%arg0 : tensor<2x4xf32>) -> tensor<*xf32> {
   %axes = "onnx.Constant"() {value = dense<[0, 1]> : tensor<2xi64> } : () -> tensor<2xi64>
   %starts = "onnx.Constant"() {value = dense<[1, 0]> : tensor<2xi64> } : () -> tensor<2xi64>
@@ -396,6 +466,29 @@ func @test_tile2(%arg0 : tensor<8xf32>, %arg1 : tensor<1xi64>) -> tensor<*xf32>
 
 // -----
 
+// Test tile with a trailing repeat of 1: each repetition of the input is copied with a memcpy.
+func @test_tile_contiguous_rows(%arg0 : tensor<4x32xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Constant"() { value = dense<[3, 1]> : tensor<2xi64>} : () -> tensor<2xi64>
+  %1 = "onnx.Tile"(%arg0, %0) : (tensor<4x32xf32>, tensor<2xi64>) -> tensor<*xf32>
+  return %1 : tensor<*xf32>
+
+// CHECK-DAG:   [[MAP_DEST_:#.+]] = affine_map<(d0) -> (d0 * 128)>
+// CHECK-LABEL:  func @test_tile_contiguous_rows
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<4x32xf32>) -> memref<12x32xf32> {
+// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0 : index
+// CHECK-DAG:       [[CST_512_:%.+]] = arith.constant 512 : i64
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<12x32xf32>
+// CHECK-DAG:       [[LOOP_0_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_0_]]) with ([[LOOP_0_]] -> [[I_0_:%.+]] = 0 to 3) {
+// CHECK:             [[VAR_DEST_:%.+]] = affine.apply [[MAP_DEST_]]([[I_0_]])
+// CHECK:             "krnl.memcpy"([[RES_]], [[PARAM_0_]], [[CST_512_]], [[VAR_DEST_]], [[CST_0_]]) : (memref<12x32xf32>, memref<4x32xf32>, i64, index, index) -> ()
+// CHECK:           }
+// CHECK:           return [[RES_]] : memref<12x32xf32>
+// CHECK:         }
+}
+
+// -----
+
 // Test gather along axis 0, first example in ONNX for Gather. Positive indices, so no select.
 func @test_gather_axis0(%arg0 : tensor<3x2xf32>) -> tensor<2x2x2xf32> {
   %indices = "onnx.Constant"() {value = dense<[[0, 1], [1, 2]]> : tensor<2x2xi64>} : () -> tensor<2x2xi64>
@@ -470,6 +563,36 @@ func @test_gather_axis1(%arg0 : tensor<3x3xf32>) -> tensor<3x1x2xf32> {
 
 // -----
 
+// Test gather of embedding vectors: each row of the data is copied with a memcpy.
+func @test_gather_embedding(%arg0 : tensor<1000x64xf32>, %arg1 : tensor<2x8xi64>) -> tensor<2x8x64xf32> {
+  %0 = "onnx.Gather"(%arg0, %arg1) {axis = 0 : si64} : (tensor<1000x64xf32>, tensor<2x8xi64>) -> tensor<2x8x64xf32>
+  "std.return"(%0) : (tensor<2x8x64xf32>) -> ()
+
+// CHECK-DAG:   [[MAP_DEST_:#.+]] = affine_map<(d0, d1) -> (d0 * 512 + d1 * 64)>
+// CHECK-LABEL:  func @test_gather_embedding
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<1000x64xf32>, [[PARAM_1_:%.+]]: memref<2x8xi64>) -> memref<2x8x64xf32> {
+// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0 : index
+// CHECK-DAG:       [[CST_1000_:%.+]] = arith.constant 1000 : index
+// CHECK-DAG:       [[CST_64_:%.+]] = arith.constant 64 : index
+// CHECK-DAG:       [[CST_256_:%.+]] = arith.constant 256 : i64
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<2x8x64xf32>
+// CHECK-DAG:       [[LOOP_0_:%.+]]:2 = krnl.define_loops 2
+// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to 2, [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to 8) {
+// CHECK:             [[LOAD_PARAM_1_MEM_:%.+]] = krnl.load [[PARAM_1_]]{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<2x8xi64>
+// CHECK:             [[VAR_INDEX_:%.+]] = arith.index_cast [[LOAD_PARAM_1_MEM_]] : i64 to index
+// CHECK-DAG:         [[VAR_NEG_:%.+]] = arith.cmpi slt, [[VAR_INDEX_]], [[CST_0_]] : index
+// CHECK-DAG:         [[VAR_WRAP_:%.+]] = arith.addi [[VAR_INDEX_]], [[CST_1000_]] : index
+// CHECK:             [[VAR_ROW_:%.+]] = select [[VAR_NEG_]], [[VAR_WRAP_]], [[VAR_INDEX_]] : index
+// CHECK-DAG:         [[VAR_DEST_:%.+]] = affine.apply [[MAP_DEST_]]([[I_0_]], [[I_1_]])
+// CHECK-DAG:         [[VAR_SRC_:%.+]] = arith.muli [[VAR_ROW_]], [[CST_64_]] : index
+// CHECK:             "krnl.memcpy"([[RES_]], [[PARAM_0_]], [[CST_256_]], [[VAR_DEST_]], [[VAR_SRC_]]) : (memref<2x8x64xf32>, memref<1000x64xf32>, i64, index, index) -> ()
+// CHECK:           }
+// CHECK:           return [[RES_]] : memref<2x8x64xf32>
+// CHECK:         }
+}
+
+// -----
+
 // COM: test split with unknown dimensions and explicit split.
 func @test_split_unknown_dimension(%arg0 : tensor<?x?x64xf32>) -> (tensor<*xf32>, tensor<*xf32>) {
   %split = "onnx.Constant"() {value = dense<[2, 30]> : tensor<2xi64>} : () -> tensor<2xi64>
@@ -478,22 +601,15 @@ func @test_split_unknown_dimension(%arg0 : tensor<?x?x64xf32>) -> (tensor<*xf32>
 
 // CHECK-LABEL:  func @test_split_unknown_dimension
 // CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<?x?x64xf32>) -> (memref<?x2x64xf32>, memref<?x30x64xf32>) {
-// CHECK:           [[CST_0_:%.+]] = arith.constant 0 : index
-// CHECK-DAG:       [[DIM_0_:%.+]] = memref.dim [[PARAM_0_]], [[CST_0_]] : memref<?x?x64xf32>
-// CHECK-DAG:       [[DIM_1_:%.+]] = memref.dim [[PARAM_0_]], [[CST_0_]] : memref<?x?x64xf32>
-// CHECK-NOT: separator of consecutive DAGs
-// CHECK-DAG:       [[RES_:%.+]] = memref.alloc([[DIM_0_]]) {{.*}} : memref<?x2x64xf32>
-// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc([[DIM_1_]]) {{.*}} : memref<?x30x64xf32>
-// CHECK-DAG:       [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
-// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1, [[LOOP_0_]]#2) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to [[DIM_0_]], [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to 2, [[LOOP_0_]]#2 -> [[I_2_:%.+]] = 0 to 64) {
-// CHECK:             [[LOAD_PARAM_0_MEM_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<?x?x64xf32>
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_]], [[RES_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<?x2x64xf32>
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc({{.*}}) {{.*}} : memref<?x2x64xf32>
+// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc({{.*}}) {{.*}} : memref<?x30x64xf32>
+// CHECK:           [[LOOP_0_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_0_]]) with ([[LOOP_0_]] -> [[I_0_:%.+]] = 0 to {{.*}}) {
+// CHECK:             "krnl.memcpy"([[RES_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<?x2x64xf32>, memref<?x?x64xf32>, i64, index, index) -> ()
 // CHECK:           }
-// CHECK:           [[LOOP_1_:%.+]]:3 = krnl.define_loops 3
-// CHECK:           krnl.iterate([[LOOP_1_]]#0, [[LOOP_1_]]#1, [[LOOP_1_]]#2) with ([[LOOP_1_]]#0 -> [[I_3_:%.+]] = 0 to [[DIM_1_]], [[LOOP_1_]]#1 -> [[I_4_:%.+]] = 0 to 30, [[LOOP_1_]]#2 -> [[I_5_:%.+]] = 0 to 64) {
-// CHECK:             [[LOAD_PARAM_0_MEM_1_:%.+]] = affine.apply #map([[I_4_]])
-// CHECK:             [[LOAD_PARAM_0_MEM_2_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_3_]], [[LOAD_PARAM_0_MEM_1_]], [[I_5_]]{{.}} : memref<?x?x64xf32>
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_2_]], [[RES_1_]]{{.}}[[I_3_]], [[I_4_]], [[I_5_]]{{.}} : memref<?x30x64xf32>
+// CHECK:           [[LOOP_1_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_1_]]) with ([[LOOP_1_]] -> [[I_1_:%.+]] = 0 to {{.*}}) {
+// CHECK:             "krnl.memcpy"([[RES_1_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<?x30x64xf32>, memref<?x?x64xf32>, i64, index, index) -> ()
 // CHECK:           }
 // CHECK:           return [[RES_]], [[RES_1_]] : memref<?x2x64xf32>, memref<?x30x64xf32>
 // CHECK:         }
@@ -509,27 +625,15 @@ func @test_split_unknown_dimension_equal_split(%arg0 : tensor<?x?x64xf32>) -> (t
 
 // CHECK-LABEL:  func @test_split_unknown_dimension_equal_split
 // CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<?x?x64xf32>) -> (memref<?x?x64xf32>, memref<?x?x64xf32>) {
-// CHECK-DAG:       [[CST_1_:%.+]] = arith.constant 1 : index
-// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0 : index
-// CHECK-NOT: separator of consecutive DAGs
-// CHECK:           [[DIM_0_:%.+]] = memref.dim [[PARAM_0_]], [[CST_1_]] : memref<?x?x64xf32>
-// CHECK-DAG:       [[VAR_3_:%.+]] = affine.apply #map0(){{.}}[[DIM_0_]]{{.}}
-// CHECK-DAG:       [[VAR_5_:%.+]] = affine.apply #map0(){{.}}[[DIM_0_]]{{.}}
-// CHECK-DAG:       [[DIM_1_:%.+]] = memref.dim [[PARAM_0_]], [[CST_0_]] : memref<?x?x64xf32>
-// CHECK-DAG:       [[DIM_2_:%.+]] = memref.dim [[PARAM_0_]], [[CST_0_]] : memref<?x?x64xf32>
-// CHECK-NOT: separator of consecutive DAGs
-// CHECK-DAG:       [[RES_:%.+]] = memref.alloc([[DIM_1_]], [[VAR_3_]]) {{.*}} : memref<?x?x64xf32>
-// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc([[DIM_2_]], [[VAR_5_]]) {{.*}} : memref<?x?x64xf32>
-// CHECK-DAG:       [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
-// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1, [[LOOP_0_]]#2) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to [[DIM_1_]], [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to [[VAR_3_]], [[LOOP_0_]]#2 -> [[I_2_:%.+]] = 0 to 64) {
-// CHECK:             [[LOAD_PARAM_0_MEM_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<?x?x64xf32>
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_]], [[RES_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<?x?x64xf32>
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc({{.*}}) {{.*}} : memref<?x?x64xf32>
+// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc({{.*}}) {{.*}} : memref<?x?x64xf32>
+// CHECK:           [[LOOP_0_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_0_]]) with ([[LOOP_0_]] -> [[I_0_:%.+]] = 0 to {{.*}}) {
+// CHECK:             "krnl.memcpy"([[RES_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<?x?x64xf32>, memref<?x?x64xf32>, i64, index, index) -> ()
 // CHECK:           }
-// CHECK:           [[LOOP_1_:%.+]]:3 = krnl.define_loops 3
-// CHECK:           krnl.iterate([[LOOP_1_]]#0, [[LOOP_1_]]#1, [[LOOP_1_]]#2) with ([[LOOP_1_]]#0 -> [[I_3_:%.+]] = 0 to [[DIM_2_]], [[LOOP_1_]]#1 -> [[I_4_:%.+]] = 0 to [[VAR_5_]], [[LOOP_1_]]#2 -> [[I_5_:%.+]] = 0 to 64) {
-// CHECK:             [[LOAD_PARAM_0_MEM_1_:%.+]] = affine.apply #map1([[I_4_]]){{.}}[[DIM_0_]]{{.}}
-// CHECK:             [[LOAD_PARAM_0_MEM_2_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_3_]], [[LOAD_PARAM_0_MEM_1_]], [[I_5_]]{{.}} : memref<?x?x64xf32>
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_2_]], [[RES_1_]]{{.}}[[I_3_]], [[I_4_]], [[I_5_]]{{.}} : memref<?x?x64xf32>
+// CHECK:           [[LOOP_1_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_1_]]) with ([[LOOP_1_]] -> [[I_1_:%.+]] = 0 to {{.*}}) {
+// CHECK:             "krnl.memcpy"([[RES_1_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<?x?x64xf32>, memref<?x?x64xf32>, i64, index, index) -> ()
 // CHECK:           }
 // CHECK:           return [[RES_]], [[RES_1_]] : memref<?x?x64xf32>, memref<?x?x64xf32>
 // CHECK:         }
@@ -544,22 +648,15 @@ func @test_splitv11_unknown_dimension(%arg0 : tensor<?x?x64xf32>) -> (tensor<*xf
 
 // CHECK-LABEL:  func @test_splitv11_unknown_dimension
 // CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<?x?x64xf32>) -> (memref<?x2x64xf32>, memref<?x30x64xf32>) {
-// CHECK:           [[CST_0_:%.+]] = arith.constant 0 : index
-// CHECK-DAG:       [[DIM_0_:%.+]] = memref.dim [[PARAM_0_]], [[CST_0_]] : memref<?x?x64xf32>
-// CHECK-DAG:       [[DIM_1_:%.+]] = memref.dim [[PARAM_0_]], [[CST_0_]] : memref<?x?x64xf32>
-// CHECK-NOT: separator of consecutive DAGs
-// CHECK-DAG:       [[RES_:%.+]] = memref.alloc([[DIM_0_]]) {{.*}} : memref<?x2x64xf32>
-// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc([[DIM_1_]]) {{.*}} : memref<?x30x64xf32>
-// CHECK-DAG:       [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
-// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1, [[LOOP_0_]]#2) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to [[DIM_0_]], [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to 2, [[LOOP_0_]]#2 -> [[I_2_:%.+]] = 0 to 64) {
-// CHECK:             [[LOAD_PARAM_0_MEM_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<?x?x64xf32>
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_]], [[RES_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<?x2x64xf32>
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc({{.*}}) {{.*}} : memref<?x2x64xf32>
+// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc({{.*}}) {{.*}} : memref<?x30x64xf32>
+// CHECK:           [[LOOP_0_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_0_]]) with ([[LOOP_0_]] -> [[I_0_:%.+]] = 0 to {{.*}}) {
+// CHECK:             "krnl.memcpy"([[RES_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<?x2x64xf32>, memref<?x?x64xf32>, i64, index, index) -> ()
 // CHECK:           }
-// CHECK:           [[LOOP_1_:%.+]]:3 = krnl.define_loops 3
-// CHECK:           krnl.iterate([[LOOP_1_]]#0, [[LOOP_1_]]#1, [[LOOP_1_]]#2) with ([[LOOP_1_]]#0 -> [[I_3_:%.+]] = 0 to [[DIM_1_]], [[LOOP_1_]]#1 -> [[I_4_:%.+]] = 0 to 30, [[LOOP_1_]]#2 -> [[I_5_:%.+]] = 0 to 64) {
-// CHECK:             [[LOAD_PARAM_0_MEM_1_:%.+]] = affine.apply #map([[I_4_]])
-// CHECK:             [[LOAD_PARAM_0_MEM_2_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_3_]], [[LOAD_PARAM_0_MEM_1_]], [[I_5_]]{{.}} : memref<?x?x64xf32>
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_2_]], [[RES_1_]]{{.}}[[I_3_]], [[I_4_]], [[I_5_]]{{.}} : memref<?x30x64xf32>
+// CHECK:           [[LOOP_1_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_1_]]) with ([[LOOP_1_]] -> [[I_1_:%.+]] = 0 to {{.*}}) {
+// CHECK:             "krnl.memcpy"([[RES_1_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<?x30x64xf32>, memref<?x?x64xf32>, i64, index, index) -> ()
 // CHECK:           }
 // CHECK:           return [[RES_]], [[RES_1_]] : memref<?x2x64xf32>, memref<?x30x64xf32>
 // CHECK:         }
@@ -574,27 +671,15 @@ func @test_splitv11_unknown_dimension_equal_split(%arg0 : tensor<?x?x64xf32>) ->
 
 // CHECK-LABEL:  func @test_splitv11_unknown_dimension_equal_split
 // CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<?x?x64xf32>) -> (memref<?x?x64xf32>, memref<?x?x64xf32>) {
-// CHECK-DAG:       [[CST_1_:%.+]] = arith.constant 1 : index
-// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0 : index
-// CHECK-NOT: separator of consecutive DAGs
-// CHECK:           [[DIM_0_:%.+]] = memref.dim [[PARAM_0_]], [[CST_1_]] : memref<?x?x64xf32>
-// CHECK-DAG:       [[VAR_3_:%.+]] = affine.apply #map0(){{.}}[[DIM_0_]]{{.}}
-// CHECK-DAG:       [[VAR_5_:%.+]] = affine.apply #map0(){{.}}[[DIM_0_]]{{.}}
-// CHECK-DAG:       [[DIM_1_:%.+]] = memref.dim [[PARAM_0_]], [[CST_0_]] : memref<?x?x64xf32>
-// CHECK-DAG:       [[DIM_2_:%.+]] = memref.dim [[PARAM_0_]], [[CST_0_]] : memref<?x?x64xf32>
-// CHECK-NOT: separator of consecutive DAGs
-// CHECK-DAG:       [[RES_:%.+]] = memref.alloc([[DIM_1_]], [[VAR_3_]]) {{.*}} : memref<?x?x64xf32>
-// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc([[DIM_2_]], [[VAR_5_]]) {{.*}} : memref<?x?x64xf32>
-// CHECK-DAG:       [[LOOP_0_:%.+]]:3 = krnl.define_loops 3
-// CHECK:           krnl.iterate([[LOOP_0_]]#0, [[LOOP_0_]]#1, [[LOOP_0_]]#2) with ([[LOOP_0_]]#0 -> [[I_0_:%.+]] = 0 to [[DIM_1_]], [[LOOP_0_]]#1 -> [[I_1_:%.+]] = 0 to [[VAR_3_]], [[LOOP_0_]]#2 -> [[I_2_:%.+]] = 0 to 64) {
-// CHECK:             [[LOAD_PARAM_0_MEM_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<?x?x64xf32>
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_]], [[RES_]]{{.}}[[I_0_]], [[I_1_]], [[I_2_]]{{.}} : memref<?x?x64xf32>
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc({{.*}}) {{.*}} : memref<?x?x64xf32>
+// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc({{.*}}) {{.*}} : memref<?x?x64xf32>
+// CHECK:           [[LOOP_0_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_0_]]) with ([[LOOP_0_]] -> [[I_0_:%.+]] = 0 to {{.*}}) {
+// CHECK:             "krnl.memcpy"([[RES_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<?x?x64xf32>, memref<?x?x64xf32>, i64, index, index) -> ()
 // CHECK:           }
-// CHECK:           [[LOOP_1_:%.+]]:3 = krnl.define_loops 3
-// CHECK:           krnl.iterate([[LOOP_1_]]#0, [[LOOP_1_]]#1, [[LOOP_1_]]#2) with ([[LOOP_1_]]#0 -> [[I_3_:%.+]] = 0 to [[DIM_2_]], [[LOOP_1_]]#1 -> [[I_4_:%.+]] = 0 to [[VAR_5_]], [[LOOP_1_]]#2 -> [[I_5_:%.+]] = 0 to 64) {
-// CHECK:             [[LOAD_PARAM_0_MEM_1_:%.+]] = affine.apply #map1([[I_4_]]){{.}}[[DIM_0_]]{{.}}
-// CHECK:             [[LOAD_PARAM_0_MEM_2_:%.+]] = krnl.load [[PARAM_0_]]{{.}}[[I_3_]], [[LOAD_PARAM_0_MEM_1_]], [[I_5_]]{{.}} : memref<?x?x64xf32>
-// CHECK:             krnl.store [[LOAD_PARAM_0_MEM_2_]], [[RES_1_]]{{.}}[[I_3_]], [[I_4_]], [[I_5_]]{{.}} : memref<?x?x64xf32>
+// CHECK:           [[LOOP_1_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_1_]]) with ([[LOOP_1_]] -> [[I_1_:%.+]] = 0 to {{.*}}) {
+// CHECK:             "krnl.memcpy"([[RES_1_]], [[PARAM_0_]], {{.*}}, {{.*}}, {{.*}}) : (memref<?x?x64xf32>, memref<?x?x64xf32>, i64, index, index) -> ()
 // CHECK:           }
 // CHECK:           return [[RES_]], [[RES_1_]] : memref<?x?x64xf32>, memref<?x?x64xf32>
 // CHECK:         }
@@ -831,22 +916,23 @@ func private @test_concat_1(%arg0 : tensor<5x5x1x32xf32>, %arg1 : tensor<5x5x3x3
 
   // CHECK-LABEL: test_concat_1
   // CHECK: [[RES:%.+]] = memref.alloc() {{.*}}: memref<5x5x9x32xf32>
-  // CHECK: [[DEF_LOOPS0:%.+]]:4 = krnl.define_loops 4
-  // CHECK: krnl.iterate([[DEF_LOOPS0]]#0, [[DEF_LOOPS0]]#1, [[DEF_LOOPS0]]#2, [[DEF_LOOPS0]]#3) with ([[DEF_LOOPS0]]#0 -> %arg3 = 0 to 5, [[DEF_LOOPS0]]#1 -> %arg4 = 0 to 5, [[DEF_LOOPS0]]#2 -> %arg5 = 0 to 1, [[DEF_LOOPS0]]#3 -> %arg6 = 0 to 32) {
-  // CHECK: [[LOAD0:%.+]] = krnl.load %arg0[%arg3, %arg4, %arg5, %arg6] :  memref<5x5x1x32xf32>
-  // CHECK: krnl.store [[LOAD0]], [[RES]][%arg3, %arg4, %arg5, %arg6] : memref<5x5x9x32xf32>
-
-  // CHECK: [[DEF_LOOPS1:%.+]]:4 = krnl.define_loops 4
-  // CHECK: krnl.iterate([[DEF_LOOPS1]]#0, [[DEF_LOOPS1]]#1, [[DEF_LOOPS1]]#2, [[DEF_LOOPS1]]#3) with ([[DEF_LOOPS1]]#0 -> %arg3 = 0 to 5, [[DEF_LOOPS1]]#1 -> %arg4 = 0 to 5, [[DEF_LOOPS1]]#2 -> %arg5 = 0 to 3, [[DEF_LOOPS1]]#3 -> %arg6 = 0 to 32) {
-  // CHECK: [[AFFINE_APPLY1:%.+]] = affine.apply #{{.*}}(%arg5)
-  // CHECK: [[LOAD1:%.+]] = krnl.load %arg1[%arg3, %arg4, %arg5, %arg6] :  memref<5x5x3x32xf32>
-  // CHECK: krnl.store [[LOAD1]], [[RES]][%arg3, %arg4, [[AFFINE_APPLY1]], %arg6] : memref<5x5x9x32xf32>
-
-  // CHECK: [[DEF_LOOPS2:%.+]]:4 = krnl.define_loops 4
-  // CHECK: krnl.iterate([[DEF_LOOPS2]]#0, [[DEF_LOOPS2]]#1, [[DEF_LOOPS2]]#2, [[DEF_LOOPS2]]#3) with ([[DEF_LOOPS2]]#0 -> %arg3 = 0 to 5, [[DEF_LOOPS2]]#1 -> %arg4 = 0 to 5, [[DEF_LOOPS2]]#2 -> %arg5 = 0 to 5, [[DEF_LOOPS2]]#3 -> %arg6 = 0 to 32) {
-  // CHECK: [[AFFINE_APPLY2:%.+]] = affine.apply #{{.*}}(%arg5)
-  // CHECK: [[LOAD2:%.+]] = krnl.load %arg2[%arg3, %arg4, %arg5, %arg6] :  memref<5x5x5x32xf32>
-  // CHECK: krnl.store [[LOAD2]], [[RES]][%arg3, %arg4, [[AFFINE_APPLY2]], %arg6] : memref<5x5x9x32xf32>
+  // CHECK: [[DEF_LOOPS0:%.+]]:2 = krnl.define_loops 2
+  // CHECK: krnl.iterate([[DEF_LOOPS0]]#0, [[DEF_LOOPS0]]#1) with ([[DEF_LOOPS0]]#0 -> %arg3 = 0 to 5, [[DEF_LOOPS0]]#1 -> %arg4 = 0 to 5) {
+  // CHECK-DAG: [[DEST0:%.+]] = affine.apply #{{.*}}(%arg3, %arg4)
+  // CHECK-DAG: [[SRC0:%.+]] = affine.apply #{{.*}}(%arg3, %arg4)
+  // CHECK: "krnl.memcpy"([[RES]], %arg0, {{.*}}, [[DEST0]], [[SRC0]]) : (memref<5x5x9x32xf32>, memref<5x5x1x32xf32>, i64, index, index) -> ()
+
+  // CHECK: [[DEF_LOOPS1:%.+]]:2 = krnl.define_loops 2
+  // CHECK: krnl.iterate([[DEF_LOOPS1]]#0, [[DEF_LOOPS1]]#1) with ([[DEF_LOOPS1]]#0 -> %arg3 = 0 to 5, [[DEF_LOOPS1]]#1 -> %arg4 = 0 to 5) {
+  // CHECK-DAG: [[DEST1:%.+]] = affine.apply #{{.*}}(%arg3, %arg4)
+  // CHECK-DAG: [[SRC1:%.+]] = affine.apply #{{.*}}(%arg3, %arg4)
+  // CHECK: "krnl.memcpy"([[RES]], %arg1, {{.*}}, [[DEST1]], [[SRC1]]) : (memref<5x5x9x32xf32>, memref<5x5x3x32xf32>, i64, index, index) -> ()
+
+  // CHECK: [[DEF_LOOPS2:%.+]]:2 = krnl.define_loops 2
+  // CHECK: krnl.iterate([[DEF_LOOPS2]]#0, [[DEF_LOOPS2]]#1) with ([[DEF_LOOPS2]]#0 -> %arg3 = 0 to 5, [[DEF_LOOPS2]]#1 -> %arg4 = 0 to 5) {
+  // CHECK-DAG: [[DEST2:%.+]] = affine.apply #{{.*}}(%arg3, %arg4)
+  // CHECK-DAG: [[SRC2:%.+]] = affine.apply #{{.*}}(%arg3, %arg4)
+  // CHECK: "krnl.memcpy"([[RES]], %arg2, {{.*}}, [[DEST2]], [[SRC2]]) : (memref<5x5x9x32xf32>, memref<5x5x5x32xf32>, i64, index, index) -> ()
 
   // CHECK: return [[RES]] :  memref<5x5x9x32xf32>
 }
@@ -2168,6 +2254,29 @@ func @test_expand_with_arith.constant(%arg0 : tensor<2x1x6x1xf32>) -> tensor<*xf
 // CHECK:         }
 }
 
+// -----
+
+// Only the leading dimension is broadcast: each row of the input is copied with a memcpy.
+func @test_expand_contiguous_rows(%arg0 : tensor<1x64xf32>) -> tensor<*xf32> {
+  %0 = "onnx.Constant"() {value = dense<[8, 64]> : tensor<2xi64> } : () -> tensor<2xi64>
+  %1 = "onnx.Expand"(%arg0, %0) : (tensor<1x64xf32>, tensor<2xi64>) -> tensor<*xf32>
+  "std.return"(%1) : (tensor<*xf32>) -> ()
+
+// CHECK-DAG:   [[MAP_DEST_:#.+]] = affine_map<(d0) -> (d0 * 64)>
+// CHECK-LABEL:  func @test_expand_contiguous_rows
+// CHECK-SAME:   ([[INPUT_:%.+]]: memref<1x64xf32>) -> memref<8x64xf32> {
+// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0 : index
+// CHECK-DAG:       [[CST_256_:%.+]] = arith.constant 256 : i64
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() {{.*}}: memref<8x64xf32>
+// CHECK-DAG:       [[LOOP_0_:%.+]] = krnl.define_loops 1
+// CHECK:           krnl.iterate([[LOOP_0_]]) with ([[LOOP_0_]] -> [[I_0_:%.+]] = 0 to 8) {
+// CHECK:             [[VAR_DEST_:%.+]] = affine.apply [[MAP_DEST_]]([[I_0_]])
+// CHECK:             "krnl.memcpy"([[RES_]], [[INPUT_]], [[CST_256_]], [[VAR_DEST_]], [[CST_0_]]) : (memref<8x64xf32>, memref<1x64xf32>, i64, index, index) -> ()
+// CHECK:           }
+// CHECK:           return [[RES_]] : memref<8x64xf32>
+// CHECK:         }
+}
+
 // -----
 
   func @expand_dyn(%arg0: tensor<?x?xf32>, %arg1: tensor<2xi64>) -> tensor<?x?xf32>  {
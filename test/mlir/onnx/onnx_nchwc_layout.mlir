@@ -0,0 +1,63 @@
+// RUN: onnx-mlir-opt --convert-onnx-to-nchwc='block-size=8' %s -split-input-file | FileCheck %s
+
+// -----
+
+// The layout is converted once before the first conv, and once after the
+// pool, and propagated through the relu and the per channel add.
+func @test_conv_relu_add_pool(%arg0 : tensor<1x16x8x8xf32>, %arg1 : tensor<16x16x3x3xf32>, %arg2 : tensor<16xf32>, %arg3 : tensor<16x16x1x1xf32>) -> tensor<1x16x4x4xf32> {
+  %cst = constant unit
+  %0 = "onnx.Conv"(%arg0, %arg1, %arg2) {kernel_shape = [3, 3], pads = [1, 1, 1, 1]} : (tensor<1x16x8x8xf32>, tensor<16x16x3x3xf32>, tensor<16xf32>) -> tensor<1x16x8x8xf32>
+  %1 = "onnx.Relu"(%0) : (tensor<1x16x8x8xf32>) -> tensor<1x16x8x8xf32>
+  %2 = "onnx.Constant"() {value = dense<1.0> : tensor<16x1x1xf32>} : () -> tensor<16x1x1xf32>
+  %3 = "onnx.Add"(%1, %2) : (tensor<1x16x8x8xf32>, tensor<16x1x1xf32>) -> tensor<1x16x8x8xf32>
+  %4 = "onnx.Conv"(%3, %arg3, %cst) {} : (tensor<1x16x8x8xf32>, tensor<16x16x1x1xf32>, none) -> tensor<1x16x8x8xf32>
+  %5 = "onnx.MaxPoolSingleOut"(%4) {kernel_shape = [2, 2], strides = [2, 2]} : (tensor<1x16x8x8xf32>) -> tensor<1x16x4x4xf32>
+  return %5 : tensor<1x16x4x4xf32>
+
+  // CHECK-LABEL: test_conv_relu_add_pool
+  // CHECK:       [[X:%.+]] = "onnx.LayoutTransform"(%arg0) {target_layout = "NCHW8c"} : (tensor<1x16x8x8xf32>) -> tensor<1x2x8x8x8xf32>
+  // CHECK:       [[CONV1:%.+]] = "onnx.ConvNCHWc"([[X]], %arg1, %arg2) {dilations = [1, 1], kernel_shape = [3, 3], pads = [1, 1, 1, 1], strides = [1, 1]} : (tensor<1x2x8x8x8xf32>, tensor<16x16x3x3xf32>, tensor<16xf32>) -> tensor<1x2x8x8x8xf32>
+  // CHECK:       [[RELU:%.+]] = "onnx.Relu"([[CONV1]]) : (tensor<1x2x8x8x8xf32>) -> tensor<1x2x8x8x8xf32>
+  // CHECK-DAG:   [[SHAPE:%.+]] = "onnx.Constant"() {value = dense<[1, 16, 1, 1]> : tensor<4xi64>} : () -> tensor<4xi64>
+  // CHECK:       [[RESHAPE:%.+]] = "onnx.Reshape"({{.*}}, [[SHAPE]]) : (tensor<16x1x1xf32>, tensor<4xi64>) -> tensor<1x16x1x1xf32>
+  // CHECK:       [[BIAS:%.+]] = "onnx.LayoutTransform"([[RESHAPE]]) {target_layout = "NCHW8c"} : (tensor<1x16x1x1xf32>) -> tensor<1x2x1x1x8xf32>
+  // CHECK:       [[ADD:%.+]] = "onnx.Add"([[RELU]], [[BIAS]]) : (tensor<1x2x8x8x8xf32>, tensor<1x2x1x1x8xf32>) -> tensor<1x2x8x8x8xf32>
+  // CHECK:       [[CONV2:%.+]] = "onnx.ConvNCHWc"([[ADD]], %arg3, {{.*}}) {dilations = [1, 1], kernel_shape = [1, 1], pads = [0, 0, 0, 0], strides = [1, 1]} : (tensor<1x2x8x8x8xf32>, tensor<16x16x1x1xf32>, none) -> tensor<1x2x8x8x8xf32>
+  // CHECK:       [[POOL:%.+]] = "onnx.PoolNCHWc"([[CONV2]]) {count_include_pad = 0 : si64, kernel_shape = [2, 2], mode = "max", pads = [0, 0, 0, 0], strides = [2, 2]} : (tensor<1x2x8x8x8xf32>) -> tensor<1x2x4x4x8xf32>
+  // CHECK:       [[RES:%.+]] = "onnx.LayoutTransform"([[POOL]]) {target_layout = "NCHW"} : (tensor<1x2x4x4x8xf32>) -> tensor<1x16x4x4xf32>
+  // CHECK:       return [[RES]] : tensor<1x16x4x4xf32>
+}
+
+// -----
+
+// A conv whose input channels are not a multiple of the block size stays in
+// NCHW, and so does the relu that follows it.
+func @test_conv_rgb_input(%arg0 : tensor<1x3x8x8xf32>, %arg1 : tensor<16x3x3x3xf32>) -> tensor<1x16x6x6xf32> {
+  %cst = constant unit
+  %0 = "onnx.Conv"(%arg0, %arg1, %cst) {kernel_shape = [3, 3]} : (tensor<1x3x8x8xf32>, tensor<16x3x3x3xf32>, none) -> tensor<1x16x6x6xf32>
+  %1 = "onnx.Relu"(%0) : (tensor<1x16x6x6xf32>) -> tensor<1x16x6x6xf32>
+  return %1 : tensor<1x16x6x6xf32>
+
+  // CHECK-LABEL: test_conv_rgb_input
+  // CHECK-NOT:   onnx.LayoutTransform
+  // CHECK:       "onnx.Conv"
+  // CHECK:       "onnx.Relu"
+  // CHECK-NOT:   onnx.LayoutTransform
+}
+
+// -----
+
+// A global average pool on a blocked tensor becomes an average PoolNCHWc with
+// the whole image as its kernel.
+func @test_conv_global_average_pool(%arg0 : tensor<1x8x4x4xf32>, %arg1 : tensor<8x8x1x1xf32>) -> tensor<1x8x1x1xf32> {
+  %cst = constant unit
+  %0 = "onnx.Conv"(%arg0, %arg1, %cst) {} : (tensor<1x8x4x4xf32>, tensor<8x8x1x1xf32>, none) -> tensor<1x8x4x4xf32>
+  %1 = "onnx.GlobalAveragePool"(%0) : (tensor<1x8x4x4xf32>) -> tensor<1x8x1x1xf32>
+  return %1 : tensor<1x8x1x1xf32>
+
+  // CHECK-LABEL: test_conv_global_average_pool
+  // CHECK:       [[CONV:%.+]] = "onnx.ConvNCHWc"
+  // CHECK:       [[POOL:%.+]] = "onnx.PoolNCHWc"([[CONV]]) {count_include_pad = 0 : si64, kernel_shape = [4, 4], mode = "avg", pads = [0, 0, 0, 0], strides = [1, 1]} : (tensor<1x1x4x4x8xf32>) -> tensor<1x1x1x1x8xf32>
+  // CHECK:       [[RES:%.+]] = "onnx.LayoutTransform"([[POOL]]) {target_layout = "NCHW"} : (tensor<1x1x1x1x8xf32>) -> tensor<1x8x1x1xf32>
+  // CHECK:       return [[RES]] : tensor<1x8x1x1xf32>
+}
@@ -406,6 +406,56 @@ func @test_conv_transpose_2(%arg0 : tensor<1x64x36x48xf32>, %arg1 : tensor<64x1x
   // CHECK: return [[RES_ATTR]] : tensor<1x64x72x96xf32>
 }
 
+/// An output_shape over the spatial dimensions defines the pads, or the output
+/// padding when it is larger than the natural output.
+func @test_conv_transpose_output_shape(%arg0 : tensor<1x1x3x3xf32>, %arg1 : tensor<1x2x3x3xf32>) -> tensor<*xf32> {
+  %cst = constant unit
+  %0 = "onnx.ConvTranspose"(%arg0, %arg1, %cst) {output_shape = [10, 8], strides = [3, 2]} : (tensor<1x1x3x3xf32>, tensor<1x2x3x3xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_conv_transpose_output_shape
+  // CHECK: [[RES_ATTR:%.+]] = "onnx.ConvTranspose"(%arg0, %arg1, %cst) {auto_pad = "NOTSET", dilations = [1, 1], group = 1 : si64, kernel_shape = [3, 3], output_padding = [1, 1], output_shape = [1, 2, 10, 8], pads = [0, 0, 0, 0], strides = [3, 2]} : (tensor<1x1x3x3xf32>, tensor<1x2x3x3xf32>, none) -> tensor<1x2x10x8xf32>
+  // CHECK: return [[RES_ATTR]] : tensor<1x2x10x8xf32>
+}
+
+func @test_conv_transpose_output_shape_pads(%arg0 : tensor<1x1x3x3xf32>, %arg1 : tensor<1x2x3x3xf32>) -> tensor<*xf32> {
+  %cst = constant unit
+  %0 = "onnx.ConvTranspose"(%arg0, %arg1, %cst) {output_shape = [8, 6], strides = [3, 2]} : (tensor<1x1x3x3xf32>, tensor<1x2x3x3xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_conv_transpose_output_shape_pads
+  // CHECK: [[RES_ATTR:%.+]] = "onnx.ConvTranspose"(%arg0, %arg1, %cst) {auto_pad = "NOTSET", dilations = [1, 1], group = 1 : si64, kernel_shape = [3, 3], output_padding = [0, 0], output_shape = [1, 2, 8, 6], pads = [1, 1, 0, 0], strides = [3, 2]} : (tensor<1x1x3x3xf32>, tensor<1x2x3x3xf32>, none) -> tensor<1x2x8x6xf32>
+  // CHECK: return [[RES_ATTR]] : tensor<1x2x8x6xf32>
+}
+
+// -----
+
+//===----------------------------------------------------------------------===//
+/// Test the LayerNormalization shape inference.
+//===----------------------------------------------------------------------===//
+
+func @test_layer_normalization(%arg0 : tensor<2x?x8xf32>, %arg1 : tensor<8xf32>) -> (tensor<*xf32>, tensor<*xf32>, tensor<*xf32>) {
+  %cst = constant unit
+  %Y, %Mean, %InvStdDev = "onnx.LayerNormalization"(%arg0, %arg1, %cst) {axis = -2 : si64} : (tensor<2x?x8xf32>, tensor<8xf32>, none) -> (tensor<*xf32>, tensor<*xf32>, tensor<*xf32>)
+  "std.return"(%Y, %Mean, %InvStdDev) : (tensor<*xf32>, tensor<*xf32>, tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_layer_normalization
+  // CHECK: [[RES:%.+]]:3 = "onnx.LayerNormalization"(%arg0, %arg1, %cst) {axis = 1 : si64} : (tensor<2x?x8xf32>, tensor<8xf32>, none) -> (tensor<2x?x8xf32>, tensor<2x1x1xf32>, tensor<2x1x1xf32>)
+  // CHECK: return [[RES]]#0, [[RES]]#1, [[RES]]#2 : tensor<2x?x8xf32>, tensor<2x1x1xf32>, tensor<2x1x1xf32>
+}
+
+// -----
+
+func @test_scaled_dot_product_attention(%arg0 : tensor<2x?x16x8xf32>, %arg1 : tensor<2x?x32x8xf32>, %arg2 : tensor<2x?x32x4xf32>) -> tensor<*xf32> {
+  %cst = constant unit
+  %0 = "onnx.ScaledDotProductAttention"(%arg0, %arg1, %arg2, %cst) {scale = 5.000000e-01 : f32} : (tensor<2x?x16x8xf32>, tensor<2x?x32x8xf32>, tensor<2x?x32x4xf32>, none) -> tensor<*xf32>
+  "std.return"(%0) : (tensor<*xf32>) -> ()
+
+  // CHECK-LABEL: test_scaled_dot_product_attention
+  // CHECK: [[RES:%.+]] = "onnx.ScaledDotProductAttention"(%arg0, %arg1, %arg2, %cst) {scale = 5.000000e-01 : f32} : (tensor<2x?x16x8xf32>, tensor<2x?x32x8xf32>, tensor<2x?x32x4xf32>, none) -> tensor<2x?x16x4xf32>
+  // CHECK: return [[RES]] : tensor<2x?x16x4xf32>
+}
+
 // -----
 //===----------------------------------------------------------------------===//
 
@@ -0,0 +1,279 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//====--------------------- ModelBuilder.hpp ------------------------------===//
+//
+// This file defines builders for the single-op models that are compiled by
+// the numerical tests and by the op benchmarks.
+//
+//====---------------------------------------------------------------------===//
+
+/// Create an empty main_graph function with the given signature, and set the
+/// insertion point of builder to the start of its body.
+FuncOp createMainGraph(MLIRContext &ctx, OpBuilder &builder,
+    ArrayRef<Type> inputsType, ArrayRef<Type> outputsType) {
+  auto funcType = builder.getFunctionType(inputsType, outputsType);
+  string funcName = "main_graph";
+  llvm::SmallVector<NamedAttribute, 1> attrs;
+  auto funcOp =
+      builder.create<FuncOp>(UnknownLoc::get(&ctx), funcName, funcType, attrs);
+
+  auto entryBlock = funcOp.addEntryBlock();
+  builder.setInsertionPointToStart(entryBlock);
+  return funcOp;
+}
+
+/// Return the results from main_graph and emit the entry point operation which
+/// specifies the number of user inputs and outputs.
+OwningModuleRef finishMainGraph(MLIRContext &ctx, OpBuilder &builder,
+    ModuleOp module, FuncOp funcOp, ArrayRef<Value> results) {
+  builder.create<ReturnOp>(UnknownLoc::get(&ctx), results);
+  module.push_back(funcOp);
+
+  std::string signature("");
+  auto entryPoint = ONNXEntryPointOp::create(UnknownLoc::get(&ctx), funcOp,
+      /*numInputs=*/funcOp.getNumArguments(),
+      /*numOutputs=*/results.size(),
+      /*signature*/ signature);
+  module.push_back(entryPoint);
+  return OwningModuleRef(module);
+}
+
+/// Build a Gemm model: A[IxK] * B[KxJ] + C = Y[IxJ], where A and B are given
+/// transposed when aTrans and bTrans are set, and C has shape [J] or [IxJ]
+/// depending on cRank.
+OwningModuleRef buildGemmModule(MLIRContext &ctx, const int I, const int J,
+    const int K, const int aTrans, const int bTrans, const int cRank,
+    const float alphaVal, const float betaVal) {
+  auto module = ModuleOp::create(UnknownLoc::get(&ctx));
+  OpBuilder builder(&ctx);
+
+  llvm::SmallVector<int64_t, 2> aShape = {I, K};
+  llvm::SmallVector<int64_t, 2> aShapeT = {K, I};
+  llvm::SmallVector<int64_t, 2> bShape = {K, J};
+  llvm::SmallVector<int64_t, 2> bShapeT = {J, K};
+  if (aTrans)
+    aShape = aShapeT;
+  if (bTrans)
+    bShape = bShapeT;
+  llvm::SmallVector<int64_t, 2> cShape = {J};
+  llvm::SmallVector<int64_t, 2> cShape2 = {I, J};
+  if (cRank == 2)
+    cShape = cShape2;
+  else
+    assert(cRank == 1 && "cRank == 1 or 2");
+
+  llvm::SmallVector<int64_t, 2> yShape = {I, J};
+  auto aType = RankedTensorType::get(aShape, builder.getF32Type());
+  auto bType = RankedTensorType::get(bShape, builder.getF32Type());
+  auto cType = RankedTensorType::get(cShape, builder.getF32Type());
+  auto yType = RankedTensorType::get(yShape, builder.getF32Type());
+
+  llvm::SmallVector<Type, 3> inputsType{aType, bType, cType};
+  llvm::SmallVector<Type, 1> outputsType{yType};
+  FuncOp funcOp = createMainGraph(ctx, builder, inputsType, outputsType);
+
+  auto entryBlock = &funcOp.getBody().front();
+  auto aVal = entryBlock->getArgument(0);
+  auto bVal = entryBlock->getArgument(1);
+  auto cVal = entryBlock->getArgument(2);
+
+  FloatAttr alphaAttr = FloatAttr::get(builder.getF32Type(), alphaVal);
+  FloatAttr betaAttr = FloatAttr::get(builder.getF32Type(), betaVal);
+  IntegerAttr aTransAttr =
+      IntegerAttr::get(builder.getIntegerType(64, true), aTrans);
+  IntegerAttr bTransAttr =
+      IntegerAttr::get(builder.getIntegerType(64, true), bTrans);
+  auto gemmOp = builder.create<ONNXGemmOp>(UnknownLoc::get(&ctx),
+      /*Y=*/yType, /*A=*/aVal, /*B=*/bVal, /*C=*/cVal, alphaAttr, betaAttr,
+      aTransAttr, bTransAttr);
+  gemmOp.getResult().setType(yType);
+
+  llvm::SmallVector<Value, 1> results = {gemmOp.getResult()};
+  return finishMainGraph(ctx, builder, module, funcOp, results);
+}
+
+/// Build a 2D MatMul model: A[IxK] * B[KxJ] = Y[IxJ].
+OwningModuleRef buildMatMul2DModule(
+    MLIRContext &ctx, const int I, const int J, const int K) {
+  auto module = ModuleOp::create(UnknownLoc::get(&ctx));
+  OpBuilder builder(&ctx);
+  llvm::SmallVector<int64_t, 4> aShape = {I, K};
+  llvm::SmallVector<int64_t, 1> bShape = {K, J};
+  llvm::SmallVector<int64_t, 4> cShape = {I, J};
+  auto aType = RankedTensorType::get(aShape, builder.getF32Type());
+  auto bType = RankedTensorType::get(bShape, builder.getF32Type());
+  auto yType = RankedTensorType::get(cShape, builder.getF32Type());
+
+  llvm::SmallVector<Type, 2> inputsType{aType, bType};
+  llvm::SmallVector<Type, 1> outputsType{yType};
+  FuncOp funcOp = createMainGraph(ctx, builder, inputsType, outputsType);
+
+  auto entryBlock = &funcOp.getBody().front();
+  auto aVal = entryBlock->getArgument(0);
+  auto bVal = entryBlock->getArgument(1);
+
+  auto MatmulOp = builder.create<ONNXMatMulOp>(UnknownLoc::get(&ctx),
+      /*Y=*/yType, /*A=*/aVal, /*B=*/bVal);
+
+  llvm::SmallVector<Value, 1> results = {MatmulOp.getResult()};
+  return finishMainGraph(ctx, builder, module, funcOp, results);
+}
+
+/// Build a Conv model without bias: X[NxCxHxW] conv W[Cx(C/group)xkHxkW], with
+/// square strides and dilations. When isDynamic is set, all dimensions of X
+/// are unknown at compile time. The output shape, as inferred from the static
+/// shape of X, is returned in outputShape; a null module is returned when
+/// shape inference fails.
+OwningModuleRef buildConvModule(MLIRContext &ctx, const int N, const int C,
+    const int H, const int W, const int kH, const int kW, const int pHBegin,
+    const int pHEnd, const int pWBegin, const int pWEnd, const string &autoPad,
+    const int stride, const int dilation, const int isDynamic,
+    llvm::SmallVectorImpl<int64_t> &outputShape, const int group = 1) {
+  int N1 = N;
+  int C1 = C;
+  int H1 = H;
+  int W1 = W;
+  if (isDynamic)
+    N1 = C1 = H1 = W1 = -1;
+
+  auto module = ModuleOp::create(UnknownLoc::get(&ctx));
+  OpBuilder builder(&ctx);
+  llvm::SmallVector<int64_t, 4> xShape = {N, C, H, W};
+  llvm::SmallVector<int64_t, 3> xShapeSymbol = {N1, C1, H1, W1};
+  llvm::SmallVector<int64_t, 4> wShape = {C, C / group, kH, kW};
+  auto xType = RankedTensorType::get(xShape, builder.getF32Type());
+  auto xTypeSymbol = RankedTensorType::get(xShapeSymbol, builder.getF32Type());
+  auto wType = RankedTensorType::get(wShape, builder.getF32Type());
+  auto yType = UnrankedTensorType::get(builder.getF32Type());
+
+  llvm::SmallVector<Type, 2> inputsType{xTypeSymbol, wType};
+  llvm::SmallVector<Type, 1> outputsType{yType};
+  FuncOp funcOp = createMainGraph(ctx, builder, inputsType, outputsType);
+
+  auto entryBlock = &funcOp.getBody().front();
+  auto xVal = entryBlock->getArgument(0);
+  auto wVal = entryBlock->getArgument(1);
+  auto bVal =
+      builder.create<ConstantOp>(UnknownLoc::get(&ctx), builder.getUnitAttr())
+          .getResult();
+
+  auto dilations = builder.getI64ArrayAttr({dilation, dilation});
+  auto kernel_shape = builder.getI64ArrayAttr({kH, kW});
+  auto pads = builder.getI64ArrayAttr({pHBegin, pWBegin, pHEnd, pWEnd});
+  auto strides = builder.getI64ArrayAttr({stride, stride});
+
+  auto convOp = builder.create<ONNXConvOp>(UnknownLoc::get(&ctx),
+      /*Y=*/yType,
+      /*X=*/xVal, /*W=*/wVal, /*B=*/bVal,
+      /*auto_pad=*/builder.getStringAttr(autoPad),
+      /*dilations=*/dilations,
+      /*group=*/
+      IntegerAttr::get(builder.getIntegerType(64, /*isSigned=*/true),
+          APInt(64, group, /*isSigned=*/true)),
+      /*kernel_shape=*/kernel_shape, /*pads=*/pads,
+      /*strides=*/strides);
+
+  // Use the convOp shape inference method to compute output shape, and unset
+  // the shape so that we don't leave IR in a inconsistent state.
+  convOp.X().setType(xType); // Use static dims to infer shape.
+  LogicalResult res = convOp.inferShapes([](mlir::Region &) {});
+  if (failed(res)) {
+    funcOp.erase();
+    module.erase();
+    return OwningModuleRef();
+  }
+  auto shape = convOp.getResult().getType().cast<ShapedType>().getShape();
+  outputShape.assign(shape.begin(), shape.end());
+  convOp.getResult().setType(yType);
+  convOp.X().setType(xTypeSymbol);
+
+  llvm::SmallVector<Value, 1> results = {convOp.getResult()};
+  return finishMainGraph(ctx, builder, module, funcOp, results);
+}
+
+/// Build a LayerNormalization model of X[NxSxH], normalized over its last
+/// dimension with Scale[H] and B[H], that only returns Y. When isDynamic is
+/// set, N and S are unknown at compile time.
+OwningModuleRef buildLayerNormModule(MLIRContext &ctx, const int N,
+    const int S, const int H, const float epsilon, const int isDynamic) {
+  auto module = ModuleOp::create(UnknownLoc::get(&ctx));
+  OpBuilder builder(&ctx);
+  llvm::SmallVector<int64_t, 3> xShape = {N, S, H};
+  if (isDynamic)
+    xShape = {-1, -1, H};
+  llvm::SmallVector<int64_t, 1> pShape = {H};
+  auto xType = RankedTensorType::get(xShape, builder.getF32Type());
+  auto pType = RankedTensorType::get(pShape, builder.getF32Type());
+  auto yType = UnrankedTensorType::get(builder.getF32Type());
+  auto noneType = builder.getNoneType();
+
+  llvm::SmallVector<Type, 3> inputsType{xType, pType, pType};
+  llvm::SmallVector<Type, 1> outputsType{yType};
+  FuncOp funcOp = createMainGraph(ctx, builder, inputsType, outputsType);
+
+  auto entryBlock = &funcOp.getBody().front();
+  auto xVal = entryBlock->getArgument(0);
+  auto scaleVal = entryBlock->getArgument(1);
+  auto bVal = entryBlock->getArgument(2);
+
+  auto si64Type = builder.getIntegerType(64, /*isSigned=*/true);
+  auto layerNormOp = builder.create<ONNXLayerNormalizationOp>(
+      UnknownLoc::get(&ctx), /*Y=*/yType, /*Mean=*/noneType,
+      /*InvStdDev=*/noneType, /*X=*/xVal, /*Scale=*/scaleVal, /*B=*/bVal,
+      /*axis=*/IntegerAttr::get(si64Type, -1),
+      /*epsilon=*/builder.getF32FloatAttr(epsilon),
+      /*stash_type=*/IntegerAttr::get(si64Type, 1));
+
+  llvm::SmallVector<Value, 1> results = {layerNormOp.Y()};
+  return finishMainGraph(ctx, builder, module, funcOp, results);
+}
+
+/// Build a ScaledDotProductAttention model of Q[BxSxE], K[BxLxE] and
+/// V[BxLxE], with an additive Mask[SxL] when hasMask is set, and a scale of
+/// 1/sqrt(E). When isDynamic is set, S and L are unknown at compile time.
+OwningModuleRef buildAttentionModule(MLIRContext &ctx, const int B,
+    const int S, const int L, const int E, const int hasMask,
+    const int isDynamic) {
+  auto module = ModuleOp::create(UnknownLoc::get(&ctx));
+  OpBuilder builder(&ctx);
+  llvm::SmallVector<int64_t, 3> qShape = {B, S, E};
+  llvm::SmallVector<int64_t, 3> kvShape = {B, L, E};
+  llvm::SmallVector<int64_t, 2> maskShape = {S, L};
+  if (isDynamic) {
+    qShape = {B, -1, E};
+    kvShape = {B, -1, E};
+    maskShape = {-1, -1};
+  }
+  auto qType = RankedTensorType::get(qShape, builder.getF32Type());
+  auto kvType = RankedTensorType::get(kvShape, builder.getF32Type());
+  auto maskType = RankedTensorType::get(maskShape, builder.getF32Type());
+  auto yType = UnrankedTensorType::get(builder.getF32Type());
+
+  llvm::SmallVector<Type, 4> inputsType{qType, kvType, kvType};
+  if (hasMask)
+    inputsType.emplace_back(maskType);
+  llvm::SmallVector<Type, 1> outputsType{yType};
+  FuncOp funcOp = createMainGraph(ctx, builder, inputsType, outputsType);
+
+  auto entryBlock = &funcOp.getBody().front();
+  auto qVal = entryBlock->getArgument(0);
+  auto kVal = entryBlock->getArgument(1);
+  auto vVal = entryBlock->getArgument(2);
+  Value maskVal;
+  if (hasMask)
+    maskVal = entryBlock->getArgument(3);
+  else
+    maskVal = builder
+                  .create<ConstantOp>(
+                      UnknownLoc::get(&ctx), builder.getUnitAttr())
+                  .getResult();
+
+  auto attentionOp = builder.create<ONNXScaledDotProductAttentionOp>(
+      UnknownLoc::get(&ctx), /*Y=*/yType, /*Q=*/qVal, /*K=*/kVal, /*V=*/vVal,
+      /*Mask=*/maskVal, /*scale=*/builder.getF32FloatAttr(1.0 / sqrt(E)));
+
+  llvm::SmallVector<Value, 1> results = {attentionOp.Y()};
+  return finishMainGraph(ctx, builder, module, funcOp, results);
+}
@@ -0,0 +1,303 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//====---------------------- OpBenchmark.cpp ------------------------------===//
+//
+// This file times the single-op models of the numerical tests over a grid of
+// realistic shapes. For each configuration, the model is compiled, run a few
+// times, and its median time is reported as GFLOP/s and GB/s, together with
+// the attainable performance given by a roofline model of the machine. The
+// results can be written in JSON, with keys sorted and configurations in a
+// fixed order, so that the outputs of two commits can be diffed.
+//
+//====---------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mlir/IR/BuiltinOps.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "src/Compiler/CompilerUtils.hpp"
+#include "src/Dialect/ONNX/ONNXOps.hpp"
+#include "src/Runtime/ExecutionSession.hpp"
+#include "src/Runtime/OMTensorHelper.h"
+
+#define SHARED_LIB_BASE string("./OpBenchmark_main_graph")
+
+using namespace std;
+using namespace mlir;
+
+// Include some helper functions.
+#include "Helper.hpp"
+#include "ModelBuilder.hpp"
+
+static llvm::cl::OptionCategory OMBenchmarkOptions(
+    "ONNX-MLIR Op Benchmark Options", "");
+
+static llvm::cl::opt<string> jsonFile("json",
+    llvm::cl::desc("Write the results in JSON to <file> (\"-\" for stdout)"),
+    llvm::cl::value_desc("file"), llvm::cl::init(""),
+    llvm::cl::cat(OMBenchmarkOptions));
+
+static llvm::cl::opt<string> filter("filter",
+    llvm::cl::desc("Only run the configurations whose name contains <str>"),
+    llvm::cl::value_desc("str"), llvm::cl::init(""),
+    llvm::cl::cat(OMBenchmarkOptions));
+
+static llvm::cl::opt<int> warmup("warmup",
+    llvm::cl::desc("Number of untimed runs per configuration (default 2)"),
+    llvm::cl::init(2), llvm::cl::cat(OMBenchmarkOptions));
+
+static llvm::cl::opt<int> repetitions("repetitions",
+    llvm::cl::desc("Number of timed runs per configuration (default 10)"),
+    llvm::cl::init(10), llvm::cl::cat(OMBenchmarkOptions));
+
+static llvm::cl::opt<double> peakGFlops("peak-gflops",
+    llvm::cl::desc("Peak GFLOP/s of the machine, for the roofline estimate. "
+                   "When not given, only the memory roof is used"),
+    llvm::cl::init(0), llvm::cl::cat(OMBenchmarkOptions));
+
+static llvm::cl::opt<double> peakGBps("peak-gbps",
+    llvm::cl::desc("Peak memory bandwidth of the machine in GB/s, for the "
+                   "roofline estimate. When not given, it is measured"),
+    llvm::cl::init(0), llvm::cl::cat(OMBenchmarkOptions));
+
+// Description of one benchmarked configuration.
+struct OpBenchmark {
+  string op;
+  // Unique and stable name of the configuration, used as key in the results.
+  string name;
+  // Build the model of the configuration.
+  function<OwningModuleRef(MLIRContext &)> build;
+  // Number of floating point operations, given the shape of the output.
+  function<double(ArrayRef<int64_t>)> flops;
+};
+
+// Measure the bandwidth of a large copy, as a stand-in for the peak memory
+// bandwidth of the machine. Reads and writes are both counted.
+double measureCopyBandwidth() {
+  const size_t numElems = 32 * 1024 * 1024;
+  vector<float> src(numElems, 1.0f), dst(numElems, 0.0f);
+  double best = 0;
+  for (int i = 0; i < 5; ++i) {
+    auto start = chrono::steady_clock::now();
+    std::copy(src.begin(), src.end(), dst.begin());
+    chrono::duration<double> time = chrono::steady_clock::now() - start;
+    best = max(best, 2.0 * numElems * sizeof(float) / time.count() / 1e9);
+  }
+  return best;
+}
+
+// Shapes of the grid. The Gemm and MatMul sizes are those of the fully
+// connected and attention layers of common CNN and transformer models, the
+// Conv sizes are those of the ResNet-50 stages, and the LayerNormalization
+// and attention sizes are those of common transformer models.
+vector<OpBenchmark> getBenchmarks() {
+  vector<OpBenchmark> benchmarks;
+  // I, J, K, bTrans.
+  const int gemmShapes[][4] = {{1, 1000, 2048, 1}, {1, 4096, 4096, 1},
+      {1, 4096, 25088, 1}, {64, 1000, 2048, 1}, {128, 768, 768, 0},
+      {128, 3072, 768, 0}};
+  for (auto &s : gemmShapes) {
+    int I = s[0], J = s[1], K = s[2], bTrans = s[3];
+    benchmarks.push_back({"Gemm",
+        "gemm_" + to_string(I) + "x" + to_string(J) + "x" + to_string(K) +
+            (bTrans ? "_bT" : ""),
+        [=](MLIRContext &ctx) {
+          return buildGemmModule(ctx, I, J, K, 0, bTrans, 1, 1.0, 1.0);
+        },
+        [=](ArrayRef<int64_t>) { return 2.0 * I * J * K + 2.0 * I * J; }});
+  }
+  // I, J, K.
+  const int matmulShapes[][3] = {{128, 128, 64}, {128, 768, 768},
+      {384, 384, 64}, {512, 512, 512}, {1024, 1024, 1024}};
+  for (auto &s : matmulShapes) {
+    int I = s[0], J = s[1], K = s[2];
+    benchmarks.push_back({"MatMul",
+        "matmul_" + to_string(I) + "x" + to_string(J) + "x" + to_string(K),
+        [=](MLIRContext &ctx) { return buildMatMul2DModule(ctx, I, J, K); },
+        [=](ArrayRef<int64_t>) { return 2.0 * I * J * K; }});
+  }
+  // N, C, H/W, kH/kW, pad, stride.
+  const int convShapes[][6] = {{1, 64, 56, 3, 1, 1}, {1, 128, 28, 3, 1, 1},
+      {1, 256, 14, 3, 1, 1}, {1, 512, 7, 3, 1, 1}, {1, 64, 56, 1, 0, 1},
+      {1, 256, 56, 1, 0, 2}, {8, 64, 56, 3, 1, 1}};
+  for (auto &s : convShapes) {
+    int N = s[0], C = s[1], H = s[2], K = s[3], P = s[4], S = s[5];
+    benchmarks.push_back({"Conv",
+        "conv_" + to_string(N) + "x" + to_string(C) + "x" + to_string(H) +
+            "x" + to_string(H) + "_k" + to_string(K) + "_p" + to_string(P) +
+            "_s" + to_string(S),
+        [=](MLIRContext &ctx) {
+          llvm::SmallVector<int64_t, 4> outputShape;
+          return buildConvModule(ctx, N, C, H, H, K, K, P, P, P, P, "NOTSET",
+              S, 1, 0, outputShape);
+        },
+        [=](ArrayRef<int64_t> y) {
+          return 2.0 * y[0] * y[1] * y[2] * y[3] * C * K * K;
+        }});
+  }
+  // S, H of the LayerNormalization of BERT-base, BERT-large and GPT-2 XL.
+  const int layerNormShapes[][2] = {{128, 768}, {384, 1024}, {1024, 1600}};
+  for (auto &s : layerNormShapes) {
+    int S = s[0], H = s[1];
+    benchmarks.push_back({"LayerNormalization",
+        "layernorm_" + to_string(S) + "x" + to_string(H),
+        [=](MLIRContext &ctx) {
+          return buildLayerNormModule(ctx, 1, S, H, 1e-5, 0);
+        },
+        [=](ArrayRef<int64_t>) { return 8.0 * S * H; }});
+  }
+  // Heads, S = L, E of the self attention of BERT-base, BERT-large and
+  // GPT-2 XL.
+  const int attentionShapes[][3] = {
+      {12, 128, 64}, {16, 384, 64}, {25, 1024, 64}};
+  for (auto &s : attentionShapes) {
+    int B = s[0], S = s[1], E = s[2];
+    benchmarks.push_back({"ScaledDotProductAttention",
+        "attention_" + to_string(B) + "x" + to_string(S) + "x" + to_string(E),
+        [=](MLIRContext &ctx) {
+          return buildAttentionModule(ctx, B, S, S, E, 0, 0);
+        },
+        [=](ArrayRef<int64_t>) { return 4.0 * B * S * S * E; }});
+  }
+  return benchmarks;
+}
+
+// Compile and time one configuration, and return its results, or a null
+// value on failure.
+llvm::json::Value runBenchmark(const OpBenchmark &benchmark, double gbps) {
+  MLIRContext ctx;
+  registerDialects(ctx);
+  OwningModuleRef moduleRef = benchmark.build(ctx);
+  if (!moduleRef)
+    return nullptr;
+  // Inputs are created from the static signature of main_graph.
+  FuncOp funcOp = *moduleRef->getOps<FuncOp>().begin();
+  vector<unique_ptr<OMTensor, decltype(&omTensorDestroy)>> inputs;
+  for (Type type : funcOp.getType().getInputs())
+    inputs.emplace_back(omTensorCreateWithRandomData<float>(
+                            type.cast<ShapedType>().getShape()),
+        omTensorDestroy);
+
+  if (compileModule(moduleRef, ctx, SHARED_LIB_BASE, onnx_mlir::EmitLib) != 0)
+    return nullptr;
+  onnx_mlir::ExecutionSession sess(
+      getSharedLibName(SHARED_LIB_BASE), "run_main_graph");
+
+  // Each run gets non-owning views of the inputs, so that the inputs are
+  // created once and shared by all the runs.
+  double bytes = 0;
+  vector<int64_t> outputShape;
+  vector<double> times;
+  for (int r = 0; r < warmup + repetitions; ++r) {
+    vector<unique_ptr<OMTensor, decltype(&omTensorDestroy)>> views;
+    for (auto &input : inputs)
+      views.emplace_back(omTensorCreate(omTensorGetDataPtr(input.get()),
+                             omTensorGetShape(input.get()),
+                             omTensorGetRank(input.get()), ONNX_TYPE_FLOAT),
+          omTensorDestroy);
+    auto start = chrono::steady_clock::now();
+    auto outputs = sess.run(move(views));
+    chrono::duration<double> time = chrono::steady_clock::now() - start;
+    if (r < warmup)
+      continue;
+    times.emplace_back(time.count());
+    if (outputShape.empty()) {
+      OMTensor *output = outputs.at(0).get();
+      outputShape.assign(omTensorGetShape(output),
+          omTensorGetShape(output) + omTensorGetRank(output));
+      // Compulsory traffic: every input is read and the output written once.
+      bytes = omTensorGetBufferSize(output);
+      for (auto &input : inputs)
+        bytes += omTensorGetBufferSize(input.get());
+    }
+  }
+  sort(times.begin(), times.end());
+  double median = times[times.size() / 2];
+  double flops = benchmark.flops(outputShape);
+  double intensity = flops / bytes;
+  double roofline = intensity * gbps;
+  if (peakGFlops > 0)
+    roofline = min(roofline, (double)peakGFlops);
+  double achieved = flops / median / 1e9;
+
+  printf("%-28s %10.3f ms %9.2f GFLOP/s %8.2f GB/s %7.2f flop/B %6.1f%% of "
+         "roofline\n",
+      benchmark.name.c_str(), median * 1e3, achieved, bytes / median / 1e9,
+      intensity, 100.0 * achieved / roofline);
+
+  llvm::json::Object result{{"op", benchmark.op}, {"name", benchmark.name},
+      {"output_shape", llvm::json::Array(outputShape)}, {"flops", flops},
+      {"bytes", bytes}, {"time_ms_min", times.front() * 1e3},
+      {"time_ms_median", median * 1e3}, {"gflops", achieved},
+      {"gbps", bytes / median / 1e9}, {"arithmetic_intensity", intensity},
+      {"roofline_gflops", roofline},
+      {"roofline_efficiency", achieved / roofline}};
+  if (peakGFlops > 0)
+    result["bound"] = intensity * gbps < peakGFlops ? "memory" : "compute";
+  return llvm::json::Value(move(result));
+}
+
+int main(int argc, char *argv[]) {
+  llvm::FileRemover remover(getSharedLibName(SHARED_LIB_BASE));
+
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "OpBenchmark\n", nullptr, "BENCHMARK_ARGS");
+  if (repetitions < 1)
+    repetitions = 1;
+  if (warmup < 0)
+    warmup = 0;
+
+  bool measuredGBps = peakGBps <= 0;
+  double gbps = measuredGBps ? measureCopyBandwidth() : (double)peakGBps;
+  printf("Roofline with %.2f GB/s%s and ", gbps,
+      measuredGBps ? " (measured copy bandwidth)" : "");
+  if (peakGFlops > 0)
+    printf("%.2f GFLOP/s\n", (double)peakGFlops);
+  else
+    printf("no compute roof\n");
+
+  llvm::json::Array results;
+  bool success = true;
+  for (const OpBenchmark &benchmark : getBenchmarks()) {
+    if (benchmark.name.find(filter) == string::npos)
+      continue;
+    llvm::json::Value result = runBenchmark(benchmark, gbps);
+    if (result.kind() == llvm::json::Value::Null) {
+      printf("%-28s failed to build or compile\n", benchmark.name.c_str());
+      success = false;
+      continue;
+    }
+    results.push_back(move(result));
+  }
+
+  if (!jsonFile.empty()) {
+    llvm::json::Object machine{{"peak_gbps", gbps},
+        {"peak_gbps_measured", measuredGBps},
+        {"peak_gflops", (double)peakGFlops}};
+    llvm::json::Object report{{"machine", move(machine)},
+        {"warmup", (int)warmup}, {"repetitions", (int)repetitions},
+        {"results", move(results)}};
+    std::error_code EC;
+    llvm::raw_fd_ostream os(jsonFile, EC);
+    if (EC) {
+      cerr << "Cannot open " << jsonFile << ": " << EC.message() << endl;
+      return 1;
+    }
+    llvm::json::OStream J(os, 2);
+    J.value(llvm::json::Value(move(report)));
+    os << "\n";
+  }
+  return success ? 0 : 1;
+}
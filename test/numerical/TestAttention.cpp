@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <rapidcheck.h>
+#include <string>
+#include <vector>
+
+#include "mlir/IR/BuiltinOps.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "src/Compiler/CompilerUtils.hpp"
+#include "src/Dialect/ONNX/ONNXOps.hpp"
+#include "src/Runtime/ExecutionSession.hpp"
+#include "src/Runtime/OMTensorHelper.h"
+
+#define SHARED_LIB_BASE string("./TestAttention_main_graph")
+
+using namespace std;
+using namespace mlir;
+
+// Include some helper functions.
+#include "Helper.hpp"
+#include "ModelBuilder.hpp"
+
+// Returns whether onnx-mlir compiled ScaledDotProductAttention is producing
+// the same results as a naive implementation, which materializes the scores
+// and applies a two pass softmax, for a specific set of parameters. When
+// hasInfMask is set, the mask also has -inf entries: a varying number of
+// leading keys are masked out in each row, and all of them in every third
+// row, whose output is then NaN as with an unfused softmax.
+bool isOMAttentionTheSameAsNaiveImplFor(const int B, const int S, const int L,
+    const int E, const int hasMask, const int hasInfMask,
+    const int isDynamic) {
+  MLIRContext ctx;
+  registerDialects(ctx);
+  static int testNum = 0;
+  printf("attempt %d with b %d, s %d, l %d, e %d, mask %d, inf mask %d, "
+         "dynamic %d\n",
+      ++testNum, B, S, L, E, hasMask, hasInfMask, isDynamic);
+
+  OwningModuleRef moduleRef =
+      buildAttentionModule(ctx, B, S, L, E, hasMask, isDynamic);
+
+  compileModule(moduleRef, ctx, SHARED_LIB_BASE, onnx_mlir::EmitLib);
+  onnx_mlir::ExecutionSession sess(
+      getSharedLibName(SHARED_LIB_BASE), "run_main_graph");
+
+  std::vector<unique_ptr<OMTensor, decltype(&omTensorDestroy)>> inputs;
+  auto qOmt = unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
+      omTensorCreateWithRandomData<float>({B, S, E}), omTensorDestroy);
+  inputs.emplace_back(move(qOmt));
+  auto kOmt = unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
+      omTensorCreateWithRandomData<float>({B, L, E}), omTensorDestroy);
+  inputs.emplace_back(move(kOmt));
+  auto vOmt = unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
+      omTensorCreateWithRandomData<float>({B, L, E}), omTensorDestroy);
+  inputs.emplace_back(move(vOmt));
+  if (hasMask) {
+    auto maskOmt = unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
+        omTensorCreateWithRandomData<float>({S, L}, -10.0f, 0.0f),
+        omTensorDestroy);
+    if (hasInfMask) {
+      for (int64_t s = 0; s < S; ++s) {
+        int64_t masked = (s % 3 == 2) ? L : (s * 37) % (L + 1);
+        for (int64_t l = 0; l < masked; ++l)
+          omTensorGetElem<float>(maskOmt.get(), {s, l}) =
+              -std::numeric_limits<float>::infinity();
+      }
+    }
+    inputs.emplace_back(move(maskOmt));
+  }
+
+  auto ref = omTensorCreateWithShape<float>({B, S, E});
+  auto &q = inputs.at(0);
+  auto &k = inputs.at(1);
+  auto &v = inputs.at(2);
+  const double scale = 1.0 / sqrt(E);
+  std::vector<double> scores(L);
+  for (int64_t b = 0; b < B; ++b) {
+    for (int64_t s = 0; s < S; ++s) {
+      double maxScore = -std::numeric_limits<double>::infinity();
+      for (int64_t l = 0; l < L; ++l) {
+        double score = 0;
+        for (int64_t e = 0; e < E; ++e)
+          score += omTensorGetElem<float>(q.get(), {b, s, e}) *
+                   omTensorGetElem<float>(k.get(), {b, l, e});
+        score *= scale;
+        if (hasMask)
+          score += omTensorGetElem<float>(inputs.at(3).get(), {s, l});
+        scores[l] = score;
+        maxScore = std::max(maxScore, score);
+      }
+      double sum = 0;
+      for (int64_t l = 0; l < L; ++l) {
+        scores[l] = exp(scores[l] - maxScore);
+        sum += scores[l];
+      }
+      for (int64_t e = 0; e < E; ++e) {
+        double y = 0;
+        for (int64_t l = 0; l < L; ++l)
+          y += scores[l] * omTensorGetElem<float>(v.get(), {b, l, e});
+        omTensorGetElem<float>(ref, {b, s, e}) = y / sum;
+      }
+    }
+  }
+
+  auto outputs = sess.run(move(inputs));
+  auto &attention = outputs.at(0);
+
+  // The fully masked rows must be NaN in both, and are then left out of the
+  // comparison.
+  for (int64_t b = 0; b < B; ++b)
+    for (int64_t s = 0; s < S; ++s)
+      for (int64_t e = 0; e < E; ++e) {
+        float &expected = omTensorGetElem<float>(ref, {b, s, e});
+        float &actual = omTensorGetElem<float>(attention.get(), {b, s, e});
+        if (std::isnan(expected) != std::isnan(actual))
+          return false;
+        if (std::isnan(expected))
+          expected = actual = 0;
+      }
+
+  float rtol = getenv("TEST_RTOL") ? atof(getenv("TEST_RTOL")) : 1e-4;
+  float atol = getenv("TEST_ATOL") ? atof(getenv("TEST_ATOL")) : 1e-4;
+
+  return omTensorAreTwoOmtsClose<float>(attention.get(), ref, rtol, atol);
+}
+
+int main(int argc, char *argv[]) {
+  llvm::FileRemover remover(getSharedLibName(SHARED_LIB_BASE));
+
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "TestAttention\n", nullptr, "TEST_ARGS");
+
+  printf("RapidCheck test case generation.\n");
+  bool success = rc::check("Attention implementation correctness", []() {
+    const auto B = *rc::gen::inRange(1, 4);
+    const auto S = *rc::gen::inRange(1, 80);
+    const auto L = *rc::gen::inRange(1, 150);
+    const auto E = *rc::gen::inRange(1, 40);
+    const auto hasMask = *rc::gen::inRange(0, 2);
+    const auto hasInfMask = hasMask ? *rc::gen::inRange(0, 2) : 0;
+    const auto isDynamic = *rc::gen::inRange(0, 2);
+
+    RC_ASSERT(isOMAttentionTheSameAsNaiveImplFor(
+        B, S, L, E, hasMask, hasInfMask, isDynamic));
+  });
+  if (!success)
+    return 1;
+
+  printf("\n\nExhaustive test case generation.\n");
+  // Sequence lengths around the query and key/value block sizes.
+  for (int S : {31, 32, 33})
+    for (int L : {63, 64, 65, 129})
+      for (int hasMask = 0; hasMask < 2; hasMask++)
+        for (int hasInfMask = 0; hasInfMask <= hasMask; hasInfMask++)
+          assert(isOMAttentionTheSameAsNaiveImplFor(
+              2, S, L, 8, hasMask, hasInfMask, 0));
+
+  return 0;
+}
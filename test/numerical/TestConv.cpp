@@ -17,6 +17,7 @@
 #include "src/Dialect/ONNX/ONNXOps.hpp"
 #include "src/Runtime/ExecutionSession.hpp"
 #include "src/Runtime/OMTensorHelper.h"
+#include "src/Support/OMOptions.hpp"
 
 #define DEBUG 0
 
@@ -25,6 +26,7 @@ using namespace mlir;
 
 // Include some helper functions.
 #include "Helper.hpp"
+#include "ModelBuilder.hpp"
 
 #define SHARED_LIB_BASE string("./TestConv_main_graph")
 
@@ -41,6 +43,17 @@ const string autoPadName[] = {"NOTSET", "VALID", "SAME_LOWER", "SAME_UPPER"};
 // dilations. Had to make them global to conform with the signatures of lambda
 // requested by RapidTest.
 int stride, dilation, isDynamic;
+int group = 1;
+
+// Default tolerance, and tolerance of the convolutions lowered with Winograd,
+// whose transforms reassociate the reduction, for the two tile sizes.
+float getTolerance(const int kH, const int kW) {
+  bool isWinograd = winogradTile > 0 && !isDynamic && group == 1 && kH == 3 &&
+                    kW == 3 && stride == 1 && dilation == 1;
+  if (!isWinograd)
+    return 1e-5;
+  return (winogradTile == 2) ? 1e-4 : 1e-3;
+}
 
 // Support.
 int myCeil(int a, int b) { return ceil((1.0 * a) / (1.0 * b)); }
@@ -140,9 +153,9 @@ bool isOMConvTheSameAsNaiveImplFor(const int N, const int C, const int H,
     printf(
         "attempt %d with N %d, C %d, H %d, W %d, kH %d, kW %d, pHBegin %d, "
         "pHEnd %d, pWBegin %d, pWEnd %d, autopad %s, isDynamic %d, stride %d, "
-        "dilation %d\n",
+        "dilation %d, group %d\n",
         ++testNum, N, C, H, W, kH, kW, pHBegin, pHEnd, pWBegin, pWEnd,
-        autoPadName[autoPad].c_str(), isDynamic, stride, dilation);
+        autoPadName[autoPad].c_str(), isDynamic, stride, dilation, group);
   if (autoPad != AUTO_PAD_NOTSET) {
     // make sure all pads are initially zero, only value tolarated.
     assert(pHBegin == 0 && pHEnd == 0 && pWBegin == 0 && pWEnd == 0);
@@ -151,74 +164,18 @@ bool isOMConvTheSameAsNaiveImplFor(const int N, const int C, const int H,
   MLIRContext ctx;
   registerDialects(ctx);
 
-  int N1 = N;
-  int C1 = C;
-  int H1 = H;
-  int W1 = W;
-  if (isDynamic)
-    N1 = C1 = H1 = W1 = -1;
-
-  auto module = ModuleOp::create(UnknownLoc::get(&ctx));
-  OpBuilder builder(&ctx);
-  llvm::SmallVector<int64_t, 4> xShape = {N, C, H, W};
-  llvm::SmallVector<int64_t, 3> xShapeSymbol = {N1, C1, H1, W1};
-  llvm::SmallVector<int64_t, 1> bShape = {C};
-  llvm::SmallVector<int64_t, 4> wShape = {C, C, kH, kW};
-  auto xType = RankedTensorType::get(xShape, builder.getF32Type());
-  auto xTypeSymbol = RankedTensorType::get(xShapeSymbol, builder.getF32Type());
-  auto wType = RankedTensorType::get(wShape, builder.getF32Type());
-  auto yType = UnrankedTensorType::get(builder.getF32Type());
-
-  llvm::SmallVector<Type, 2> inputsType{xTypeSymbol, wType};
-  llvm::SmallVector<Type, 1> outputsType{yType};
-
-  auto funcType = builder.getFunctionType(inputsType, outputsType);
-  string funcName = "main_graph";
-  llvm::SmallVector<NamedAttribute, 1> attrs;
-  auto funcOp =
-      builder.create<FuncOp>(UnknownLoc::get(&ctx), funcName, funcType, attrs);
-
-  auto entryBlock = funcOp.addEntryBlock();
-  builder.setInsertionPointToStart(entryBlock);
-
-  auto xVal = entryBlock->getArgument(0);
-  auto wVal = entryBlock->getArgument(1);
-  auto bVal =
-      builder.create<ConstantOp>(UnknownLoc::get(&ctx), builder.getUnitAttr())
-          .getResult();
-
-  auto dilations = builder.getI64ArrayAttr({dilation, dilation});
-  auto kernel_shape = builder.getI64ArrayAttr({kH, kW});
-  auto pads = builder.getI64ArrayAttr({pHBegin, pWBegin, pHEnd, pWEnd});
-  auto strides = builder.getI64ArrayAttr({stride, stride});
-
-  auto convOp = builder.create<ONNXConvOp>(UnknownLoc::get(&ctx),
-      /*Y=*/yType,
-      /*X=*/xVal, /*W=*/wVal, /*B=*/bVal,
-      /*auto_pad=*/builder.getStringAttr(autoPadName[autoPad]),
-      /*dilations=*/dilations,
-      /*group=*/
-      IntegerAttr::get(builder.getIntegerType(64, /*isSigned=*/true),
-          APInt(64, 1, /*isSigned=*/true)),
-      /*kernel_shape=*/kernel_shape, /*pads=*/pads,
-      /*strides=*/strides);
-
-  // Use the convOp shape inference method to compute output shape, and unset
-  // the shape so that we don't leave IR in a inconsistent state.
-  convOp.X().setType(xType); // Use static dims to infer shape.
-  LogicalResult res = convOp.inferShapes([](mlir::Region &) {});
-  if (failed(res)) {
+  llvm::SmallVector<int64_t, 4> outputShape;
+  OwningModuleRef moduleRef = buildConvModule(ctx, N, C, H, W, kH, kW,
+      pHBegin, pHEnd, pWBegin, pWEnd, autoPadName[autoPad], stride, dilation,
+      isDynamic, outputShape, group);
+  if (!moduleRef)
     return false;
-  }
-  auto outputShape = convOp.getResult().getType().cast<ShapedType>().getShape();
   auto NOut = outputShape[0];
   auto COut = outputShape[1];
   auto HOut = outputShape[2];
   auto WOut = outputShape[3];
-  convOp.getResult().setType(yType);
-  convOp.X().setType(xTypeSymbol);
-  res = checkShapes(N, C, H, W, kH, kW, pHBegin, pHEnd, pWBegin, pWEnd, autoPad,
-      NOut, COut, HOut, WOut);
+  LogicalResult res = checkShapes(N, C, H, W, kH, kW, pHBegin, pHEnd, pWBegin,
+      pWEnd, autoPad, NOut, COut, HOut, WOut);
   if (failed(res)) {
     if (DEBUG) {
       cerr << "Conv after check shape, N out " << NOut << ", C out " << COut
@@ -229,21 +186,6 @@ bool isOMConvTheSameAsNaiveImplFor(const int N, const int C, const int H,
     return false;
   }
 
-  llvm::SmallVector<Value, 1> results = {convOp.getResult()};
-  builder.create<ReturnOp>(UnknownLoc::get(&ctx), results);
-  module.push_back(funcOp);
-
-  // Emit the entry point operation which specifies the number of user
-  // inputs and outputs.
-  std::string signature("");
-  auto entryPoint = ONNXEntryPointOp::create(UnknownLoc::get(&ctx), funcOp,
-      /*numInputs=*/2,
-      /*numOutputs=*/1,
-      /*signature*/ signature);
-  module.push_back(entryPoint);
-
-  OwningModuleRef moduleRef(module);
-
   compileModule(moduleRef, ctx, SHARED_LIB_BASE, onnx_mlir::EmitLib);
   onnx_mlir::ExecutionSession sess(
       getSharedLibName(SHARED_LIB_BASE), "run_main_graph");
@@ -253,18 +195,22 @@ bool isOMConvTheSameAsNaiveImplFor(const int N, const int C, const int H,
       omTensorCreateWithRandomData<float>({N, C, H, W}), omTensorDestroy);
   inputs.emplace_back(move(xOmt));
   auto wOmt = unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
-      omTensorCreateWithRandomData<float>({C, C, kH, kW}), omTensorDestroy);
+      omTensorCreateWithRandomData<float>({C, C / group, kH, kW}),
+      omTensorDestroy);
   inputs.emplace_back(move(wOmt));
 
   auto ref = omTensorCreateWithShape<float>({NOut, COut, HOut, WOut});
   auto &img = inputs.at(0);
   auto &filter = inputs.at(1);
+  // Output channel c reads the input channels of its group, g = c / CPerGroup.
+  const int64_t CPerGroup = C / group;
   for (int64_t n = 0; n < NOut; n++)
     for (int64_t c = 0; c < COut; c++)
       for (int64_t h = 0; h < HOut; h++)
         for (int64_t w = 0; w < WOut; w++) {
           omTensorGetElem<float>(ref, {n, c, h, w}) = 0;
-          for (int64_t ci = 0; ci < C; ci++)
+          int64_t ciBase = (c / CPerGroup) * CPerGroup;
+          for (int64_t ci = 0; ci < CPerGroup; ci++)
             for (int64_t kh = 0; kh < kH; kh++)
               for (int64_t kw = 0; kw < kW; kw++)
                 if ((h * stride + kh * dilation - pHBegin >= 0 &&
@@ -273,7 +219,8 @@ bool isOMConvTheSameAsNaiveImplFor(const int N, const int C, const int H,
                         w * stride + kw * dilation - pWBegin < W))
                   omTensorGetElem<float>(ref, {n, c, h, w}) +=
                       omTensorGetElem<float>(img.get(),
-                          {n, ci, h * stride + kh * dilation - pHBegin,
+                          {n, ciBase + ci,
+                              h * stride + kh * dilation - pHBegin,
                               w * stride + kw * dilation - pWBegin}) *
                       omTensorGetElem<float>(filter.get(), {c, ci, kh, kw});
         }
@@ -281,8 +228,9 @@ bool isOMConvTheSameAsNaiveImplFor(const int N, const int C, const int H,
   auto outputs = sess.run(move(inputs));
   auto &conv = outputs.at(0);
 
-  float rtol = getenv("TEST_RTOL") ? atof(getenv("TEST_RTOL")) : 1e-5;
-  float atol = getenv("TEST_ATOL") ? atof(getenv("TEST_ATOL")) : 1e-5;
+  float tolerance = getTolerance(kH, kW);
+  float rtol = getenv("TEST_RTOL") ? atof(getenv("TEST_RTOL")) : tolerance;
+  float atol = getenv("TEST_ATOL") ? atof(getenv("TEST_ATOL")) : tolerance;
 
   return omTensorAreTwoOmtsClose<float>(conv.get(), ref, rtol, atol);
 }
@@ -372,5 +320,70 @@ int main(int argc, char *argv[]) {
                 pHEnd, pWBegin, pWEnd, AUTO_PAD_NOTSET));
 
   } // End loop over static / dynamic
+
+  // Fourth test: 3x3 convolutions with unit stride and dilation over static
+  // shapes are lowered with Winograd F(m x m, 3 x 3). Check the accuracy of
+  // both tile sizes with deeper channels, odd image sizes (partial output
+  // tiles) and asymmetric pads.
+  isDynamic = 0;
+  stride = dilation = 1;
+  int defaultWinogradTile = winogradTile;
+  for (int m = 2; m <= 4; m += 2) {
+    printf("\nWinograd F(%dx%d, 3x3) test cases.\n", m, m);
+    winogradTile = m;
+    bool success = rc::check("winograd convolution accuracy", []() {
+      const auto N = *rc::gen::inRange(1, 3);
+      const auto C = *rc::gen::inRange(1, 33);
+      const auto H = *rc::gen::inRange(3, 24);
+      const auto W = *rc::gen::inRange(3, 24);
+      const auto pHBegin = *rc::gen::inRange(0, 3);
+      const auto pHEnd = *rc::gen::inRange(0, 3);
+      const auto pWBegin = *rc::gen::inRange(0, 3);
+      const auto pWEnd = *rc::gen::inRange(0, 3);
+      RC_ASSERT(isOMConvTheSameAsNaiveImplFor(N, C, H, W, 3, 3, pHBegin,
+          pHEnd, pWBegin, pWEnd, AUTO_PAD_NOTSET));
+    });
+    if (!success)
+      return 1;
+  }
+  winogradTile = defaultWinogradTile;
+
+  // Fifth test: depthwise convolutions (one group per channel) over static
+  // shapes, which have a dedicated lowering.
+  printf("\nDepthwise test cases.\n");
+  bool success = rc::check("depthwise convolution correctness", []() {
+    const auto S = *rc::gen::inRange(1, 3);
+    stride = S;
+    const auto D = *rc::gen::inRange(1, 3);
+    dilation = D;
+    const auto N = *rc::gen::inRange(1, 3);
+    const auto C = *rc::gen::inRange(2, 33);
+    group = C;
+    const auto H = *rc::gen::inRange(5, 24 * stride);
+    const auto W = *rc::gen::inRange(5, 24 * stride);
+    const auto kH = *rc::gen::inRange(1, 6);
+    const auto kW = *rc::gen::inRange(1, 6);
+    const auto pHBegin = *rc::gen::inRange(0, kH);
+    const auto pHEnd = *rc::gen::inRange(0, kH);
+    const auto pWBegin = *rc::gen::inRange(0, kW);
+    const auto pWEnd = *rc::gen::inRange(0, kW);
+    // Make sure we have at least 1 output per dimension.
+    RC_PRE((H / stride >= kH * dilation) && (W / stride > kW * dilation));
+    RC_ASSERT(isOMConvTheSameAsNaiveImplFor(N, C, H, W, kH, kW, pHBegin,
+        pHEnd, pWBegin, pWEnd, AUTO_PAD_NOTSET));
+  });
+  if (!success)
+    return 1;
+  group = 1;
+
+  // Sixth test: pointwise convolutions, which are lowered to a matrix
+  // multiplication, with deeper channels and odd image sizes.
+  printf("\nPointwise test cases.\n");
+  stride = dilation = 1;
+  for (isDynamic = 0; isDynamic < 2; ++isDynamic)
+    for (int C = 1; C < 40; C += 7)
+      for (int HW = 1; HW < 20; HW += 6)
+        assert(isOMConvTheSameAsNaiveImplFor(
+            2, C, HW, HW + 3, 1, 1, 0, 0, 0, 0, AUTO_PAD_NOTSET));
   return 0;
 }
@@ -25,8 +25,8 @@ using namespace mlir;
 
 // Include some helper functions.
 #include "Helper.hpp"
+#include "ModelBuilder.hpp"
 
-void *omTensorGetAllocatedPtr(OMTensor *tensor);
 template <typename TYPE>
 void omPrintAsPython(OMTensor *tensor, string name) {
   int rank = omTensorGetRank(tensor);
@@ -67,9 +67,6 @@ bool isOMGemmTheSameAsNaiveImplFor(const int I, const int J, const int K,
       ++testNum, I, J, K, (aTrans ? ", aTrans" : ""),
       (bTrans ? ", bTrans" : ""), cRank, (double)alphaVal, (double)betaVal);
 
-  auto module = ModuleOp::create(UnknownLoc::get(&ctx));
-  OpBuilder builder(&ctx);
-
   llvm::SmallVector<int64_t, 2> aShape = {I, K};
   llvm::SmallVector<int64_t, 2> aShapeT = {K, I};
   llvm::SmallVector<int64_t, 2> bShape = {K, J};
@@ -85,53 +82,8 @@ bool isOMGemmTheSameAsNaiveImplFor(const int I, const int J, const int K,
   else
     assert(cRank == 1 && "cRank == 1 or 2");
 
-  llvm::SmallVector<int64_t, 2> yShape = {I, J};
-  auto aType = RankedTensorType::get(aShape, builder.getF32Type());
-  auto bType = RankedTensorType::get(bShape, builder.getF32Type());
-  auto cType = RankedTensorType::get(cShape, builder.getF32Type());
-  auto yType = RankedTensorType::get(yShape, builder.getF32Type());
-
-  llvm::SmallVector<Type, 3> inputsType{aType, bType, cType};
-  llvm::SmallVector<Type, 1> outputsType{yType};
-
-  auto funcType = builder.getFunctionType(inputsType, outputsType);
-  string funcName = "main_graph";
-  llvm::SmallVector<NamedAttribute, 1> attrs;
-  auto funcOp =
-      builder.create<FuncOp>(UnknownLoc::get(&ctx), funcName, funcType, attrs);
-
-  auto entryBlock = funcOp.addEntryBlock();
-  builder.setInsertionPointToStart(entryBlock);
-
-  auto aVal = entryBlock->getArgument(0);
-  auto bVal = entryBlock->getArgument(1);
-  auto cVal = entryBlock->getArgument(2);
-
-  FloatAttr alphaAttr = FloatAttr::get(builder.getF32Type(), alphaVal);
-  FloatAttr betaAttr = FloatAttr::get(builder.getF32Type(), betaVal);
-  IntegerAttr aTransAttr =
-      IntegerAttr::get(builder.getIntegerType(64, true), aTrans);
-  IntegerAttr bTransAttr =
-      IntegerAttr::get(builder.getIntegerType(64, true), bTrans);
-  auto gemmOp = builder.create<ONNXGemmOp>(UnknownLoc::get(&ctx),
-      /*Y=*/yType, /*A=*/aVal, /*B=*/bVal, /*C=*/cVal, alphaAttr, betaAttr,
-      aTransAttr, bTransAttr);
-  gemmOp.getResult().setType(yType);
-
-  llvm::SmallVector<Value, 1> results = {gemmOp.getResult()};
-  builder.create<ReturnOp>(UnknownLoc::get(&ctx), results);
-  module.push_back(funcOp);
-
-  // Emit the entry point operation which specifies the number of user
-  // inputs and outputs.
-  std::string signature("");
-  auto entryPoint = ONNXEntryPointOp::create(UnknownLoc::get(&ctx), funcOp,
-      /*numInputs=*/3,
-      /*numOutputs=*/1,
-      /*signature*/ signature);
-  module.push_back(entryPoint);
-
-  OwningModuleRef moduleRef(module);
+  OwningModuleRef moduleRef = buildGemmModule(
+      ctx, I, J, K, aTrans, bTrans, cRank, alphaVal, betaVal);
 
   compileModule(moduleRef, ctx, SHARED_LIB_BASE, onnx_mlir::EmitLib);
   onnx_mlir::ExecutionSession sess(
@@ -0,0 +1,121 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <rapidcheck.h>
+#include <string>
+#include <vector>
+
+#include "mlir/IR/BuiltinOps.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "src/Compiler/CompilerUtils.hpp"
+#include "src/Dialect/ONNX/ONNXOps.hpp"
+#include "src/Runtime/ExecutionSession.hpp"
+#include "src/Runtime/OMTensorHelper.h"
+
+#define SHARED_LIB_BASE string("./TestLayerNorm_main_graph")
+
+using namespace std;
+using namespace mlir;
+
+// Include some helper functions.
+#include "Helper.hpp"
+#include "ModelBuilder.hpp"
+
+// Returns whether onnx-mlir compiled LayerNormalization is producing the same
+// results as a naive implementation of LayerNormalization for a specific set
+// of parameters. The values of X are drawn around offset, so that a large
+// offset checks that the variance does not suffer from cancellation.
+bool isOMLayerNormTheSameAsNaiveImplFor(const int N, const int S, const int H,
+    const float offset, const int isDynamic) {
+  MLIRContext ctx;
+  registerDialects(ctx);
+  static int testNum = 0;
+  printf("attempt %d with n %d, s %d, h %d, offset %f, dynamic %d\n",
+      ++testNum, N, S, H, offset, isDynamic);
+
+  const float epsilon = 1e-5;
+  OwningModuleRef moduleRef =
+      buildLayerNormModule(ctx, N, S, H, epsilon, isDynamic);
+
+  compileModule(moduleRef, ctx, SHARED_LIB_BASE, onnx_mlir::EmitLib);
+  onnx_mlir::ExecutionSession sess(
+      getSharedLibName(SHARED_LIB_BASE), "run_main_graph");
+
+  std::vector<unique_ptr<OMTensor, decltype(&omTensorDestroy)>> inputs;
+  auto xOmt = unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
+      omTensorCreateWithRandomData<float>(
+          {N, S, H}, offset - 1.0f, offset + 1.0f),
+      omTensorDestroy);
+  inputs.emplace_back(move(xOmt));
+  auto scaleOmt = unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
+      omTensorCreateWithRandomData<float>({H}), omTensorDestroy);
+  inputs.emplace_back(move(scaleOmt));
+  auto bOmt = unique_ptr<OMTensor, decltype(&omTensorDestroy)>(
+      omTensorCreateWithRandomData<float>({H}), omTensorDestroy);
+  inputs.emplace_back(move(bOmt));
+
+  auto ref = omTensorCreateWithShape<float>({N, S, H});
+  auto &x = inputs.at(0);
+  auto &scale = inputs.at(1);
+  auto &b = inputs.at(2);
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t s = 0; s < S; ++s) {
+      double mean = 0, var = 0;
+      for (int64_t h = 0; h < H; ++h)
+        mean += omTensorGetElem<float>(x.get(), {n, s, h});
+      mean /= H;
+      for (int64_t h = 0; h < H; ++h) {
+        double d = omTensorGetElem<float>(x.get(), {n, s, h}) - mean;
+        var += d * d;
+      }
+      var /= H;
+      for (int64_t h = 0; h < H; ++h)
+        omTensorGetElem<float>(ref, {n, s, h}) =
+            (omTensorGetElem<float>(x.get(), {n, s, h}) - mean) /
+                sqrt(var + epsilon) * omTensorGetElem<float>(scale.get(), {h}) +
+            omTensorGetElem<float>(b.get(), {h});
+    }
+  }
+
+  auto outputs = sess.run(move(inputs));
+  auto &layerNorm = outputs.at(0);
+
+  float rtol = getenv("TEST_RTOL") ? atof(getenv("TEST_RTOL")) : 1e-4;
+  float atol = getenv("TEST_ATOL") ? atof(getenv("TEST_ATOL")) : 1e-4;
+
+  return omTensorAreTwoOmtsClose<float>(layerNorm.get(), ref, rtol, atol);
+}
+
+int main(int argc, char *argv[]) {
+  llvm::FileRemover remover(getSharedLibName(SHARED_LIB_BASE));
+
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "TestLayerNorm\n", nullptr, "TEST_ARGS");
+
+  printf("RapidCheck test case generation.\n");
+  bool success = rc::check("LayerNorm implementation correctness", []() {
+    const auto N = *rc::gen::inRange(1, 4);
+    const auto S = *rc::gen::inRange(1, 20);
+    const auto H = *rc::gen::inRange(1, 100);
+    const auto offset = *rc::gen::element(0.0f, 10.0f, 100.0f);
+    const auto isDynamic = *rc::gen::inRange(0, 2);
+
+    RC_ASSERT(isOMLayerNormTheSameAsNaiveImplFor(N, S, H, offset, isDynamic));
+  });
+  if (!success)
+    return 1;
+
+  printf("\n\nExhaustive test case generation.\n");
+  // Normalized sizes around the number of lanes of the statistics.
+  for (int H = 1; H < 20; H++)
+    for (int isDynamic = 0; isDynamic < 2; isDynamic++)
+      assert(isOMLayerNormTheSameAsNaiveImplFor(2, 3, H, 0.0f, isDynamic));
+
+  return 0;
+}
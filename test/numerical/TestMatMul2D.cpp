@@ -25,6 +25,7 @@ using namespace mlir;
 
 // Include some helper functions.
 #include "Helper.hpp"
+#include "ModelBuilder.hpp"
 
 // Returns whether onnx-mlir compiled Matmul is producing the same results
 // as a naive implementation of Matmul for a specific set of Matmul
@@ -35,47 +36,7 @@ bool isOMMatmulTheSameAsNaiveImplFor(const int I, const int J, const int K) {
   static int testNum = 0;
   printf("attempt %d with i %d, j %d, k %d\n", ++testNum, I, J, K);
 
-  auto module = ModuleOp::create(UnknownLoc::get(&ctx));
-  OpBuilder builder(&ctx);
-  llvm::SmallVector<int64_t, 4> aShape = {I, K};
-  llvm::SmallVector<int64_t, 1> bShape = {K, J};
-  llvm::SmallVector<int64_t, 4> cShape = {I, J};
-  auto aType = RankedTensorType::get(aShape, builder.getF32Type());
-  auto bType = RankedTensorType::get(bShape, builder.getF32Type());
-  auto yType = RankedTensorType::get(cShape, builder.getF32Type());
-
-  llvm::SmallVector<Type, 2> inputsType{aType, bType};
-  llvm::SmallVector<Type, 1> outputsType{yType};
-
-  auto funcType = builder.getFunctionType(inputsType, outputsType);
-  string funcName = "main_graph";
-  llvm::SmallVector<NamedAttribute, 1> attrs;
-  auto funcOp =
-      builder.create<FuncOp>(UnknownLoc::get(&ctx), funcName, funcType, attrs);
-
-  auto entryBlock = funcOp.addEntryBlock();
-  builder.setInsertionPointToStart(entryBlock);
-
-  auto aVal = entryBlock->getArgument(0);
-  auto bVal = entryBlock->getArgument(1);
-
-  auto MatmulOp = builder.create<ONNXMatMulOp>(UnknownLoc::get(&ctx),
-      /*Y=*/yType, /*A=*/aVal, /*B=*/bVal);
-
-  llvm::SmallVector<Value, 1> results = {MatmulOp.getResult()};
-  builder.create<ReturnOp>(UnknownLoc::get(&ctx), results);
-  module.push_back(funcOp);
-
-  // Emit the entry point operation which specifies the number of user
-  // inputs and outputs.
-  std::string signature("");
-  auto entryPoint = ONNXEntryPointOp::create(UnknownLoc::get(&ctx), funcOp,
-      /*numInputs=*/2,
-      /*numOutputs=*/1,
-      /*signature*/ signature);
-  module.push_back(entryPoint);
-
-  OwningModuleRef moduleRef(module);
+  OwningModuleRef moduleRef = buildMatMul2DModule(ctx, I, J, K);
 
   compileModule(moduleRef, ctx, SHARED_LIB_BASE, onnx_mlir::EmitLib);
   onnx_mlir::ExecutionSession sess(
@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===------------------ OMAsyncTest.c - OMAsync Unit Test -----------------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the asynchronous inference API, using a
+// fake model entry point.
+//
+//===----------------------------------------------------------------------===//
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "OnnxMlirRuntime.h"
+
+#define NUM_REQUESTS 64
+
+static pthread_mutex_t doneMutex = PTHREAD_MUTEX_INITIALIZER;
+static int numDone = 0;
+static float results[NUM_REQUESTS];
+
+static int64_t shape[1] = {1};
+
+/* Fake entry point: output a tensor holding twice the input. */
+static OMTensorList *doubleEntryPoint(OMTensorList *input) {
+  OMTensor *x = omTensorListGetOmtByIndex(input, 0);
+  float *y = (float *)malloc(sizeof(float));
+  *y = 2.f * *(float *)omTensorGetDataPtr(x);
+  OMTensor **list = (OMTensor **)malloc(sizeof(OMTensor *));
+  list[0] = omTensorCreateWithOwnership(y, shape, 1, ONNX_TYPE_FLOAT, 1);
+  return omTensorListCreateWithOwnership(list, 1, 1);
+}
+
+static void requestDone(OMTensorList *output, void *userData) {
+  int64_t index = (int64_t)(intptr_t)userData;
+  OMTensor *y = omTensorListGetOmtByIndex(output, 0);
+  pthread_mutex_lock(&doneMutex);
+  results[index] = *(float *)omTensorGetDataPtr(y);
+  numDone++;
+  pthread_mutex_unlock(&doneMutex);
+  omTensorListDestroy(output);
+}
+
+void testOMAsyncQueue() {
+  float data[NUM_REQUESTS];
+  OMTensor *omts[NUM_REQUESTS];
+  OMTensorList *inputs[NUM_REQUESTS];
+
+  OMAsyncQueue *queue = omAsyncQueueCreate(doubleEntryPoint, 4);
+  assert(queue);
+  for (int64_t i = 0; i < NUM_REQUESTS; i++) {
+    data[i] = (float)i;
+    omts[i] = omTensorCreate(&data[i], shape, 1, ONNX_TYPE_FLOAT);
+    inputs[i] = omTensorListCreate(&omts[i], 1);
+    int rc = omRunAsync(queue, inputs[i], requestDone, (void *)(intptr_t)i);
+    assert(rc == 0);
+  }
+  /* Destroying the queue waits for all the requests. */
+  omAsyncQueueDestroy(queue);
+
+  assert(numDone == NUM_REQUESTS);
+  for (int64_t i = 0; i < NUM_REQUESTS; i++) {
+    assert(results[i] == 2.f * i);
+    omTensorListDestroy(inputs[i]);
+  }
+}
+
+/* Fake entry point of a second model: output a tensor holding the input
+ * plus one.
+ */
+static OMTensorList *incrementEntryPoint(OMTensorList *input) {
+  OMTensor *x = omTensorListGetOmtByIndex(input, 0);
+  float *y = (float *)malloc(sizeof(float));
+  *y = *(float *)omTensorGetDataPtr(x) + 1.f;
+  OMTensor **list = (OMTensor **)malloc(sizeof(OMTensor *));
+  list[0] = omTensorCreateWithOwnership(y, shape, 1, ONNX_TYPE_FLOAT, 1);
+  return omTensorListCreateWithOwnership(list, 1, 1);
+}
+
+/* One queue serves the requests of two models. */
+void testOMAsyncQueueShared() {
+  float data[NUM_REQUESTS];
+  OMTensor *omts[NUM_REQUESTS];
+  OMTensorList *inputs[NUM_REQUESTS];
+
+  numDone = 0;
+  OMAsyncQueue *queue = omAsyncQueueCreate(doubleEntryPoint, 4);
+  assert(queue);
+  for (int64_t i = 0; i < NUM_REQUESTS; i++) {
+    data[i] = (float)i;
+    omts[i] = omTensorCreate(&data[i], shape, 1, ONNX_TYPE_FLOAT);
+    inputs[i] = omTensorListCreate(&omts[i], 1);
+    int rc = omRunAsyncWithEntryPoint(queue,
+        (i % 2) ? incrementEntryPoint : doubleEntryPoint, inputs[i],
+        requestDone, (void *)(intptr_t)i);
+    assert(rc == 0);
+  }
+  omAsyncQueueDestroy(queue);
+
+  assert(numDone == NUM_REQUESTS);
+  for (int64_t i = 0; i < NUM_REQUESTS; i++) {
+    assert(results[i] == ((i % 2) ? i + 1.f : 2.f * i));
+    omTensorListDestroy(inputs[i]);
+  }
+}
+
+void testOMAsyncQueueInvalid() {
+  assert(!omAsyncQueueCreate(doubleEntryPoint, 0));
+  assert(!omAsyncQueueCreate(NULL, 1));
+}
+
+int main() {
+  testOMAsyncQueue();
+  testOMAsyncQueueShared();
+  testOMAsyncQueueInvalid();
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+//===-------------- OMTensorArenaTest.c - OMTensorArena Unit Test ---------===//
+//
+// Copyright 2022 The IBM Research Authors.
+//
+// =============================================================================
+//
+// This file contains unit tests of the OMTensor single allocation layout and
+// of OMTensorArena.
+//
+//===----------------------------------------------------------------------===//
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "OnnxMlirRuntime.h"
+
+#define LARGE_RANK 10
+
+static void checkDims(OMTensor *tensor, int64_t *shape, int64_t rank) {
+  int64_t *shapePtr = omTensorGetShape(tensor);
+  int64_t *stridesPtr = omTensorGetStrides(tensor);
+  int64_t stride = 1;
+  for (int64_t i = rank - 1; i >= 0; i--) {
+    assert(shapePtr[i] == shape[i]);
+    assert(stridesPtr[i] == stride);
+    stride *= shape[i];
+  }
+}
+
+/* Shape and strides are laid out right after each other, whatever the rank */
+void testOMTensorLayout() {
+  float data[1] = {0.f};
+  int64_t shape[LARGE_RANK];
+  for (int64_t i = 0; i < LARGE_RANK; i++)
+    shape[i] = i + 1;
+
+  for (int64_t rank = 1; rank <= LARGE_RANK; rank++) {
+    OMTensor *tensor = omTensorCreate(data, shape, rank, ONNX_TYPE_FLOAT);
+    assert(tensor);
+    checkDims(tensor, shape, rank);
+    assert(omTensorGetStrides(tensor) == omTensorGetShape(tensor) + rank);
+    omTensorDestroy(tensor);
+  }
+}
+
+/* Create an output list as the entry point does, with owned data buffers */
+static OMTensorList *createOutputs(int64_t *shape, int64_t n) {
+  OMTensor **omts = omTensorArrayCreate(n);
+  assert(omts);
+  for (int64_t i = 0; i < n; i++) {
+    int64_t rank = (i % 2) ? LARGE_RANK : 2;
+    omts[i] = omTensorCreateWithOwnership(
+        malloc(sizeof(float)), shape, rank, ONNX_TYPE_FLOAT, /*owning=*/1);
+    assert(omts[i]);
+  }
+  return omTensorListCreateWithOwnership(omts, n, /*owning=*/1);
+}
+
+/* After a reset, the arena hands out the same memory again */
+void testOMTensorArenaReuse() {
+  int64_t shape[LARGE_RANK];
+  for (int64_t i = 0; i < LARGE_RANK; i++)
+    shape[i] = 1;
+
+  /* Start small so that the first round has to grow the arena. */
+  OMTensorArena *arena = omTensorArenaCreate(64);
+  assert(arena);
+  omTensorArenaSetCurrent(arena);
+  assert(omTensorArenaGetCurrent() == arena);
+
+  OMTensorList *firstList = NULL;
+  OMTensor *firstOmt = NULL;
+  for (int64_t round = 0; round < 4; round++) {
+    OMTensorList *list = createOutputs(shape, 8);
+    assert(list);
+    assert(omTensorListGetSize(list) == 8);
+    for (int64_t i = 0; i < 8; i++)
+      checkDims(omTensorListGetOmtByIndex(list, i), shape,
+          omTensorGetRank(omTensorListGetOmtByIndex(list, i)));
+    /* The arena was coalesced by the first reset, so rounds after the
+     * second one reuse exactly the same memory.
+     */
+    if (round == 1) {
+      firstList = list;
+      firstOmt = omTensorListGetOmtByIndex(list, 0);
+    } else if (round > 1) {
+      assert(list == firstList);
+      assert(omTensorListGetOmtByIndex(list, 0) == firstOmt);
+    }
+    omTensorListDestroy(list);
+    omTensorArenaReset(arena);
+  }
+
+  omTensorArenaSetCurrent(NULL);
+  omTensorArenaDestroy(arena);
+
+  /* Without a current arena, metadata comes from the heap again. */
+  OMTensorList *list = createOutputs(shape, 2);
+  assert(list);
+  omTensorListDestroy(list);
+}
+
+int main() {
+  testOMTensorLayout();
+  testOMTensorArenaReuse();
+  return 0;
+}
@@ -19,5 +19,19 @@ int main(int argc, char *argv[]) {
   OMInstrumentPoint(*(const int64_t*)op4, 9);
   std::this_thread::sleep_for(std::chrono::milliseconds(1000));
   OMInstrumentPoint(*(const int64_t*)opfinal, 12);
+  // Named points are accumulated per node and summarized at exit.
+  for (int i = 0; i < 3; ++i) {
+    OMInstrumentNamedPoint("Conv", "conv_0", 5);
+    OMInstrumentNamedPoint("Conv", "conv_0", 6);
+    OMInstrumentNamedPoint("Conv", "conv_1", 5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    OMInstrumentNamedPoint("Conv", "conv_1", 6);
+  }
+  // Hardware counters are reported when the tag has the perf bit (16) set.
+  volatile double sum = 0;
+  OMInstrumentNamedPoint("Sum", "sum_0", 21);
+  for (int i = 0; i < 1000000; ++i)
+    sum += i;
+  OMInstrumentNamedPoint("Sum", "sum_0", 22);
   return 0;
 }
@@ -10,10 +10,10 @@
 /*
   This file help run a onnx model as simply as possible for testing.
   Compile as follows in the onnx-mlir build subdirectory. The tool is built as
-  follows. For dinamically loaded models:
+  follows. For dinamically loaded models, the tool is a regular CMake target:
 
 cd onnx-mlir/build
-. ../utils/build-run-onnx-lib.sh
+cmake --build . --target run-onnx-lib
 run-onnx-lib test/backend/test_add.so
 
   For statically loaded models, best is to run the utility in the directory
@@ -41,10 +41,23 @@ Usage: run-onnx-lib [options] model.so
          Default is "run_main_graph".
     -n NUM | --iterations NUM
          Number of times to run the tests, default 1
+    -w NUM | --warmup NUM
+         Number of untimed iterations run before the measured ones
+    -t NUM | --threads NUM
+         Number of concurrent runners in closed-loop throughput mode
+    -p | --pin
+         Pin the input buffers in memory
+    -j file | --json file
+         Write the latency and throughput results as JSON to file
     -v | --verbose
          Print the shape of the inputs and outputs
     -h | --help
          help
+
+  A typical benchmark invocation, with 10 warmup runs followed by 1000
+  measured runs on each of 4 concurrent runners, is:
+
+run-onnx-lib -w 10 -m 1000 -t 4 -p -j results.json model.so
 */
 
 //===----------------------------------------------------------------------===//
@@ -54,27 +67,29 @@ Usage: run-onnx-lib [options] model.so
 
 #include <algorithm>
 #include <assert.h>
+#include <chrono>
+#include <cmath>
 #include <dlfcn.h>
 #include <getopt.h>
 #include <iostream>
 #include <string>
+#include <sys/mman.h>
+#include <thread>
 #include <vector>
 
 // Json reader & LLVM suport.
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
 
 // Include ONNX-MLIR Runtime support.
 #include "OnnxMlirRuntime.h"
 
 using namespace std;
 
-#ifdef _WIN32
-// TO BE FIXED
-#else
-#include <sys/time.h>
-#endif
 // Data structure to hold measurement times (in microseconds).
 vector<uint64_t> timeLogInMicroSec;
+// Wall-clock time of the measured iterations over all runners, in seconds.
+static double wallTimeInSec = 0;
 
 // Interface definitions
 extern "C" OMTensorList *run_main_graph(OMTensorList *);
@@ -98,7 +113,7 @@ void (*dll_omTensorListDestroy)(OMTensorList *);
 #define OM_TENSOR_CREATE omTensorCreate
 #define OM_TENSOR_LIST_CREATE omTensorListCreate
 #define OM_TENSOR_LIST_DESTROY omTensorListDestroy
-#define OPTIONS "hn:m:vd:r:"
+#define OPTIONS "hn:m:vd:r:w:t:pj:"
 #else
 #define RUN_MAIN_GRAPH dll_run_main_graph
 #define OM_INPUT_SIGNATURE dll_omInputSignature
@@ -106,14 +121,20 @@ void (*dll_omTensorListDestroy)(OMTensorList *);
 #define OM_TENSOR_CREATE dll_omTensorCreate
 #define OM_TENSOR_LIST_CREATE dll_omTensorListCreate
 #define OM_TENSOR_LIST_DESTROY dll_omTensorListDestroy
-#define OPTIONS "e:hn:m:vd:r:"
+#define OPTIONS "e:hn:m:vd:r:w:t:pj:"
 #endif
 
 // Global variables to record what we should do in this run.
 static int sIterations = 1;
+static int sWarmup = 0;
+static int sThreads = 1;
 static bool verbose = false;
 static bool reuseInput = true;
+static bool pinInput = false;
 static bool measureExecTime = false;
+static string jsonFileName;
+static string modelName;
+static string entryPointName("run_main_graph");
 static vector<int64_t> dimKnownAtRuntime;
 
 void usage(const char *name) {
@@ -142,12 +163,25 @@ void usage(const char *name) {
 #endif
   cout << "    -h | --help" << endl;
   cout << "         Print help message." << endl;
+  cout << "    -j file | --json file" << endl;
+  cout << "         Write latency percentiles and throughput as JSON" << endl;
+  cout << "         to file (\"-\" for stdout). Measures time." << endl;
   cout << "    -n NUM | --iterations NUM" << endl;
   cout << "         Number of times to run the tests, default 1." << endl;
   cout << "    -m NUM | --meas NUM" << endl;
   cout << "         Measure the kernel execution time NUM times." << endl;
+  cout << "    -p | --pin" << endl;
+  cout << "         Pin the input buffers in memory (mlock) so that" << endl;
+  cout << "         page faults do not pollute the measurements." << endl;
   cout << "    -r | -reuse true|false" << endl;
   cout << "         Reuse input data, default on" << endl;
+  cout << "    -t NUM | --threads NUM" << endl;
+  cout << "         Closed-loop throughput mode: NUM runners, each" << endl;
+  cout << "         with its own inputs, run back to back." << endl;
+  cout << "         Implies time measurement. Default is 1." << endl;
+  cout << "    -w NUM | --warmup NUM" << endl;
+  cout << "         Run NUM untimed iterations per runner before the" << endl;
+  cout << "         measured ones, default 0." << endl;
   cout << "    -v | --verbose" << endl;
   cout << "         Print the shape of the inputs and outputs." << endl;
   cout << endl;
@@ -189,15 +223,18 @@ void loadDLL(string name, string entryPointName) {
 void parseArgs(int argc, char **argv) {
   dimKnownAtRuntime.clear();
   int c;
-  string entryPointName("run_main_graph");
   static struct option long_options[] = {
       {"dim", required_argument, 0, 'd'},         // dimensions.
       {"entry-point", required_argument, 0, 'e'}, // Entry point.
       {"help", no_argument, 0, 'h'},              // Help.
       {"iterations", required_argument, 0, 'n'},  // Number of iterations.
+      {"json", required_argument, 0, 'j'},        // JSON output file.
       {"meas", required_argument, 0, 'm'},        // Measurement of time.
+      {"pin", no_argument, 0, 'p'},               // Pin inputs in memory.
       {"reuse", required_argument, 0, 'r'},       // cached input.
+      {"threads", required_argument, 0, 't'},     // Concurrent runners.
       {"verbose", no_argument, 0, 'v'},           // Verbose.
+      {"warmup", required_argument, 0, 'w'},      // Untimed iterations.
       {0, 0, 0, 0}};
 
   while (true) {
@@ -227,6 +264,10 @@ void parseArgs(int argc, char **argv) {
     case 'e':
       entryPointName = optarg;
       break;
+    case 'j':
+      jsonFileName = optarg;
+      measureExecTime = true;
+      break;
     case 'n':
       sIterations = atoi(optarg);
       break;
@@ -250,9 +291,19 @@ void parseArgs(int argc, char **argv) {
         usage(argv[0]);
       }
       break;
+    case 'p':
+      pinInput = true;
+      break;
+    case 't':
+      sThreads = atoi(optarg);
+      measureExecTime = true;
+      break;
     case 'v':
       verbose = true;
       break;
+    case 'w':
+      sWarmup = atoi(optarg);
+      break;
     default:
       usage(argv[0]);
     }
@@ -260,6 +311,10 @@ void parseArgs(int argc, char **argv) {
   // Make sure that iterations are positive.
   if (sIterations < 1)
     sIterations = 1;
+  if (sWarmup < 0)
+    sWarmup = 0;
+  if (sThreads < 1)
+    sThreads = 1;
 
 // Process the DLL.
 #if LOAD_MODEL_STATICALLY
@@ -272,8 +327,8 @@ void parseArgs(int argc, char **argv) {
     cout << "Error: need one model.so dynamic library" << endl;
     usage(argv[0]);
   } else if (optind + 1 == argc) {
-    string name = argv[optind];
-    loadDLL(name, entryPointName);
+    modelName = argv[optind];
+    loadDLL(modelName, entryPointName);
   } else {
     cout << "Error: handle only one model.so dynamic library at a time" << endl;
     usage(argv[0]);
@@ -281,6 +336,19 @@ void parseArgs(int argc, char **argv) {
 #endif
 }
 
+// Lock freshly allocated input data in memory when requested, so that the
+// measured runs neither page fault on nor swap out their inputs.
+void pinInputData(void *data, size_t size) {
+  if (!pinInput || size == 0)
+    return;
+  if (mlock(data, size) != 0) {
+    static bool warned = false;
+    if (!warned)
+      perror("> Failed to pin input data, check ulimit -l");
+    warned = true;
+  }
+}
+
 /**
  * \brief Create and initialize an OMTensorList from the signature of a model
  *
@@ -367,6 +435,7 @@ OMTensorList *omTensorListCreateFromInputSignature(
       } else if (dataAlloc) {
         data = new float[size];
         assert(data && "failed to allocate data");
+        pinInputData(data, size * sizeof(float));
       }
       tensor = OM_TENSOR_CREATE(data, shape, rank, ONNX_TYPE_FLOAT);
     } else if (type.equals("double") || type.equals("f64") || type.equals("i64")) {
@@ -377,6 +446,7 @@ OMTensorList *omTensorListCreateFromInputSignature(
       } else if (dataAlloc) {
         data = new double[size];
         assert(data && "failed to allocate data");
+        pinInputData(data, size * sizeof(double));
       }
       tensor = OM_TENSOR_CREATE(data, shape, rank, ONNX_TYPE_DOUBLE);
     }
@@ -394,37 +464,13 @@ OMTensorList *omTensorListCreateFromInputSignature(
   return OM_TENSOR_LIST_CREATE(inputTensors, inputNum);
 }
 
-// Data structures for timing info.
-#ifdef _WIN32
-#else
-struct timeval startTime, stopTime, result;
-#endif
-
-// Process start time.
-#ifdef _WIN32
-inline void processStartTime() {}
-#else
-inline void processStartTime() {
-  if (!measureExecTime)
-    return;
-  gettimeofday(&startTime, NULL);
-}
-#endif
-
-// Process stop time, store result in log.
-#ifdef _WIN32
-inline void processStopTime() {}
-#else
-inline void processStopTime() {
-  if (!measureExecTime)
-    return;
-  gettimeofday(&stopTime, NULL);
-  timersub(&stopTime, &startTime, &result);
-  uint64_t time =
-      (uint64_t)result.tv_sec * 1000000ull + (uint64_t)result.tv_usec;
-  timeLogInMicroSec.emplace_back(time);
+// Return the value at the given percentile of a sorted time log, using the
+// nearest-rank method.
+double percentile(double pct) {
+  int s = timeLogInMicroSec.size();
+  int rank = (int)ceil(pct / 100.0 * s);
+  return (double)timeLogInMicroSec[max(rank, 1) - 1];
 }
-#endif
 
 // Print timing info, removing shortest/longest measured time.
 void printTime(double avg, double std, double factor, string unit) {
@@ -436,6 +482,38 @@ void printTime(double avg, double std, double factor, string unit) {
       (double)(avg / factor), (double)(std / factor),
       (double)timeLogInMicroSec[0] / factor,
       (double)timeLogInMicroSec[s - 1] / factor, s);
+  printf("@latency, %s, p50, %.1f, p90, %.1f, p99, %.1f, max, %.1f\n",
+      unit.c_str(), percentile(50) / factor, percentile(90) / factor,
+      percentile(99) / factor, (double)timeLogInMicroSec[s - 1] / factor);
+}
+
+// Write the benchmark results in JSON format, either to stdout or to the file
+// given by the -j option.
+void writeJSON(double avg, double std) {
+  int s = timeLogInMicroSec.size();
+  llvm::json::Object latency{{"min", (double)timeLogInMicroSec[0]},
+      {"p50", percentile(50)}, {"p90", percentile(90)},
+      {"p99", percentile(99)}, {"max", (double)timeLogInMicroSec[s - 1]},
+      {"avg", avg}, {"std", std}};
+  llvm::json::Object throughput{{"runners", sThreads}, {"inferences", s},
+      {"wall_time_s", wallTimeInSec},
+      {"inferences_per_s", wallTimeInSec > 0 ? s / wallTimeInSec : 0.0}};
+  llvm::json::Object results{{"model", modelName},
+      {"entry_point", entryPointName}, {"warmup", sWarmup},
+      {"iterations", sIterations}, {"pinned_inputs", pinInput},
+      {"reuse_inputs", reuseInput}, {"latency_us", std::move(latency)},
+      {"throughput", std::move(throughput)}};
+
+  std::error_code EC;
+  llvm::raw_fd_ostream file(jsonFileName, EC);
+  if (EC) {
+    cout << "Error: cannot open " << jsonFileName << ": " << EC.message()
+         << endl;
+    return;
+  }
+  llvm::json::OStream J(file, 2);
+  J.value(llvm::json::Value(std::move(results)));
+  file << "\n";
 }
 
 void displayTime() {
@@ -459,26 +537,43 @@ void displayTime() {
   if (avg >= 1e6) {
     printTime(avg, std, 1e6, "second");
   }
+  if (wallTimeInSec > 0)
+    printf("@throughput, runners, %d, inferences, %d, wall-second, %.3f, "
+           "inferences-per-second, %.1f\n",
+        sThreads, s, wallTimeInSec, s / wallTimeInSec);
+  if (!jsonFileName.empty()) {
+    fflush(stdout);
+    writeJSON(avg, std);
+  }
 }
 
-// Perform generation of input, run, measure time,...
-int main(int argc, char **argv) {
-  // Init args.
-  parseArgs(argc, argv);
-  // Init inputs.
-  OMTensorList *tensorListIn =
-      omTensorListCreateFromInputSignature(nullptr, true, verbose, false);
+// Closed-loop runner: run the warmup iterations, then the measured ones back
+// to back, recording the latency of each measured run in timeLog and the
+// bounds of the measured window in window. Every runner owns its inputs so
+// that concurrent runners share no data.
+using TimePoint = chrono::steady_clock::time_point;
+void runIterations(
+    int runner, vector<uint64_t> &timeLog, pair<TimePoint, TimePoint> &window) {
+  bool first = runner == 0;
+  OMTensorList *tensorListIn = omTensorListCreateFromInputSignature(
+      nullptr, true, verbose && first, !first);
   assert(tensorListIn && "failed to scan signature");
-  // Call the compiled onnx model function.
-  cout << "Start computing " << sIterations << " iterations" << endl;
-  for (int i = 0; i < sIterations; ++i) {
+  int total = sWarmup + sIterations;
+  for (int i = 0; i < total; ++i) {
     OMTensorList *tensorListOut = nullptr;
-    processStartTime();
+    TimePoint startTime = chrono::steady_clock::now();
     tensorListOut = RUN_MAIN_GRAPH(tensorListIn);
-    processStopTime();
+    TimePoint stopTime = chrono::steady_clock::now();
+    if (i == sWarmup)
+      window.first = startTime;
+    window.second = stopTime;
+    if (measureExecTime && i >= sWarmup)
+      timeLog.emplace_back(
+          chrono::duration_cast<chrono::microseconds>(stopTime - startTime)
+              .count());
     if (tensorListOut)
       OM_TENSOR_LIST_DESTROY(tensorListOut);
-    if (i > 0 && i % 10 == 0)
+    if (first && sThreads == 1 && i > 0 && i % 10 == 0)
       cout << "  computed " << i << " iterations" << endl;
     if (!reuseInput) {
       OM_TENSOR_LIST_DESTROY(tensorListIn);
@@ -486,10 +581,43 @@ int main(int argc, char **argv) {
           omTensorListCreateFromInputSignature(nullptr, true, false, true);
     }
   }
+  OM_TENSOR_LIST_DESTROY(tensorListIn);
+}
+
+// Perform generation of input, run, measure time,...
+int main(int argc, char **argv) {
+  // Init args.
+  parseArgs(argc, argv);
+  // Call the compiled onnx model function.
+  cout << "Start computing " << sIterations << " iterations";
+  if (sWarmup > 0)
+    cout << " after " << sWarmup << " warmup iterations";
+  if (sThreads > 1)
+    cout << " on each of " << sThreads << " runners";
+  cout << endl;
+  vector<vector<uint64_t>> timeLogs(sThreads);
+  vector<pair<TimePoint, TimePoint>> windows(sThreads);
+  if (sThreads == 1) {
+    runIterations(0, timeLogs[0], windows[0]);
+  } else {
+    vector<thread> runners;
+    for (int t = 0; t < sThreads; ++t)
+      runners.emplace_back(runIterations, t, ref(timeLogs[t]), ref(windows[t]));
+    for (thread &runner : runners)
+      runner.join();
+  }
+  // Throughput is measured from the first measured run of any runner to the
+  // last completed run, so that warmup iterations are left out.
+  TimePoint windowStart = windows[0].first, windowStop = windows[0].second;
+  for (int t = 0; t < sThreads; ++t) {
+    timeLogInMicroSec.insert(
+        timeLogInMicroSec.end(), timeLogs[t].begin(), timeLogs[t].end());
+    windowStart = min(windowStart, windows[t].first);
+    windowStop = max(windowStop, windows[t].second);
+  }
+  if (measureExecTime)
+    wallTimeInSec = chrono::duration<double>(windowStop - windowStart).count();
   cout << "Finish computing " << sIterations << " iterations" << endl;
   displayTime();
-
-  // Cleanup.
-  OM_TENSOR_LIST_DESTROY(tensorListIn);
   return 0;
 }